@@ -0,0 +1,260 @@
+/**
+ * Benchmark: đường xử lý lệnh MQTT
+ *
+ * So sánh handleMqttCommand() (parse tại chỗ trong buffer PubSubClient,
+ * trả lời từ template tĩnh) với bản sao đường cũ trong mqttCallback()
+ * (VLA char msg[length + 1], StaticJsonDocument<256> trên stack,
+ * StaticJsonDocument<128> + char[128] cho bản tin trả lời).
+ *
+ * Chạy trên host với HEAP_TRACK_ALLOCATIONS + -Wl,--wrap=malloc,... và đo:
+ *   - số lần cấp phát heap mỗi lệnh (theo scope của heap_monitor)
+ *   - stack sâu nhất mỗi lệnh (tô stack trước khi gọi, đếm phần bị ghi đè)
+ *   - thời gian trung bình từng đợt khi chạy liên tục, để thấy không tăng dần
+ *   - kích thước lệnh và bản tin trả lời, JSON so với MessagePack (topic /mp)
+ */
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <unistd.h>
+#include "config.h"
+#include "heap_monitor.h"
+#include "scheduler.h"
+#include "locker_controller.h"
+#include "status_outbox.h"
+#include "pin_cache.h"
+#include "command_dedup.h"
+#include "mqtt_commands.h"
+
+// ============================================
+// Configuration
+// ============================================
+#define BENCH_COMMANDS 20000     // Số lệnh mỗi trường hợp
+#define BENCH_BATCHES 10         // Chia thành các đợt để so thời gian
+#define STACK_PROBE 16384        // Vùng stack được tô để đo (byte)
+#define STACK_FILL 0xA5
+
+static FILE* _out = stdout;      // Kết quả; stdout (log Serial) bị chuyển vào /dev/null
+static uint32_t _published = 0;
+static size_t _replyBytes = 0;
+
+// ============================================
+// Legacy Path (mqttCallback trước đây)
+// ============================================
+
+static bool countPublish(const char* topic, const uint8_t* payload, size_t length) {
+    _published++;
+    _replyBytes = length;
+    return length > 0;
+}
+
+static void legacyCommand(char* topic, byte* payload, unsigned int length) {
+    HeapScope heapScope("legacy:command");
+
+    char msg[length + 1];
+    memcpy(msg, payload, length);
+    msg[length] = '\0';
+
+    Serial.printf("[MQTT] Message on [%s]: %s\n", topic, msg);
+
+    StaticJsonDocument<256> doc;
+    DeserializationError err = deserializeJson(doc, msg);
+    if (err) return;
+
+    int cmdBoxId = doc["box_id"] | -1;
+    const char* action = doc["action"] | "";
+    if (!isValidBox(cmdBoxId)) return;
+
+    bool open = strcmp(action, "OPEN") == 0;
+    if (open) {
+        unlockBox(cmdBoxId);
+    } else {
+        lockBox(cmdBoxId);
+    }
+
+    StaticJsonDocument<128> status;
+    status["box_id"] = cmdBoxId;
+    status["status"] = open ? "UNLOCKED" : "LOCKED";
+    status["device"] = DEVICE_ID;
+    char statusMsg[128];
+    serializeJson(status, statusMsg);
+    countPublish(MQTT_TOPIC_STATUS, (const uint8_t*)statusMsg, strlen(statusMsg));
+}
+
+static void currentCommand(char* topic, byte* payload, unsigned int length) {
+    markMqttReceive();
+    handleMqttCommand(topic, payload, length);
+}
+
+// ============================================
+// Stack Measurement
+// ============================================
+
+/**
+ * Tô vùng stack bên dưới frame hiện tại; lệnh được gọi ngay sau đó dùng
+ * lại đúng vùng này
+ */
+__attribute__((noinline)) static uint8_t* paintStack() {
+    uintptr_t frame = (uintptr_t)__builtin_frame_address(0);
+    uint8_t* bottom = (uint8_t*)(frame - 256 - STACK_PROBE);
+    memset(bottom, STACK_FILL, STACK_PROBE);
+    return bottom;
+}
+
+static uint32_t stackDepth(const uint8_t* bottom, const uint8_t* top) {
+    const uint8_t* p = bottom;
+    while (p < top && *p == STACK_FILL) p++;
+    return (uint32_t)(top - p);
+}
+
+// ============================================
+// Benchmark Runner
+// ============================================
+
+typedef void (*CommandHandler)(char* topic, byte* payload, unsigned int length);
+
+/**
+ * Dựng payload thứ i; cmd_id đổi theo i để dedup không chặn lệnh
+ */
+typedef int (*PayloadBuilder)(char* buffer, size_t size, uint32_t i);
+
+static int openPayload(char* buffer, size_t size, uint32_t i) {
+    return snprintf(buffer, size, "{\"box_id\":%d,\"action\":\"%s\",\"cmd_id\":\"%08lx-0b4a-4c55-9d7e-1a2b3c4d5e6f\",\"seq\":%lu}",
+                    BOX_ID, (i & 1) ? "LOCK" : "OPEN", (unsigned long)i, (unsigned long)i + 1);
+}
+
+static int paddedPayload(char* buffer, size_t size, uint32_t i) {
+    int len = snprintf(buffer, size, "{\"box_id\":%d,\"action\":\"%s\",\"seq\":%lu,\"note\":\"",
+                       BOX_ID, (i & 1) ? "LOCK" : "OPEN", (unsigned long)i + 1);
+    while (len < 400) buffer[len++] = 'x';
+    return len + snprintf(buffer + len, size - len, "\"}");
+}
+
+static int provisionPayload(char* buffer, size_t size, uint32_t i) {
+    return snprintf(buffer, size,
+                    "{\"box_id\":%d,\"action\":\"PIN_PROVISION\",\"order_id\":%lu,\"cmd_id\":\"p%lu\","
+                    "\"salt\":\"00112233445566778899aabbccddeeff\","
+                    "\"hash\":\"752ca099318cb3ac4debe4d367d35247b98e7055ee32950d33cb3e6a9a9cace3\",\"ttl\":3600}",
+                    BOX_ID, (unsigned long)(i % PIN_CACHE_SIZE) + 1, (unsigned long)i);
+}
+
+static int duplicatePayload(char* buffer, size_t size, uint32_t i) {
+    return snprintf(buffer, size, "{\"box_id\":%d,\"action\":\"OPEN\",\"cmd_id\":\"6f1c2d9e-0b4a-4c55-9d7e-1a2b3c4d5e6f\"}", BOX_ID);
+}
+
+/**
+ * Cùng lệnh dạng MessagePack (gửi lên topic /mp)
+ */
+static int msgpackPayload(char* buffer, size_t size, uint32_t i, PayloadBuilder json) {
+    static char text[MQTT_BUFFER_SIZE];
+    StaticJsonDocument<JSON_OBJECT_SIZE(10)> doc;
+    json(text, sizeof(text), i);
+    deserializeJson(doc, (const char*)text);
+    return serializeMsgPack(doc, buffer, size);
+}
+
+static int openMsgpack(char* buffer, size_t size, uint32_t i) {
+    return msgpackPayload(buffer, size, i, openPayload);
+}
+
+static int provisionMsgpack(char* buffer, size_t size, uint32_t i) {
+    return msgpackPayload(buffer, size, i, provisionPayload);
+}
+
+static HeapSiteStats siteStats(const char* name) {
+    HeapSiteStats sites[HEAP_MAX_SITES];
+    uint8_t count = heapTopSites(sites, HEAP_MAX_SITES);
+    for (uint8_t i = 0; i < count; i++) {
+        if (strcmp(sites[i].site, name) == 0) return sites[i];
+    }
+    HeapSiteStats empty = {};
+    return empty;
+}
+
+static void runCase(const char* name, CommandHandler handler, const char* site, PayloadBuilder build,
+                    const char* commandTopic = MQTT_TOPIC_CMD) {
+    // Buffer giống buffer của PubSubClient: payload bị sửa tại chỗ khi parse
+    static uint8_t buffer[MQTT_BUFFER_SIZE];
+    static char topic[64];
+
+    // Chạy nóng (buffer stdio, site heap_monitor...) trước khi đo
+    for (uint32_t i = 0; i < 16; i++) {
+        strcpy(topic, commandTopic);
+        unsigned int length = build((char*)buffer, sizeof(buffer), i);
+        handler(topic, buffer, length);
+    }
+
+    HeapSiteStats before = siteStats(site);
+    uint32_t payloadBytes = 0;
+    uint32_t maxStack = 0;
+    uint32_t maxUs = 0;
+    uint32_t batchUs[BENCH_BATCHES] = {};
+
+    const uint8_t* top = (const uint8_t*)(uintptr_t)__builtin_frame_address(0);
+
+    for (uint32_t i = 0; i < BENCH_COMMANDS; i++) {
+        strcpy(topic, commandTopic);
+        unsigned int length = build((char*)buffer, sizeof(buffer), 1000 + i);
+        payloadBytes = length;
+
+        uint8_t* bottom = paintStack();
+        uint32_t start = micros();
+        handler(topic, buffer, length);
+        uint32_t us = micros() - start;
+
+        uint32_t depth = stackDepth(bottom, top);
+        if (depth > maxStack) maxStack = depth;
+        if (us > maxUs) maxUs = us;
+        batchUs[i / (BENCH_COMMANDS / BENCH_BATCHES)] += us;
+
+        // Như loop(): các auto-lock tới hạn được chạy giữa các lệnh
+        schedulerRun();
+    }
+
+    HeapSiteStats after = siteStats(site);
+    double allocs = (double)(after.allocs - before.allocs) / BENCH_COMMANDS;
+    double allocBytes = (double)(after.allocBytes - before.allocBytes) / BENCH_COMMANDS;
+
+    double total = 0;
+    for (uint8_t b = 0; b < BENCH_BATCHES; b++) total += batchUs[b];
+    fprintf(_out, "%-22s %4u B -> %3u B  %6.2f allocs %7.1f B heap %6u B stack %7.2f us avg %6u us max\n",
+            name, (unsigned)payloadBytes, (unsigned)_replyBytes, allocs, allocBytes, (unsigned)maxStack,
+            total / BENCH_COMMANDS, (unsigned)maxUs);
+
+    fprintf(_out, "%-22s batches (us avg):", "");
+    for (uint8_t b = 0; b < BENCH_BATCHES; b++) {
+        fprintf(_out, " %.2f", (double)batchUs[b] / (BENCH_COMMANDS / BENCH_BATCHES));
+    }
+    fprintf(_out, "\n");
+}
+
+int main() {
+    // Kết quả ra stdout gốc, log Serial của firmware vào /dev/null
+    _out = fdopen(dup(STDOUT_FILENO), "w");
+    setvbuf(_out, nullptr, _IOLBF, 0);
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+
+#ifndef HEAP_TRACK_ALLOCATIONS
+    fprintf(_out, "Build with -DHEAP_TRACK_ALLOCATIONS -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc\n");
+#endif
+
+    initHeapMonitor();
+    initScheduler();
+    initLockerController();
+    initStatusOutbox();
+    initMqttCommands(countPublish);
+    initPinCache(publishPinUsed);
+    initCommandDedup();
+
+    fprintf(_out, "%d commands per case, MQTT_BUFFER_SIZE %d\n", BENCH_COMMANDS, MQTT_BUFFER_SIZE);
+    runCase("current OPEN/LOCK", currentCommand, "mqtt:command", openPayload);
+    runCase("current padded", currentCommand, "mqtt:command", paddedPayload);
+    runCase("current PIN_PROVISION", currentCommand, "mqtt:command", provisionPayload);
+    runCase("current duplicate", currentCommand, "mqtt:command", duplicatePayload);
+    runCase("msgpack OPEN/LOCK", currentCommand, "mqtt:command", openMsgpack, MQTT_TOPIC_CMD_MSGPACK);
+    runCase("msgpack PIN_PROVISION", currentCommand, "mqtt:command", provisionMsgpack, MQTT_TOPIC_CMD_MSGPACK);
+    runCase("json after msgpack", currentCommand, "mqtt:command", openPayload);
+    runCase("legacy OPEN/LOCK", legacyCommand, "legacy:command", openPayload);
+    runCase("legacy padded", legacyCommand, "legacy:command", paddedPayload);
+    fprintf(_out, "%lu replies published\n", (unsigned long)_published);
+    return 0;
+}
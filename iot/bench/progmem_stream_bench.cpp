@@ -0,0 +1,154 @@
+/**
+ * Benchmark: PROGMEM streaming vs send_P() chặn
+ *
+ * Chạy trên Linux với lớp giả lập Arduino/ESP8266 cho host. Một web server
+ * phục vụ trang kiosk (LOCKER_UI_HTML, không nén) qua hai route:
+ *   /stream   streamProgmem(): handler trả về ngay, loop() ghi từng khối
+ *   /blocking server.send_P(): handler giữ loop() tới khi gửi hết
+ * Các thread client tải trang liên tục (có thể giới hạn tốc độ để giả lập
+ * tablet Wi-Fi chậm). Vòng lặp chính đóng vai loop() và đo:
+ *   - throughput (byte/s)
+ *   - heap cao nhất dùng thêm so với lúc bắt đầu
+ *   - vòng loop() dài nhất = thời gian một lệnh MQTT mở khóa phải chờ
+ */
+
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+#include <host_env.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "config.h"
+#include "progmem_stream.h"
+#include "web_ui.h"
+
+// ============================================
+// Configuration
+// ============================================
+#define BENCH_PORT 18480
+
+static ESP8266WebServer server(BENCH_PORT);
+static std::atomic<uint64_t> _received(0);
+static std::atomic<int> _running(0);
+
+// ============================================
+// Handlers
+// ============================================
+
+static void handleStream() {
+    streamProgmem(server, 200, "text/html", LOCKER_UI_HTML, sizeof(LOCKER_UI_HTML) - 1);
+}
+
+static void handleBlocking() {
+    server.send_P(200, "text/html", LOCKER_UI_HTML, sizeof(LOCKER_UI_HTML) - 1);
+}
+
+// ============================================
+// Client Threads
+// ============================================
+
+/**
+ * Tải trang `requests` lần; rateBps > 0 thì đọc không nhanh hơn rateBps
+ */
+static void clientThread(const char* path, int requests, uint32_t rateBps) {
+    char request[128];
+    int requestLen = snprintf(request, sizeof(request),
+                              "GET %s HTTP/1.1\r\nHost: bench\r\nConnection: close\r\n\r\n", path);
+
+    for (int i = 0; i < requests; i++) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (rateBps > 0) {
+            int rcvBuf = 2048;  // Cửa sổ nhận nhỏ như tablet qua Wi-Fi
+            setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvBuf, sizeof(rcvBuf));
+        }
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(BENCH_PORT);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            close(fd);
+            continue;
+        }
+        send(fd, request, requestLen, MSG_NOSIGNAL);
+
+        char buffer[512];
+        uint64_t start = micros();
+        uint64_t got = 0;
+        ssize_t n;
+        while ((n = recv(fd, buffer, rateBps > 0 ? 256 : sizeof(buffer), 0)) > 0) {
+            got += n;
+            if (rateBps > 0) {
+                uint64_t due = start + got * 1000000ULL / rateBps;
+                uint64_t now = micros();
+                if (due > now) usleep(due - now);
+            }
+        }
+        _received += got;
+        close(fd);
+    }
+    _running--;
+}
+
+// ============================================
+// Benchmark Runner
+// ============================================
+
+static void runCase(const char* name, const char* path, int clients, int requests, uint32_t rateBps) {
+    _received = 0;
+    _running = clients;
+
+    uint32_t baseline = ESP.getFreeHeap();
+    uint32_t minFree = baseline;
+    uint32_t maxLoopUs = 0;
+
+    std::vector<std::thread> threads;
+    uint64_t start = micros();
+    for (int i = 0; i < clients; i++) threads.emplace_back(clientThread, path, requests, rateBps);
+
+    ProgmemStreamStats stream;
+    do {
+        uint32_t loopStart = micros();
+        server.handleClient();
+        progmemStreamLoop();
+        uint32_t loopUs = micros() - loopStart;
+        if (loopUs > maxLoopUs) maxLoopUs = loopUs;
+
+        uint32_t freeHeap = ESP.getFreeHeap();
+        if (freeHeap < minFree) minFree = freeHeap;
+
+        // Như schedulerIdle(): ngủ ngắn khi không có việc
+        if (!progmemStreamReady()) usleep(200);
+        progmemStreamGetStats(stream);
+    } while (_running > 0 || stream.active > 0);
+
+    uint64_t elapsed = micros() - start;
+    for (auto& t : threads) t.join();
+
+    double seconds = elapsed / 1e6;
+    Serial.printf("%-26s %10.0f B/s %8u B heap %9.2f ms max loop\n",
+                  name, (double)_received / seconds, (unsigned)(baseline - minFree), maxLoopUs / 1000.0);
+}
+
+int main() {
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    server.on("/stream", HTTP_GET, handleStream);
+    server.on("/blocking", HTTP_GET, handleBlocking);
+    server.begin();
+
+    Serial.printf("Asset: %u bytes, STREAM_BLOCK_SIZE %d, STREAM_MAX_CLIENTS %d\n",
+                  (unsigned)(sizeof(LOCKER_UI_HTML) - 1), STREAM_BLOCK_SIZE, STREAM_MAX_CLIENTS);
+
+    // Client nhanh (loopback): đo throughput
+    runCase("stream   fast x1", "/stream", 1, 200, 0);
+    runCase("blocking fast x1", "/blocking", 1, 200, 0);
+
+    // Tablet chậm 64 KB/s: đo thời gian loop() bị giữ
+    runCase("stream   64KB/s x2", "/stream", 2, 3, 64 * 1024);
+    runCase("blocking 64KB/s x2", "/blocking", 2, 3, 64 * 1024);
+    return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * Benchmark: hàng đợi SPSC giữa task mạng và task actuation
+ *
+ * Chạy trên Linux với lớp giả lập FreeRTOS của host (mỗi task một thread,
+ * gắn CPU theo lõi nếu máy có từ 2 CPU). Producer ghim NETWORK_CORE,
+ * consumer ghim ACTUATION_CORE, như dual_core.cpp:
+ *   - throughput: producer đẩy liên tục (quay lại khi đầy), consumer kiểm
+ *     tra thứ tự từng phần tử
+ *   - latency: mỗi ms một lệnh, consumer ngủ như actuatorIdle(); so sánh
+ *     đánh thức bằng task notification với chỉ quét mỗi ACTUATION_POLL_MS
+ */
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "config.h"
+#include "spsc_queue.h"
+
+// ============================================
+// Configuration
+// ============================================
+#define BENCH_ITEMS 2000000     // Phần tử cho phép đo throughput
+#define BENCH_COMMANDS 2000     // Lệnh cho phép đo latency (1 lệnh/ms)
+
+struct BenchItem {
+    uint32_t seq;
+    uint32_t queuedUs;
+};
+
+static SpscQueue<BenchItem, ACTUATOR_QUEUE_SIZE> _queue;
+static TaskHandle_t _consumerTask = nullptr;
+static std::atomic<int> _finished(0);
+
+// Kết quả của lần chạy hiện tại (chỉ consumer ghi)
+static uint32_t _received = 0;
+static uint32_t _orderErrors = 0;
+static std::vector<uint32_t> _latencies;
+static bool _notify = true;
+
+// ============================================
+// Throughput
+// ============================================
+
+static void throughputProducer(void* arg) {
+    for (uint32_t seq = 0; seq < BENCH_ITEMS; seq++) {
+        BenchItem item = {seq, 0};
+        while (!_queue.push(item)) taskYIELD();
+    }
+    _finished++;
+    vTaskDelete(nullptr);
+}
+
+static void throughputConsumer(void* arg) {
+    BenchItem item;
+    uint32_t expected = 0;
+    while (expected < BENCH_ITEMS) {
+        if (!_queue.pop(item)) {
+            taskYIELD();
+            continue;
+        }
+        if (item.seq != expected) _orderErrors++;
+        expected = item.seq + 1;
+        _received++;
+    }
+    _finished++;
+    vTaskDelete(nullptr);
+}
+
+// ============================================
+// Latency
+// ============================================
+
+static void latencyProducer(void* arg) {
+    for (uint32_t seq = 0; seq < BENCH_COMMANDS; seq++) {
+        vTaskDelay(1);
+        BenchItem item = {seq, (uint32_t)micros()};
+        if (!_queue.push(item)) continue;
+        if (_notify) xTaskNotifyGive(_consumerTask);
+    }
+    _finished++;
+    vTaskDelete(nullptr);
+}
+
+static void latencyConsumer(void* arg) {
+    BenchItem item;
+    uint32_t expected = 0;
+    while (_received < BENCH_COMMANDS) {
+        while (_queue.pop(item)) {
+            _latencies.push_back(micros() - item.queuedUs);
+            if (item.seq != expected) _orderErrors++;
+            expected = item.seq + 1;
+            _received++;
+        }
+        if (_received >= BENCH_COMMANDS) break;
+        // Như actuatorIdle(): notification đánh thức sớm, hết giờ thì quét lại
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ACTUATION_POLL_MS));
+    }
+    _finished++;
+    vTaskDelete(nullptr);
+}
+
+// ============================================
+// Runner
+// ============================================
+
+static void runCase(TaskFunction_t producer, TaskFunction_t consumer) {
+    _received = 0;
+    _orderErrors = 0;
+    _latencies.clear();
+    _finished = 0;
+
+    xTaskCreatePinnedToCore(consumer, "consumer", ACTUATION_TASK_STACK, nullptr, ACTUATION_TASK_PRIORITY,
+                            &_consumerTask, ACTUATION_CORE);
+    xTaskCreatePinnedToCore(producer, "producer", NETWORK_TASK_STACK, nullptr, NETWORK_TASK_PRIORITY,
+                            nullptr, NETWORK_CORE);
+    while (_finished < 2) vTaskDelay(1);
+}
+
+static void reportLatency(const char* name) {
+    std::sort(_latencies.begin(), _latencies.end());
+    uint64_t total = 0;
+    for (uint32_t us : _latencies) total += us;
+    size_t n = _latencies.size();
+    printf("%-26s %5u cmds  avg %7.1f us  p50 %5u us  p99 %5u us  max %5u us  order errors %u\n",
+           name, (unsigned)n, n ? (double)total / n : 0.0,
+           n ? _latencies[n / 2] : 0, n ? _latencies[n * 99 / 100] : 0, n ? _latencies[n - 1] : 0,
+           _orderErrors);
+}
+
+int main() {
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+    printf("SpscQueue<%u B, %d>, producer core %d, consumer core %d, poll %d ms\n",
+           (unsigned)sizeof(BenchItem), ACTUATOR_QUEUE_SIZE, NETWORK_CORE, ACTUATION_CORE, ACTUATION_POLL_MS);
+
+    uint32_t start = micros();
+    runCase(throughputProducer, throughputConsumer);
+    uint32_t elapsedUs = micros() - start;
+    printf("%-26s %u items in %.1f ms (%.1f M/s), order errors %u\n", "throughput",
+           _received, elapsedUs / 1000.0, elapsedUs ? (double)_received / elapsedUs : 0.0, _orderErrors);
+
+    _notify = true;
+    runCase(latencyProducer, latencyConsumer);
+    reportLatency("latency notify");
+
+    _notify = false;
+    runCase(latencyProducer, latencyConsumer);
+    reportLatency("latency poll only");
+    return 0;
+}
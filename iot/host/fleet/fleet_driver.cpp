@@ -0,0 +1,308 @@
+/**
+ * Fleet Driver Implementation
+ */
+
+#include "fleet_driver.h"
+#include "fleet_pool.h"
+#include <ArduinoJson.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+
+#define DRIVER_KEEPALIVE 60         // Giây
+#define DRIVER_STATUS_FILTER "locker/status/+"
+
+// ============================================
+// LatencyRecorder
+// ============================================
+
+void LatencyRecorder::add(uint64_t us) {
+    std::lock_guard<std::mutex> lock(_lock);
+    _us.push_back(us > UINT32_MAX ? UINT32_MAX : (uint32_t)us);
+}
+
+void LatencyRecorder::clear() {
+    std::lock_guard<std::mutex> lock(_lock);
+    _us.clear();
+}
+
+size_t LatencyRecorder::count() {
+    std::lock_guard<std::mutex> lock(_lock);
+    return _us.size();
+}
+
+void LatencyRecorder::report(FILE* out, const char* name) {
+    std::vector<uint32_t> sorted;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        sorted = _us;
+    }
+    if (sorted.empty()) {
+        fprintf(out, "  %-22s %8u\n", name, 0u);
+        return;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    auto rank = [&sorted](double p) {
+        size_t r = (size_t)(p / 100.0 * sorted.size() + 0.999999);
+        return sorted[std::max<size_t>(r, 1) - 1] / 1000.0;
+    };
+    fprintf(out, "  %-22s %8zu %10.3f %10.3f %10.3f %10.3f\n",
+            name, sorted.size(), rank(50), rank(99), rank(99.9), sorted.back() / 1000.0);
+}
+
+// ============================================
+// MQTT Connection
+// ============================================
+
+static std::string mqttString(const std::string& s) {
+    std::string out;
+    out.push_back((char)(s.size() >> 8));
+    out.push_back((char)(s.size() & 0xFF));
+    return out + s;
+}
+
+static bool recvAll(int fd, char* buf, size_t size) {
+    while (size > 0) {
+        ssize_t n = recv(fd, buf, size, 0);
+        if (n <= 0) return false;
+        buf += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static int connectTcp(const char* host, uint16_t port, uint32_t timeoutMs) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    struct sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(port);
+    if (fd < 0 || inet_pton(AF_INET, host, &sa.sin_addr) != 1 ||
+        ::connect(fd, (struct sockaddr*)&sa, sizeof(sa)) < 0) {
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    struct timeval tv = { (time_t)(timeoutMs / 1000), (suseconds_t)(timeoutMs % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    return fd;
+}
+
+FleetDriver::~FleetDriver() { disconnect(); }
+
+bool FleetDriver::connect(const char* host, uint16_t port) {
+    _fd = connectTcp(host, port, 5000);
+    if (_fd < 0) {
+        fprintf(stderr, "[DRIVER] Cannot connect to broker %s:%u\n", host, port);
+        return false;
+    }
+
+    char clientId[32];
+    snprintf(clientId, sizeof(clientId), "fleet-driver-%d", (int)getpid());
+    std::string connectBody = mqttString("MQTT") + std::string("\x04\x02", 2);
+    connectBody.push_back(0);
+    connectBody.push_back(DRIVER_KEEPALIVE);
+    connectBody += mqttString(clientId);
+    writePacket(0x10, connectBody);
+
+    char connack[4];
+    if (!recvAll(_fd, connack, sizeof(connack)) || (uint8_t)connack[0] != 0x20 || connack[3] != 0) {
+        fprintf(stderr, "[DRIVER] Broker refused connection\n");
+        disconnect();
+        return false;
+    }
+
+    writePacket(0x82, std::string("\x00\x01", 2) + mqttString(DRIVER_STATUS_FILTER) + std::string(1, '\0'));
+
+    // Hết thời gian chờ recv = rảnh: gửi PINGREQ
+    struct timeval tv = { DRIVER_KEEPALIVE / 2, 0 };
+    setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    _running = true;
+    _reader = std::thread(&FleetDriver::readerLoop, this);
+    return true;
+}
+
+void FleetDriver::disconnect() {
+    if (_fd < 0) return;
+    _running = false;
+    writePacket(0xE0, std::string());
+    shutdown(_fd, SHUT_RDWR);
+    if (_reader.joinable()) _reader.join();
+    close(_fd);
+    _fd = -1;
+}
+
+bool FleetDriver::writePacket(uint8_t header, const std::string& body) {
+    std::string out(1, (char)header);
+    size_t n = body.size();
+    do {
+        uint8_t byte = n % 128;
+        n /= 128;
+        out.push_back((char)(byte | (n ? 0x80 : 0)));
+    } while (n);
+    out += body;
+
+    std::lock_guard<std::mutex> lock(_writeLock);
+    return ::send(_fd, out.data(), out.size(), MSG_NOSIGNAL) == (ssize_t)out.size();
+}
+
+void FleetDriver::readerLoop() {
+    while (_running) {
+        char header;
+        ssize_t n = recv(_fd, &header, 1, 0);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            writePacket(0xC0, std::string());
+            continue;
+        }
+        if (n <= 0) break;
+
+        size_t length = 0, multiplier = 1;
+        char byte;
+        do {
+            if (!recvAll(_fd, &byte, 1)) return;
+            length += (byte & 0x7F) * multiplier;
+            multiplier *= 128;
+        } while (byte & 0x80);
+
+        std::string body(length, '\0');
+        if (length && !recvAll(_fd, &body[0], length)) return;
+        if (((uint8_t)header & 0xF0) != 0x30 || length < 2) continue;
+
+        size_t topicLength = ((uint8_t)body[0] << 8) | (uint8_t)body[1];
+        size_t payloadStart = 2 + topicLength + (((uint8_t)header & 0x06) ? 2 : 0);
+        if (payloadStart > body.size()) continue;
+        handlePublish(body.substr(2, topicLength), body.substr(payloadStart));
+    }
+}
+
+void FleetDriver::handlePublish(const std::string& topic, const std::string& payload) {
+    uint64_t now = fleetNowUs();
+
+    if (payload.find("\"status\":\"ONLINE\"") != std::string::npos) {
+        std::string device = topic.substr(topic.rfind('/') + 1);
+        std::lock_guard<std::mutex> lock(_onlineLock);
+        if (_online.insert(device).second) onlineLatency.add(now - _onlineSince);
+        _onlineChanged.notify_all();
+        return;
+    }
+    if (payload.find("\"cmd_id\"") == std::string::npos) return;
+
+    StaticJsonDocument<512> doc;
+    if (deserializeJson(doc, payload)) return;
+    const char* cmdId = doc["cmd_id"] | "";
+
+    // Ghi mẫu trước khi xóa khỏi _pending: waitCommands() trả về ngay khi
+    // _pending rỗng và report() không được thiếu lệnh cuối cùng
+    std::lock_guard<std::mutex> lock(_pendingLock);
+    auto it = _pending.find(cmdId);
+    if (it == _pending.end()) return;
+    commandLatency.add(now - it->second);
+
+    JsonObjectConst trace = doc["trace"];
+    if (!trace.isNull()) {
+        uint32_t cb = trace["cb"] | 0, relay = trace["relay"] | 0, pub = trace["pub"] | 0;
+        deviceCallback.add(cb);
+        deviceRelay.add(relay - cb);
+        devicePublish.add(pub);
+    }
+
+    _pending.erase(it);
+    if (_pending.empty()) _pendingDone.notify_all();
+}
+
+// ============================================
+// Commands
+// ============================================
+
+bool FleetDriver::sendCommand(const char* deviceId, int boxId, const char* action, const char* cmdId) {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    char payload[160];
+    int length = snprintf(payload, sizeof(payload), "{\"box_id\":%d,\"action\":\"%s\",\"cmd_id\":\"%s\",\"ts\":%llu}",
+                          boxId, action, cmdId,
+                          (unsigned long long)tv.tv_sec * 1000ULL + (unsigned long long)tv.tv_usec / 1000);
+
+    {
+        std::lock_guard<std::mutex> lock(_pendingLock);
+        _pending[cmdId] = fleetNowUs();
+    }
+    return writePacket(0x30, mqttString(std::string("locker/commands/") + deviceId) + std::string(payload, length));
+}
+
+uint32_t FleetDriver::waitCommands(uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(_pendingLock);
+    _pendingDone.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return _pending.empty(); });
+    uint32_t lost = (uint32_t)_pending.size();
+    _pending.clear();
+    return lost;
+}
+
+// ============================================
+// ONLINE
+// ============================================
+
+void FleetDriver::resetOnline() {
+    std::lock_guard<std::mutex> lock(_onlineLock);
+    _online.clear();
+    _onlineSince = fleetNowUs();
+    onlineLatency.clear();
+}
+
+uint32_t FleetDriver::onlineCount() {
+    std::lock_guard<std::mutex> lock(_onlineLock);
+    return (uint32_t)_online.size();
+}
+
+bool FleetDriver::waitOnline(uint32_t count, uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(_onlineLock);
+    return _onlineChanged.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                                   [this, count] { return _online.size() >= count; });
+}
+
+// ============================================
+// Kiosk
+// ============================================
+
+int FleetDriver::kioskVerify(uint16_t port, const char* pin, int boxId, uint32_t timeoutMs, bool& unlocked) {
+    unlocked = false;
+    int fd = connectTcp("127.0.0.1", port, timeoutMs);
+    if (fd < 0) return 0;
+
+    char body[64];
+    int bodyLength = snprintf(body, sizeof(body), "{\"pinCode\":\"%s\",\"boxId\":%d}", pin, boxId);
+    char request[256];
+    int length = snprintf(request, sizeof(request),
+                          "POST /verify-and-unlock HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Type: application/json\r\n"
+                          "Content-Length: %d\r\nConnection: close\r\n\r\n%s", bodyLength, body);
+    if (::send(fd, request, length, MSG_NOSIGNAL) != length) {
+        close(fd);
+        return 0;
+    }
+
+    // Đọc tới khi đủ Content-Length hoặc server đóng kết nối
+    std::string response;
+    char buf[2048];
+    while (true) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) break;
+        response.append(buf, (size_t)n);
+        size_t headEnd = response.find("\r\n\r\n");
+        if (headEnd == std::string::npos) continue;
+        const char* cl = strcasestr(response.c_str(), "Content-Length:");
+        if (cl && response.size() >= headEnd + 4 + strtoul(cl + 15, nullptr, 10)) break;
+    }
+    close(fd);
+
+    int status = 0;
+    if (sscanf(response.c_str(), "HTTP/1.%*d %d", &status) != 1) return 0;
+    unlocked = response.find("\"success\":true") != std::string::npos;
+    return status;
+}
@@ -0,0 +1,109 @@
+/**
+ * Fleet Driver
+ *
+ * Phía "backend" của kịch bản tải: một kết nối MQTT subscribe
+ * locker/status/+ để gửi lệnh OPEN/LOCK (kèm cmd_id và ts) rồi ghép với
+ * bản tin trả lời, theo dõi ONLINE của từng locker, và client HTTP cho
+ * kiosk (/verify-and-unlock). Độ trễ đo bằng đồng hồ chung fleetNowUs().
+ */
+
+#ifndef FLEET_DRIVER_H
+#define FLEET_DRIVER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Tập mẫu độ trễ (µs), báo cáo p50 / p99 / p999 theo nearest-rank
+ */
+class LatencyRecorder {
+public:
+    void add(uint64_t us);
+    void clear();
+    size_t count();
+    void report(FILE* out, const char* name);
+
+private:
+    std::mutex _lock;
+    std::vector<uint32_t> _us;
+};
+
+class FleetDriver {
+public:
+    ~FleetDriver();
+
+    bool connect(const char* host, uint16_t port);
+    void disconnect();
+
+    // ============================================
+    // Lệnh MQTT
+    // ============================================
+
+    /**
+     * Gửi lệnh tới locker; độ trễ được ghi khi nhận trả lời cùng cmd_id
+     */
+    bool sendCommand(const char* deviceId, int boxId, const char* action, const char* cmdId);
+
+    /**
+     * Chờ mọi lệnh đã gửi được trả lời
+     * @return Số lệnh chưa được trả lời khi hết hạn (bị xoá khỏi danh sách chờ)
+     */
+    uint32_t waitCommands(uint32_t timeoutMs);
+
+    LatencyRecorder commandLatency;     // Gửi lệnh -> nhận trả lời (end-to-end)
+    LatencyRecorder deviceCallback;     // trace.cb: đọc gói -> callback
+    LatencyRecorder deviceRelay;        // trace.relay - cb: callback -> ghi relay
+    LatencyRecorder devicePublish;      // trace.pub: đọc gói -> publish trả lời
+
+    // ============================================
+    // ONLINE
+    // ============================================
+
+    /**
+     * Bắt đầu đếm: các locker gửi ONLINE sau thời điểm này
+     */
+    void resetOnline();
+    uint32_t onlineCount();
+    bool waitOnline(uint32_t count, uint32_t timeoutMs);
+
+    LatencyRecorder onlineLatency;      // resetOnline() -> ONLINE đầu tiên của mỗi locker
+
+    // ============================================
+    // Kiosk
+    // ============================================
+
+    /**
+     * POST /verify-and-unlock tới HTTP server của một locker (chặn)
+     * @return Mã HTTP, 0 nếu lỗi kết nối/timeout; unlocked = "success":true
+     */
+    static int kioskVerify(uint16_t port, const char* pin, int boxId, uint32_t timeoutMs, bool& unlocked);
+
+private:
+    void readerLoop();
+    bool writePacket(uint8_t header, const std::string& body);
+    void handlePublish(const std::string& topic, const std::string& payload);
+
+    int _fd = -1;
+    std::atomic<bool> _running{false};
+    std::thread _reader;
+    std::mutex _writeLock;
+
+    std::mutex _pendingLock;
+    std::condition_variable _pendingDone;
+    std::unordered_map<std::string, uint64_t> _pending;     // cmd_id -> lúc gửi (µs)
+
+    std::mutex _onlineLock;
+    std::condition_variable _onlineChanged;
+    std::unordered_set<std::string> _online;
+    uint64_t _onlineSince = 0;
+};
+
+#endif // FLEET_DRIVER_H
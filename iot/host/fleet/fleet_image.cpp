@@ -0,0 +1,51 @@
+/**
+ * Fleet Image Entry
+ *
+ * Chỉ biên dịch vào env:fleet_image (shared object): xuất FleetImageApi
+ * để fleet simulator điều khiển bản firmware này.
+ */
+
+#include <Arduino.h>
+#include <host_env.h>
+#include "config.h"
+#include "scheduler.h"
+#include "fleet_image.h"
+
+void setup();
+void loop();
+
+static constexpr bool sameString(const char* a, const char* b) {
+    return *a == *b && (*a == '\0' || sameString(a + 1, b + 1));
+}
+
+static_assert(sameString(DEVICE_ID, FLEET_DEVICE_ID_PLACEHOLDER),
+              "env:fleet_image must define DEVICE_ID as FLEET_DEVICE_ID_PLACEHOLDER");
+static_assert(SCHED_MAX_IDLE_MS == 0, "env:fleet_image: loop() must return instead of idling");
+
+static void configure(uint16_t httpPort, FILE* log, FleetSocketHook hook, void* ctx) {
+    // setup() có delay(1000): không giữ worker thread, chỉ đẩy đồng hồ của bản này
+    hostClockSkipDelays(true);
+    hostSetHttpPort(httpPort);
+    hostSetSerialOutput(log);
+    hostSetSocketHook(hook, ctx);
+}
+
+static void loopOnce() {
+    loop();
+    hostRunTimers();
+}
+
+static const FleetImageApi _api = {
+    FLEET_IMAGE_ABI_VERSION,
+    MQTT_BROKER,
+    MQTT_PORT,
+    BACKEND_URL,
+    configure,
+    setup,
+    loopOnce,
+    schedulerTimeToNext,
+};
+
+extern "C" __attribute__((visibility("default"))) const FleetImageApi* fleetImageApi() {
+    return &_api;
+}
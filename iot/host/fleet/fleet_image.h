@@ -0,0 +1,47 @@
+/**
+ * Fleet Image ABI
+ *
+ * Giao diện C giữa fleet simulator và firmware build thành shared object
+ * (env:fleet_image). Mỗi locker ảo là một bản sao riêng của image, được
+ * dlopen từ memfd: biến toàn cục/static của firmware và của lớp host/ (đồng
+ * hồ, GPIO, Wi-Fi, socket) không dùng chung giữa các locker.
+ *
+ * DEVICE_ID được biên dịch vào image là FLEET_DEVICE_ID_PLACEHOLDER; loader
+ * thay mọi chỗ xuất hiện (cả trong topic MQTT) bằng ID cùng độ dài của
+ * từng locker trước khi dlopen.
+ */
+
+#ifndef FLEET_IMAGE_H
+#define FLEET_IMAGE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define FLEET_IMAGE_ABI_VERSION 1
+#define FLEET_IMAGE_API_SYMBOL "fleetImageApi"
+
+#define FLEET_DEVICE_ID_PLACEHOLDER "FLEET_LOCKER_000000"
+#define FLEET_DEVICE_ID_FORMAT "FLEET_LOCKER_%06u"
+#define FLEET_MAX_DEVICES 999999
+
+typedef void (*FleetSocketHook)(int fd, bool open, void* ctx);
+
+/**
+ * Hàm và cấu hình của một bản firmware
+ */
+struct FleetImageApi {
+    uint32_t abiVersion;
+    const char* mqttBroker;     // MQTT_BROKER / MQTT_PORT / BACKEND_URL đã biên dịch vào image
+    uint16_t mqttPort;
+    const char* backendUrl;
+
+    // Gọi trước setup(): cổng HTTP riêng, log Serial (nullptr = bỏ), hook socket
+    void (*configure)(uint16_t httpPort, FILE* log, FleetSocketHook hook, void* ctx);
+    void (*setup)();
+    void (*loop)();
+    uint32_t (*timeToNextMs)();     // Tới deadline kế tiếp của scheduler (ms)
+};
+
+typedef const FleetImageApi* (*FleetImageApiFn)();
+
+#endif // FLEET_IMAGE_H
@@ -0,0 +1,302 @@
+/**
+ * Fleet Simulator
+ *
+ * Chạy nhiều locker ảo (image firmware env:fleet_image) trong một tiến
+ * trình cùng broker MQTT và backend giả, rồi chạy các kịch bản tải:
+ *   commands   Bão lệnh OPEN/LOCK tới mọi locker qua MQTT
+ *   reconnect  Ngắt mọi kết nối MQTT cùng lúc, đo thời gian tới ONLINE lại
+ *   pins       Nhiều kiosk POST /verify-and-unlock cùng lúc
+ * và in phân vị độ trễ (ms).
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fleet_driver.h"
+#include "fleet_pool.h"
+#include "stub_backend.h"
+#include "stub_broker.h"
+
+#define FLEET_ONLINE_TIMEOUT_MS 60000
+#define FLEET_COMMAND_TIMEOUT_MS 30000
+#define FLEET_KIOSK_TIMEOUT_MS 15000
+
+struct FleetOptions {
+    const char* image = ".pio/build/fleet_image/program";
+    uint32_t devices = 100;
+    unsigned threads = 0;
+    uint16_t httpBase = 20000;
+    uint32_t maxIdleMs = 50;
+    int logIndex = -1;
+    int box = 1;
+    std::string scenarios = "all";
+    uint32_t rounds = 3;
+    uint32_t rate = 0;              // Lệnh/giây, 0 = nhanh nhất có thể
+    uint32_t kioskClients = 32;
+    const char* pin = "123456";
+    uint32_t backendDelayMs = 0;
+    bool externalBroker = false;
+    bool externalBackend = false;
+};
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --image PATH           Image firmware (mặc định .pio/build/fleet_image/program)\n"
+            "  --devices N            Số locker ảo (100)\n"
+            "  --threads N            Worker thread (số CPU)\n"
+            "  --http-base PORT       HTTP của locker i là PORT + i (20000)\n"
+            "  --max-idle-ms N        Gọi loop() ít nhất mỗi N ms (50)\n"
+            "  --log N                In log Serial của locker thứ N ra stderr\n"
+            "  --box N                Ô tủ dùng cho lệnh và PIN (1)\n"
+            "  --scenario LIST        all hoặc commands,reconnect,pins (all)\n"
+            "  --rounds N             Số vòng mỗi kịch bản (3)\n"
+            "  --rate N               Lệnh/giây của bão lệnh, 0 = không giới hạn (0)\n"
+            "  --kiosk-clients N      Số kiosk song song (32)\n"
+            "  --pin CODE             PIN hợp lệ của backend giả (123456)\n"
+            "  --backend-delay-ms N   Backend giả trả lời trễ N ms (0)\n"
+            "  --external-broker      Dùng broker đang chạy tại MQTT_BROKER:MQTT_PORT của image\n"
+            "  --external-backend     Dùng backend đang chạy tại BACKEND_URL của image\n",
+            argv0);
+}
+
+static bool parseOptions(int argc, char** argv, FleetOptions& opt) {
+    static const struct option longOptions[] = {
+        { "image", required_argument, nullptr, 'i' },
+        { "devices", required_argument, nullptr, 'n' },
+        { "threads", required_argument, nullptr, 't' },
+        { "http-base", required_argument, nullptr, 'H' },
+        { "max-idle-ms", required_argument, nullptr, 'I' },
+        { "log", required_argument, nullptr, 'l' },
+        { "box", required_argument, nullptr, 'b' },
+        { "scenario", required_argument, nullptr, 's' },
+        { "rounds", required_argument, nullptr, 'r' },
+        { "rate", required_argument, nullptr, 'R' },
+        { "kiosk-clients", required_argument, nullptr, 'k' },
+        { "pin", required_argument, nullptr, 'p' },
+        { "backend-delay-ms", required_argument, nullptr, 'd' },
+        { "external-broker", no_argument, nullptr, 'B' },
+        { "external-backend", no_argument, nullptr, 'E' },
+        { "help", no_argument, nullptr, 'h' },
+        { nullptr, 0, nullptr, 0 }
+    };
+
+    int c;
+    while ((c = getopt_long(argc, argv, "i:n:t:h", longOptions, nullptr)) != -1) {
+        switch (c) {
+            case 'i': opt.image = optarg; break;
+            case 'n': opt.devices = strtoul(optarg, nullptr, 10); break;
+            case 't': opt.threads = strtoul(optarg, nullptr, 10); break;
+            case 'H': opt.httpBase = (uint16_t)strtoul(optarg, nullptr, 10); break;
+            case 'I': opt.maxIdleMs = strtoul(optarg, nullptr, 10); break;
+            case 'l': opt.logIndex = atoi(optarg); break;
+            case 'b': opt.box = atoi(optarg); break;
+            case 's': opt.scenarios = optarg; break;
+            case 'r': opt.rounds = strtoul(optarg, nullptr, 10); break;
+            case 'R': opt.rate = strtoul(optarg, nullptr, 10); break;
+            case 'k': opt.kioskClients = strtoul(optarg, nullptr, 10); break;
+            case 'p': opt.pin = optarg; break;
+            case 'd': opt.backendDelayMs = strtoul(optarg, nullptr, 10); break;
+            case 'B': opt.externalBroker = true; break;
+            case 'E': opt.externalBackend = true; break;
+            default: return false;
+        }
+    }
+    if (opt.devices == 0 || opt.devices > FLEET_MAX_DEVICES || (uint32_t)opt.httpBase + opt.devices > 65536) {
+        fprintf(stderr, "[FLEET] Invalid --devices / --http-base\n");
+        return false;
+    }
+    if (opt.threads == 0) opt.threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4;
+    if (opt.kioskClients == 0) opt.kioskClients = 1;
+    return true;
+}
+
+static bool scenarioEnabled(const FleetOptions& opt, const char* name) {
+    if (opt.scenarios == "all") return true;
+    std::string list = "," + opt.scenarios + ",";
+    return list.find(std::string(",") + name + ",") != std::string::npos;
+}
+
+/**
+ * Cổng trong BACKEND_URL ("http://host:port/..."), 80 nếu không ghi
+ */
+static uint16_t urlPort(const char* url) {
+    const char* host = strstr(url, "://");
+    host = host ? host + 3 : url;
+    const char* colon = strchr(host, ':');
+    const char* slash = strchr(host, '/');
+    if (!colon || (slash && colon > slash)) return 80;
+    return (uint16_t)strtoul(colon + 1, nullptr, 10);
+}
+
+static void raiseFileLimit() {
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+        rl.rlim_cur = rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+}
+
+static void printHeader(const char* title) {
+    printf("\n== %s ==\n", title);
+    printf("  %-22s %8s %10s %10s %10s %10s\n", "(ms)", "n", "p50", "p99", "p999", "max");
+}
+
+// ============================================
+// Scenarios
+// ============================================
+
+static void runCommandStorm(const FleetOptions& opt, FleetPool& pool, FleetDriver& driver) {
+    driver.commandLatency.clear();
+    driver.deviceCallback.clear();
+    driver.deviceRelay.clear();
+    driver.devicePublish.clear();
+
+    uint32_t sent = 0, lost = 0;
+    uint64_t start = fleetNowUs();
+    for (uint32_t round = 0; round < opt.rounds; round++) {
+        const char* action = (round % 2 == 0) ? "OPEN" : "LOCK";
+        for (uint32_t i = 0; i < pool.size(); i++) {
+            char cmdId[32];
+            snprintf(cmdId, sizeof(cmdId), "fleet-%u-%u", round, i);
+            if (driver.sendCommand(pool.deviceId(i), opt.box, action, cmdId)) sent++;
+            if (opt.rate) {
+                int64_t due = (int64_t)(start + (uint64_t)sent * 1000000ULL / opt.rate);
+                int64_t wait = due - (int64_t)fleetNowUs();
+                if (wait > 0) usleep((useconds_t)wait);
+            }
+        }
+        lost += driver.waitCommands(FLEET_COMMAND_TIMEOUT_MS);
+    }
+    double seconds = (fleetNowUs() - start) / 1e6;
+
+    printHeader("Command storm");
+    driver.commandLatency.report(stdout, "end-to-end");
+    driver.deviceCallback.report(stdout, "device read->callback");
+    driver.deviceRelay.report(stdout, "device callback->relay");
+    driver.devicePublish.report(stdout, "device read->publish");
+    printf("  sent %u, lost %u, %.0f cmd/s\n", sent, lost, seconds > 0 ? sent / seconds : 0.0);
+}
+
+static void runReconnectStorm(const FleetOptions& opt, FleetPool& pool, FleetDriver& driver, uint16_t mqttPort) {
+    printHeader("Reconnect storm");
+    for (uint32_t round = 0; round < opt.rounds; round++) {
+        driver.resetOnline();
+        uint32_t dropped = pool.dropConnections(mqttPort);
+        bool ok = driver.waitOnline(pool.size(), FLEET_ONLINE_TIMEOUT_MS);
+        char name[32];
+        snprintf(name, sizeof(name), "round %u -> ONLINE", round + 1);
+        driver.onlineLatency.report(stdout, name);
+        if (!ok) printf("  only %u/%u back ONLINE (dropped %u)\n", driver.onlineCount(), pool.size(), dropped);
+    }
+}
+
+static void runPinBurst(const FleetOptions& opt, FleetPool& pool) {
+    LatencyRecorder latency;
+    std::atomic<uint32_t> unlocked{0}, failed{0};
+
+    for (uint32_t round = 0; round < opt.rounds; round++) {
+        std::atomic<uint32_t> next{0};
+        std::vector<std::thread> clients;
+        for (uint32_t c = 0; c < opt.kioskClients && c < pool.size(); c++) {
+            clients.emplace_back([&] {
+                uint32_t i;
+                while ((i = next++) < pool.size()) {
+                    bool ok = false;
+                    uint64_t start = fleetNowUs();
+                    int status = FleetDriver::kioskVerify(pool.httpPort(i), opt.pin, opt.box, FLEET_KIOSK_TIMEOUT_MS, ok);
+                    latency.add(fleetNowUs() - start);
+                    if (status == 200 && ok) unlocked++;
+                    else failed++;
+                }
+            });
+        }
+        for (std::thread& t : clients) t.join();
+    }
+
+    printHeader("Kiosk PIN burst");
+    latency.report(stdout, "verify-and-unlock");
+    printf("  unlocked %u, failed %u\n", unlocked.load(), failed.load());
+}
+
+// ============================================
+// Main
+// ============================================
+
+int main(int argc, char** argv) {
+    FleetOptions opt;
+    if (!parseOptions(argc, argv, opt)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    raiseFileLimit();
+    setenv("LOCKER_WIFI_SCAN_MS", "100", 0);
+    unsetenv("LOCKER_FLASH_FILE");      // EEPROM và RTC của mỗi locker chỉ nằm trong RAM
+    unsetenv("LOCKER_RTC_FILE");
+
+    FleetPool pool;
+    if (!pool.load(opt.image, opt.devices, opt.httpBase, opt.logIndex)) return 1;
+    const FleetImageApi* api = pool.api();
+
+    StubBroker broker;
+    StubBackend backend;
+    if (!opt.externalBroker && !broker.start(api->mqttPort)) return 1;
+    if (!opt.externalBackend && !backend.start(urlPort(api->backendUrl), opt.backendDelayMs, opt.pin)) return 1;
+
+    FleetDriver driver;
+    if (!driver.connect(api->mqttBroker, api->mqttPort)) return 1;
+
+    printf("[FLEET] %u lockers, %u workers, broker %s:%u, backend %s\n",
+           pool.size(), opt.threads, api->mqttBroker, api->mqttPort, api->backendUrl);
+
+    driver.resetOnline();
+    pool.start(opt.threads, opt.maxIdleMs);
+    bool online = driver.waitOnline(pool.size(), FLEET_ONLINE_TIMEOUT_MS);
+    printHeader("Boot");
+    driver.onlineLatency.report(stdout, "start -> ONLINE");
+    if (!online) {
+        printf("  only %u/%u lockers ONLINE, aborting\n", driver.onlineCount(), pool.size());
+        fflush(stdout);
+        _exit(1);
+    }
+
+    if (scenarioEnabled(opt, "commands")) runCommandStorm(opt, pool, driver);
+    if (scenarioEnabled(opt, "reconnect")) runReconnectStorm(opt, pool, driver, api->mqttPort);
+    if (scenarioEnabled(opt, "pins")) runPinBurst(opt, pool);
+
+    FleetPoolStats ps;
+    pool.getStats(ps);
+    printf("\n== Pool ==\n");
+    printf("  loops %llu, busy %.1f s, max loop %.3f ms, wakeups %llu socket / %llu timer, sockets %u\n",
+           (unsigned long long)ps.loops, ps.busyUs / 1e6, ps.maxLoopUs / 1000.0,
+           (unsigned long long)ps.wakeups, (unsigned long long)ps.timerWakeups, ps.sockets);
+    if (!opt.externalBroker) {
+        StubBrokerStats bs;
+        broker.getStats(bs);
+        printf("  broker: clients %u, connects %llu, published %llu, delivered %llu\n", bs.clients,
+               (unsigned long long)bs.connects, (unsigned long long)bs.published, (unsigned long long)bs.delivered);
+    }
+    if (!opt.externalBackend) {
+        StubBackendStats es;
+        backend.getStats(es);
+        printf("  backend: connections %u, requests %llu, verify-pin %llu (valid %llu)\n", es.connections,
+               (unsigned long long)es.requests, (unsigned long long)es.verifyRequests,
+               (unsigned long long)es.validPins);
+    }
+
+    // Không chạy destructor tĩnh của các bản image (thread pool còn đang gọi loop())
+    fflush(stdout);
+    fflush(stderr);
+    _exit(0);
+}
@@ -0,0 +1,351 @@
+/**
+ * Fleet Pool Implementation
+ *
+ * Mỗi bản firmware được nạp bằng dlopen() từ một memfd riêng: glibc coi
+ * mỗi memfd là một object khác nên mỗi bản có .data/.bss riêng. Socket
+ * của bản được báo qua hook (host_env.h) và đăng ký EPOLLONESHOT; sau mỗi
+ * lần chạy loop() các socket được arm lại, dữ liệu còn trong socket sẽ
+ * đánh thức bản đó ngay.
+ */
+
+#include "fleet_pool.h"
+#include <arpa/inet.h>
+#include <dlfcn.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+
+#define WHEEL_SLOTS 1024        // Timer wheel 1 ms/slot; maxIdleMs phải nhỏ hơn
+#define EPOLL_BATCH 1024
+
+enum InstanceState : uint8_t {
+    INSTANCE_IDLE = 0,
+    INSTANCE_QUEUED,
+    INSTANCE_RUNNING,
+    INSTANCE_DIRTY          // Có sự kiện mới trong lúc đang chạy: chạy lại ngay
+};
+
+struct FleetInstance {
+    FleetPool* pool = nullptr;
+    uint32_t index = 0;
+    void* handle = nullptr;
+    int imageFd = -1;       // Giữ mở: glibc nhận diện object đã nạp theo đường dẫn /proc/self/fd/N
+    const FleetImageApi* api = nullptr;
+    char deviceId[sizeof(FLEET_DEVICE_ID_PLACEHOLDER)] = {};
+    uint16_t httpPort = 0;
+    bool started = false;
+
+    std::atomic<uint8_t> state{INSTANCE_QUEUED};
+    std::atomic<uint64_t> timerDue{0};
+
+    std::mutex fdLock;
+    std::vector<int> fds;
+};
+
+uint64_t fleetNowUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static void atomicMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t cur = target.load(std::memory_order_relaxed);
+    while (value > cur && !target.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+}
+
+// ============================================
+// Loading
+// ============================================
+
+FleetPool::FleetPool()
+    : _running(false), _wheel(WHEEL_SLOTS),
+      _loops(0), _busyUs(0), _maxLoopUs(0), _wakeups(0), _timerWakeups(0), _sockets(0) {
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+}
+
+FleetPool::~FleetPool() {
+    stop();
+    if (_epoll >= 0) close(_epoll);
+}
+
+static bool readFile(const char* path, std::vector<char>& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) out.insert(out.end(), chunk, chunk + n);
+    fclose(f);
+    return !out.empty();
+}
+
+static bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n <= 0) return false;
+        data += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+bool FleetPool::load(const char* imagePath, uint32_t count, uint16_t httpBasePort, int logIndex) {
+    std::vector<char> image;
+    if (!readFile(imagePath, image)) {
+        fprintf(stderr, "[FLEET] Cannot read image %s\n", imagePath);
+        return false;
+    }
+
+    // Vị trí DEVICE_ID trong image (chuỗi riêng và các topic ghép từ nó)
+    const size_t idLength = strlen(FLEET_DEVICE_ID_PLACEHOLDER);
+    std::vector<size_t> idOffsets;
+    auto it = image.begin();
+    while ((it = std::search(it, image.end(), FLEET_DEVICE_ID_PLACEHOLDER,
+                             FLEET_DEVICE_ID_PLACEHOLDER + idLength)) != image.end()) {
+        idOffsets.push_back((size_t)(it - image.begin()));
+        it += idLength;
+    }
+    if (idOffsets.empty()) {
+        fprintf(stderr, "[FLEET] %s is not a fleet image (no %s)\n", imagePath, FLEET_DEVICE_ID_PLACEHOLDER);
+        return false;
+    }
+
+    _instances.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        std::unique_ptr<FleetInstance> inst(new FleetInstance());
+        inst->pool = this;
+        inst->index = i;
+        inst->httpPort = (uint16_t)(httpBasePort + i);
+        snprintf(inst->deviceId, sizeof(inst->deviceId), FLEET_DEVICE_ID_FORMAT, (i + 1) % 1000000);
+        for (size_t offset : idOffsets) memcpy(&image[offset], inst->deviceId, idLength);
+
+        int fd = memfd_create(inst->deviceId, MFD_CLOEXEC);
+        if (fd < 0 || !writeAll(fd, image.data(), image.size())) {
+            fprintf(stderr, "[FLEET] memfd for %s failed: %s\n", inst->deviceId, strerror(errno));
+            if (fd >= 0) close(fd);
+            return false;
+        }
+        char path[32];
+        snprintf(path, sizeof(path), "/proc/self/fd/%d", fd);
+        inst->imageFd = fd;
+        inst->handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+        if (!inst->handle) {
+            fprintf(stderr, "[FLEET] dlopen %s failed: %s\n", inst->deviceId, dlerror());
+            return false;
+        }
+
+        FleetImageApiFn apiFn = (FleetImageApiFn)dlsym(inst->handle, FLEET_IMAGE_API_SYMBOL);
+        inst->api = apiFn ? apiFn() : nullptr;
+        if (!inst->api || inst->api->abiVersion != FLEET_IMAGE_ABI_VERSION) {
+            fprintf(stderr, "[FLEET] %s: missing or incompatible %s\n", imagePath, FLEET_IMAGE_API_SYMBOL);
+            return false;
+        }
+        inst->api->configure(inst->httpPort, (int)i == logIndex ? stderr : nullptr, socketHook, inst.get());
+        _instances.push_back(std::move(inst));
+
+        if ((i + 1) % 500 == 0) fprintf(stderr, "[FLEET] Loaded %u/%u\n", i + 1, count);
+    }
+    return true;
+}
+
+const FleetImageApi* FleetPool::api() const {
+    return _instances.empty() ? nullptr : _instances[0]->api;
+}
+
+const char* FleetPool::deviceId(uint32_t index) const { return _instances[index]->deviceId; }
+uint16_t FleetPool::httpPort(uint32_t index) const { return _instances[index]->httpPort; }
+
+// ============================================
+// Sockets
+// ============================================
+
+void FleetPool::socketHook(int fd, bool open, void* ctx) {
+    FleetInstance* inst = (FleetInstance*)ctx;
+    FleetPool* pool = inst->pool;
+    std::lock_guard<std::mutex> lock(inst->fdLock);
+    if (open) {
+        inst->fds.push_back(fd);
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        ev.data.ptr = inst;
+        epoll_ctl(pool->_epoll, EPOLL_CTL_ADD, fd, &ev);
+        pool->_sockets++;
+    } else {
+        auto pos = std::find(inst->fds.begin(), inst->fds.end(), fd);
+        if (pos == inst->fds.end()) return;
+        inst->fds.erase(pos);
+        epoll_ctl(pool->_epoll, EPOLL_CTL_DEL, fd, nullptr);
+        pool->_sockets--;
+    }
+}
+
+uint32_t FleetPool::dropConnections(uint16_t peerPort) {
+    uint32_t dropped = 0;
+    for (auto& inst : _instances) {
+        std::lock_guard<std::mutex> lock(inst->fdLock);
+        for (int fd : inst->fds) {
+            struct sockaddr_in sa = {};
+            socklen_t len = sizeof(sa);
+            if (getpeername(fd, (struct sockaddr*)&sa, &len) == 0 && sa.sin_family == AF_INET &&
+                ntohs(sa.sin_port) == peerPort) {
+                shutdown(fd, SHUT_RDWR);
+                dropped++;
+            }
+        }
+    }
+    return dropped;
+}
+
+// ============================================
+// Scheduling
+// ============================================
+
+void FleetPool::schedule(FleetInstance* inst) {
+    uint8_t state = inst->state.load();
+    while (true) {
+        if (state == INSTANCE_IDLE) {
+            if (inst->state.compare_exchange_weak(state, INSTANCE_QUEUED)) break;
+        } else if (state == INSTANCE_RUNNING) {
+            if (inst->state.compare_exchange_weak(state, INSTANCE_DIRTY)) return;
+        } else {
+            return;     // Đã trong hàng đợi hoặc đã được đánh dấu chạy lại
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        _queue.push_back(inst);
+    }
+    _queueReady.notify_one();
+}
+
+void FleetPool::addTimer(FleetInstance* inst, uint64_t dueMs) {
+    inst->timerDue = dueMs;
+    std::lock_guard<std::mutex> lock(_timerLock);
+    uint64_t slot = std::max(dueMs, _wheelMs);
+    _wheel[slot % WHEEL_SLOTS].emplace_back(inst, dueMs);
+}
+
+void FleetPool::eventLoop() {
+    struct epoll_event events[EPOLL_BATCH];
+    std::vector<FleetInstance*> expired;
+
+    while (_running) {
+        int n = epoll_wait(_epoll, events, EPOLL_BATCH, 1);
+        for (int i = 0; i < n; i++) {
+            _wakeups++;
+            schedule((FleetInstance*)events[i].data.ptr);
+        }
+
+        // Timer wheel: _wheelMs là slot kế tiếp chưa xử lý
+        uint64_t nowMs = fleetNowUs() / 1000;
+        expired.clear();
+        {
+            std::lock_guard<std::mutex> lock(_timerLock);
+            if (_wheelMs == 0) _wheelMs = nowMs;
+            uint32_t steps = 0;
+            for (; _wheelMs <= nowMs && steps < WHEEL_SLOTS; _wheelMs++, steps++) {
+                auto& slot = _wheel[_wheelMs % WHEEL_SLOTS];
+                size_t keep = 0;
+                for (auto& entry : slot) {
+                    if (entry.second > nowMs) {
+                        slot[keep++] = entry;   // Vòng sau của wheel
+                    } else if (entry.first->timerDue == entry.second) {
+                        expired.push_back(entry.first);
+                    }
+                }
+                slot.resize(keep);
+            }
+            if (_wheelMs <= nowMs) _wheelMs = nowMs + 1;
+        }
+        for (FleetInstance* inst : expired) {
+            _timerWakeups++;
+            schedule(inst);
+        }
+    }
+}
+
+void FleetPool::run(FleetInstance* inst) {
+    uint64_t start = fleetNowUs();
+    if (!inst->started) {
+        inst->api->setup();
+        inst->started = true;
+    } else {
+        inst->api->loop();
+    }
+    uint64_t end = fleetNowUs();
+    _loops++;
+    _busyUs += end - start;
+    atomicMax(_maxLoopUs, end - start);
+
+    {
+        std::lock_guard<std::mutex> lock(inst->fdLock);
+        for (int fd : inst->fds) {
+            struct epoll_event ev = {};
+            ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+            ev.data.ptr = inst;
+            epoll_ctl(_epoll, EPOLL_CTL_MOD, fd, &ev);
+        }
+    }
+
+    uint32_t next = inst->api->timeToNextMs();
+    if (next > _maxIdleMs) next = _maxIdleMs;
+    addTimer(inst, end / 1000 + next);
+}
+
+void FleetPool::workerLoop() {
+    while (true) {
+        FleetInstance* inst;
+        {
+            std::unique_lock<std::mutex> lock(_queueLock);
+            _queueReady.wait(lock, [this] { return !_queue.empty() || !_running; });
+            if (!_running) return;
+            inst = _queue.front();
+            _queue.pop_front();
+        }
+
+        inst->state = INSTANCE_RUNNING;
+        run(inst);
+
+        uint8_t expected = INSTANCE_RUNNING;
+        if (!inst->state.compare_exchange_strong(expected, INSTANCE_IDLE)) {
+            inst->state = INSTANCE_QUEUED;
+            std::lock_guard<std::mutex> lock(_queueLock);
+            _queue.push_back(inst);
+        }
+    }
+}
+
+void FleetPool::start(unsigned threads, uint32_t maxIdleMs) {
+    _maxIdleMs = std::min<uint32_t>(maxIdleMs, WHEEL_SLOTS - 1);
+    _running = true;
+
+    // Mọi bản bắt đầu ở trạng thái QUEUED: lần chạy đầu là setup()
+    for (auto& inst : _instances) _queue.push_back(inst.get());
+
+    _eventThread = std::thread(&FleetPool::eventLoop, this);
+    for (unsigned i = 0; i < threads; i++) _workers.emplace_back(&FleetPool::workerLoop, this);
+}
+
+void FleetPool::stop() {
+    if (!_running) return;
+    _running = false;
+    _queueReady.notify_all();
+    if (_eventThread.joinable()) _eventThread.join();
+    for (auto& t : _workers) t.join();
+    _workers.clear();
+}
+
+void FleetPool::getStats(FleetPoolStats& stats) {
+    stats.loops = _loops;
+    stats.busyUs = _busyUs;
+    stats.maxLoopUs = _maxLoopUs;
+    stats.wakeups = _wakeups;
+    stats.timerWakeups = _timerWakeups;
+    stats.sockets = _sockets;
+}
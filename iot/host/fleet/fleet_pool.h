@@ -0,0 +1,108 @@
+/**
+ * Fleet Pool
+ *
+ * Chạy N bản firmware trong một tiến trình: mỗi bản là một bản sao image
+ * (xem fleet_image.h). Socket của mọi bản được đưa vào một epoll; một
+ * thread sự kiện chuyển bản có socket sẵn sàng hoặc tới deadline scheduler
+ * vào hàng đợi, các worker thread gọi loop() của bản đó. Một bản không bao
+ * giờ chạy trên hai worker cùng lúc.
+ *
+ * Image được build với SCHED_MAX_IDLE_MS 0 nên loop() trả về ngay thay vì
+ * ngủ trong schedulerIdle(); việc chờ do pool đảm nhiệm (timer wheel 1 ms).
+ */
+
+#ifndef FLEET_POOL_H
+#define FLEET_POOL_H
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "fleet_image.h"
+
+/**
+ * Số liệu pool
+ */
+struct FleetPoolStats {
+    uint64_t loops;         // Số lần gọi loop() (cả setup())
+    uint64_t busyUs;        // Tổng thời gian trong loop()
+    uint64_t maxLoopUs;     // loop() dài nhất
+    uint64_t wakeups;       // Lần được đánh thức vì socket
+    uint64_t timerWakeups;  // ...vì deadline scheduler
+    uint32_t sockets;       // Socket đang mở
+};
+
+struct FleetInstance;
+
+class FleetPool {
+public:
+    FleetPool();
+    ~FleetPool();
+
+    /**
+     * Nạp count bản sao image; bản i nghe HTTP trên httpBasePort + i
+     * @param logIndex Bản có log Serial ra stderr (-1 = không bản nào)
+     * @return false nếu không đọc/nạp được image
+     */
+    bool load(const char* imagePath, uint32_t count, uint16_t httpBasePort, int logIndex);
+
+    /**
+     * Khởi động worker: setup() của mọi bản rồi loop() theo sự kiện
+     * @param maxIdleMs Gọi lại loop() ít nhất mỗi maxIdleMs kể cả khi rảnh
+     */
+    void start(unsigned threads, uint32_t maxIdleMs);
+    void stop();
+
+    uint32_t size() const { return (uint32_t)_instances.size(); }
+    const FleetImageApi* api() const;
+    const char* deviceId(uint32_t index) const;
+    uint16_t httpPort(uint32_t index) const;
+
+    /**
+     * Ngắt (shutdown) mọi kết nối TCP của các bản tới peerPort, như khi
+     * broker khởi động lại; firmware tự phát hiện và kết nối lại
+     * @return Số kết nối đã ngắt
+     */
+    uint32_t dropConnections(uint16_t peerPort);
+
+    void getStats(FleetPoolStats& stats);
+
+private:
+    friend struct FleetInstance;
+    static void socketHook(int fd, bool open, void* ctx);
+
+    void schedule(FleetInstance* inst);
+    void addTimer(FleetInstance* inst, uint64_t dueMs);
+    void eventLoop();
+    void workerLoop();
+    void run(FleetInstance* inst);
+
+    std::vector<std::unique_ptr<FleetInstance>> _instances;
+    int _epoll = -1;
+    uint32_t _maxIdleMs = 50;
+    std::atomic<bool> _running;
+    std::thread _eventThread;
+    std::vector<std::thread> _workers;
+
+    std::mutex _queueLock;
+    std::condition_variable _queueReady;
+    std::deque<FleetInstance*> _queue;
+
+    std::mutex _timerLock;
+    std::vector<std::vector<std::pair<FleetInstance*, uint64_t>>> _wheel;
+    uint64_t _wheelMs = 0;
+
+    std::atomic<uint64_t> _loops, _busyUs, _maxLoopUs, _wakeups, _timerWakeups;
+    std::atomic<uint32_t> _sockets;
+};
+
+/**
+ * Đồng hồ chung của simulator (CLOCK_MONOTONIC, µs)
+ */
+uint64_t fleetNowUs();
+
+#endif // FLEET_POOL_H
@@ -0,0 +1,235 @@
+/**
+ * Stub Backend Implementation
+ */
+
+#include "stub_backend.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BACKEND_LISTEN_FD (-1)
+
+static uint64_t nowMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/**
+ * Giá trị header (không phân biệt hoa thường), "" nếu không có
+ */
+static std::string headerValue(const std::string& head, const char* name) {
+    size_t nameLength = strlen(name);
+    size_t pos = head.find("\r\n");
+    while (pos != std::string::npos && pos + 2 < head.size()) {
+        size_t start = pos + 2;
+        size_t end = head.find("\r\n", start);
+        if (end == std::string::npos) end = head.size();
+        if (end - start > nameLength && strncasecmp(head.c_str() + start, name, nameLength) == 0 &&
+            head[start + nameLength] == ':') {
+            size_t value = head.find_first_not_of(' ', start + nameLength + 1);
+            return value < end ? head.substr(value, end - value) : std::string();
+        }
+        pos = end;
+    }
+    return std::string();
+}
+
+/**
+ * Giá trị chuỗi của key trong body JSON phẳng ({"pinCode":"123456",...})
+ */
+static std::string jsonString(const std::string& body, const char* key) {
+    std::string needle = std::string("\"") + key + "\"";
+    size_t pos = body.find(needle);
+    if (pos == std::string::npos) return std::string();
+    size_t open = body.find('"', body.find(':', pos + needle.size()));
+    size_t close = open == std::string::npos ? open : body.find('"', open + 1);
+    if (close == std::string::npos) return std::string();
+    return body.substr(open + 1, close - open - 1);
+}
+
+// ============================================
+// Lifecycle
+// ============================================
+
+StubBackend::~StubBackend() { stop(); }
+
+bool StubBackend::start(uint16_t port, uint32_t delayMs, const char* validPin) {
+    _delayMs = delayMs;
+    _validPin = validPin;
+
+    _listen = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    setsockopt(_listen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(INADDR_ANY);
+    sa.sin_port = htons(port);
+    if (bind(_listen, (struct sockaddr*)&sa, sizeof(sa)) < 0 || listen(_listen, 4096) < 0) {
+        fprintf(stderr, "[BACKEND] Cannot listen on port %u: %s\n", port, strerror(errno));
+        ::close(_listen);
+        _listen = -1;
+        return false;
+    }
+
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = BACKEND_LISTEN_FD;
+    epoll_ctl(_epoll, EPOLL_CTL_ADD, _listen, &ev);
+
+    _running = true;
+    _thread = std::thread(&StubBackend::run, this);
+    return true;
+}
+
+void StubBackend::stop() {
+    if (!_running) return;
+    _running = false;
+    _thread.join();
+    while (!_connections.empty()) close(_connections.begin()->first);
+    ::close(_listen);
+    ::close(_epoll);
+}
+
+void StubBackend::getStats(StubBackendStats& stats) {
+    stats.connections = _open;
+    stats.requests = _requests;
+    stats.verifyRequests = _verifyRequests;
+    stats.validPins = _validPins;
+}
+
+// ============================================
+// Event Loop
+// ============================================
+
+void StubBackend::run() {
+    struct epoll_event events[256];
+    while (_running) {
+        int timeout = 50;
+        if (!_deferred.empty()) {
+            int64_t wait = (int64_t)_deferred.front().dueMs - (int64_t)nowMs();
+            timeout = wait < 0 ? 0 : (wait < timeout ? (int)wait : timeout);
+        }
+        int n = epoll_wait(_epoll, events, 256, timeout);
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            if (fd == BACKEND_LISTEN_FD) {
+                accept();
+                continue;
+            }
+            auto it = _connections.find(fd);
+            if (it == _connections.end()) continue;
+            if (events[i].events & EPOLLOUT) write(fd, it->second, std::string());
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) read(fd);
+        }
+
+        uint64_t now = nowMs();
+        while (!_deferred.empty() && _deferred.front().dueMs <= now) {
+            Deferred& d = _deferred.front();
+            auto it = _connections.find(d.fd);
+            if (it != _connections.end() && it->second.id == d.connectionId) write(d.fd, it->second, d.response);
+            _deferred.pop_front();
+        }
+    }
+}
+
+void StubBackend::accept() {
+    while (true) {
+        int fd = accept4(_listen, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &ev);
+        Connection& c = _connections[fd];
+        c.id = _nextId++;
+        _open++;
+    }
+}
+
+void StubBackend::read(int fd) {
+    Connection& c = _connections[fd];
+    char buf[8192];
+    while (true) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            c.in.append(buf, (size_t)n);
+            continue;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            close(fd);
+            return;
+        }
+        break;
+    }
+
+    // Các request hoàn chỉnh (keep-alive: có thể nhiều request trong buffer)
+    while (true) {
+        size_t headEnd = c.in.find("\r\n\r\n");
+        if (headEnd == std::string::npos) return;
+        std::string head = c.in.substr(0, headEnd);
+        size_t length = strtoul(headerValue(head, "Content-Length").c_str(), nullptr, 10);
+        if (c.in.size() < headEnd + 4 + length) return;
+        std::string body = c.in.substr(headEnd + 4, length);
+        c.in.erase(0, headEnd + 4 + length);
+
+        std::string response = respond(head, body);
+        if (_delayMs) {
+            _deferred.push_back(Deferred{ nowMs() + _delayMs, fd, c.id, response });
+        } else {
+            write(fd, c, response);
+        }
+    }
+}
+
+std::string StubBackend::respond(const std::string& head, const std::string& body) {
+    _requests++;
+    std::string json = "{\"success\":true}";
+    if (head.compare(0, 25, "POST /api/iot/verify-pin ") == 0) {
+        _verifyRequests++;
+        bool valid = jsonString(body, "pinCode") == _validPin;
+        if (valid) _validPins++;
+        json = valid
+            ? "{\"success\":true,\"data\":{\"valid\":true,\"orderId\":42,\"boxNumber\":1},\"code\":\"PIN_VALID\"}"
+            : "{\"success\":true,\"data\":{\"valid\":false,\"message\":\"Sai PIN\"},\"code\":\"PIN_INVALID\"}";
+    }
+
+    char header[160];
+    snprintf(header, sizeof(header),
+             "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: %u\r\n%s\r\n",
+             (unsigned)json.size(),
+             strcasecmp(headerValue(head, "Connection").c_str(), "close") == 0 ? "Connection: close\r\n" : "");
+    return header + json;
+}
+
+void StubBackend::write(int fd, Connection& c, const std::string& data) {
+    c.out += data;
+    while (!c.out.empty()) {
+        ssize_t n = ::send(fd, c.out.data(), c.out.size(), MSG_NOSIGNAL);
+        if (n <= 0) break;
+        c.out.erase(0, (size_t)n);
+    }
+    struct epoll_event ev = {};
+    ev.events = c.out.empty() ? EPOLLIN : (EPOLLIN | EPOLLOUT);
+    ev.data.fd = fd;
+    epoll_ctl(_epoll, EPOLL_CTL_MOD, fd, &ev);
+}
+
+void StubBackend::close(int fd) {
+    epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    _connections.erase(fd);
+    _open--;
+}
@@ -0,0 +1,73 @@
+/**
+ * Stub Backend
+ *
+ * Backend HTTP/1.1 giả cho fleet simulator (keep-alive, một thread epoll):
+ *   POST /api/iot/verify-pin   PIN == validPin thì hợp lệ (orderId 42)
+ *   mọi request khác           200 {"success":true}
+ * Có thể trả lời trễ một khoảng cố định để giả lập backend/WAN chậm.
+ */
+
+#ifndef STUB_BACKEND_H
+#define STUB_BACKEND_H
+
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <string>
+#include <thread>
+
+/**
+ * Số liệu backend
+ */
+struct StubBackendStats {
+    uint32_t connections;       // Kết nối đang mở
+    uint64_t requests;          // Tổng request
+    uint64_t verifyRequests;    // ...trong đó /api/iot/verify-pin
+    uint64_t validPins;         // PIN hợp lệ đã trả lời
+};
+
+class StubBackend {
+public:
+    ~StubBackend();
+
+    bool start(uint16_t port, uint32_t delayMs, const char* validPin);
+    void stop();
+    void getStats(StubBackendStats& stats);
+
+private:
+    struct Connection {
+        uint64_t id;
+        std::string in;
+        std::string out;
+    };
+
+    struct Deferred {
+        uint64_t dueMs;
+        int fd;
+        uint64_t connectionId;
+        std::string response;
+    };
+
+    void run();
+    void accept();
+    void read(int fd);
+    void write(int fd, Connection& c, const std::string& data);
+    void close(int fd);
+    std::string respond(const std::string& head, const std::string& body);
+
+    int _listen = -1;
+    int _epoll = -1;
+    uint32_t _delayMs = 0;
+    std::string _validPin;
+    uint64_t _nextId = 1;
+    std::atomic<bool> _running{false};
+    std::thread _thread;
+    std::map<int, Connection> _connections;
+    std::deque<Deferred> _deferred;     // Cùng độ trễ nên luôn theo thứ tự hạn
+
+    std::atomic<uint32_t> _open{0};
+    std::atomic<uint64_t> _requests{0}, _verifyRequests{0}, _validPins{0};
+};
+
+#endif // STUB_BACKEND_H
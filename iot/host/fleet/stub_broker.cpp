@@ -0,0 +1,325 @@
+/**
+ * Stub MQTT Broker Implementation
+ */
+
+#include "stub_broker.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+
+#define BROKER_MAX_OUT (4 * 1024 * 1024)    // Subscriber đọc chậm hơn mức này bị ngắt
+#define BROKER_LISTEN_FD (-1)
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static std::string encodeLength(size_t n) {
+    std::string out;
+    do {
+        uint8_t byte = n % 128;
+        n /= 128;
+        out.push_back((char)(byte | (n ? 0x80 : 0)));
+    } while (n);
+    return out;
+}
+
+static std::string packet(uint8_t header, const std::string& body) {
+    return std::string(1, (char)header) + encodeLength(body.size()) + body;
+}
+
+static bool readString(const std::string& body, size_t& pos, std::string& out) {
+    if (pos + 2 > body.size()) return false;
+    size_t len = ((uint8_t)body[pos] << 8) | (uint8_t)body[pos + 1];
+    if (pos + 2 + len > body.size()) return false;
+    out.assign(body, pos + 2, len);
+    pos += 2 + len;
+    return true;
+}
+
+/**
+ * So khớp topic với filter (+ một cấp, # mọi cấp còn lại)
+ */
+static bool topicMatches(const std::string& filter, const std::string& topic) {
+    size_t f = 0, t = 0;
+    while (true) {
+        size_t fEnd = filter.find('/', f);
+        size_t tEnd = topic.find('/', t);
+        if (fEnd == std::string::npos) fEnd = filter.size();
+        if (tEnd == std::string::npos) tEnd = topic.size();
+        if (filter.compare(f, fEnd - f, "#") == 0) return true;
+
+        bool plus = fEnd - f == 1 && filter[f] == '+';
+        if (!plus && filter.compare(f, fEnd - f, topic, t, tEnd - t) != 0) return false;
+
+        bool filterDone = fEnd == filter.size();
+        bool topicDone = tEnd == topic.size();
+        if (topicDone && !filterDone) return filter.compare(fEnd, std::string::npos, "/#") == 0;
+        if (filterDone) return topicDone;
+        f = fEnd + 1;
+        t = tEnd + 1;
+    }
+}
+
+// ============================================
+// Lifecycle
+// ============================================
+
+StubBroker::~StubBroker() { stop(); }
+
+bool StubBroker::start(uint16_t port) {
+    _listen = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    setsockopt(_listen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(INADDR_ANY);
+    sa.sin_port = htons(port);
+    if (bind(_listen, (struct sockaddr*)&sa, sizeof(sa)) < 0 || listen(_listen, 4096) < 0) {
+        fprintf(stderr, "[BROKER] Cannot listen on port %u: %s\n", port, strerror(errno));
+        ::close(_listen);
+        _listen = -1;
+        return false;
+    }
+
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = BROKER_LISTEN_FD;
+    epoll_ctl(_epoll, EPOLL_CTL_ADD, _listen, &ev);
+
+    _running = true;
+    _thread = std::thread(&StubBroker::run, this);
+    return true;
+}
+
+void StubBroker::stop() {
+    if (!_running) return;
+    _running = false;
+    _thread.join();
+    while (!_sessions.empty()) close(_sessions.begin()->first);
+    ::close(_listen);
+    ::close(_epoll);
+}
+
+void StubBroker::getStats(StubBrokerStats& stats) {
+    stats.clients = _clients;
+    stats.connects = _connects;
+    stats.published = _published;
+    stats.delivered = _delivered;
+}
+
+// ============================================
+// Event Loop
+// ============================================
+
+void StubBroker::run() {
+    struct epoll_event events[256];
+    while (_running) {
+        int n = epoll_wait(_epoll, events, 256, 50);
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            if (fd == BROKER_LISTEN_FD) {
+                accept();
+                continue;
+            }
+            auto it = _sessions.find(fd);
+            if (it == _sessions.end()) continue;
+            if (events[i].events & EPOLLOUT) flush(fd, it->second);
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) read(fd);
+        }
+    }
+}
+
+void StubBroker::accept() {
+    while (true) {
+        int fd = accept4(_listen, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &ev);
+        _sessions[fd] = Session();
+        _clients++;
+    }
+}
+
+void StubBroker::read(int fd) {
+    Session& s = _sessions[fd];
+    char buf[16384];
+    while (true) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            s.in.append(buf, (size_t)n);
+            continue;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            close(fd);
+            return;
+        }
+        break;
+    }
+
+    // Tách các gói hoàn chỉnh
+    size_t pos = 0;
+    while (pos + 2 <= s.in.size()) {
+        size_t length = 0, multiplier = 1, i = pos + 1;
+        bool complete = false;
+        while (i < s.in.size() && i < pos + 5) {
+            uint8_t byte = (uint8_t)s.in[i++];
+            length += (byte & 0x7F) * multiplier;
+            multiplier *= 128;
+            if (!(byte & 0x80)) {
+                complete = true;
+                break;
+            }
+        }
+        if (!complete || i + length > s.in.size()) break;
+        uint8_t header = (uint8_t)s.in[pos];
+        std::string body = s.in.substr(i, length);
+        pos = i + length;
+        if (!handlePacket(fd, s, header, body)) {
+            close(fd);
+            return;
+        }
+    }
+    s.in.erase(0, pos);
+}
+
+bool StubBroker::handlePacket(int fd, Session& s, uint8_t header, const std::string& body) {
+    size_t pos = 0;
+    switch (header & 0xF0) {
+        case 0x10:  // CONNECT
+            _connects++;
+            send(fd, s, std::string("\x20\x02\x00\x00", 4));
+            return true;
+
+        case 0x30: {  // PUBLISH
+            std::string topic;
+            if (!readString(body, pos, topic)) return false;
+            uint8_t qos = (header >> 1) & 0x03;
+            if (qos > 0) {
+                if (pos + 2 > body.size()) return false;
+                send(fd, s, packet(0x40, body.substr(pos, 2)));     // PUBACK
+                pos += 2;
+            }
+            _published++;
+            route(topic, body.substr(pos));
+            return true;
+        }
+
+        case 0x80: {  // SUBSCRIBE
+            if (body.size() < 2) return false;
+            std::string granted = body.substr(0, 2);
+            pos = 2;
+            std::string filter;
+            while (pos < body.size() && readString(body, pos, filter)) {
+                pos++;      // QoS yêu cầu
+                granted.push_back('\0');
+                s.filters.push_back(filter);
+                if (filter.find_first_of("+#") == std::string::npos) _exact[filter].push_back(fd);
+                else _wildcards.emplace_back(filter, fd);
+            }
+            send(fd, s, packet(0x90, granted));
+            return true;
+        }
+
+        case 0xA0:  // UNSUBSCRIBE: chỉ xác nhận, lọc lại khi đóng kết nối
+            if (body.size() < 2) return false;
+            send(fd, s, packet(0xB0, body.substr(0, 2)));
+            return true;
+
+        case 0xC0:  // PINGREQ
+            send(fd, s, std::string("\xD0\x00", 2));
+            return true;
+
+        case 0xE0:  // DISCONNECT
+            return false;
+
+        default:
+            return true;
+    }
+}
+
+void StubBroker::route(const std::string& topic, const std::string& payload) {
+    std::string body;
+    body.push_back((char)(topic.size() >> 8));
+    body.push_back((char)(topic.size() & 0xFF));
+    body += topic;
+    body += payload;
+    std::string out = packet(0x30, body);
+
+    std::vector<int> targets;
+    auto it = _exact.find(topic);
+    if (it != _exact.end()) targets = it->second;
+    for (auto& w : _wildcards) {
+        if (topicMatches(w.first, topic)) targets.push_back(w.second);
+    }
+    for (int fd : targets) {
+        auto s = _sessions.find(fd);
+        if (s == _sessions.end()) continue;
+        send(fd, s->second, out);
+        _delivered++;
+    }
+}
+
+void StubBroker::send(int fd, Session& s, const std::string& data) {
+    if (s.out.empty()) {
+        ssize_t n = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (n == (ssize_t)data.size()) return;
+        s.out.assign(data, n > 0 ? (size_t)n : 0, std::string::npos);
+    } else {
+        s.out += data;
+    }
+    if (s.out.size() > BROKER_MAX_OUT) {
+        shutdown(fd, SHUT_RDWR);    // Đóng ở lần đọc kế tiếp (đang duyệt subscriber)
+        return;
+    }
+    if (s.writable) {
+        s.writable = false;
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN | EPOLLOUT;
+        ev.data.fd = fd;
+        epoll_ctl(_epoll, EPOLL_CTL_MOD, fd, &ev);
+    }
+}
+
+void StubBroker::flush(int fd, Session& s) {
+    while (!s.out.empty()) {
+        ssize_t n = ::send(fd, s.out.data(), s.out.size(), MSG_NOSIGNAL);
+        if (n <= 0) return;
+        s.out.erase(0, (size_t)n);
+    }
+    s.writable = true;
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    epoll_ctl(_epoll, EPOLL_CTL_MOD, fd, &ev);
+}
+
+void StubBroker::close(int fd) {
+    auto it = _sessions.find(fd);
+    if (it == _sessions.end()) return;
+    for (const std::string& filter : it->second.filters) {
+        auto e = _exact.find(filter);
+        if (e == _exact.end()) continue;
+        e->second.erase(std::remove(e->second.begin(), e->second.end(), fd), e->second.end());
+        if (e->second.empty()) _exact.erase(e);
+    }
+    _wildcards.erase(std::remove_if(_wildcards.begin(), _wildcards.end(),
+                                    [fd](const std::pair<std::string, int>& w) { return w.second == fd; }),
+                     _wildcards.end());
+    epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    _sessions.erase(it);
+    _clients--;
+}
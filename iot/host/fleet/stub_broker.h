@@ -0,0 +1,70 @@
+/**
+ * Stub MQTT Broker
+ *
+ * Broker MQTT 3.1.1 tối giản cho fleet simulator: QoS 0 (PUBLISH QoS 1 được
+ * PUBACK rồi chuyển tiếp QoS 0), wildcard + và #, không retain, không
+ * session. Một thread epoll; đủ cho vài nghìn locker ảo trên loopback.
+ * Muốn đo broker thật thì chạy fleet với --external-broker.
+ */
+
+#ifndef STUB_BROKER_H
+#define STUB_BROKER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Số liệu broker
+ */
+struct StubBrokerStats {
+    uint32_t clients;           // Kết nối đang mở
+    uint64_t connects;          // Tổng CONNECT
+    uint64_t published;         // PUBLISH nhận được
+    uint64_t delivered;         // PUBLISH đã chuyển cho subscriber
+};
+
+class StubBroker {
+public:
+    ~StubBroker();
+
+    /**
+     * Nghe trên port (mọi interface) và chạy thread broker
+     */
+    bool start(uint16_t port);
+    void stop();
+    void getStats(StubBrokerStats& stats);
+
+private:
+    struct Session {
+        std::string in;
+        std::string out;
+        std::vector<std::string> filters;
+        bool writable = true;
+    };
+
+    void run();
+    void accept();
+    void read(int fd);
+    void flush(int fd, Session& s);
+    void send(int fd, Session& s, const std::string& packet);
+    void close(int fd);
+    bool handlePacket(int fd, Session& s, uint8_t header, const std::string& body);
+    void route(const std::string& topic, const std::string& payload);
+
+    int _listen = -1;
+    int _epoll = -1;
+    std::atomic<bool> _running{false};
+    std::thread _thread;
+    std::map<int, Session> _sessions;
+    std::map<std::string, std::vector<int>> _exact;             // Topic -> fd
+    std::vector<std::pair<std::string, int>> _wildcards;         // Filter có + / #
+
+    std::atomic<uint32_t> _clients{0};
+    std::atomic<uint64_t> _connects{0}, _published{0}, _delivered{0};
+};
+
+#endif // STUB_BROKER_H
@@ -0,0 +1,167 @@
+/**
+ * Host stand-in: Arduino.h (ESP8266 core subset)
+ *
+ * Cho phép biên dịch firmware trên Linux: đồng hồ ảo, GPIO ảo,
+ * Serial ra stdout, PROGMEM là bộ nhớ thường.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+// newlib của ESP8266 có strlcpy, glibc chỉ có từ 2.38
+static inline size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+#include <math.h>
+#include <algorithm>
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "IPAddress.h"
+
+#ifndef ARDUINO
+#define ARDUINO 10819
+#endif
+#define LOCKER_HOST 1
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x00
+#define INPUT_PULLUP 0x02
+#define OUTPUT 0x01
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_byte_near(addr) pgm_read_byte(addr)
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define memcpy_P memcpy
+#define memcmp_P memcmp
+#define strlen_P strlen
+#define strncpy_P strncpy
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define snprintf_P snprintf
+#define vsnprintf_P vsnprintf
+
+#define digitalPinToInterrupt(p) (p)
+#define NOT_AN_INTERRUPT (-1)
+
+using std::min;
+using std::max;
+
+// ============================================
+// Time (đồng hồ ảo, xem host_env.h)
+// ============================================
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// ============================================
+// GPIO
+// ============================================
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+typedef void (*voidFuncPtr)(void);
+typedef void (*voidFuncPtrArg)(void*);
+void attachInterrupt(uint8_t pin, voidFuncPtr isr, int mode);
+void attachInterruptArg(uint8_t pin, voidFuncPtrArg isr, void* arg, int mode);
+void detachInterrupt(uint8_t pin);
+void noInterrupts();
+void interrupts();
+uint32_t xt_rsil(uint32_t level);
+void xt_wsr_ps(uint32_t state);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+// ============================================
+// Serial
+// ============================================
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    using Print::write;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t size) override;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void setDebugOutput(bool) {}
+    explicit operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+// ============================================
+// ESP (EspClass)
+// ============================================
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint32_t getMaxFreeBlockSize();
+    uint8_t getHeapFragmentation();
+    void getHeapStats(uint32_t* free = nullptr, uint16_t* max = nullptr, uint8_t* frag = nullptr);
+    void getHeapStats(uint32_t* free, uint32_t* max, uint8_t* frag);
+    uint32_t getFreeContStack();
+    uint32_t getChipId();
+    uint32_t getCycleCount();
+    uint8_t getCpuFreqMHz() { return 80; }
+    String getResetReason();
+    void wdtEnable(uint32_t timeout_ms = 0) { (void)timeout_ms; }
+    void wdtDisable();      // Bật giả lập WDT phần cứng (xem arduino_host.cpp)
+    void wdtFeed();
+    void restart();
+    void reset() { restart(); }
+
+    bool rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size);
+    bool rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size);
+
+    bool flashEraseSector(uint32_t sector);
+    bool flashWrite(uint32_t address, const uint32_t* data, size_t size);
+    bool flashRead(uint32_t address, uint32_t* data, size_t size);
+    uint32_t getFlashChipSize();
+};
+extern EspClass ESP;
+
+#define SPI_FLASH_SEC_SIZE 4096
+
+// SNTP: trên host đồng hồ hệ thống đã được đồng bộ, gettimeofday() dùng trực tiếp
+inline void configTime(int timezone, int daylightOffset_sec, const char* server1,
+                       const char* server2 = nullptr, const char* server3 = nullptr) {
+    (void)timezone; (void)daylightOffset_sec; (void)server1; (void)server2; (void)server3;
+}
+
+#endif // HOST_ARDUINO_H
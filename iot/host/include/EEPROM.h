@@ -0,0 +1,76 @@
+/**
+ * Host stand-in: EEPROM (giả lập bằng một sector flash ảo như core ESP8266)
+ */
+
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include "Arduino.h"
+
+class EEPROMClass {
+public:
+    // Sector EEPROM của layout 4 MB (FS 1 MB): 0x3FB000
+    explicit EEPROMClass(uint32_t sector = 0x3FB000 / SPI_FLASH_SEC_SIZE) : _sector(sector) {}
+
+    void begin(size_t size) {
+        if (size == 0 || size > SPI_FLASH_SEC_SIZE) return;
+        _size = (size + 3) & ~3;
+        ESP.flashRead(_sector * SPI_FLASH_SEC_SIZE, (uint32_t*)_data, _size);
+        _dirty = false;
+    }
+
+    uint8_t read(int address) { return (address >= 0 && (size_t)address < _size) ? _data[address] : 0; }
+
+    void write(int address, uint8_t value) {
+        if (address < 0 || (size_t)address >= _size) return;
+        if (_data[address] != value) {
+            _data[address] = value;
+            _dirty = true;
+        }
+    }
+
+    template <typename T>
+    T& get(int address, T& t) {
+        if (address >= 0 && address + sizeof(T) <= _size) memcpy((uint8_t*)&t, _data + address, sizeof(T));
+        return t;
+    }
+
+    template <typename T>
+    const T& put(int address, const T& t) {
+        if (address >= 0 && address + sizeof(T) <= _size && memcmp(_data + address, &t, sizeof(T)) != 0) {
+            memcpy(_data + address, &t, sizeof(T));
+            _dirty = true;
+        }
+        return t;
+    }
+
+    bool commit() {
+        if (!_size) return false;
+        if (!_dirty) return true;
+        _commits++;
+        if (!ESP.flashEraseSector(_sector)) return false;
+        if (!ESP.flashWrite(_sector * SPI_FLASH_SEC_SIZE, (const uint32_t*)_data, _size)) return false;
+        _dirty = false;
+        return true;
+    }
+
+    bool end() {
+        bool ok = commit();
+        _size = 0;
+        return ok;
+    }
+
+    size_t length() const { return _size; }
+    uint32_t commits() const { return _commits; }  // Chỉ có trên host: số lần xoá sector
+
+private:
+    uint32_t _sector;
+    uint8_t _data[SPI_FLASH_SEC_SIZE] = {};
+    size_t _size = 0;
+    bool _dirty = false;
+    uint32_t _commits = 0;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
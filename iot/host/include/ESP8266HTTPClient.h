@@ -0,0 +1,96 @@
+/**
+ * Host stand-in: ESP8266HTTPClient (HTTP/1.1, Content-Length và chunked)
+ */
+
+#ifndef HOST_ESP8266HTTPCLIENT_H
+#define HOST_ESP8266HTTPCLIENT_H
+
+#include <vector>
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+#define HTTPC_ERROR_CONNECTION_FAILED   (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED  (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED       (-4)
+#define HTTPC_ERROR_CONNECTION_LOST     (-5)
+#define HTTPC_ERROR_NO_STREAM           (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER      (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM        (-8)
+#define HTTPC_ERROR_ENCODING            (-9)
+#define HTTPC_ERROR_STREAM_WRITE        (-10)
+#define HTTPC_ERROR_READ_TIMEOUT        (-11)
+
+#define HTTPCLIENT_DEFAULT_TCP_TIMEOUT (5000)
+
+typedef enum {
+    HTTP_CODE_CONTINUE = 100,
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_CREATED = 201,
+    HTTP_CODE_ACCEPTED = 202,
+    HTTP_CODE_NO_CONTENT = 204,
+    HTTP_CODE_NOT_MODIFIED = 304,
+    HTTP_CODE_BAD_REQUEST = 400,
+    HTTP_CODE_UNAUTHORIZED = 401,
+    HTTP_CODE_FORBIDDEN = 403,
+    HTTP_CODE_NOT_FOUND = 404,
+    HTTP_CODE_TOO_MANY_REQUESTS = 429,
+    HTTP_CODE_INTERNAL_SERVER_ERROR = 500,
+    HTTP_CODE_BAD_GATEWAY = 502,
+    HTTP_CODE_SERVICE_UNAVAILABLE = 503,
+    HTTP_CODE_GATEWAY_TIMEOUT = 504
+} t_http_codes;
+
+class HTTPClient {
+public:
+    HTTPClient() {}
+    ~HTTPClient();
+
+    bool begin(WiFiClient& client, const String& url);
+    bool begin(WiFiClient& client, const String& host, uint16_t port, const String& uri = "/");
+    void end();
+    bool connected();
+
+    void setReuse(bool reuse) { _reuse = reuse; }
+    void setTimeout(uint16_t timeout) { _timeout = timeout; }
+    void useHTTP10(bool usehttp10 = true) { _useHTTP10 = usehttp10; }
+    void addHeader(const String& name, const String& value, bool first = false, bool replace = true);
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+    String header(const char* name);
+    bool hasHeader(const char* name);
+
+    int GET();
+    int POST(const String& payload) { return sendRequest("POST", (const uint8_t*)payload.c_str(), payload.length()); }
+    int POST(const uint8_t* payload, size_t size) { return sendRequest("POST", payload, size); }
+    int PUT(const String& payload) { return sendRequest("PUT", (const uint8_t*)payload.c_str(), payload.length()); }
+    int sendRequest(const char* type, const uint8_t* payload = nullptr, size_t size = 0);
+
+    int getSize() const { return _size; }
+    WiFiClient& getStream() { return *_client; }
+    WiFiClient* getStreamPtr() { return _client; }
+    int writeToStream(Stream* stream);
+    const String& getString();
+    static String errorToString(int error);
+
+private:
+    struct KV { String key; String value; };
+    int _readHeaders();
+
+    WiFiClient* _client = nullptr;
+    String _host;
+    uint16_t _port = 80;
+    String _uri;
+    bool _reuse = true;
+    bool _useHTTP10 = false;
+    uint16_t _timeout = HTTPCLIENT_DEFAULT_TCP_TIMEOUT;
+    String _headers;
+    std::vector<String> _collectKeys;
+    std::vector<KV> _respHeaders;
+    int _returnCode = 0;
+    int _size = -1;
+    bool _chunked = false;
+    bool _canReuse = false;
+    String _payload;
+};
+
+#endif // HOST_ESP8266HTTPCLIENT_H
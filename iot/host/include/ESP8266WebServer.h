@@ -0,0 +1,117 @@
+/**
+ * Host stand-in: ESP8266WebServer
+ *
+ * Server HTTP/1.0 một luồng như bản gốc: mỗi handleClient() nhận tối đa
+ * một request, gọi handler rồi đóng kết nối (trừ khi handler giữ lại
+ * bản copy của client()).
+ */
+
+#ifndef HOST_ESP8266WEBSERVER_H
+#define HOST_ESP8266WEBSERVER_H
+
+#include <functional>
+#include <vector>
+#include "Arduino.h"
+#include "ESP8266WiFi.h"
+#include "WiFiClient.h"
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
+#define HTTP_DOWNLOAD_UNIT_SIZE 1460
+#define HTTP_MAX_DATA_WAIT 5000
+#define HTTP_MAX_CLOSE_WAIT 2000
+
+class ESP8266WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    explicit ESP8266WebServer(int port = 80);
+    void begin();
+    void begin(uint16_t port) { _port = port; begin(); }
+    void handleClient();
+    void close();
+    void stop() { close(); }
+
+    void on(const String& uri, THandlerFunction fn) { on(uri, HTTP_ANY, fn); }
+    void on(const String& uri, HTTPMethod method, THandlerFunction fn);
+    void onNotFound(THandlerFunction fn) { _notFound = fn; }
+
+    const String& uri() const { return _uri; }
+    HTTPMethod method() const { return _method; }
+    WiFiClient& client() { return _client; }
+
+    const String& arg(const String& name) const;
+    const String& arg(int i) const;
+    const String& argName(int i) const;
+    int args() const { return (int)_args.size(); }
+    bool hasArg(const String& name) const;
+
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+    template <typename... Args>
+    bool collectHeaders(const Args&... args) {
+        const char* keys[] = { args... };
+        collectHeaders(keys, sizeof...(args));
+        return true;
+    }
+    const String& header(const String& name) const;
+    const String& header(int i) const;
+    const String& headerName(int i) const;
+    int headers() const { return (int)_headers.size(); }
+    bool hasHeader(const String& name) const;
+    const String& hostHeader() const { return header("Host"); }
+
+    void send(int code, const char* content_type = nullptr, const String& content = emptyString);
+    void send(int code, const String& content_type, const String& content) { send(code, content_type.c_str(), content); }
+    void send(int code, const char* content_type, const char* content) { send(code, content_type, String(content)); }
+    void send(int code, const char* content_type, const char* content, size_t len) { send(code, content_type, String(content, (unsigned int)len)); }
+    void send(int code, const char* content_type, const __FlashStringHelper* content) { send(code, content_type, String(content)); }
+    // Như core: header rồi ghi thẳng từ flash, chặn tới khi gửi hết
+    void send_P(int code, PGM_P content_type, PGM_P content) { send_P(code, content_type, content, strlen(content)); }
+    void send_P(int code, PGM_P content_type, PGM_P content, size_t len) {
+        _writeHead(code, content_type, len);
+        sendContent(content, len);
+    }
+
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void setContentLength(const size_t contentLength) { _contentLength = contentLength; }
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char* content, size_t size);
+    void sendContent(const char* content) { sendContent(content, strlen(content)); }
+    void sendContent_P(PGM_P content) { sendContent(content); }
+    void sendContent_P(PGM_P content, size_t size) { sendContent(content, size); }
+    void enableCORS(bool) {}
+
+    static String responseCodeToString(int code);
+
+private:
+    struct Route { String uri; HTTPMethod method; THandlerFunction fn; };
+    struct KV { String key; String value; };
+
+    bool _readRequest();
+    void _parseArgs(const String& query);
+    void _writeHead(int code, const char* content_type, size_t contentLength);
+
+    uint16_t _port;
+
+protected:
+    WiFiServer _server;
+
+private:
+    WiFiClient _client;
+    std::vector<Route> _routes;
+    THandlerFunction _notFound;
+    std::vector<String> _headerKeys;
+
+    String _uri;
+    HTTPMethod _method = HTTP_ANY;
+    std::vector<KV> _args;
+    std::vector<KV> _headers;
+    String _responseHeaders;
+    size_t _contentLength = CONTENT_LENGTH_NOT_SET;
+    bool _chunked = false;
+    bool _responded = false;
+};
+
+#endif // HOST_ESP8266WEBSERVER_H
@@ -0,0 +1,77 @@
+/**
+ * Host stand-in: ESP8266WiFi
+ *
+ * Trạng thái Wi-Fi ảo; điều khiển bằng host_env.h (mất sóng, RSSI, ...).
+ */
+
+#ifndef HOST_ESP8266WIFI_H
+#define HOST_ESP8266WIFI_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "WiFiClient.h"
+
+typedef enum {
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_WRONG_PASSWORD = 6,
+    WL_DISCONNECTED = 7
+} wl_status_t;
+
+typedef enum WiFiMode {
+    WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3
+} WiFiMode_t;
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+class ESP8266WiFiClass {
+public:
+    bool mode(WiFiMode_t m) { _mode = m; return true; }
+    WiFiMode_t getMode() const { return _mode; }
+    void persistent(bool p) { (void)p; }
+    bool setAutoReconnect(bool a) { (void)a; return true; }
+    bool setAutoConnect(bool a) { (void)a; return true; }
+    bool hostname(const char* name) { (void)name; return true; }
+
+    wl_status_t begin(const char* ssid, const char* pass = nullptr, int32_t channel = 0,
+                      const uint8_t* bssid = nullptr, bool connect = true);
+    bool config(IPAddress local, IPAddress gateway, IPAddress subnet,
+                IPAddress dns1 = (uint32_t)0, IPAddress dns2 = (uint32_t)0);
+    bool disconnect(bool wifioff = false);
+    bool reconnect();
+    bool isConnected() { return status() == WL_CONNECTED; }
+    wl_status_t status();
+
+    IPAddress localIP();
+    IPAddress gatewayIP();
+    IPAddress subnetMask();
+    IPAddress dnsIP(uint8_t n = 0);
+    String macAddress();
+    uint8_t* macAddress(uint8_t* mac);
+    String SSID() const;
+    uint8_t* BSSID();
+    String BSSIDstr();
+    int32_t channel();
+    int32_t RSSI();
+
+    int8_t scanNetworks(bool async = false, bool show_hidden = false,
+                        uint8_t channel = 0, uint8_t* ssid = nullptr);
+    int8_t scanComplete();
+    void scanDelete();
+    String SSID(uint8_t i);
+    int32_t RSSI(uint8_t i);
+    uint8_t* BSSID(uint8_t i);
+    int32_t channel(uint8_t i);
+
+private:
+    WiFiMode_t _mode = WIFI_OFF;
+};
+extern ESP8266WiFiClass WiFi;
+
+#endif // HOST_ESP8266WIFI_H
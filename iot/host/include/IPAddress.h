@@ -0,0 +1,32 @@
+/**
+ * Host stand-in: IPAddress (IPv4)
+ */
+
+#ifndef HOST_IPADDRESS_H
+#define HOST_IPADDRESS_H
+
+#include <stdint.h>
+#include "WString.h"
+
+class IPAddress {
+public:
+    IPAddress() : _addr(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        : _addr((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24)) {}
+    IPAddress(uint32_t addr) : _addr(addr) {}
+    IPAddress(const uint8_t* a) : IPAddress(a[0], a[1], a[2], a[3]) {}
+
+    operator uint32_t() const { return _addr; }
+    uint32_t v4() const { return _addr; }
+    uint8_t operator[](int i) const { return (uint8_t)(_addr >> (8 * i)); }
+    bool operator==(const IPAddress& o) const { return _addr == o._addr; }
+    bool operator!=(const IPAddress& o) const { return _addr != o._addr; }
+    bool isSet() const { return _addr != 0; }
+    bool fromString(const char* s);
+    String toString() const;
+
+private:
+    uint32_t _addr;  // network byte order, như lwIP
+};
+
+#endif // HOST_IPADDRESS_H
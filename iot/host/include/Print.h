@@ -0,0 +1,71 @@
+/**
+ * Host stand-in: Print
+ */
+
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include <stdarg.h>
+#include <stdio.h>
+#include "WString.h"
+#include "Printable.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*buf++);
+        return n;
+    }
+    size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+    size_t write(const char* buf, size_t size) { return write((const uint8_t*)buf, size); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+    size_t printf_P(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const String& s) { return write(s.c_str(), s.length()); }
+    size_t print(const char* s) { return write(s); }
+    size_t print(const __FlashStringHelper* s) { return write(reinterpret_cast<const char*>(s)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    // Như core ESP8266: số được định dạng trên stack, không qua String
+    size_t print(int v, int base = DEC) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC) {
+        if (base == DEC || v >= 0) return printNumber(v < 0 ? 0UL - (unsigned long)v : (unsigned long)v, base, v < 0);
+        return printNumber((unsigned long)v, base, false);
+    }
+    size_t print(unsigned long v, int base = DEC) { return printNumber(v, base, false); }
+    size_t print(double v, int digits = 2) { return print(String(v, (unsigned char)digits)); }
+
+    size_t print(const Printable& p) { return p.printTo(*this); }
+    size_t println() { return write("\r\n"); }
+
+private:
+    size_t printNumber(unsigned long v, int base, bool negative) {
+        char buf[8 * sizeof(long) + 2];
+        char* p = buf + sizeof(buf);
+        if (base < 2) base = 10;
+        do {
+            unsigned digit = v % base;
+            *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+            v /= base;
+        } while (v);
+        if (negative) *--p = '-';
+        return write((const uint8_t*)p, buf + sizeof(buf) - p);
+    }
+
+public:
+    template <typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(const T& v, int base) { size_t n = print(v, base); return n + println(); }
+};
+
+#endif // HOST_PRINT_H
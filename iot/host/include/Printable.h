@@ -0,0 +1,18 @@
+/**
+ * Host stand-in: Printable
+ */
+
+#ifndef HOST_PRINTABLE_H
+#define HOST_PRINTABLE_H
+
+#include <stddef.h>
+
+class Print;
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+#endif // HOST_PRINTABLE_H
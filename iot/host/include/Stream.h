@@ -0,0 +1,38 @@
+/**
+ * Host stand-in: Stream
+ */
+
+#ifndef HOST_STREAM_H
+#define HOST_STREAM_H
+
+#include "Print.h"
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual int read(uint8_t* buf, size_t size) {
+        size_t n = 0;
+        while (n < size) {
+            int c = timedRead();
+            if (c < 0) break;
+            buf[n++] = (uint8_t)c;
+        }
+        return (int)n;
+    }
+
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    unsigned long getTimeout() const { return _timeout; }
+
+    size_t readBytes(char* buf, size_t len) { return (size_t)read((uint8_t*)buf, len); }
+    size_t readBytes(uint8_t* buf, size_t len) { return (size_t)read(buf, len); }
+    String readString();
+    String readStringUntil(char terminator);
+
+protected:
+    int timedRead();
+    unsigned long _timeout = 1000;
+};
+
+#endif // HOST_STREAM_H
@@ -0,0 +1,125 @@
+/**
+ * Host stand-in: Arduino String
+ *
+ * Bản thay thế WString.h của core ESP8266, dựa trên std::string
+ */
+
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <string>
+
+class __FlashStringHelper;
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper*>(p))
+#define F(s) FPSTR(s)
+
+class String {
+public:
+    String() {}
+    String(const char* s) : _s(s ? s : "") {}
+    String(const char* s, unsigned int len) : _s(s ? s : "", s ? len : 0) {}
+    String(const __FlashStringHelper* s) : _s(s ? reinterpret_cast<const char*>(s) : "") {}
+    String(const std::string& s) : _s(s) {}
+    String(const String&) = default;
+    String(String&&) = default;
+    explicit String(char c) : _s(1, c) {}
+    explicit String(unsigned char v, unsigned char base = 10) { _fromUnsigned(v, base); }
+    explicit String(int v, unsigned char base = 10) { _fromSigned(v, base); }
+    explicit String(unsigned int v, unsigned char base = 10) { _fromUnsigned(v, base); }
+    explicit String(long v, unsigned char base = 10) { _fromSigned(v, base); }
+    explicit String(unsigned long v, unsigned char base = 10) { _fromUnsigned(v, base); }
+    explicit String(long long v, unsigned char base = 10) { _fromSigned(v, base); }
+    explicit String(unsigned long long v, unsigned char base = 10) { _fromUnsigned(v, base); }
+    explicit String(float v, unsigned char decimals = 2) { _fromDouble(v, decimals); }
+    explicit String(double v, unsigned char decimals = 2) { _fromDouble(v, decimals); }
+
+    String& operator=(const String&) = default;
+    String& operator=(String&&) = default;
+    String& operator=(const char* s) { _s = s ? s : ""; return *this; }
+    String& operator=(const __FlashStringHelper* s) { _s = s ? reinterpret_cast<const char*>(s) : ""; return *this; }
+
+    size_t length() const { return _s.size(); }
+    bool isEmpty() const { return _s.empty(); }
+    const char* c_str() const { return _s.c_str(); }
+    char* begin() { return &_s[0]; }
+    char* end() { return &_s[0] + _s.size(); }
+    const char* begin() const { return _s.c_str(); }
+    const char* end() const { return _s.c_str() + _s.size(); }
+    bool reserve(unsigned int size) { _s.reserve(size); return true; }
+    void clear() { _s.clear(); }
+
+    bool concat(const String& s) { _s += s._s; return true; }
+    bool concat(const char* s) { if (s) _s += s; return true; }
+    bool concat(const char* s, unsigned int len) { _s.append(s, len); return true; }
+    bool concat(const __FlashStringHelper* s) { return concat(reinterpret_cast<const char*>(s)); }
+    bool concat(char c) { _s += c; return true; }
+    bool concat(unsigned char v) { return concat(String(v)); }
+    bool concat(int v) { return concat(String(v)); }
+    bool concat(unsigned int v) { return concat(String(v)); }
+    bool concat(long v) { return concat(String(v)); }
+    bool concat(unsigned long v) { return concat(String(v)); }
+    bool concat(long long v) { return concat(String(v)); }
+    bool concat(unsigned long long v) { return concat(String(v)); }
+    bool concat(float v) { return concat(String(v)); }
+    bool concat(double v) { return concat(String(v)); }
+
+    template <typename T> String& operator+=(const T& v) { concat(v); return *this; }
+
+    int compareTo(const String& s) const { return _s.compare(s._s); }
+    bool equals(const String& s) const { return _s == s._s; }
+    bool equals(const char* s) const { return _s == (s ? s : ""); }
+    bool equalsIgnoreCase(const String& s) const { return strcasecmp(_s.c_str(), s.c_str()) == 0; }
+    bool startsWith(const String& p) const { return _s.compare(0, p._s.size(), p._s) == 0; }
+    bool endsWith(const String& p) const {
+        return _s.size() >= p._s.size() && _s.compare(_s.size() - p._s.size(), p._s.size(), p._s) == 0;
+    }
+    bool operator==(const String& s) const { return equals(s); }
+    bool operator==(const char* s) const { return equals(s); }
+    bool operator!=(const String& s) const { return !equals(s); }
+    bool operator!=(const char* s) const { return !equals(s); }
+    bool operator<(const String& s) const { return _s < s._s; }
+
+    char charAt(unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+    char& operator[](unsigned int i) { return _s[i]; }
+    int indexOf(char c, unsigned int from = 0) const { size_t p = _s.find(c, from); return p == std::string::npos ? -1 : (int)p; }
+    int indexOf(const String& s, unsigned int from = 0) const { size_t p = _s.find(s._s, from); return p == std::string::npos ? -1 : (int)p; }
+    int lastIndexOf(char c) const { size_t p = _s.rfind(c); return p == std::string::npos ? -1 : (int)p; }
+    String substring(unsigned int from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) { unsigned int t = from; from = to; to = t; }
+        if (from >= _s.size()) return String();
+        return String(_s.substr(from, to - from));
+    }
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    long toInt() const { return strtol(_s.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(_s.c_str(), nullptr); }
+    double toDouble() const { return strtod(_s.c_str(), nullptr); }
+
+    explicit operator bool() const { return true; }
+    const std::string& str() const { return _s; }
+
+private:
+    void _fromSigned(long long v, unsigned char base);
+    void _fromUnsigned(unsigned long long v, unsigned char base);
+    void _fromDouble(double v, unsigned char decimals);
+
+    std::string _s;
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r.concat(b); return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r.concat(b); return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r.concat(b); return r; }
+inline String operator+(const String& a, char b) { String r(a); r.concat(b); return r; }
+template <typename T> inline String operator+(const String& a, T b) { String r(a); r.concat(b); return r; }
+
+extern const String emptyString;
+
+#endif // HOST_WSTRING_H
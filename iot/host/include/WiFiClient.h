@@ -0,0 +1,109 @@
+/**
+ * Host stand-in: WiFiClient / WiFiServer trên POSIX sockets
+ *
+ * Giống core ESP8266, WiFiClient là handle đếm tham chiếu: copy client
+ * không mở socket mới, socket đóng khi handle cuối cùng bị huỷ hoặc stop().
+ */
+
+#ifndef HOST_WIFICLIENT_H
+#define HOST_WIFICLIENT_H
+
+#include <memory>
+#include "Arduino.h"
+#include "Client.h"
+
+#define TCP_DEFAULT_KEEPALIVE_IDLE_SEC 7200
+#define TCP_DEFAULT_KEEPALIVE_INTERVAL_SEC 75
+#define TCP_DEFAULT_KEEPALIVE_COUNT 9
+
+enum {
+    CLOSED = 0,
+    ESTABLISHED = 4,
+};
+
+struct HostSocket;
+
+class WiFiClient : public Client {
+public:
+    WiFiClient();
+    WiFiClient(const WiFiClient&) = default;
+    WiFiClient& operator=(const WiFiClient&) = default;
+    ~WiFiClient() override;
+
+    // Dùng bởi WiFiServer
+    explicit WiFiClient(int fd);
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char* host, uint16_t port) override;
+    int connect(const String& host, uint16_t port) { return connect(host.c_str(), port); }
+
+    using Print::write;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t size) override;
+    size_t write_P(PGM_P buf, size_t size) { return write((const uint8_t*)buf, size); }
+    int availableForWrite() override;
+
+    int available() override;
+    int read() override;
+    int read(uint8_t* buf, size_t size) override;
+    int read(char* buf, size_t size) { return read((uint8_t*)buf, size); }
+    int peek() override;
+    size_t peekBytes(uint8_t* buf, size_t size);
+    void flush() override {}
+    bool flush(unsigned int maxWaitMs) { (void)maxWaitMs; return true; }
+    void stop() override;
+    bool stop(unsigned int maxWaitMs) { (void)maxWaitMs; stop(); return true; }
+    uint8_t connected() override;
+    uint8_t status();
+    operator bool() override { return connected(); }
+
+    void setNoDelay(bool nodelay);
+    bool getNoDelay() const { return _nodelay; }
+    void keepAlive(uint16_t idle_sec = TCP_DEFAULT_KEEPALIVE_IDLE_SEC,
+                   uint16_t intv_sec = TCP_DEFAULT_KEEPALIVE_INTERVAL_SEC,
+                   uint8_t count = TCP_DEFAULT_KEEPALIVE_COUNT);
+    void disableKeepAlive() { keepAlive(0, 0, 0); }
+
+    IPAddress remoteIP();
+    uint16_t remotePort();
+    IPAddress localIP();
+    uint16_t localPort();
+
+    bool operator==(const WiFiClient& o) const { return _sock == o._sock; }
+
+    static void stopAll();
+
+    // Host-only: file descriptor cho epoll / select
+    int fd() const;
+
+private:
+    bool _fillUntil(unsigned long deadline);
+
+    std::shared_ptr<HostSocket> _sock;
+    bool _nodelay = false;
+};
+
+class WiFiServer {
+public:
+    explicit WiFiServer(uint16_t port);
+    ~WiFiServer();
+    void begin();
+    void begin(uint16_t port) { _port = port; begin(); }
+    void setNoDelay(bool nodelay) { _nodelay = nodelay; }
+    bool hasClient();
+    WiFiClient available();
+    WiFiClient accept() { return available(); }
+    void close();
+    void stop() { close(); }
+    uint8_t status() { return _fd >= 0 ? 1 : 0; }
+    uint16_t port() const { return _port; }
+    int fd() const { return _fd; }
+
+private:
+    uint16_t _port;
+    int _fd = -1;
+    int _pending = -1;
+    bool _nodelay = false;
+};
+
+#endif // HOST_WIFICLIENT_H
@@ -0,0 +1,21 @@
+/**
+ * Host stand-in: BearSSL SHA-256 (chỉ các hàm firmware dùng)
+ */
+
+#ifndef HOST_BEARSSL_HASH_H
+#define HOST_BEARSSL_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    uint8_t buf[64];
+    uint64_t count;
+    uint32_t val[8];
+} br_sha256_context;
+
+void br_sha256_init(br_sha256_context* ctx);
+void br_sha256_update(br_sha256_context* ctx, const void* data, size_t len);
+void br_sha256_out(const br_sha256_context* ctx, void* out);
+
+#endif // HOST_BEARSSL_HASH_H
@@ -0,0 +1,40 @@
+/**
+ * Host stand-in: cont.h của core ESP8266 (stack của loop())
+ *
+ * Trên host loop() chạy trên stack của thread, không có cont riêng:
+ * g_pcont trỏ tới một cont rỗng (sp_yield = nullptr) nên mã chụp stack
+ * của firmware không tìm thấy địa chỉ nào.
+ */
+
+#ifndef HOST_CONT_H
+#define HOST_CONT_H
+
+#include <stdint.h>
+
+#ifndef CONT_STACKSIZE
+#define CONT_STACKSIZE 4096
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct cont_ {
+    void (*pc_ret)(void);
+    unsigned* sp_ret;
+    void (*pc_yield)(void);
+    unsigned* sp_yield;
+    unsigned* stack_end;
+    unsigned stack_guard1;
+    unsigned stack[CONT_STACKSIZE / 4];
+    unsigned stack_guard2;
+    unsigned* struct_start;
+} cont_t;
+
+extern cont_t* g_pcont;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_CONT_H
@@ -0,0 +1,33 @@
+/**
+ * Host stand-in: FreeRTOS (phần bản build hai lõi dùng, xem dual_core.h)
+ *
+ * Mỗi task là một std::thread, "lõi" chỉ là nhãn của thread (gắn CPU tương
+ * ứng nếu máy có, không bắt buộc). Tick = 1 ms như cấu hình Arduino-ESP32.
+ */
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define configTICK_RATE_HZ 1000
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS 1
+#define pdFAIL 0
+#define tskNO_AFFINITY 0x7fffffff
+
+/**
+ * Lõi của task đang chạy (thread chính = lõi của loopTask trên Arduino-ESP32)
+ */
+BaseType_t xPortGetCoreID();
+
+#endif // HOST_FREERTOS_H
@@ -0,0 +1,32 @@
+/**
+ * Host stand-in: FreeRTOS task API (tạo task ghim lõi, task notification)
+ */
+
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef struct HostTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void* param);
+
+/**
+ * Tạo thread cho task; stack và priority chỉ được ghi nhận
+ */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char* name, uint32_t stackDepth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t coreId);
+
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+/**
+ * Kết thúc task (chỉ hỗ trợ task đang gọi: nullptr hoặc handle của chính nó)
+ */
+void vTaskDelete(TaskHandle_t task);
+
+void vTaskDelay(TickType_t ticks);
+void taskYIELD();
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
+
+#endif // HOST_FREERTOS_TASK_H
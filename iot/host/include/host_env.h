@@ -0,0 +1,51 @@
+/**
+ * Host environment controls
+ *
+ * API chỉ có trên bản build native: điều khiển đồng hồ ảo, GPIO ảo
+ * và trạng thái Wi-Fi để benchmark/mô phỏng firmware trên Linux.
+ */
+
+#ifndef HOST_ENV_H
+#define HOST_ENV_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Đồng hồ ảo: mặc định chạy theo CLOCK_MONOTONIC; ở chế độ manual
+// thời gian chỉ tiến khi gọi hostAdvanceMillis() hoặc delay().
+void hostClockManual(bool manual);
+void hostAdvanceMicros(uint64_t us);
+inline void hostAdvanceMillis(uint32_t ms) { hostAdvanceMicros((uint64_t)ms * 1000); }
+
+// Bỏ qua delay(): không ngủ mà cộng thẳng vào đồng hồ (đồng hồ vẫn chạy theo
+// CLOCK_MONOTONIC); dùng khi nhiều firmware chung một thread (fleet simulator)
+void hostClockSkipDelays(bool skip);
+
+// GPIO ảo: mức logic hiện tại của chân output, và đặt mức cho chân input
+// (gọi ISR đã attachInterrupt nếu cạnh khớp mode).
+int hostPinLevel(uint8_t pin);
+void hostSetPin(uint8_t pin, int level);
+
+// Wi-Fi ảo
+void hostWiFiSetConnected(bool connected);
+void hostWiFiSetRssi(int32_t rssi);
+
+// Serial: mặc định stdout, nullptr = bỏ log
+void hostSetSerialOutput(FILE* out);
+
+// Cổng HTTP server, ưu tiên hơn LOCKER_HTTP_PORT và SERVER_PORT (gọi trước setup())
+void hostSetHttpPort(uint16_t port);
+
+// Báo mỗi socket được mở (open = true) / sắp đóng, để tiến trình chủ đưa fd
+// vào vòng epoll của nó (fleet simulator)
+typedef void (*HostSocketHook)(int fd, bool open, void* ctx);
+void hostSetSocketHook(HostSocketHook hook, void* ctx);
+
+// Gọi các os_timer tới hạn và feed WDT, như SDK làm giữa hai vòng loop()
+// (yield() và delay() cũng gọi)
+void hostRunTimers();
+
+// Chạy vòng setup()/loop() của firmware (dùng bởi host main mặc định)
+void hostRunFirmware(unsigned long maxLoops);
+
+#endif // HOST_ENV_H
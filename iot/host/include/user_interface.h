@@ -0,0 +1,60 @@
+/**
+ * Host stand-in: ESP8266 NONOS SDK user_interface.h (phần firmware dùng)
+ *
+ * os_timer chạy như trên chip: không có thread riêng, callback được gọi
+ * khi firmware nhường CPU (yield(), delay()) hoặc giữa hai vòng loop().
+ */
+
+#ifndef HOST_USER_INTERFACE_H
+#define HOST_USER_INTERFACE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void os_timer_func_t(void* arg);
+
+typedef struct _os_timer_t {
+    struct _os_timer_t* timer_next;
+    uint32_t timer_expire;      // millis() tới hạn
+    uint32_t timer_period;      // 0 = một lần
+    os_timer_func_t* timer_func;
+    void* timer_arg;
+    uint8_t timer_armed;
+} os_timer_t;
+
+typedef os_timer_t ETSTimer;
+
+void os_timer_setfn(os_timer_t* timer, os_timer_func_t* func, void* arg);
+void os_timer_arm(os_timer_t* timer, uint32_t ms, bool repeat);
+void os_timer_disarm(os_timer_t* timer);
+
+enum rst_reason {
+    REASON_DEFAULT_RST = 0,
+    REASON_WDT_RST = 1,
+    REASON_EXCEPTION_RST = 2,
+    REASON_SOFT_WDT_RST = 3,
+    REASON_SOFT_RESTART = 4,
+    REASON_DEEP_SLEEP_AWAKE = 5,
+    REASON_EXT_SYS_RST = 6
+};
+
+struct rst_info {
+    uint32_t reason;
+    uint32_t exccause;
+    uint32_t epc1;
+    uint32_t epc2;
+    uint32_t epc3;
+    uint32_t excvaddr;
+    uint32_t depc;
+};
+
+struct rst_info* system_get_rst_info(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_USER_INTERFACE_H
@@ -0,0 +1,582 @@
+/**
+ * Host stand-in: Arduino core (time, GPIO, Serial, String, ESP)
+ */
+
+#include <Arduino.h>
+#include <host_env.h>
+#include <cont.h>
+#include <user_interface.h>
+#include <arpa/inet.h>
+#include <malloc.h>
+#include <sys/mman.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================
+// Virtual clock
+// ============================================
+
+static bool _clockManual = false;
+static uint64_t _manualUs = 0;
+static bool _skipDelays = false;
+static uint64_t _skippedUs = 0;    // Tổng delay() đã bỏ qua (hostClockSkipDelays)
+
+static uint64_t monotonicUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static uint64_t nowUs() {
+    static const uint64_t start = monotonicUs();
+    return _clockManual ? _manualUs : monotonicUs() - start + _skippedUs;
+}
+
+void hostClockManual(bool manual) {
+    if (manual && !_clockManual) _manualUs = nowUs();
+    _clockManual = manual;
+}
+
+void hostAdvanceMicros(uint64_t us) {
+    if (_clockManual) _manualUs += us;
+}
+
+void hostClockSkipDelays(bool skip) { _skipDelays = skip; }
+
+unsigned long millis() { return (unsigned long)(uint32_t)(nowUs() / 1000); }
+unsigned long micros() { return (unsigned long)(uint32_t)nowUs(); }
+
+static void serviceSystem();
+
+void delay(unsigned long ms) {
+    serviceSystem();
+    if (_clockManual) {
+        _manualUs += (uint64_t)ms * 1000;
+    } else if (_skipDelays) {
+        _skippedUs += (uint64_t)ms * 1000;
+    } else if (ms > 0) {
+        usleep(ms * 1000);
+    }
+}
+
+void delayMicroseconds(unsigned int us) {
+    if (_clockManual) _manualUs += us;
+    else if (_skipDelays) _skippedUs += us;
+    else usleep(us);
+}
+
+void yield() { serviceSystem(); }
+
+// ============================================
+// os_timer + watchdog phần cứng
+// ============================================
+// Như trên chip: timer và việc feed WDT chỉ diễn ra khi firmware nhường CPU
+// (yield(), delay()) hoặc giữa hai vòng loop() (hostRunTimers())
+
+#define HOST_HW_WDT_MS 8000     // WDT phần cứng của ESP8266 (~8 s không được feed)
+
+static os_timer_t* _timers = nullptr;
+static std::atomic<bool> _inTimers{false};   // Thread chính và task của bản build hai lõi
+static std::atomic<uint64_t> _lastFeedUs{0};
+static std::atomic<bool> _hwWdtStarted{false};
+
+static void persistRtc(uint32_t reason);
+
+void os_timer_setfn(os_timer_t* timer, os_timer_func_t* func, void* arg) {
+    os_timer_disarm(timer);
+    timer->timer_func = func;
+    timer->timer_arg = arg;
+}
+
+void os_timer_arm(os_timer_t* timer, uint32_t ms, bool repeat) {
+    os_timer_disarm(timer);
+    timer->timer_expire = (uint32_t)millis() + ms;
+    timer->timer_period = repeat ? ms : 0;
+    timer->timer_armed = 1;
+    timer->timer_next = _timers;
+    _timers = timer;
+}
+
+void os_timer_disarm(os_timer_t* timer) {
+    for (os_timer_t** link = &_timers; *link; link = &(*link)->timer_next) {
+        if (*link == timer) {
+            *link = timer->timer_next;
+            break;
+        }
+    }
+    timer->timer_armed = 0;
+}
+
+void hostRunTimers() {
+    _lastFeedUs = monotonicUs();
+    if (_inTimers.exchange(true)) return;
+    uint32_t now = (uint32_t)millis();
+    for (os_timer_t* t = _timers; t; ) {
+        os_timer_t* next = t->timer_next;
+        if (t->timer_armed && (int32_t)(now - t->timer_expire) >= 0) {
+            if (t->timer_period) {
+                t->timer_expire += t->timer_period;
+                if ((int32_t)(now - t->timer_expire) >= 0) t->timer_expire = now + t->timer_period;
+            } else {
+                os_timer_disarm(t);
+            }
+            t->timer_func(t->timer_arg);
+        }
+        t = next;
+    }
+    _inTimers = false;
+}
+
+static void serviceSystem() { hostRunTimers(); }
+
+/**
+ * WDT phần cứng chỉ được giả lập sau ESP.wdtDisable() (trên chip soft WDT
+ * thường reset trước): loop() không nhường CPU quá HOST_HW_WDT_MS thì
+ * tiến trình kết thúc như chip bị reset, RTC được giữ (LOCKER_RTC_FILE)
+ */
+static void hardwareWatchdog() {
+    while (true) {
+        usleep(100 * 1000);
+        if (monotonicUs() - _lastFeedUs > (uint64_t)HOST_HW_WDT_MS * 1000) {
+            fprintf(stdout, "\n ets Jan  8 2013,rst cause:4, boot mode:(3,6)\n\nwdt reset\n");
+            fflush(stdout);
+            persistRtc(REASON_WDT_RST);
+            _exit(0);
+        }
+    }
+}
+
+void EspClass::wdtDisable() {
+    _lastFeedUs = monotonicUs();
+    if (!_hwWdtStarted.exchange(true)) std::thread(hardwareWatchdog).detach();
+}
+
+void EspClass::wdtFeed() { _lastFeedUs = monotonicUs(); }
+
+// loop() chạy trên stack của thread: không có cont để chụp
+static cont_t _cont;
+cont_t* g_pcont = &_cont;
+
+// ============================================
+// Virtual GPIO
+// ============================================
+
+struct PinState {
+    uint8_t mode = INPUT;
+    int level = LOW;
+    voidFuncPtr isr = nullptr;
+    voidFuncPtrArg isrArg = nullptr;
+    void* arg = nullptr;
+    int isrMode = 0;
+};
+
+static std::map<uint8_t, PinState> _pins;
+static int _irqDepth = 0;
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    PinState& p = _pins[pin];
+    p.mode = mode;
+    if (mode == INPUT_PULLUP) p.level = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) { _pins[pin].level = val ? HIGH : LOW; }
+int digitalRead(uint8_t pin) { return _pins[pin].level; }
+int analogRead(uint8_t pin) { (void)pin; return 0; }
+
+void attachInterrupt(uint8_t pin, voidFuncPtr isr, int mode) {
+    _pins[pin].isr = isr;
+    _pins[pin].isrArg = nullptr;
+    _pins[pin].isrMode = mode;
+}
+
+void attachInterruptArg(uint8_t pin, voidFuncPtrArg isr, void* arg, int mode) {
+    _pins[pin].isr = nullptr;
+    _pins[pin].isrArg = isr;
+    _pins[pin].arg = arg;
+    _pins[pin].isrMode = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+    _pins[pin].isr = nullptr;
+    _pins[pin].isrArg = nullptr;
+}
+void noInterrupts() { _irqDepth++; }
+void interrupts() { if (_irqDepth > 0) _irqDepth--; }
+uint32_t xt_rsil(uint32_t level) { (void)level; return (uint32_t)_irqDepth++; }
+void xt_wsr_ps(uint32_t state) { _irqDepth = (int)state; }
+
+int hostPinLevel(uint8_t pin) { return _pins[pin].level; }
+
+void hostSetPin(uint8_t pin, int level) {
+    PinState& p = _pins[pin];
+    int old = p.level;
+    p.level = level ? HIGH : LOW;
+    if ((!p.isr && !p.isrArg) || old == p.level) return;
+    bool rising = p.level == HIGH;
+    if (p.isrMode == CHANGE || (p.isrMode == RISING && rising) || (p.isrMode == FALLING && !rising)) {
+        if (p.isr) p.isr();
+        else p.isrArg(p.arg);
+    }
+}
+
+long random(long max) { return max > 0 ? ::random() % max : 0; }
+long random(long min, long max) { return max > min ? min + ::random() % (max - min) : min; }
+void randomSeed(unsigned long seed) { srandom((unsigned)seed); }
+
+// ============================================
+// Serial
+// ============================================
+
+HardwareSerial Serial;
+static FILE* _serialOut = nullptr;
+static bool _serialRedirected = false;  // Khởi tạo tĩnh: Serial dùng được cả trong constructor toàn cục
+
+void hostSetSerialOutput(FILE* out) {
+    _serialOut = out;
+    _serialRedirected = true;
+}
+
+size_t HardwareSerial::write(uint8_t c) { return write(&c, 1); }
+size_t HardwareSerial::write(const uint8_t* buf, size_t size) {
+    FILE* out = _serialRedirected ? _serialOut : stdout;
+    return out ? fwrite(buf, 1, size, out) : size;
+}
+
+// ============================================
+// Print / Stream
+// ============================================
+
+// Như Print::printf của core ESP8266: buffer 64 byte trên stack, dòng dài
+// hơn thì cấp phát heap (để đếm cấp phát trên host khớp với thiết bị)
+static size_t vprintTo(Print& out, const char* fmt, va_list ap) {
+    char buf[64];
+    va_list copy;
+    va_copy(copy, ap);
+    int len = vsnprintf(buf, sizeof(buf), fmt, copy);
+    va_end(copy);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(buf)) return out.write((const uint8_t*)buf, (size_t)len);
+    char* big = (char*)malloc((size_t)len + 1);
+    if (!big) return 0;
+    vsnprintf(big, (size_t)len + 1, fmt, ap);
+    size_t n = out.write((const uint8_t*)big, (size_t)len);
+    free(big);
+    return n;
+}
+
+size_t Print::printf(const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    size_t n = vprintTo(*this, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+size_t Print::printf_P(const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    size_t n = vprintTo(*this, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+int Stream::timedRead() {
+    unsigned long start = millis();
+    do {
+        int c = read();
+        if (c >= 0) return c;
+        yield();
+        if (available() <= 0) usleep(100);
+    } while (millis() - start < _timeout);
+    return -1;
+}
+
+String Stream::readString() {
+    String s;
+    int c;
+    while ((c = timedRead()) >= 0) s.concat((char)c);
+    return s;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String s;
+    int c;
+    while ((c = timedRead()) >= 0 && c != terminator) s.concat((char)c);
+    return s;
+}
+
+// ============================================
+// String
+// ============================================
+
+const String emptyString;
+
+void String::_fromSigned(long long v, unsigned char base) {
+    if (v < 0 && base == 10) {
+        _fromUnsigned((unsigned long long)(-v), base);
+        _s.insert(_s.begin(), '-');
+    } else {
+        _fromUnsigned((unsigned long long)v, base);
+    }
+}
+
+void String::_fromUnsigned(unsigned long long v, unsigned char base) {
+    if (base < 2) base = 10;
+    char buf[66];
+    char* p = buf + sizeof(buf) - 1;
+    *p = 0;
+    do {
+        unsigned d = (unsigned)(v % base);
+        *--p = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+        v /= base;
+    } while (v);
+    _s = p;
+}
+
+void String::_fromDouble(double v, unsigned char decimals) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    _s = buf;
+}
+
+void String::trim() {
+    size_t b = _s.find_first_not_of(" \t\r\n");
+    size_t e = _s.find_last_not_of(" \t\r\n");
+    _s = b == std::string::npos ? std::string() : _s.substr(b, e - b + 1);
+}
+
+void String::toLowerCase() { for (auto& c : _s) c = (char)tolower((unsigned char)c); }
+void String::toUpperCase() { for (auto& c : _s) c = (char)toupper((unsigned char)c); }
+
+// ============================================
+// IPAddress
+// ============================================
+
+bool IPAddress::fromString(const char* s) {
+    struct in_addr a;
+    if (inet_pton(AF_INET, s, &a) != 1) return false;
+    _addr = a.s_addr;
+    return true;
+}
+
+String IPAddress::toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(buf);
+}
+
+// ============================================
+// ESP
+// ============================================
+
+EspClass ESP;
+
+#include <EEPROM.h>
+EEPROMClass EEPROM;
+
+// Heap của ESP8266 ~ 80 KB; trên host báo theo mallinfo2 để số liệu
+// tương đối (rò rỉ, phân mảnh) vẫn có ý nghĩa.
+static const uint32_t HOST_HEAP_SIZE = 80 * 1024;
+
+uint32_t EspClass::getFreeHeap() {
+    // Tính từ lần gọi đầu tiên (bỏ phần heap của runtime host)
+    static const size_t baseline = mallinfo2().uordblks;
+    size_t now = mallinfo2().uordblks;
+    size_t used = now > baseline ? now - baseline : 0;
+    return used >= HOST_HEAP_SIZE ? 0 : HOST_HEAP_SIZE - (uint32_t)used;
+}
+
+uint32_t EspClass::getMaxFreeBlockSize() {
+    // Phân mảnh xấp xỉ bằng phần free nằm rải rác trong arena của glibc
+    struct mallinfo2 mi = mallinfo2();
+    uint32_t free = getFreeHeap();
+    uint32_t frag = (uint32_t)std::min<size_t>(mi.fordblks / 16, free / 2);
+    return free - frag;
+}
+
+uint8_t EspClass::getHeapFragmentation() {
+    uint32_t free = getFreeHeap();
+    if (free == 0) return 0;
+    return (uint8_t)(100 - (uint64_t)getMaxFreeBlockSize() * 100 / free);
+}
+
+void EspClass::getHeapStats(uint32_t* free, uint16_t* max, uint8_t* frag) {
+    if (free) *free = getFreeHeap();
+    if (max) *max = (uint16_t)std::min<uint32_t>(getMaxFreeBlockSize(), 0xffff);
+    if (frag) *frag = getHeapFragmentation();
+}
+
+void EspClass::getHeapStats(uint32_t* free, uint32_t* max, uint8_t* frag) {
+    if (free) *free = getFreeHeap();
+    if (max) *max = getMaxFreeBlockSize();
+    if (frag) *frag = getHeapFragmentation();
+}
+
+uint32_t EspClass::getFreeContStack() { return 4096; }
+uint32_t EspClass::getChipId() { return (uint32_t)gethostid(); }
+uint32_t EspClass::getCycleCount() { return (uint32_t)(nowUs() * 80); }
+void EspClass::restart() {
+    Serial.println("[HOST] ESP.restart()");
+    fflush(stdout);
+    persistRtc(REASON_SOFT_RESTART);
+    exit(0);
+}
+
+// RTC user memory: 512 byte. LOCKER_RTC_FILE: giữ RTC và lý do reset qua
+// các lần chạy như reset trên chip (restart(), WDT; tiến trình bị kill thì
+// lần sau là "External System"). Xoá file = mất điện
+struct HostRtc {
+    uint32_t mem[128];
+    struct rst_info info;
+};
+
+static HostRtc& rtc() {
+    static HostRtc state;
+    static bool loaded = false;
+    if (!loaded) {
+        loaded = true;
+        const char* path = getenv("LOCKER_RTC_FILE");
+        FILE* f = path ? fopen(path, "rb") : nullptr;
+        if (f) {
+            HostRtc saved;
+            if (fread(&saved, sizeof(saved), 1, f) == 1) {
+                state = saved;
+                persistRtc(REASON_EXT_SYS_RST);
+            }
+            fclose(f);
+        }
+    }
+    return state;
+}
+
+static void persistRtc(uint32_t reason) {
+    const char* path = getenv("LOCKER_RTC_FILE");
+    if (!path) return;
+    HostRtc saved = rtc();
+    saved.info.reason = reason;
+    FILE* f = fopen(path, "wb");
+    if (!f) return;
+    fwrite(&saved, sizeof(saved), 1, f);
+    fclose(f);
+}
+
+struct rst_info* system_get_rst_info() { return &rtc().info; }
+
+String EspClass::getResetReason() {
+    static const char* const REASONS[] = {
+        "Power On", "Hardware Watchdog", "Exception", "Software Watchdog",
+        "Software/System restart", "Deep-Sleep Wake", "External System"
+    };
+    uint32_t reason = rtc().info.reason;
+    return String(reason < 7 ? REASONS[reason] : "Unknown");
+}
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size) {
+    if (offset * 4 + size > sizeof(rtc().mem) || (size & 3)) return false;
+    memcpy(data, (uint8_t*)rtc().mem + offset * 4, size);
+    return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size) {
+    if (offset * 4 + size > sizeof(rtc().mem) || (size & 3)) return false;
+    memcpy((uint8_t*)rtc().mem + offset * 4, data, size);
+    persistRtc(REASON_EXT_SYS_RST);
+    return true;
+}
+
+// Flash ảo 4 MB, xoá về 0xFF như NOR flash. LOCKER_FLASH_FILE: lưu ra file
+// để giữ qua các lần chạy (mô phỏng mất điện: RTC mất, flash còn).
+// Lưu dạng đảo bit trong trang mmap ẩn danh: sector đã xoá là trang 0 chưa
+// chạm tới, không tốn RAM (fleet simulator nạp hàng nghìn bản)
+#define HOST_FLASH_SIZE (4 * 1024 * 1024)
+
+static uint8_t* flashImage() {
+    static uint8_t* img = nullptr;
+    if (!img) {
+        img = (uint8_t*)mmap(nullptr, HOST_FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        const char* path = getenv("LOCKER_FLASH_FILE");
+        FILE* f = path ? fopen(path, "rb") : nullptr;
+        if (f) {
+            size_t n = fread(img, 1, HOST_FLASH_SIZE, f);
+            for (size_t i = 0; i < n; i++) img[i] = ~img[i];
+            fclose(f);
+        }
+    }
+    return img;
+}
+
+/**
+ * Ghi vùng [addr, addr + size) ra LOCKER_FLASH_FILE (cả image nếu file chưa có)
+ */
+static void flashPersist(size_t addr, size_t size) {
+    const char* path = getenv("LOCKER_FLASH_FILE");
+    if (!path) return;
+    FILE* f = fopen(path, "r+b");
+    if (!f) {
+        f = fopen(path, "wb");
+        if (!f) return;
+        addr = 0;
+        size = HOST_FLASH_SIZE;
+    }
+    const uint8_t* img = flashImage();
+    uint8_t chunk[4096];
+    fseek(f, addr, SEEK_SET);
+    for (size_t done = 0; done < size; done += sizeof(chunk)) {
+        size_t n = size - done < sizeof(chunk) ? size - done : sizeof(chunk);
+        for (size_t i = 0; i < n; i++) chunk[i] = ~img[addr + done + i];
+        fwrite(chunk, 1, n, f);
+    }
+    fclose(f);
+}
+
+uint32_t EspClass::getFlashChipSize() { return HOST_FLASH_SIZE; }
+
+bool EspClass::flashEraseSector(uint32_t sector) {
+    size_t addr = (size_t)sector * SPI_FLASH_SEC_SIZE;
+    if (addr + SPI_FLASH_SEC_SIZE > HOST_FLASH_SIZE) return false;
+    memset(flashImage() + addr, 0, SPI_FLASH_SEC_SIZE);
+    flashPersist(addr, SPI_FLASH_SEC_SIZE);
+    return true;
+}
+
+bool EspClass::flashWrite(uint32_t address, const uint32_t* data, size_t size) {
+    if ((address & 3) || (size & 3) || address + size > HOST_FLASH_SIZE) return false;
+    uint8_t* img = flashImage();
+    const uint8_t* src = (const uint8_t*)data;
+    // NOR flash chỉ có thể xoá bit 1 -> 0 (đảo bit: chỉ bật thêm bit)
+    for (size_t i = 0; i < size; i++) img[address + i] |= (uint8_t)~src[i];
+    flashPersist(address, size);
+    return true;
+}
+
+bool EspClass::flashRead(uint32_t address, uint32_t* data, size_t size) {
+    if ((address & 3) || address + size > HOST_FLASH_SIZE) return false;
+    const uint8_t* img = flashImage();
+    uint8_t* dst = (uint8_t*)data;
+    for (size_t i = 0; i < size; i++) dst[i] = ~img[address + i];
+    return true;
+}
+
+// ============================================
+// operator new -> malloc
+// ============================================
+// Giống core ESP8266: new gọi malloc của firmware, nhờ vậy
+// -Wl,--wrap=malloc (HEAP_TRACK_ALLOCATIONS) cũng đếm được cấp phát của String
+#include <new>
+
+void* operator new(size_t size) {
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
@@ -0,0 +1,105 @@
+/**
+ * Host stand-in: FreeRTOS task trên std::thread
+ *
+ * Task notification là bộ đếm + condition variable riêng của mỗi task.
+ * vTaskDelay()/ulTaskNotifyTake() ngủ theo thời gian thật, không chạy
+ * os_timer (khác delay() của thread chính).
+ */
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <pthread.h>
+#include <sched.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct HostTask {
+    HostTask(const char* taskName, BaseType_t coreId) : name(taskName), core(coreId) {}
+
+    const char* name;
+    BaseType_t core;
+    std::mutex lock;
+    std::condition_variable wake;
+    uint32_t notifications = 0;
+};
+
+// Thread chính chạy setup()/loop() như loopTask (lõi 1 trên Arduino-ESP32)
+static HostTask _mainTask("loopTask", 1);
+static thread_local HostTask* _current = &_mainTask;
+
+/**
+ * Gắn thread vào CPU tương ứng với lõi nếu có (chỉ để gần giống chip)
+ */
+static void pinThread(BaseType_t core) {
+    if (core == tskNO_AFFINITY) return;
+    unsigned cpus = std::thread::hardware_concurrency();
+    if (cpus < 2) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((unsigned)core % cpus, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+BaseType_t xPortGetCoreID() {
+    return _current->core;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char* name, uint32_t stackDepth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t coreId) {
+    (void)stackDepth;
+    (void)priority;
+    HostTask* task = new HostTask(name, coreId);
+    if (created) *created = task;
+    std::thread([task, code, param]() {
+        _current = task;
+        pthread_setname_np(pthread_self(), task->name);
+        pinThread(task->core);
+        code(param);
+        // Task FreeRTOS không được return; coi như vTaskDelete(nullptr)
+        vTaskDelete(nullptr);
+    }).detach();
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return _current;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (task != nullptr && task != _current) return;
+    // Thread chính cũng thoát được: tiến trình sống tiếp tới khi các task khác kết thúc
+    pthread_exit(nullptr);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+void taskYIELD() {
+    std::this_thread::yield();
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    {
+        std::lock_guard<std::mutex> guard(task->lock);
+        task->notifications++;
+    }
+    task->wake.notify_one();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait) {
+    HostTask* task = _current;
+    std::unique_lock<std::mutex> guard(task->lock);
+    auto ready = [task]() { return task->notifications > 0; };
+    if (ticksToWait == portMAX_DELAY) {
+        task->wake.wait(guard, ready);
+    } else {
+        task->wake.wait_for(guard, std::chrono::milliseconds(ticksToWait * portTICK_PERIOD_MS), ready);
+    }
+    uint32_t count = task->notifications;
+    if (count > 0) task->notifications = clearCountOnExit ? 0 : count - 1;
+    return count;
+}
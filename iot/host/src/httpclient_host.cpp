@@ -0,0 +1,224 @@
+/**
+ * Host stand-in: ESP8266HTTPClient
+ */
+
+#include <ESP8266HTTPClient.h>
+
+// Giống core ESP8266: destructor luôn đóng client, kể cả khi setReuse(true)
+HTTPClient::~HTTPClient() { if (_client) _client->stop(); }
+
+bool HTTPClient::begin(WiFiClient& client, const String& url) {
+    String rest = url;
+    if (rest.startsWith("http://")) rest = rest.substring(7);
+    else if (rest.indexOf("://") >= 0) return false;
+    int slash = rest.indexOf('/');
+    String hostPort = slash < 0 ? rest : rest.substring(0, slash);
+    String uri = slash < 0 ? String("/") : rest.substring(slash);
+    int colon = hostPort.indexOf(':');
+    uint16_t port = 80;
+    if (colon >= 0) {
+        port = (uint16_t)hostPort.substring(colon + 1).toInt();
+        hostPort = hostPort.substring(0, colon);
+    }
+    return begin(client, hostPort, port, uri);
+}
+
+bool HTTPClient::begin(WiFiClient& client, const String& host, uint16_t port, const String& uri) {
+    if (_client && _client != &client) end();
+    _client = &client;
+    _host = host;
+    _port = port;
+    _uri = uri;
+    _headers.clear();
+    _respHeaders.clear();
+    _payload.clear();
+    _returnCode = 0;
+    _size = -1;
+    return true;
+}
+
+void HTTPClient::end() {
+    if (_client && (!_reuse || !_canReuse)) _client->stop();
+    _payload.clear();
+    _canReuse = false;
+}
+
+bool HTTPClient::connected() { return _client && _client->connected(); }
+
+void HTTPClient::addHeader(const String& name, const String& value, bool first, bool replace) {
+    (void)replace;
+    String line = name + ": " + value + "\r\n";
+    if (first) _headers = line + _headers;
+    else _headers.concat(line);
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+    _collectKeys.clear();
+    for (size_t i = 0; i < headerKeysCount; i++) _collectKeys.push_back(headerKeys[i]);
+}
+
+String HTTPClient::header(const char* name) {
+    for (const auto& kv : _respHeaders) if (kv.key.equalsIgnoreCase(name)) return kv.value;
+    return String();
+}
+
+bool HTTPClient::hasHeader(const char* name) {
+    for (const auto& kv : _respHeaders) if (kv.key.equalsIgnoreCase(name)) return true;
+    return false;
+}
+
+int HTTPClient::GET() { return sendRequest("GET"); }
+
+int HTTPClient::sendRequest(const char* type, const uint8_t* payload, size_t size) {
+    if (!_client) return HTTPC_ERROR_NOT_CONNECTED;
+    _client->setTimeout(_timeout);
+    if (!_client->connected()) {
+        if (!_client->connect(_host.c_str(), _port)) return HTTPC_ERROR_CONNECTION_FAILED;
+    }
+
+    String req = String(type) + " " + _uri + (_useHTTP10 ? " HTTP/1.0\r\n" : " HTTP/1.1\r\n");
+    req += String("Host: ") + _host + (_port != 80 ? String(":") + String(_port) : String()) + "\r\n";
+    req += String("Connection: ") + (_reuse && !_useHTTP10 ? "keep-alive" : "close") + "\r\n";
+    req += "User-Agent: ESP8266HTTPClient\r\n";
+    if (payload || strcmp(type, "GET") != 0) req += String("Content-Length: ") + String((unsigned long)size) + "\r\n";
+    req += _headers;
+    req += "\r\n";
+
+    if (_client->write((const uint8_t*)req.c_str(), req.length()) != req.length()) return HTTPC_ERROR_SEND_HEADER_FAILED;
+    if (size && _client->write(payload, size) != size) return HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+    return _readHeaders();
+}
+
+int HTTPClient::_readHeaders() {
+    _respHeaders.clear();
+    _size = -1;
+    _chunked = false;
+    _canReuse = _reuse && !_useHTTP10;
+    unsigned long start = millis();
+    String line;
+    bool first = true;
+    while (millis() - start < _timeout) {
+        int c = _client->read();
+        if (c < 0) {
+            if (!_client->connected()) return HTTPC_ERROR_CONNECTION_LOST;
+            delay(1);
+            continue;
+        }
+        if (c != '\n') {
+            if (c != '\r') line.concat((char)c);
+            continue;
+        }
+        if (first) {
+            int sp = line.indexOf(' ');
+            _returnCode = sp < 0 ? 0 : (int)line.substring(sp + 1).toInt();
+            if (_returnCode <= 0) return HTTPC_ERROR_NO_HTTP_SERVER;
+            first = false;
+        } else if (line.length() == 0) {
+            return _returnCode;
+        } else {
+            int colon = line.indexOf(':');
+            if (colon > 0) {
+                String key = line.substring(0, colon);
+                String value = line.substring(colon + 1);
+                value.trim();
+                if (key.equalsIgnoreCase("Content-Length")) _size = (int)value.toInt();
+                if (key.equalsIgnoreCase("Transfer-Encoding") && value.equalsIgnoreCase("chunked")) _chunked = true;
+                if (key.equalsIgnoreCase("Connection") && value.equalsIgnoreCase("close")) _canReuse = false;
+                for (const auto& k : _collectKeys) {
+                    if (k.equalsIgnoreCase(key)) _respHeaders.push_back(KV{ k, value });
+                }
+            }
+        }
+        line.clear();
+    }
+    return HTTPC_ERROR_READ_TIMEOUT;
+}
+
+int HTTPClient::writeToStream(Stream* stream) {
+    if (!stream) return HTTPC_ERROR_NO_STREAM;
+    if (!connected() && _size != 0) return HTTPC_ERROR_NOT_CONNECTED;
+    int total = 0;
+    uint8_t buf[512];
+    unsigned long last = millis();
+    auto readExact = [&](size_t want) -> int {
+        size_t got = 0;
+        while (got < want && millis() - last < _timeout) {
+            int n = _client->read(buf, std::min(sizeof(buf), want - got));
+            if (n > 0) {
+                if (stream->write(buf, (size_t)n) != (size_t)n) return HTTPC_ERROR_STREAM_WRITE;
+                got += (size_t)n;
+                last = millis();
+            } else if (!_client->connected()) {
+                break;
+            } else {
+                delay(1);
+            }
+        }
+        return (int)got;
+    };
+
+    if (_chunked) {
+        while (true) {
+            _client->setTimeout(_timeout);
+            String len = _client->readStringUntil('\n');
+            long chunk = strtol(len.c_str(), nullptr, 16);
+            if (chunk <= 0) {
+                _client->readStringUntil('\n');
+                break;
+            }
+            int n = readExact((size_t)chunk);
+            if (n < 0) return n;
+            total += n;
+            _client->readStringUntil('\n');
+        }
+    } else if (_size >= 0) {
+        int n = readExact((size_t)_size);
+        if (n < 0) return n;
+        total = n;
+    } else {
+        _canReuse = false;
+        int n = readExact((size_t)-1 / 2);
+        if (n < 0) return n;
+        total = n;
+    }
+    return total;
+}
+
+namespace {
+class StringStream : public Stream {
+public:
+    explicit StringStream(String& s) : _s(s) {}
+    size_t write(uint8_t c) override { _s.concat((char)c); return 1; }
+    size_t write(const uint8_t* b, size_t n) override { _s.concat((const char*)b, (unsigned)n); return n; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+private:
+    String& _s;
+};
+}
+
+const String& HTTPClient::getString() {
+    if (_payload.length() == 0) {
+        StringStream out(_payload);
+        writeToStream(&out);
+    }
+    return _payload;
+}
+
+String HTTPClient::errorToString(int error) {
+    switch (error) {
+        case HTTPC_ERROR_CONNECTION_FAILED: return F("connection failed");
+        case HTTPC_ERROR_SEND_HEADER_FAILED: return F("send header failed");
+        case HTTPC_ERROR_SEND_PAYLOAD_FAILED: return F("send payload failed");
+        case HTTPC_ERROR_NOT_CONNECTED: return F("not connected");
+        case HTTPC_ERROR_CONNECTION_LOST: return F("connection lost");
+        case HTTPC_ERROR_NO_STREAM: return F("no stream");
+        case HTTPC_ERROR_NO_HTTP_SERVER: return F("no HTTP server");
+        case HTTPC_ERROR_TOO_LESS_RAM: return F("too less ram");
+        case HTTPC_ERROR_ENCODING: return F("Transfer-Encoding not supported");
+        case HTTPC_ERROR_STREAM_WRITE: return F("Stream write error");
+        case HTTPC_ERROR_READ_TIMEOUT: return F("read Timeout");
+        default: return String();
+    }
+}
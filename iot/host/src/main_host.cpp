@@ -0,0 +1,33 @@
+/**
+ * Host entry point: chạy setup() rồi loop() như core Arduino
+ *
+ * Biến môi trường:
+ *   LOCKER_HTTP_PORT  cổng HTTP server (mặc định SERVER_PORT)
+ *   LOCKER_MAX_LOOPS  dừng sau N vòng loop() (0 = chạy mãi)
+ *   LOCKER_FLASH_FILE flash ảo lưu ra file (giữ qua các lần chạy)
+ *   LOCKER_RTC_FILE   RTC memory + lý do reset lưu ra file (giữ qua restart/WDT)
+ */
+
+#include <Arduino.h>
+#include <host_env.h>
+#include <stdio.h>
+
+void setup();
+void loop();
+
+void hostRunFirmware(unsigned long maxLoops) {
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+    setup();
+    for (unsigned long n = 0; maxLoops == 0 || n < maxLoops; n++) {
+        loop();
+        hostRunTimers();
+    }
+}
+
+#ifndef LOCKER_HOST_NO_MAIN
+int main() {
+    const char* loops = getenv("LOCKER_MAX_LOOPS");
+    hostRunFirmware(loops ? strtoul(loops, nullptr, 10) : 0);
+    return 0;
+}
+#endif
@@ -0,0 +1,248 @@
+/**
+ * Host stand-in: ESP8266WebServer
+ */
+
+#include <ESP8266WebServer.h>
+#include <host_env.h>
+
+static uint16_t _portOverride = 0;
+
+void hostSetHttpPort(uint16_t port) { _portOverride = port; }
+
+ESP8266WebServer::ESP8266WebServer(int port) : _port((uint16_t)port), _server((uint16_t)port) {}
+
+void ESP8266WebServer::begin() {
+    // Cổng < 1024 cần root trên Linux: cho phép đổi qua biến môi trường
+    const char* override = getenv("LOCKER_HTTP_PORT");
+    if (_portOverride) _port = _portOverride;
+    else if (override) _port = (uint16_t)atoi(override);
+    _server.begin(_port);
+}
+
+void ESP8266WebServer::close() { _server.close(); }
+
+void ESP8266WebServer::on(const String& uri, HTTPMethod method, THandlerFunction fn) {
+    _routes.push_back(Route{ uri, method, fn });
+}
+
+void ESP8266WebServer::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+    _headerKeys.clear();
+    for (size_t i = 0; i < headerKeysCount; i++) _headerKeys.push_back(headerKeys[i]);
+}
+
+const String& ESP8266WebServer::arg(const String& name) const {
+    for (const auto& kv : _args) if (kv.key == name) return kv.value;
+    return emptyString;
+}
+
+const String& ESP8266WebServer::arg(int i) const { return i < (int)_args.size() ? _args[i].value : emptyString; }
+const String& ESP8266WebServer::argName(int i) const { return i < (int)_args.size() ? _args[i].key : emptyString; }
+
+bool ESP8266WebServer::hasArg(const String& name) const {
+    for (const auto& kv : _args) if (kv.key == name) return true;
+    return false;
+}
+
+const String& ESP8266WebServer::header(const String& name) const {
+    for (const auto& kv : _headers) if (kv.key.equalsIgnoreCase(name)) return kv.value;
+    return emptyString;
+}
+
+const String& ESP8266WebServer::header(int i) const { return i < (int)_headers.size() ? _headers[i].value : emptyString; }
+const String& ESP8266WebServer::headerName(int i) const { return i < (int)_headers.size() ? _headers[i].key : emptyString; }
+
+bool ESP8266WebServer::hasHeader(const String& name) const {
+    for (const auto& kv : _headers) if (kv.key.equalsIgnoreCase(name)) return kv.value.length() > 0;
+    return false;
+}
+
+static String urlDecode(const String& s) {
+    String out;
+    for (unsigned i = 0; i < s.length(); i++) {
+        char c = s[i];
+        if (c == '+') out.concat(' ');
+        else if (c == '%' && i + 2 < s.length()) {
+            char hex[3] = { s[i + 1], s[i + 2], 0 };
+            out.concat((char)strtol(hex, nullptr, 16));
+            i += 2;
+        } else out.concat(c);
+    }
+    return out;
+}
+
+void ESP8266WebServer::_parseArgs(const String& query) {
+    unsigned pos = 0;
+    while (pos < query.length()) {
+        int amp = query.indexOf('&', pos);
+        String pair = query.substring(pos, amp < 0 ? query.length() : (unsigned)amp);
+        int eq = pair.indexOf('=');
+        if (pair.length()) {
+            _args.push_back(KV{ urlDecode(eq < 0 ? pair : pair.substring(0, eq)),
+                                eq < 0 ? String() : urlDecode(pair.substring(eq + 1)) });
+        }
+        if (amp < 0) break;
+        pos = (unsigned)amp + 1;
+    }
+}
+
+static bool readLine(WiFiClient& c, String& line, unsigned long deadline) {
+    line.clear();
+    while ((long)(deadline - millis()) > 0) {
+        int ch = c.read();
+        if (ch < 0) {
+            if (!c.connected()) return false;
+            delay(1);
+            continue;
+        }
+        if (ch == '\n') {
+            if (line.length() && line[line.length() - 1] == '\r') line = line.substring(0, line.length() - 1);
+            return true;
+        }
+        line.concat((char)ch);
+    }
+    return false;
+}
+
+bool ESP8266WebServer::_readRequest() {
+    unsigned long deadline = millis() + HTTP_MAX_DATA_WAIT;
+    String line;
+    if (!readLine(_client, line, deadline)) return false;
+
+    int sp1 = line.indexOf(' ');
+    int sp2 = line.indexOf(' ', sp1 + 1);
+    if (sp1 < 0 || sp2 < 0) return false;
+    String method = line.substring(0, sp1);
+    String url = line.substring(sp1 + 1, sp2);
+
+    _method = HTTP_ANY;
+    if (method == "GET") _method = HTTP_GET;
+    else if (method == "POST") _method = HTTP_POST;
+    else if (method == "PUT") _method = HTTP_PUT;
+    else if (method == "PATCH") _method = HTTP_PATCH;
+    else if (method == "DELETE") _method = HTTP_DELETE;
+    else if (method == "OPTIONS") _method = HTTP_OPTIONS;
+    else if (method == "HEAD") _method = HTTP_HEAD;
+
+    int q = url.indexOf('?');
+    _uri = q < 0 ? url : url.substring(0, q);
+    _args.clear();
+    _headers.clear();
+    if (q >= 0) _parseArgs(url.substring(q + 1));
+
+    size_t contentLength = 0;
+    while (readLine(_client, line, deadline) && line.length()) {
+        int colon = line.indexOf(':');
+        if (colon < 0) continue;
+        String key = line.substring(0, colon);
+        String value = line.substring(colon + 1);
+        value.trim();
+        if (key.equalsIgnoreCase("Content-Length")) contentLength = (size_t)value.toInt();
+        for (const auto& k : _headerKeys) {
+            if (k.equalsIgnoreCase(key)) _headers.push_back(KV{ k, value });
+        }
+    }
+
+    if (contentLength > 0) {
+        String body;
+        body.reserve((unsigned)contentLength);
+        while (body.length() < contentLength && (long)(deadline - millis()) > 0) {
+            uint8_t buf[512];
+            int n = _client.read(buf, std::min(sizeof(buf), contentLength - body.length()));
+            if (n > 0) body.concat((const char*)buf, (unsigned)n);
+            else if (!_client.connected()) break;
+            else delay(1);
+        }
+        _args.push_back(KV{ "plain", body });
+    }
+    return true;
+}
+
+void ESP8266WebServer::handleClient() {
+    if (!_server.hasClient()) return;
+    _client = _server.available();
+    if (!_readRequest()) {
+        _client = WiFiClient();
+        return;
+    }
+
+    _responseHeaders.clear();
+    _contentLength = CONTENT_LENGTH_NOT_SET;
+    _chunked = false;
+    _responded = false;
+
+    bool handled = false;
+    for (const auto& r : _routes) {
+        if (r.uri == _uri && (r.method == HTTP_ANY || r.method == _method)) {
+            r.fn();
+            handled = true;
+            break;
+        }
+    }
+    if (!handled) {
+        if (_notFound) _notFound();
+        else send(404, "text/plain", String("Not found: ") + _uri);
+    }
+    if (_chunked) sendContent("", 0);
+
+    // Handler có thể giữ bản copy của client() để trả lời sau (như core gốc)
+    _client = WiFiClient();
+}
+
+String ESP8266WebServer::responseCodeToString(int code) {
+    switch (code) {
+        case 200: return F("OK");
+        case 204: return F("No Content");
+        case 304: return F("Not Modified");
+        case 400: return F("Bad Request");
+        case 401: return F("Unauthorized");
+        case 403: return F("Forbidden");
+        case 404: return F("Not Found");
+        case 429: return F("Too Many Requests");
+        case 500: return F("Internal Server Error");
+        case 502: return F("Bad Gateway");
+        case 503: return F("Service Unavailable");
+        case 504: return F("Gateway Time-out");
+        default: return F("");
+    }
+}
+
+void ESP8266WebServer::sendHeader(const String& name, const String& value, bool first) {
+    String line = name + ": " + value + "\r\n";
+    if (first) _responseHeaders = line + _responseHeaders;
+    else _responseHeaders.concat(line);
+}
+
+void ESP8266WebServer::_writeHead(int code, const char* content_type, size_t contentLength) {
+    String head = String("HTTP/1.1 ") + String(code) + " " + responseCodeToString(code) + "\r\n";
+    if (content_type) head.concat(String("Content-Type: ") + content_type + "\r\n");
+    if (contentLength == CONTENT_LENGTH_UNKNOWN) {
+        _chunked = true;
+        head.concat("Transfer-Encoding: chunked\r\n");
+    } else {
+        head.concat(String("Content-Length: ") + String((unsigned long)contentLength) + "\r\n");
+    }
+    head.concat(_responseHeaders);
+    head.concat("Connection: close\r\n\r\n");
+    _client.write((const uint8_t*)head.c_str(), head.length());
+    _responseHeaders.clear();
+    _responded = true;
+}
+
+void ESP8266WebServer::send(int code, const char* content_type, const String& content) {
+    size_t len = _contentLength == CONTENT_LENGTH_NOT_SET ? content.length() : _contentLength;
+    _writeHead(code, content_type, len);
+    if (content.length()) sendContent(content.c_str(), content.length());
+}
+
+void ESP8266WebServer::sendContent(const char* content, size_t size) {
+    if (_chunked) {
+        char head[16];
+        int n = snprintf(head, sizeof(head), "%zx\r\n", size);
+        _client.write((const uint8_t*)head, (size_t)n);
+        if (size) _client.write((const uint8_t*)content, size);
+        _client.write((const uint8_t*)"\r\n", 2);
+        if (size == 0) _chunked = false;
+    } else if (size) {
+        _client.write((const uint8_t*)content, size);
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * Host stand-in: ESP8266WiFi (trạng thái ảo)
+ */
+
+#include <ESP8266WiFi.h>
+#include <host_env.h>
+
+ESP8266WiFiClass WiFi;
+
+static bool _linkUp = true;      // host_env: AP có "phát sóng" không
+static bool _associated = false;
+static int32_t _rssi = -55;
+static uint8_t _bssid[6] = { 0x02, 0x00, 0x5e, 0x10, 0x00, 0x01 };
+static int32_t _channel = 6;
+static String _ssid;
+static int8_t _scanResult = WIFI_SCAN_FAILED;
+static uint32_t _assocAt = 0;
+static bool _assocPending = false;
+static bool _assocFast = false;
+
+// Thời gian kết nối ảo (ms): LOCKER_WIFI_ASSOC_MS khi đã biết BSSID + kênh,
+// thêm LOCKER_WIFI_SCAN_MS khi phải quét. LOCKER_WIFI_CHANNEL: kênh thật của AP.
+static uint32_t envMs(const char* name, uint32_t fallback) {
+    const char* v = getenv(name);
+    return v ? (uint32_t)strtoul(v, nullptr, 10) : fallback;
+}
+
+void hostWiFiSetConnected(bool connected) {
+    bool wasUp = _linkUp;
+    _linkUp = connected;
+    if (!connected) {
+        if (_associated) _assocPending = false;
+        _associated = false;
+    } else if (!wasUp && _assocPending) {
+        // AP vừa lên lại: kết nối đang chờ cần thêm một lần quét/association
+        uint32_t delayMs = envMs("LOCKER_WIFI_ASSOC_MS", 300) + (_assocFast ? 0 : envMs("LOCKER_WIFI_SCAN_MS", 2500));
+        if ((int32_t)(millis() + delayMs - _assocAt) > 0) _assocAt = millis() + delayMs;
+    }
+}
+
+void hostWiFiSetRssi(int32_t rssi) { _rssi = rssi; }
+
+wl_status_t ESP8266WiFiClass::begin(const char* ssid, const char* pass, int32_t channel,
+                                    const uint8_t* bssid, bool connect) {
+    (void)pass;
+    _ssid = ssid ? ssid : "";
+    int32_t apChannel = (int32_t)envMs("LOCKER_WIFI_CHANNEL", 6);
+    _associated = false;
+    _assocPending = false;
+    if (!connect) return status();
+
+    // Như SDK: begin() tiếp tục thử tới khi AP xuất hiện (xem hostWiFiSetConnected)
+    _assocFast = channel > 0 && bssid;
+    if (_assocFast) {
+        // Đường nhanh chỉ thành công nếu AP vẫn ở kênh/BSSID đó
+        if (channel != apChannel || memcmp(bssid, _bssid, sizeof(_bssid)) != 0) return status();
+        _assocAt = millis() + envMs("LOCKER_WIFI_ASSOC_MS", 300);
+    } else {
+        _assocAt = millis() + envMs("LOCKER_WIFI_SCAN_MS", 2500) + envMs("LOCKER_WIFI_ASSOC_MS", 300);
+    }
+    _channel = apChannel;
+    _assocPending = true;
+    return status();
+}
+
+bool ESP8266WiFiClass::config(IPAddress, IPAddress, IPAddress, IPAddress, IPAddress) { return true; }
+
+bool ESP8266WiFiClass::disconnect(bool wifioff) {
+    (void)wifioff;
+    _associated = false;
+    _assocPending = false;
+    return true;
+}
+
+bool ESP8266WiFiClass::reconnect() {
+    _associated = _linkUp;
+    return true;
+}
+
+wl_status_t ESP8266WiFiClass::status() {
+    // LOCKER_WIFI_DROP_AT_MS / LOCKER_WIFI_DROP_FOR_MS: AP "khởi động lại" một lần
+    static uint32_t dropAt = envMs("LOCKER_WIFI_DROP_AT_MS", 0);
+    static uint32_t dropFor = envMs("LOCKER_WIFI_DROP_FOR_MS", 0);
+    if (dropAt) {
+        uint32_t now = millis();
+        if (now >= dropAt && now < dropAt + dropFor) {
+            if (_linkUp) hostWiFiSetConnected(false);
+        } else if (now >= dropAt + dropFor && !_linkUp) {
+            hostWiFiSetConnected(true);
+            dropAt = 0;
+        }
+    }
+    if (_assocPending && _linkUp && (int32_t)(millis() - _assocAt) >= 0) {
+        _assocPending = false;
+        _associated = true;
+    }
+    if (_associated && !_linkUp) _associated = false;
+    return _associated ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+IPAddress ESP8266WiFiClass::localIP() { return _associated ? IPAddress(127, 0, 0, 1) : IPAddress(); }
+IPAddress ESP8266WiFiClass::gatewayIP() { return IPAddress(127, 0, 0, 1); }
+IPAddress ESP8266WiFiClass::subnetMask() { return IPAddress(255, 0, 0, 0); }
+IPAddress ESP8266WiFiClass::dnsIP(uint8_t) { return IPAddress(127, 0, 0, 53); }
+String ESP8266WiFiClass::macAddress() { return String("02:00:5E:00:00:01"); }
+
+uint8_t* ESP8266WiFiClass::macAddress(uint8_t* mac) {
+    static const uint8_t m[6] = { 0x02, 0x00, 0x5e, 0x00, 0x00, 0x01 };
+    memcpy(mac, m, 6);
+    return mac;
+}
+
+String ESP8266WiFiClass::SSID() const { return _ssid; }
+uint8_t* ESP8266WiFiClass::BSSID() { return _bssid; }
+
+String ESP8266WiFiClass::BSSIDstr() {
+    char buf[18];
+    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X",
+             _bssid[0], _bssid[1], _bssid[2], _bssid[3], _bssid[4], _bssid[5]);
+    return String(buf);
+}
+
+int32_t ESP8266WiFiClass::channel() { return _channel; }
+int32_t ESP8266WiFiClass::RSSI() { return _associated ? _rssi : 31; }
+
+int8_t ESP8266WiFiClass::scanNetworks(bool async, bool, uint8_t, uint8_t*) {
+    _scanResult = _linkUp ? 1 : 0;
+    return async ? WIFI_SCAN_RUNNING : _scanResult;
+}
+
+int8_t ESP8266WiFiClass::scanComplete() { return _scanResult; }
+void ESP8266WiFiClass::scanDelete() { _scanResult = WIFI_SCAN_FAILED; }
+String ESP8266WiFiClass::SSID(uint8_t) { return _ssid; }
+int32_t ESP8266WiFiClass::RSSI(uint8_t) { return _rssi; }
+uint8_t* ESP8266WiFiClass::BSSID(uint8_t) { return _bssid; }
+int32_t ESP8266WiFiClass::channel(uint8_t) { return _channel; }
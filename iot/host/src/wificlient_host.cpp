@@ -0,0 +1,317 @@
+/**
+ * Host stand-in: WiFiClient / WiFiServer trên POSIX sockets
+ */
+
+#include <WiFiClient.h>
+#include <ESP8266WiFi.h>
+#include <host_env.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <linux/sockios.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static HostSocketHook _socketHook = nullptr;
+static void* _socketHookCtx = nullptr;
+
+void hostSetSocketHook(HostSocketHook hook, void* ctx) {
+    _socketHook = hook;
+    _socketHookCtx = ctx;
+}
+
+static void notifySocket(int fd, bool open) {
+    if (_socketHook && fd >= 0) _socketHook(fd, open, _socketHookCtx);
+}
+
+static void closeSocket(int fd) {
+    if (fd < 0) return;
+    notifySocket(fd, false);
+    ::close(fd);
+}
+
+struct HostSocket {
+    int fd = -1;
+    bool eof = false;
+
+    ~HostSocket() { close(); }
+    void close() {
+        closeSocket(fd);
+        fd = -1;
+    }
+};
+
+static void setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+static bool waitFd(int fd, short events, unsigned long timeoutMs) {
+    struct pollfd p = { fd, events, 0 };
+    return poll(&p, 1, (int)timeoutMs) > 0 && (p.revents & (events | POLLHUP | POLLERR));
+}
+
+// ============================================
+// WiFiClient
+// ============================================
+
+WiFiClient::WiFiClient() {}
+WiFiClient::~WiFiClient() {}
+
+WiFiClient::WiFiClient(int fd) : _sock(std::make_shared<HostSocket>()) {
+    _sock->fd = fd;
+    setNonBlocking(fd);
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+    return connect(ip.toString().c_str(), port);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    if (WiFi.status() != WL_CONNECTED) return 0;
+    stop();
+
+    struct addrinfo hints = {};
+    struct addrinfo* res = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    char portStr[8];
+    snprintf(portStr, sizeof(portStr), "%u", port);
+    if (getaddrinfo(host, portStr, &hints, &res) != 0 || !res) return 0;
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        freeaddrinfo(res);
+        return 0;
+    }
+    setNonBlocking(fd);
+    int rc = ::connect(fd, res->ai_addr, res->ai_addrlen);
+    freeaddrinfo(res);
+    if (rc < 0 && errno != EINPROGRESS) {
+        ::close(fd);
+        return 0;
+    }
+    if (rc < 0) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if (!waitFd(fd, POLLOUT, _timeout) ||
+            getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0 || err != 0) {
+            ::close(fd);
+            return 0;
+        }
+    }
+    _sock = std::make_shared<HostSocket>();
+    _sock->fd = fd;
+    notifySocket(fd, true);
+    setNoDelay(_nodelay);
+    return 1;
+}
+
+size_t WiFiClient::write(uint8_t c) { return write(&c, 1); }
+
+// Như lwIP ESP8266: dữ liệu chưa được ACK không vượt quá TCP_SND_BUF
+// (LOCKER_TCP_SNDBUF, mặc định 1072 = 2 x MSS 536); write() chặn tới khi
+// cửa sổ có chỗ, nên ghi một lượng lớn sẽ giữ caller như trên thiết bị
+static int tcpSndBuf() {
+    static const int sndBuf = getenv("LOCKER_TCP_SNDBUF") ? atoi(getenv("LOCKER_TCP_SNDBUF")) : 1072;
+    return sndBuf;
+}
+
+static int sendWindow(int fd) {
+    int queued = 0;
+    if (ioctl(fd, SIOCOUTQ, &queued) < 0) queued = 0;
+    return queued < tcpSndBuf() ? tcpSndBuf() - queued : 0;
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t size) {
+    if (!_sock || _sock->fd < 0) return 0;
+    size_t sent = 0;
+    unsigned long start = millis();
+    while (sent < size) {
+        size_t window = (size_t)sendWindow(_sock->fd);
+        if (window == 0) {
+            if (millis() - start >= _timeout) break;
+            usleep(200);
+            continue;
+        }
+        size_t chunk = size - sent < window ? size - sent : window;
+        ssize_t n = ::send(_sock->fd, buf + sent, chunk, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += (size_t)n;
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (millis() - start >= _timeout) break;
+            waitFd(_sock->fd, POLLOUT, 10);
+            continue;
+        }
+        _sock->eof = true;
+        break;
+    }
+    return sent;
+}
+
+// Chỗ trống của cửa sổ gửi (xem write())
+int WiFiClient::availableForWrite() {
+    if (!_sock || _sock->fd < 0) return 0;
+    if (!waitFd(_sock->fd, POLLOUT, 0)) return 0;
+    return sendWindow(_sock->fd);
+}
+
+int WiFiClient::available() {
+    if (!_sock || _sock->fd < 0) return 0;
+    int n = 0;
+    if (ioctl(_sock->fd, FIONREAD, &n) < 0) return 0;
+    if (n == 0 && !_sock->eof) {
+        char c;
+        ssize_t r = ::recv(_sock->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+        if (r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) _sock->eof = true;
+    }
+    // Như core: chưa có dữ liệu thì optimistic_yield(), vòng chờ bận vẫn nhường CPU
+    if (n == 0) yield();
+    return n;
+}
+
+int WiFiClient::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size) {
+    if (!_sock || _sock->fd < 0 || size == 0) return 0;
+    ssize_t n = ::recv(_sock->fd, buf, size, MSG_DONTWAIT);
+    if (n > 0) return (int)n;
+    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) _sock->eof = true;
+    return n == 0 ? 0 : -1;
+}
+
+int WiFiClient::peek() {
+    if (!_sock || _sock->fd < 0) return -1;
+    uint8_t c;
+    return ::recv(_sock->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? c : -1;
+}
+
+size_t WiFiClient::peekBytes(uint8_t* buf, size_t size) {
+    if (!_sock || _sock->fd < 0) return 0;
+    ssize_t n = ::recv(_sock->fd, buf, size, MSG_PEEK | MSG_DONTWAIT);
+    return n > 0 ? (size_t)n : 0;
+}
+
+void WiFiClient::stop() {
+    if (_sock) _sock->close();
+    _sock.reset();
+}
+
+uint8_t WiFiClient::connected() {
+    if (!_sock || _sock->fd < 0) return 0;
+    if (available() > 0) return 1;
+    return _sock->eof ? 0 : 1;
+}
+
+uint8_t WiFiClient::status() { return connected() ? ESTABLISHED : CLOSED; }
+
+void WiFiClient::setNoDelay(bool nodelay) {
+    _nodelay = nodelay;
+    if (!_sock || _sock->fd < 0) return;
+    int v = nodelay ? 1 : 0;
+    setsockopt(_sock->fd, IPPROTO_TCP, TCP_NODELAY, &v, sizeof(v));
+}
+
+void WiFiClient::keepAlive(uint16_t idle_sec, uint16_t intv_sec, uint8_t count) {
+    if (!_sock || _sock->fd < 0) return;
+    int on = idle_sec ? 1 : 0;
+    setsockopt(_sock->fd, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+    if (!on) return;
+    int idle = idle_sec, intv = intv_sec, cnt = count;
+    setsockopt(_sock->fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+    setsockopt(_sock->fd, IPPROTO_TCP, TCP_KEEPINTVL, &intv, sizeof(intv));
+    setsockopt(_sock->fd, IPPROTO_TCP, TCP_KEEPCNT, &cnt, sizeof(cnt));
+}
+
+static bool sockAddr(int fd, bool peer, struct sockaddr_in* sa) {
+    socklen_t len = sizeof(*sa);
+    return (peer ? getpeername(fd, (struct sockaddr*)sa, &len) : getsockname(fd, (struct sockaddr*)sa, &len)) == 0;
+}
+
+IPAddress WiFiClient::remoteIP() {
+    struct sockaddr_in sa;
+    return _sock && sockAddr(_sock->fd, true, &sa) ? IPAddress((uint32_t)sa.sin_addr.s_addr) : IPAddress();
+}
+
+uint16_t WiFiClient::remotePort() {
+    struct sockaddr_in sa;
+    return _sock && sockAddr(_sock->fd, true, &sa) ? ntohs(sa.sin_port) : 0;
+}
+
+IPAddress WiFiClient::localIP() {
+    struct sockaddr_in sa;
+    return _sock && sockAddr(_sock->fd, false, &sa) ? IPAddress((uint32_t)sa.sin_addr.s_addr) : IPAddress();
+}
+
+uint16_t WiFiClient::localPort() {
+    struct sockaddr_in sa;
+    return _sock && sockAddr(_sock->fd, false, &sa) ? ntohs(sa.sin_port) : 0;
+}
+
+void WiFiClient::stopAll() {}
+
+int WiFiClient::fd() const { return _sock ? _sock->fd : -1; }
+
+// ============================================
+// WiFiServer
+// ============================================
+
+WiFiServer::WiFiServer(uint16_t port) : _port(port) {}
+WiFiServer::~WiFiServer() { close(); }
+
+void WiFiServer::begin() {
+    close();
+    _fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (_fd < 0) return;
+    int one = 1;
+    setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(INADDR_ANY);
+    sa.sin_port = htons(_port);
+    if (bind(_fd, (struct sockaddr*)&sa, sizeof(sa)) < 0 || listen(_fd, 16) < 0) {
+        Serial.printf("[HOST] Cannot listen on port %u: %s\n", _port, strerror(errno));
+        ::close(_fd);
+        _fd = -1;
+        return;
+    }
+    if (_port == 0) {
+        socklen_t len = sizeof(sa);
+        getsockname(_fd, (struct sockaddr*)&sa, &len);
+        _port = ntohs(sa.sin_port);
+    }
+    setNonBlocking(_fd);
+    notifySocket(_fd, true);
+}
+
+bool WiFiServer::hasClient() {
+    if (_pending >= 0) return true;
+    if (_fd < 0) return false;
+    _pending = accept4(_fd, nullptr, nullptr, SOCK_CLOEXEC);
+    notifySocket(_pending, true);
+    return _pending >= 0;
+}
+
+WiFiClient WiFiServer::available() {
+    if (!hasClient()) return WiFiClient();
+    WiFiClient c(_pending);
+    _pending = -1;
+    c.setNoDelay(_nodelay);
+    return c;
+}
+
+void WiFiServer::close() {
+    closeSocket(_pending);
+    closeSocket(_fd);
+    _pending = _fd = -1;
+}
@@ -0,0 +1,67 @@
+/**
+ * Async HTTP Client Header
+ *
+ * HTTP client không chặn (non-blocking) để gọi Backend API từ loop().
+ * Request được gửi đi ngay, phản hồi được đọc dần mỗi lần gọi
+ * asyncHttpLoop() và trả về qua callback khi hoàn tất.
+ */
+
+#ifndef ASYNC_HTTP_H
+#define ASYNC_HTTP_H
+
+#include <Arduino.h>
+
+// ============================================
+// Callback
+// ============================================
+
+/**
+ * Callback khi request hoàn tất
+ * @param httpCode Mã HTTP (>0) hoặc mã lỗi HTTPC_ERROR_* (<0)
+ * @param body Nội dung phản hồi (null-terminated, chỉ hợp lệ trong callback)
+ * @param length Độ dài body
+ * @param ctx Con trỏ ngữ cảnh truyền vào khi tạo request
+ */
+typedef void (*AsyncHttpCallback)(int httpCode, const char* body, size_t length, void* ctx);
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Khởi tạo async HTTP client (parse BACKEND_URL)
+ */
+void initAsyncHttp();
+
+/**
+ * Gửi POST JSON tới backend mà không chờ phản hồi
+ * @param path Đường dẫn API, ví dụ "/api/iot/verify-pin"
+ * @param body JSON body
+ * @param callback Gọi khi có phản hồi, lỗi hoặc timeout
+ * @param ctx Con trỏ ngữ cảnh cho callback
+ * @return true nếu request đã được gửi, false nếu hết slot hoặc không kết nối được
+ */
+bool asyncHttpPost(const char* path, const String& body, AsyncHttpCallback callback, void* ctx);
+
+/**
+ * Đọc dữ liệu phản hồi, kiểm tra timeout và gọi callback
+ * Gọi trong mỗi vòng loop()
+ */
+void asyncHttpLoop();
+
+/**
+ * Có request nào vừa nhận dữ liệu hoặc bị đóng kết nối (cần asyncHttpLoop())
+ */
+bool asyncHttpReady();
+
+/**
+ * Số request đang chờ phản hồi
+ */
+uint8_t asyncHttpPending();
+
+/**
+ * Số request đã gửi lại do socket keep-alive bị backend đóng ngầm
+ */
+uint32_t asyncHttpRetried();
+
+#endif // ASYNC_HTTP_H
@@ -0,0 +1,73 @@
+/**
+ * Backend Connection Pool Header
+ *
+ * Giữ các kết nối HTTP/1.1 keep-alive tới BACKEND_URL để các request sau
+ * dùng lại socket thay vì bắt tay TCP mới mỗi lần. Dùng chung cho
+ * async_http (verify-pin, status outbox) và proxy auth.
+ */
+
+#ifndef BACKEND_POOL_H
+#define BACKEND_POOL_H
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Thống kê pool kết nối
+ */
+struct BackendPoolStats {
+    uint8_t open;           // Số socket đang mở (kể cả đang rảnh)
+    uint8_t inUse;          // Số socket đang được dùng
+    uint32_t acquired;      // Tổng số lần lấy kết nối
+    uint32_t reused;        // Số lần dùng lại socket keep-alive (hit)
+    uint32_t connects;      // Số lần bắt tay TCP mới (miss)
+    uint32_t stale;         // Số socket rảnh bị loại vì đã chết/hết hạn
+    uint32_t connectFailures;
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Khởi tạo pool, tách host/port từ BACKEND_URL
+ */
+void initBackendPool();
+
+/**
+ * Lấy một kết nối tới backend (dùng lại socket rảnh nếu còn sống)
+ * Khi phải mở socket mới, hàm chặn trong lúc tra DNS và bắt tay TCP (tối đa
+ * BACKEND_CONNECT_TIMEOUT), ghi vào stall watchdog dưới stage "backend-connect"
+ * @param reused Nếu khác nullptr: true khi socket được dùng lại
+ * @return Client đã kết nối hoặc nullptr nếu hết slot / không kết nối được
+ */
+WiFiClient* backendAcquire(bool* reused = nullptr);
+
+/**
+ * Trả kết nối về pool
+ * @param keepAlive true nếu phản hồi đã đọc hết và backend không yêu cầu đóng
+ */
+void backendRelease(WiFiClient* client, bool keepAlive);
+
+/**
+ * Đóng các socket rảnh đã chết hoặc quá BACKEND_KEEPALIVE_MS
+ * Gọi định kỳ (task của scheduler)
+ */
+void backendPoolMaintain();
+
+/**
+ * Host và port backend (dùng cho header Host)
+ */
+const char* backendHost();
+uint16_t backendPort();
+
+/**
+ * Lấy thống kê pool
+ */
+void backendPoolGetStats(BackendPoolStats& stats);
+
+#endif // BACKEND_POOL_H
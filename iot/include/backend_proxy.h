@@ -0,0 +1,51 @@
+/**
+ * Backend Proxy Header
+ *
+ * Chuyển tiếp request của kiosk tới backend và stream phản hồi về kiosk
+ * theo từng đoạn cố định (PROXY_BUFFER_SIZE), không giữ cả body trong
+ * String. Bộ nhớ đỉnh không phụ thuộc kích thước phản hồi.
+ */
+
+#ifndef BACKEND_PROXY_H
+#define BACKEND_PROXY_H
+
+#include <Arduino.h>
+#include "platform.h"
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Thống kê proxy
+ */
+struct ProxyStats {
+    uint32_t requests;      // Số request đã chuyển tiếp
+    uint32_t errors;        // Số lần lỗi (không kết nối được, timeout...)
+    uint32_t bytes;         // Tổng số byte body đã stream về kiosk
+    uint32_t maxBody;       // Body lớn nhất đã stream (byte)
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Chuyển tiếp request tới backend và stream phản hồi qua server
+ * @param server Web server đang xử lý request của kiosk
+ * @param method "GET", "POST" hoặc "PUT"
+ * @param path Đường dẫn API backend (ví dụ "/api/auth/email/send-otp")
+ * @param body Body JSON gửi đi (có thể rỗng)
+ * @param auth Giá trị header Authorization (có thể rỗng)
+ * @return true nếu đã gửi phản hồi cho kiosk, false nếu chưa gửi gì
+ *         (người gọi tự trả lỗi 502)
+ */
+bool proxyStream(ESP8266WebServer& server, const char* method, const char* path,
+                 const String& body, const String& auth);
+
+/**
+ * Lấy thống kê proxy
+ */
+void proxyGetStats(ProxyStats& stats);
+
+#endif // BACKEND_PROXY_H
@@ -0,0 +1,56 @@
+/**
+ * Command Dedup Header
+ *
+ * Nhớ các lệnh MQTT vừa thực hiện (theo cmd_id, hoặc seq nếu không có
+ * cmd_id) trong một vòng đệm cố định CMD_DEDUP_SIZE phần tử kèm bảng băm
+ * để tra O(1). Broker gửi lại hoặc backend retry cùng một lệnh trong
+ * CMD_DEDUP_WINDOW thì chỉ được xác nhận lại, không mở relay lần nữa.
+ */
+
+#ifndef COMMAND_DEDUP_H
+#define COMMAND_DEDUP_H
+
+#include <Arduino.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Số liệu dedup
+ */
+struct CommandDedupStats {
+    uint8_t tracked;        // Lệnh đang được nhớ
+    uint32_t executed;      // Lệnh có ID được thực hiện
+    uint32_t duplicates;    // Lệnh trùng bị bỏ qua
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Xoá vòng đệm và bảng băm
+ */
+void initCommandDedup();
+
+/**
+ * Kiểm tra lệnh đã thực hiện chưa; chưa thì ghi nhớ
+ * @param cmdId ID lệnh do backend sinh (nullptr/rỗng = dùng seq)
+ * @param seq Số thứ tự lệnh (0 = không có)
+ * @return true nếu là lệnh trùng (không được thực hiện lại)
+ */
+bool commandSeen(const char* cmdId, uint32_t seq);
+
+/**
+ * Bỏ ghi nhớ lệnh vừa được commandSeen() nhận nhưng không thực hiện được
+ * (lõi actuation bận), để lần retry của backend được thực hiện thật
+ */
+void commandForget(const char* cmdId, uint32_t seq);
+
+/**
+ * Lấy số liệu dedup
+ */
+void commandDedupGetStats(CommandDedupStats& stats);
+
+#endif // COMMAND_DEDUP_H
@@ -15,39 +15,219 @@
 #define WIFI_SSID "Thai Binh"              // Thay bằng tên WiFi của bạn
 #define WIFI_PASSWORD "thaibinh7704"      // Thay bằng mật khẩu WiFi
 
+// Kết nối nhanh: BSSID/kênh/IP lần trước được lưu trong RTC memory và flash
+#define WIFI_FAST_TIMEOUT 3000            // Chờ kết nối nhanh (BSSID + kênh đã lưu) trước khi quét đầy đủ (ms)
+#define WIFI_CONNECT_TIMEOUT 15000        // Chờ kết nối có quét đầy đủ (ms)
+#define WIFI_POLL_INTERVAL 100            // Kiểm tra trạng thái WiFi mỗi 100 ms
+#define WIFI_REUSE_LEASE true             // Dùng lại IP DHCP lần trước (bỏ qua DHCP khi kết nối nhanh)
+#define WIFI_STATIC_IP ""                 // IP tĩnh (để trống = DHCP), ví dụ "192.168.1.50"
+#define WIFI_STATIC_GATEWAY "192.168.1.1"
+#define WIFI_STATIC_SUBNET "255.255.255.0"
+#define WIFI_STATIC_DNS "192.168.1.1"
+#define WIFI_RTC_OFFSET 32                // Block RTC (4 byte) lưu cache; 32 block đầu dành cho OTA
+#define WIFI_EEPROM_ADDR 0                // Địa chỉ cache trong EEPROM (flash)
+#define EEPROM_SIZE 64                    // Kích thước vùng EEPROM dùng (byte)
+
 // ============================================
 // Backend API Configuration
 // ============================================
+#ifndef BACKEND_URL  // build_flags có thể ghi đè (env:native)
 #define BACKEND_URL "http://192.168.1.10:8080"  // IP của máy chạy backend Docker
+#endif
 #define HTTP_TIMEOUT 10000  // Timeout 10 giây
+#define BACKEND_CONNECT_TIMEOUT 2000  // Timeout bắt tay TCP tới backend (ms); loop() bị chặn tới mức này khi mở socket mới
+#define ASYNC_HTTP_SLOTS 3            // Số request backend chạy song song
+#define ASYNC_HTTP_BUFFER_SIZE 1024   // Buffer phản hồi cho mỗi request (byte)
+#define VERIFY_MAX_PENDING 2          // Số request kiosk verify-pin chờ đồng thời
+#define BACKEND_POOL_SIZE 4           // Socket keep-alive tới backend (async slots + proxy)
+#define BACKEND_KEEPALIVE_MS 15000    // Đóng socket rảnh sau thời gian này (< keep-alive timeout của backend)
+#define BACKEND_POOL_CHECK_INTERVAL 5000  // Kiểm tra socket rảnh mỗi 5 giây
+#define PROXY_BUFFER_SIZE 512         // Buffer stream body proxy backend -> kiosk (byte)
+#define PROXY_LINE_SIZE 256           // Buffer đọc một dòng header phản hồi proxy
+
+// ============================================
+// PROGMEM Streaming (trang kiosk, asset tĩnh)
+// ============================================
+#define STREAM_MAX_CLIENTS 2           // Số response PROGMEM gửi nền đồng thời
+#define STREAM_BLOCK_SIZE 1072         // Ghi tối đa mỗi lượt loop (= TCP_SND_BUF của lwIP low-memory, 2 x MSS 536)
+#define STREAM_TIMEOUT 10000           // Huỷ nếu client không nhận thêm dữ liệu trong 10 giây
+
+// ============================================
+// Status Outbox (báo cáo trạng thái nền)
+// ============================================
+#define OUTBOX_MAX_BOXES BOX_COUNT     // Số box outbox theo dõi (mỗi box một entry)
+#define OUTBOX_COALESCE_MS 20          // Chờ gộp các thay đổi liên tiếp trước khi gửi (ms)
+#define OUTBOX_RETRY_MIN_MS 1000       // Backoff ban đầu khi gửi lỗi (ms)
+#define OUTBOX_RETRY_MAX_MS 60000      // Backoff tối đa (ms)
+#define OUTBOX_HEARTBEAT_MIN_MS 60000     // Gửi lại trạng thái khi không có thay đổi: lần đầu sau 1 phút...
+#define OUTBOX_HEARTBEAT_MAX_MS 1800000   // ...rồi gấp đôi mỗi lần tới tối đa 30 phút (có thay đổi thì về lại 1 phút)
+
+// ============================================
+// Event Journal (nhật ký mở/khóa/nút nhấn trong flash, gửi lại theo lô)
+// ============================================
+#if defined(ESP32)
+#define JOURNAL_FLASH_ADDR 0x3E8000    // ESP32 (partition mặc định 4 MB): 8 sector cuối partition spiffs
+#else
+#define JOURNAL_FLASH_ADDR 0x3F2000    // Đầu vùng journal: 8 sector cuối vùng FS của layout 4 MB (firmware không dùng LittleFS)
+#endif
+#define JOURNAL_SECTORS 8              // Số sector 4 KB xoay vòng (256 bản ghi 16 byte mỗi sector)
+#define JOURNAL_BATCH_SIZE 32          // Số sự kiện tối đa mỗi lô gửi backend
+#define JOURNAL_MAINTAIN_INTERVAL 1000 // Xoá trước sector kế tiếp, gửi lô khi có WiFi (ms)
+#define JOURNAL_RETRY_MS 10000         // Chờ trước khi gửi lại lô bị lỗi (ms)
+
+// ============================================
+// Telemetry (lấy mẫu định kỳ, gửi theo lô; đổi trạng thái vẫn gửi ngay qua outbox)
+// ============================================
+#define TELEMETRY_SAMPLE_INTERVAL 30000   // Lấy mẫu trạng thái, RSSI, heap, loop mỗi 30 giây
+#define TELEMETRY_RING_SIZE 20            // Số mẫu giữ trong RAM (24 byte/mẫu, tối đa 255); đầy thì gửi ngay
+#define TELEMETRY_FLUSH_INTERVAL 600000   // Gửi lô mỗi 10 phút (MQTT, hoặc HTTP nếu MQTT mất kết nối)
+#define TELEMETRY_BUFFER_SIZE 1024        // Buffer serialize một lô (byte)
+
+// ============================================
+// PIN Cache (xác thực PIN cục bộ, backend gửi trước qua MQTT)
+// ============================================
+#define PIN_CACHE_SIZE 16              // Số đơn giữ PIN cục bộ (~60 byte RAM mỗi đơn)
+#define PIN_SALT_SIZE 16               // Độ dài salt (byte), hash = SHA-256(salt || PIN)
+#define PIN_CACHE_MAX_TTL 604800       // Thời hạn tối đa một bản ghi: 7 ngày (giây)
+#define PIN_CACHE_MAINTAIN_INTERVAL 5000  // Dọn bản ghi hết hạn, gửi lại báo cáo PIN đã dùng mỗi 5 giây
+#define MQTT_BUFFER_SIZE 512           // Buffer gói MQTT (lệnh PIN_PROVISION dài hơn 256 byte mặc định)
+
+// ============================================
+// Command Dedup (lệnh MQTT có cmd_id/seq)
+// ============================================
+#define CMD_DEDUP_SIZE 32              // Số lệnh gần nhất được nhớ (vòng đệm, tối đa 254)
+#define CMD_DEDUP_BUCKETS 64           // Số bucket bảng băm (lũy thừa của 2)
+#define CMD_DEDUP_WINDOW 600000        // Lệnh trùng trong 10 phút chỉ được xác nhận lại, không thực hiện
+#define CMD_ID_MAX_LEN 64              // Độ dài cmd_id tối đa (chữ, số, - _ . :)
+
+// ============================================
+// Latency Trace (lệnh MQTT OPEN/LOCK)
+// ============================================
+#define TRACE_COMMANDS true            // Trả lời UNLOCKED/LOCKED kèm "trace": mốc thời gian từng giai đoạn
+#define NTP_SERVER "pool.ntp.org"      // Đồng bộ giờ: mốc nhận lệnh so được với giờ backend
+#define NTP_VALID_AFTER 1600000000     // time() lớn hơn mốc này = đã đồng bộ NTP
+
+// ============================================
+// PIN Guard (chặn nhập sai PIN lặp lại, không gọi backend)
+// ============================================
+#define PIN_NEG_CACHE_SIZE 16          // Số PIN sai gần đây được nhớ
+#define PIN_NEG_CACHE_TTL 60000        // Nhớ PIN sai trong 60 giây (đơn mới tạo có PIN hợp lệ sau tối đa 1 phút)
+#define PIN_RATE_MAX_SOURCES 8         // Số IP nguồn theo dõi
+#define PIN_RATE_SOURCE_BURST 5        // Mỗi IP: nhập sai liên tiếp tối đa 5 lần...
+#define PIN_RATE_SOURCE_REFILL_MS 12000  // ...rồi hồi 1 lượt mỗi 12 giây (5 lần/phút)
+#define PIN_RATE_BOX_BURST 8           // Mỗi box: nhập sai tối đa 8 lần (mọi IP cộng lại)...
+#define PIN_RATE_BOX_REFILL_MS 15000   // ...rồi hồi 1 lượt mỗi 15 giây
 
 // ============================================
 // Box/Device Configuration
 // ============================================
-#define BOX_ID 1                                // ID của box mà ESP8266 này điều khiển
+#define BOX_ID 1                                // ID box đầu tiên mà ESP8266 này điều khiển
+#define BOX_COUNT 1                             // Số box điều khiển, ID liên tiếp BOX_ID .. BOX_ID + BOX_COUNT - 1
 #define LOCKER_ID 1                             // ID của locker chứa box này
+#ifndef DEVICE_ID
 #define DEVICE_ID "ESP8266_LOCKER_01"           // ID định danh của thiết bị
+#endif
 
 // ============================================
 // GPIO Pin Configuration (ESP8266 NodeMCU)
 // ============================================
 // NodeMCU GPIO mapping: D0=16, D1=5, D2=4, D3=0, D4=2, D5=14, D6=12, D7=13, D8=15
-#define RELAY_PIN 5         // D1 (GPIO5) - Điều khiển Relay
+#define RELAY_PIN 5         // D1 (GPIO5) - Điều khiển Relay (box đầu tiên)
 #define BUTTON_PIN 4        // D2 (GPIO4) - Nút nhấn toggle
 #define LED_STATUS 2        // D4 (GPIO2) - LED trạng thái (built-in LED, active LOW)
+#if defined(ESP32)
+#define LED_ACTIVE_LOW false     // ESP32 DevKit: LED GPIO2 sáng khi HIGH (các chân khác giữ cùng số GPIO)
+#else
+#define LED_ACTIVE_LOW true
+#endif
+#define DOOR_NO_SENSOR 0xFF
+#define DOOR_SENSOR_PINS { DOOR_NO_SENSOR }  // Công tắc từ (reed) cửa theo thứ tự box (BOX_COUNT phần tử), nối GND;
+                                 // mặc định không có. Đã lắp reed ở D5 thì đặt { 14 } (GPIO14; 74HC595/PCF8574
+                                 // dùng D5: chọn chân khác, trừ GPIO16 không có ngắt). Chân thả nổi đọc là "mở"
+#define DOOR_OPEN_LEVEL HIGH     // Mức khi cửa mở (pull-up: nam châm rời xa, reed hở; rút dây cũng đọc là mở)
 
 // ============================================
 // Timing Configuration
 // ============================================
 #define UNLOCK_DURATION 5000        // Thời gian mở khóa (ms): 5 giây
-#define STATUS_REPORT_INTERVAL 30000   // Gửi status lên backend mỗi 30 giây
-#define WIFI_RECONNECT_INTERVAL 10000  // Thử kết nối lại WiFi sau 10 giây
+#define WIFI_RECONNECT_INTERVAL 10000  // Chờ trước khi thử lại sau khi kết nối WiFi thất bại
 #define BUTTON_DEBOUNCE_TIME 200       // Debounce cho nút nhấn (ms)
+#define DOOR_DEBOUNCE_TIME 20          // Debounce cạnh cho công tắc cửa (ms)
+#define DOOR_SETTLE_MS 200             // Cửa phải giữ trạng thái mới chừng này mới tính là mở/đóng (lọc rung)
+
+// ============================================
+// Input Events (GPIO interrupt)
+// ============================================
+#define MAX_INPUTS 4                   // Số input dùng ngắt (nút nhấn, công tắc cửa...)
+#define INPUT_QUEUE_SIZE 32            // Hàng đợi cạnh ISR -> loop (lũy thừa của 2)
+
+// ============================================
+// Scheduler Configuration (timer wheel)
+// ============================================
+#define SCHED_MAX_TASKS 12             // Số task tối đa (định kỳ + một lần)
+#define SCHED_WHEEL_SLOTS 32           // Số ô của timer wheel (lũy thừa của 2)
+#define SCHED_TICK_MS 10               // Độ phân giải mỗi ô (ms)
+#ifndef SCHED_MAX_IDLE_MS
+#define SCHED_MAX_IDLE_MS 50           // Ngủ tối đa mỗi vòng loop khi rảnh (ms)
+#endif
+#define SCHED_LATE_THRESHOLD_MS 20     // Task chạy muộn hơn ngưỡng này được tính là trễ
+
+// ============================================
+// Dual Core (ESP32: mạng và relay/timer/input trên hai lõi)
+// ============================================
+#ifndef LOCKER_DUAL_CORE  // build_flags có thể ghi đè (env:native_dual)
+#if defined(ESP32)
+#define LOCKER_DUAL_CORE 1             // Tách task mạng / task actuation, mỗi task ghim một lõi
+#else
+#define LOCKER_DUAL_CORE 0             // ESP8266: một loop() như cũ
+#endif
+#endif
+#define NETWORK_CORE 0                 // Lõi chạy HTTP server, MQTT, backend (cùng lõi với WiFi stack của ESP32)
+#define ACTUATION_CORE 1               // Lõi chạy relay, auto-lock, nút nhấn, cảm biến cửa
+#define NETWORK_TASK_STACK 12288       // Stack task mạng (byte, như loopTask 8 KB + /status, TLS dự phòng)
+#define ACTUATION_TASK_STACK 4096      // Stack task actuation (byte)
+#define NETWORK_TASK_PRIORITY 1        // Như loopTask của Arduino
+#define ACTUATION_TASK_PRIORITY 2      // Cao hơn task mạng: lệnh relay không phải chờ
+#define ACTUATOR_QUEUE_SIZE 16         // Hàng đợi lệnh mạng -> actuation (lũy thừa của 2)
+#define ACTUATOR_EVENT_QUEUE_SIZE 32   // Hàng đợi kết quả/nhật ký/trạng thái actuation -> mạng (lũy thừa của 2,
+                                       // lớn hơn ACTUATOR_QUEUE_SIZE: chừng ấy chỗ dành cho kết quả lệnh)
+#define ACTUATOR_BACKLOG_SIZE 128      // Nhật ký/trạng thái chờ trên lõi actuation khi lõi mạng chậm (20 byte/phần tử)
+#define ACTUATION_POLL_MS 2            // Task actuation quét input ít nhất mỗi 2 ms (lệnh đánh thức ngay)
+
+// ============================================
+// Loop Metrics (/metrics)
+// ============================================
+#define METRICS_BUCKETS 18             // Bucket histogram: <=64us, <=128us ... <=4.2s, +Inf
+#define METRICS_FIRST_BUCKET_LOG2 6    // Bucket đầu tiên: <= 2^6 = 64 µs
+#define METRICS_PART_SIZE 2048         // Buffer dựng từng phần trang /metrics (byte)
+
+// ============================================
+// Heap Monitor
+// ============================================
+#define HEAP_MAX_SITES 16              // Số call site (handler, lệnh MQTT) được theo dõi
+#define HEAP_SCOPE_DEPTH 4             // Độ sâu scope lồng nhau tối đa
+#define HEAP_TOP_SITES 3               // Số site cấp phát nhiều nhất hiển thị ở /status
+#define HEAP_SAMPLE_INTERVAL 1000      // Lấy mẫu low-water mỗi 1 giây
+
+// ============================================
+// Stall Watchdog (stage của loop() chạy quá lâu)
+// ============================================
+#define STALL_BUDGET_MS 1000           // Stage chạy lâu hơn ngưỡng này bị ghi là stall
+#define STALL_CHECK_INTERVAL 100       // Timer kiểm tra stage đang chạy (ms, chạy khi stage nhường CPU)
+#define STALL_RECORDS 4                // Số stall lâu nhất giữ trong RTC chờ báo cáo
+#define STALL_STACK_DEPTH 8            // Số địa chỉ code trong ảnh chụp stack
+#define STALL_RTC_OFFSET 48            // Block RTC lưu bản ghi (80 block, tới hết RTC); cache WiFi dùng 32..40
+#define STALL_REPORT_INTERVAL 5000     // Gửi báo cáo stall khi có MQTT (ms)
+#define STALL_RESET_MS 0               // > 0: stage treo quá ngưỡng này thì để WDT phần cứng reset chip (0 = tắt)
 
 // ============================================
 // HTTP Server Configuration (ESP8266 Server)
 // ============================================
 #define SERVER_PORT 80  // Port cho HTTP server trên ESP8266
+// Trang kiosk: "no-cache" = tablet giữ bản cũ nhưng hỏi lại mỗi lần tải (304 nếu
+// không đổi, UI mới có hiệu lực ngay sau khi nạp firmware). Có thể đặt
+// "public, max-age=86400" để bỏ cả request 304, đổi lại UI mới chậm tới 1 ngày
+#define WEB_UI_CACHE_CONTROL "no-cache"
 
 // ============================================
 // Relay Logic
@@ -56,11 +236,29 @@
 // Thay đổi nếu relay của bạn hoạt động khác
 #define RELAY_ACTIVE_LOW false  // Thử đổi thành false nếu relay không hoạt động
 
+// Driver relay cho bảng box (xem relay_driver.h)
+#define RELAY_DRIVER_GPIO 0      // Mỗi relay một chân GPIO
+#define RELAY_DRIVER_74HC595 1   // Thanh ghi dịch 74HC595 nối chuỗi, 8 relay/IC
+#define RELAY_DRIVER_PCF8574 2   // IC mở rộng I2C PCF8574, 8 relay/IC
+#define RELAY_DRIVER RELAY_DRIVER_GPIO
+
+#define RELAY_PINS { RELAY_PIN }  // GPIO driver: chân relay theo thứ tự box (BOX_COUNT phần tử)
+#define SHIFT_DATA_PIN 13        // D7 (GPIO13) - 74HC595 DS
+#define SHIFT_CLOCK_PIN 14       // D5 (GPIO14) - 74HC595 SHCP
+#define SHIFT_LATCH_PIN 12       // D6 (GPIO12) - 74HC595 STCP
+#define I2C_SDA_PIN 12           // D6 (GPIO12) - PCF8574 SDA
+#define I2C_SCL_PIN 14           // D5 (GPIO14) - PCF8574 SCL
+#define PCF8574_ADDRESS 0x20     // Địa chỉ IC đầu tiên (các IC sau: +1, +2...)
+
 // ============================================
 // MQTT Configuration
 // ============================================
+#ifndef MQTT_BROKER
 #define MQTT_BROKER "broker.hivemq.com"      // MQTT Broker (thay bằng broker riêng nếu có)
+#endif
+#ifndef MQTT_PORT
 #define MQTT_PORT 1883                        // MQTT Port
+#endif
 #define MQTT_USER ""                          // Username (để trống nếu public broker)
 #define MQTT_PASSWORD ""                      // Password (để trống nếu public broker)
 
@@ -71,4 +269,12 @@
 #define MQTT_TOPIC_STATUS "locker/status/" DEVICE_ID
 #define MQTT_RECONNECT_INTERVAL 5000          // Thử kết nối lại MQTT sau 5 giây
 
+// MessagePack: lệnh gửi tới topic có hậu tố /mp được parse dạng MessagePack và
+// mọi bản tin trạng thái sau đó gửi dạng MessagePack lên status topic + /mp.
+// Lệnh JSON trên topic thường đưa thiết bị về JSON (mặc định khi khởi động)
+#define MQTT_MSGPACK_ENABLED true             // false = chỉ JSON, không subscribe topic /mp
+#define MQTT_MSGPACK_SUFFIX "/mp"
+#define MQTT_TOPIC_CMD_MSGPACK MQTT_TOPIC_CMD MQTT_MSGPACK_SUFFIX
+#define MQTT_TOPIC_STATUS_MSGPACK MQTT_TOPIC_STATUS MQTT_MSGPACK_SUFFIX
+
 #endif // CONFIG_H
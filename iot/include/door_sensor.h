@@ -0,0 +1,56 @@
+/**
+ * Door Sensor Header
+ *
+ * Công tắc từ (reed) cửa của từng box, đọc qua input_events (ngắt CHANGE,
+ * chống dội cạnh) rồi qua máy trạng thái lọc rung: mức mới phải giữ nguyên
+ * DOOR_SETTLE_MS. Mỗi lần cửa thật sự đổi trạng thái (mở <-> đóng) trạng
+ * thái box được đưa vào outbox ngay kèm isDoorOpen thật, thay vì đoán theo
+ * relay; khi không có gì thay đổi, outbox chỉ gửi heartbeat thưa dần.
+ */
+
+#ifndef DOOR_SENSOR_H
+#define DOOR_SENSOR_H
+
+#include <Arduino.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Số liệu cảm biến cửa
+ */
+struct DoorStats {
+    uint8_t sensors;        // Số box có cảm biến
+    uint8_t open;           // Số cửa đang mở
+    uint32_t transitions;   // Số lần cửa đổi trạng thái
+    uint32_t forced;        // Số lần cửa mở khi box đang khóa (cạy cửa / khóa hỏng)
+    uint32_t glitches;      // Số lần đổi mức không giữ đủ DOOR_SETTLE_MS (rung, nhiễu)
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Đăng ký các công tắc cửa (DOOR_SENSOR_PINS) với input_events
+ * Gọi sau initInputEvents() và initLockerController()
+ */
+void initDoorSensors();
+
+/**
+ * Box có cảm biến cửa không
+ */
+bool doorHasSensor(int boxId);
+
+/**
+ * Cửa đang mở (theo cảm biến, sau debounce)
+ */
+bool doorIsOpen(int boxId);
+
+/**
+ * Lấy số liệu cảm biến cửa
+ */
+void doorGetStats(DoorStats& stats);
+
+#endif // DOOR_SENSOR_H
@@ -0,0 +1,170 @@
+/**
+ * Dual Core Header
+ *
+ * Bản build ESP32 (LOCKER_DUAL_CORE): thay cho một loop() duy nhất, setup()
+ * tạo hai task FreeRTOS, mỗi task ghim một lõi:
+ * - Task actuation (ACTUATION_CORE): relay, auto-lock, nút nhấn, cảm biến cửa
+ * - Task mạng (NETWORK_CORE): HTTP server, MQTT, backend, outbox, journal...
+ * Mỗi task có timer wheel riêng (scheduler.h). Việc cần làm trên lõi kia đi
+ * qua hai hàng đợi SPSC (spsc_queue.h):
+ * - Lệnh (mạng -> actuation): mở/khóa box, kèm callback chạy trên lõi mạng
+ *   sau khi relay đã được ghi (trả lời lệnh MQTT kèm mốc relay thật)
+ * - Sự kiện (actuation -> mạng): kết quả lệnh, bản ghi journal, trạng thái
+ *   box cần báo về backend. Lõi mạng chậm thì journal/trạng thái chờ trong
+ *   backlog của lõi actuation; kết quả lệnh luôn có chỗ
+ * Nhờ vậy độ trễ relay, auto-lock và nút nhấn không còn phụ thuộc các stage
+ * mạng bị treo (connect MQTT, DNS, backend chậm).
+ *
+ * unlockBox()/lockBox() gọi từ lõi mạng, journalAppend()/reportBoxStatus()
+ * gọi từ lõi actuation tự chuyển qua hàng đợi, nên phần lớn module không
+ * cần biết mình chạy trên lõi nào.
+ *
+ * Dữ liệu dùng chung ngoài hai hàng đợi chỉ là trạng thái lõi actuation công
+ * bố cho lõi mạng đọc (/status, telemetry): box đang mở và hạn tự khóa, cửa
+ * mở/đóng, mốc relay, số đếm của input và cảm biến cửa. Mỗi giá trị một
+ * biến CoreShared, chỉ lõi actuation ghi. Histogram loop_metrics của stage
+ * button/auto_lock cũng do lõi actuation ghi (một writer mỗi stage).
+ *
+ * Giới hạn còn lại: ghi/xoá flash (journal, cache WiFi trong EEPROM) chạy
+ * trên lõi mạng nhưng tắt cache flash của cả chip và tạm dừng lõi kia. Code
+ * relay/timer nằm trong flash (không IRAM) nên task actuation đứng tới khi
+ * thao tác xong: xoá một sector mất vài chục ms, ghi một bản ghi vài chục µs.
+ * Mỗi lần như vậy được đếm trong flashStalls/maxFlashUs (dualCoreFlashDone).
+ */
+
+#ifndef DUAL_CORE_H
+#define DUAL_CORE_H
+
+#include <Arduino.h>
+#include "config.h"
+#if LOCKER_DUAL_CORE
+#include <atomic>
+#endif
+#include "locker_controller.h"
+#include "event_journal.h"
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Lệnh cho lõi actuation
+ */
+enum ActuatorAction : uint8_t {
+    ACTUATOR_UNLOCK,
+    ACTUATOR_LOCK
+};
+
+/**
+ * Callback chạy trên lõi mạng khi lõi actuation đã thực hiện lệnh
+ * @param ok false nếu boxId không hợp lệ
+ * @param relayUs micros() ngay sau khi ghi relay
+ */
+typedef void (*ActuatorDone)(int boxId, ActuatorAction action, bool ok, uint32_t relayUs, void* ctx);
+
+/**
+ * Biến lõi actuation ghi và lõi mạng đọc: atomic trên bản build hai lõi,
+ * biến thường trên ESP8266 (một lõi)
+ */
+#if LOCKER_DUAL_CORE
+template <typename T> using CoreShared = std::atomic<T>;
+#else
+template <typename T> using CoreShared = T;
+#endif
+
+/**
+ * Hàm setup/loop của một task
+ */
+typedef void (*CoreFunction)();
+
+/**
+ * Số liệu hai lõi
+ */
+struct DualCoreStats {
+    uint32_t commands;      // Lệnh lõi actuation đã thực hiện
+    uint32_t events;        // Sự kiện lõi mạng đã xử lý
+    uint32_t rejected;      // Lệnh bị từ chối do hàng đợi lệnh đầy
+    uint32_t deferred;      // Journal/trạng thái phải chờ trong backlog (lõi mạng chậm)
+    uint16_t backlog;       // ...đang chờ
+    uint32_t dropped;       // Sự kiện mất do backlog cũng đầy
+    uint32_t lastQueueUs;   // Thời gian lệnh gần nhất nằm trong hàng đợi
+    uint32_t maxQueueUs;    // ...lớn nhất
+    uint32_t actuationLoops;  // Số vòng của task actuation
+    uint32_t flashStalls;   // Lần ghi/xoá flash từ lõi mạng (lõi actuation bị dừng)
+    uint32_t maxFlashUs;    // ...lâu nhất
+};
+
+#if LOCKER_DUAL_CORE
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Tạo task actuation (chạy actuationSetup trên lõi của nó, rồi actuationLoop
+ * mãi mãi) và task mạng (chờ actuationSetup xong, chạy networkSetup rồi
+ * networkLoop mãi mãi). Gọi cuối setup(); loop() sau đó không còn việc gì
+ */
+void dualCoreStart(CoreFunction actuationSetup, CoreFunction actuationLoop,
+                   CoreFunction networkSetup, CoreFunction networkLoop);
+
+/**
+ * Đang chạy trong task actuation không
+ */
+bool onActuationCore();
+
+/**
+ * Lõi mạng: gửi lệnh sang lõi actuation (không chặn)
+ * @param done Callback chạy trên lõi mạng sau khi relay đã ghi (có thể null)
+ * @return false nếu hàng đợi lệnh đầy (hoặc đã có ACTUATOR_QUEUE_SIZE lệnh có
+ *         callback đang chờ lõi mạng xử lý kết quả)
+ */
+bool actuatorSubmit(ActuatorAction action, int boxId, ActuatorDone done = nullptr, void* ctx = nullptr);
+
+/**
+ * Lõi actuation: thực hiện các lệnh đang chờ
+ */
+void actuatorRun();
+
+/**
+ * Lõi actuation: ngủ tối đa maxMs, thức dậy ngay khi có lệnh mới
+ */
+void actuatorIdle(uint32_t maxMs);
+
+/**
+ * Lõi actuation: chuyển bản ghi journal sang lõi mạng (flash + replay)
+ * @return false nếu cả hàng đợi và backlog đều đầy (bản ghi mất)
+ */
+bool actuatorPostJournal(JournalEvent event, int boxId, uint32_t uptimeMs);
+
+/**
+ * Lõi actuation: chuyển trạng thái box sang lõi mạng (outbox)
+ * @return false nếu cả hàng đợi và backlog đều đầy
+ */
+bool actuatorPostStatus(int boxId, BoxStatus status, bool isDoorOpen);
+
+/**
+ * Lõi mạng: xử lý sự kiện từ lõi actuation (callback lệnh, journal, outbox)
+ * Gọi trong mỗi vòng loop mạng
+ */
+void actuatorEventsPoll();
+
+/**
+ * Lõi mạng: có sự kiện đang chờ không (thoát khỏi schedulerIdle)
+ */
+bool actuatorEventsPending();
+
+/**
+ * Lõi mạng: vừa ghi/xoá flash xong, ghi nhận khoảng lõi actuation bị dừng
+ * @param startUs micros() ngay trước thao tác flash
+ */
+void dualCoreFlashDone(uint32_t startUs);
+
+/**
+ * Lấy số liệu hai lõi
+ */
+void dualCoreGetStats(DualCoreStats& stats);
+
+#endif // LOCKER_DUAL_CORE
+
+#endif // DUAL_CORE_H
@@ -0,0 +1,77 @@
+/**
+ * Event Journal Header
+ *
+ * Nhật ký chỉ-ghi-thêm (append-only) các sự kiện mở/khóa box, nút nhấn và
+ * cảm biến cửa trong flash, còn nguyên khi mất WiFi/broker, reset hay mất
+ * điện. Mỗi sự kiện là một bản ghi nhị phân 16 byte có CRC; các sector được
+ * ghi xoay vòng nên mỗi sector bị xoá như nhau (wear levelling).
+ *
+ * journalAppend() chỉ ghi một bản ghi vào ô đã xoá sẵn (thời gian cố định,
+ * không xoá sector, không gọi mạng) nên không làm chậm đường relay. Việc
+ * xoá trước sector kế tiếp và gửi lại nhật ký về backend theo lô
+ * (POST /api/iot/events) do journalMaintain() đảm nhiệm.
+ */
+
+#ifndef EVENT_JOURNAL_H
+#define EVENT_JOURNAL_H
+
+#include <Arduino.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Loại sự kiện
+ */
+enum JournalEvent : uint8_t {
+    JOURNAL_UNLOCK = 1,     // Relay mở (unlockBox)
+    JOURNAL_LOCK = 2,       // Relay đóng (lockBox, kể cả tự khóa)
+    JOURNAL_BUTTON = 3,     // Nhấn nút bảo trì
+    JOURNAL_DOOR_OPEN = 4,  // Cảm biến cửa: mở
+    JOURNAL_DOOR_CLOSE = 5  // Cảm biến cửa: đóng
+};
+
+/**
+ * Số liệu journal
+ */
+struct JournalStats {
+    uint32_t headSeq;       // Số thứ tự bản ghi kế tiếp
+    uint16_t pending;       // Sự kiện chưa được backend xác nhận
+    uint32_t appended;      // Sự kiện ghi từ lúc khởi động
+    uint32_t replayed;      // Sự kiện backend đã nhận
+    uint32_t batches;       // Số lô đã gửi thành công
+    uint32_t failures;      // Số lô gửi lỗi
+    uint32_t dropped;       // Sự kiện bị ghi đè trước khi kịp gửi
+    uint32_t erases;        // Số lần xoá sector từ lúc khởi động
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Quét vùng journal trong flash, tìm vị trí ghi và phần chưa gửi
+ */
+void initEventJournal();
+
+/**
+ * Ghi một sự kiện (thời gian cố định, gọi ngay sau khi bật/tắt relay)
+ * @param uptimeMs millis() lúc xảy ra sự kiện (khác lúc ghi khi sự kiện
+ *                 được chuyển từ lõi actuation, xem dual_core.h)
+ * @return false nếu ghi flash lỗi
+ */
+bool journalAppend(JournalEvent event, int boxId, uint32_t uptimeMs = millis());
+
+/**
+ * Xoá trước sector kế tiếp; có WiFi thì gửi lô sự kiện chưa gửi
+ * Gọi mỗi JOURNAL_MAINTAIN_INTERVAL (scheduler)
+ */
+void journalMaintain();
+
+/**
+ * Lấy số liệu journal
+ */
+void journalGetStats(JournalStats& stats);
+
+#endif // EVENT_JOURNAL_H
@@ -0,0 +1,86 @@
+/**
+ * Heap Monitor Header
+ *
+ * Theo dõi heap ESP8266: free, khối liên tục lớn nhất, phần trăm phân mảnh
+ * và mức thấp nhất (low-water). Mỗi handler HTTP / lệnh MQTT chạy trong một
+ * "scope" để ghi nhận số lần cấp phát, số byte cấp phát và phần heap bị giữ
+ * lại sau khi handler kết thúc.
+ *
+ * Đếm cấp phát cần build flag HEAP_TRACK_ALLOCATIONS cùng với
+ * -Wl,--wrap=malloc,--wrap=realloc,--wrap=calloc (xem platformio.ini).
+ * Không có flag thì vẫn có số liệu heap và phần heap giữ lại theo scope.
+ */
+
+#ifndef HEAP_MONITOR_H
+#define HEAP_MONITOR_H
+
+#include <Arduino.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Số liệu heap tổng
+ */
+struct HeapStats {
+    uint32_t freeHeap;
+    uint32_t maxFreeBlock;  // Khối liên tục lớn nhất có thể cấp phát
+    uint8_t fragmentation;  // 0-100 (%)
+    uint32_t lowWater;      // Free heap thấp nhất từng ghi nhận
+    uint32_t totalAllocs;   // Tổng số lần cấp phát (cần HEAP_TRACK_ALLOCATIONS)
+};
+
+/**
+ * Số liệu cấp phát của một call site (handler / lệnh)
+ */
+struct HeapSiteStats {
+    const char* site;
+    uint32_t calls;         // Số lần scope được chạy
+    uint32_t allocs;        // Số lần cấp phát trong scope
+    uint32_t allocBytes;    // Tổng số byte cấp phát trong scope
+    int32_t retained;       // Tổng heap không được trả lại sau scope (byte)
+    uint32_t minFreeHeap;   // Free heap thấp nhất khi kết thúc scope
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Khởi tạo monitor, lấy mức heap ban đầu
+ */
+void initHeapMonitor();
+
+/**
+ * Bắt đầu / kết thúc scope đo cấp phát cho một call site
+ * @param site Tên call site (chuỗi hằng, ví dụ "http:/status")
+ */
+void heapScopeEnter(const char* site);
+void heapScopeExit();
+
+/**
+ * Lấy mẫu heap để cập nhật low-water (gọi định kỳ)
+ */
+void heapSample();
+
+/**
+ * Lấy số liệu heap tổng
+ */
+void heapGetStats(HeapStats& stats);
+
+/**
+ * Lấy các call site cấp phát nhiều nhất (theo số byte)
+ * @return Số site đã ghi vào sites
+ */
+uint8_t heapTopSites(HeapSiteStats* sites, uint8_t maxSites);
+
+/**
+ * Scope tự kết thúc khi ra khỏi khối lệnh (kể cả return sớm)
+ */
+struct HeapScope {
+    explicit HeapScope(const char* site) { heapScopeEnter(site); }
+    ~HeapScope() { heapScopeExit(); }
+};
+
+#endif // HEAP_MONITOR_H
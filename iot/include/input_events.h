@@ -0,0 +1,78 @@
+/**
+ * Input Events Header
+ *
+ * Bắt cạnh GPIO bằng ngắt: ISR ghi (chân, mức, thời điểm µs) vào ring
+ * buffer lock-free, loop() lấy ra, chống dội (debounce) dựa trên timestamp
+ * và gọi handler. Dùng cho nút nhấn và các input sau này (công tắc cửa).
+ */
+
+#ifndef INPUT_EVENTS_H
+#define INPUT_EVENTS_H
+
+#include <Arduino.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Handler được gọi khi input đổi mức ổn định
+ * @param input ID input trả về từ inputRegister()
+ * @param level Mức logic mới (HIGH/LOW)
+ * @param timestampUs Thời điểm cạnh xảy ra (micros() trong ISR)
+ */
+typedef void (*InputHandler)(int8_t input, uint8_t level, uint32_t timestampUs);
+
+/**
+ * Thống kê hàng đợi ISR → loop
+ */
+struct InputStats {
+    uint32_t edges;         // Tổng số cạnh ISR ghi nhận
+    uint32_t accepted;      // Số lần đổi mức hợp lệ sau debounce
+    uint32_t bounced;       // Số cạnh bị loại do dội
+    uint32_t dropped;       // Số cạnh mất do hàng đợi đầy
+    uint32_t maxLatencyUs;  // Độ trễ lớn nhất từ cạnh tới lúc gọi handler
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Khởi tạo hàng đợi sự kiện input
+ */
+void initInputEvents();
+
+/**
+ * Đăng ký một input dùng ngắt CHANGE
+ * @param pin Chân GPIO
+ * @param mode INPUT hoặc INPUT_PULLUP
+ * @param debounceMs Thời gian chống dội (ms)
+ * @param handler Hàm xử lý khi đổi mức
+ * @param name Tên input (dùng cho log)
+ * @return ID input (>= 0) hoặc -1 nếu hết slot
+ */
+int8_t inputRegister(uint8_t pin, uint8_t mode, uint32_t debounceMs, InputHandler handler, const char* name);
+
+/**
+ * Mức ổn định hiện tại của input (sau debounce)
+ */
+uint8_t inputLevel(int8_t input);
+
+/**
+ * Lấy các cạnh từ hàng đợi, debounce và gọi handler
+ * Gọi trong mỗi vòng loop()
+ */
+void inputEventsPoll();
+
+/**
+ * Có cạnh đang chờ trong hàng đợi không (dùng để đánh thức loop)
+ */
+bool inputEventsPending();
+
+/**
+ * Lấy thống kê hàng đợi
+ */
+void inputGetStats(InputStats& stats);
+
+#endif // INPUT_EVENTS_H
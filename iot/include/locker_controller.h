@@ -2,6 +2,9 @@
  * Locker Controller Header
  * 
  * Quản lý điều khiển khóa solenoid và giao tiếp với backend
+ *
+ * Một ESP8266 điều khiển BOX_COUNT box có ID liên tiếp từ BOX_ID, nên tra
+ * box theo ID chỉ là một phép trừ (O(1)).
  */
 
 #ifndef LOCKER_CONTROLLER_H
@@ -24,34 +27,75 @@ enum BoxStatus {
 // ============================================
 
 /**
- * Khởi tạo GPIO pins cho relay
+ * Khởi tạo bảng box và relay driver
  */
 void initLockerController();
 
+/**
+ * Số box controller điều khiển (BOX_COUNT)
+ */
+uint8_t boxCount();
+
+/**
+ * ID box theo chỉ số trong bảng (0 .. boxCount() - 1)
+ */
+int boxIdAt(uint8_t index);
+
+/**
+ * Kiểm tra box ID có thuộc controller này không
+ */
+bool isValidBox(int boxId);
+
 /**
  * Mở khóa box - Kích hoạt relay để mở solenoid
- * Tự động khóa lại sau UNLOCK_DURATION
+ * Tự động khóa lại sau UNLOCK_DURATION (deadline heap chung cho mọi box)
+ * Bản build hai lõi: gọi từ lõi mạng chỉ đưa lệnh vào hàng đợi actuation
+ * @return false nếu boxId không thuộc controller (hoặc hàng đợi đầy)
  */
-void unlockBox();
+bool unlockBox(int boxId);
 
 /**
  * Khóa box - Tắt relay để đóng solenoid
+ * @return false nếu boxId không thuộc controller
  */
-void lockBox();
+bool lockBox(int boxId);
 
 /**
  * Kiểm tra trạng thái khóa
- * @return true nếu đang mở, false nếu đã khóa
+ * @return true nếu đang mở, false nếu đã khóa (hoặc box không hợp lệ)
  */
-bool isUnlocked();
+bool isUnlocked(int boxId);
 
 /**
- * Gửi trạng thái box về backend
+ * Thời gian còn lại trước khi box tự khóa (ms, 0 nếu đang khóa)
+ */
+uint32_t autoLockRemaining(int boxId);
+
+/**
+ * Số box đang mở
+ */
+uint8_t unlockedCount();
+
+/**
+ * micros() ngay sau lần ghi relay gần nhất (mở hoặc khóa), dùng cho trace độ trễ
+ */
+uint32_t lastRelayWriteUs();
+
+/**
+ * Gửi trạng thái box về backend (qua outbox, không chặn)
+ * Trạng thái được gửi nền; nếu chưa kịp gửi thì bị thay bằng trạng thái mới hơn
+ * @param boxId Box cần báo cáo
  * @param status Trạng thái hiện tại của box
- * @param isDoorOpen Trạng thái cửa (mở/đóng)
- * @return true nếu gửi thành công
+ * @param isDoorOpen Trạng thái cửa (mở/đóng); bỏ qua nếu box có cảm biến cửa
+ * @return true nếu đã đưa vào outbox
+ */
+bool reportBoxStatus(int boxId, BoxStatus status, bool isDoorOpen);
+
+/**
+ * Đưa trạng thái box vào outbox đúng như được truyền, không đọc lại cảm biến
+ * cửa (lõi mạng nhận trạng thái lõi actuation đã chốt qua hàng đợi)
  */
-bool reportBoxStatus(BoxStatus status, bool isDoorOpen);
+bool queueBoxStatus(int boxId, BoxStatus status, bool isDoorOpen);
 
 /**
  * Chuyển BoxStatus thành string
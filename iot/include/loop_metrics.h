@@ -0,0 +1,68 @@
+/**
+ * Loop Metrics Header
+ *
+ * Đo thời gian từng giai đoạn trong loop() bằng histogram cố định theo
+ * thang log2 (µs), kèm max và p99. Xuất ra /metrics theo định dạng
+ * Prometheus text để tìm nguyên nhân các lần loop bị treo lâu.
+ */
+
+#ifndef LOOP_METRICS_H
+#define LOOP_METRICS_H
+
+#include <Arduino.h>
+
+// ============================================
+// Stages
+// ============================================
+enum LoopStage {
+    STAGE_LOOP,             // Toàn bộ một vòng loop() (trừ lúc ngủ)
+    STAGE_HTTP_SERVER,      // server.handleClient()
+    STAGE_ASYNC_HTTP,       // asyncHttpLoop()
+    STAGE_MQTT,             // mqttClient.loop()
+    STAGE_BUTTON,           // handleButton()
+    STAGE_AUTO_LOCK,        // Task auto-lock
+    STAGE_WIFI_CHECK,       // wifiManagerLoop()
+    STAGE_STATUS_REPORT,    // reportBoxStatus()
+    STAGE_OUTBOX,           // statusOutboxLoop()
+    STAGE_STREAM,           // progmemStreamLoop()
+    STAGE_COUNT
+};
+
+/**
+ * Số liệu tổng hợp của một stage
+ */
+struct StageSummary {
+    uint32_t count;
+    uint32_t maxUs;
+    uint32_t p99Us;         // Cận trên của bucket chứa p99
+    uint64_t sumUs;
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Ghi nhận một lần chạy của stage
+ * @param durationUs Thời gian chạy (micros() sau - trước)
+ */
+void metricsRecord(LoopStage stage, uint32_t durationUs);
+
+/**
+ * Lấy số liệu tổng hợp của stage
+ */
+void metricsGetSummary(LoopStage stage, StageSummary& summary);
+
+/**
+ * Ghi phần thứ part của trang /metrics (Prometheus text) vào buffer
+ * Gọi với part = 0, 1, 2... cho tới khi trả về 0; mỗi phần vừa METRICS_PART_SIZE
+ * @return Số byte đã ghi, 0 khi đã hết
+ */
+size_t metricsFormatPart(uint8_t part, char* buffer, size_t size);
+
+/**
+ * Tên stage dùng làm label Prometheus
+ */
+const char* metricsStageName(LoopStage stage);
+
+#endif // LOOP_METRICS_H
@@ -0,0 +1,100 @@
+/**
+ * MQTT Commands Header
+ *
+ * Xử lý lệnh trên topic locker/commands/{DEVICE_ID} mà không cấp phát:
+ * payload được parse tại chỗ ngay trong buffer của PubSubClient (zero-copy,
+ * giới hạn theo length), bản tin trả lời được dựng vào document và buffer
+ * tĩnh. Stack dùng cho mỗi lệnh không phụ thuộc độ dài payload.
+ *
+ * Định dạng dây: JSON trên topic thường, MessagePack trên topic + /mp
+ * (MQTT_MSGPACK_SUFFIX). Định dạng của lệnh gần nhất được giữ cho mọi bản
+ * tin trạng thái gửi sau đó, kể cả bản tin không phải trả lời lệnh.
+ *
+ * Trả lời OPEN/LOCK kèm "trace": mốc nhận gói (epoch ms khi đã đồng bộ
+ * NTP), vào callback, ghi relay và publish (µs tính từ lúc nhận gói), để
+ * đo độ trễ từ backend tới relay (xem scripts/latency_collector.py).
+ */
+
+#ifndef MQTT_COMMANDS_H
+#define MQTT_COMMANDS_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Định dạng payload trên MQTT
+ */
+enum WireFormat : uint8_t {
+    WIRE_JSON = 0,
+    WIRE_MSGPACK
+};
+
+/**
+ * Publish một bản tin trạng thái
+ * @param topic MQTT_TOPIC_STATUS hoặc MQTT_TOPIC_STATUS_MSGPACK
+ * @return false nếu chưa gửi được (MQTT mất kết nối)
+ */
+typedef bool (*StatusPublisher)(const char* topic, const uint8_t* payload, size_t length);
+
+/**
+ * Số liệu lệnh theo định dạng
+ */
+struct MqttCommandStats {
+    WireFormat format;          // Định dạng đang dùng cho bản tin trạng thái
+    uint32_t jsonCommands;      // Lệnh JSON đã nhận
+    uint32_t msgpackCommands;   // Lệnh MessagePack đã nhận
+    uint32_t parseErrors;       // Payload không parse được
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Khởi tạo, đăng ký hàm publish trạng thái
+ */
+void initMqttCommands(StatusPublisher publisher);
+
+/**
+ * Ghi mốc rx: gọi ngay trước mqttClient.loop(), lệnh nhận trong lần loop()
+ * đó được tính độ trễ từ mốc này
+ */
+void markMqttReceive();
+
+/**
+ * Xử lý một lệnh (gọi từ callback của PubSubClient)
+ * Payload bị sửa tại chỗ trong lúc parse
+ */
+void handleMqttCommand(const char* topic, uint8_t* payload, unsigned int length);
+
+/**
+ * Publish một bản tin trạng thái theo định dạng đang dùng (ONLINE, heap...)
+ */
+bool publishStatusDoc(JsonVariantConst status);
+
+/**
+ * Như trên cho bản tin dài (lô telemetry): serialize vào buffer của người gọi
+ * @return Số byte đã publish, 0 nếu không gửi được
+ */
+size_t publishStatusBatch(JsonVariantConst status, uint8_t* buffer, size_t size);
+
+/**
+ * Báo PIN cục bộ đã dùng (PinUsedReporter cho pin_cache)
+ */
+bool publishPinUsed(int boxId, uint32_t orderId);
+
+/**
+ * Lấy số liệu lệnh
+ */
+void mqttCommandsGetStats(MqttCommandStats& stats);
+
+/**
+ * Tên định dạng ("json" / "msgpack")
+ */
+const char* wireFormatName(WireFormat format);
+
+#endif // MQTT_COMMANDS_H
@@ -0,0 +1,93 @@
+/**
+ * PIN Cache Header
+ *
+ * Kho PIN cục bộ để mở khóa không cần gọi backend. Backend gửi trước
+ * (qua MQTT) mỗi đơn một bản ghi: box, orderId, salt ngẫu nhiên và
+ * SHA-256(salt || PIN), kèm thời hạn. Kiosk nhập PIN → so khớp ngay trên
+ * ESP trong thời gian cố định; khớp thì mở khóa, bản ghi bị dùng (một lần)
+ * và được báo lại cho backend nền. Không khớp thì đi đường online như cũ.
+ *
+ * Kho chỉ nằm trong RAM: sau khi khởi động lại ESP publish ONLINE, backend
+ * cần gửi lại các PIN còn hiệu lực.
+ */
+
+#ifndef PIN_CACHE_H
+#define PIN_CACHE_H
+
+#include <Arduino.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Kết quả so khớp PIN cục bộ
+ */
+enum PinCacheResult {
+    PIN_CACHE_MISS,     // Không có bản ghi khớp → hỏi backend
+    PIN_CACHE_HIT,      // Khớp bản ghi còn hạn → mở khóa ngay
+    PIN_CACHE_USED      // Khớp bản ghi vừa dùng, backend chưa nhận báo cáo
+};
+
+/**
+ * Gửi báo cáo "PIN đã dùng" về backend
+ * @return true nếu đã gửi được (false = thử lại sau)
+ */
+typedef bool (*PinUsedReporter)(int boxId, uint32_t orderId);
+
+/**
+ * Số liệu kho PIN
+ */
+struct PinCacheStats {
+    uint8_t entries;        // Bản ghi còn hiệu lực
+    uint8_t unreported;     // PIN đã dùng, chưa báo được cho backend
+    uint32_t provisioned;   // Tổng số bản ghi backend đã gửi
+    uint32_t hits;          // Mở khóa bằng kho cục bộ
+    uint32_t misses;        // Không khớp, chuyển sang backend
+    uint32_t expired;       // Bản ghi hết hạn trước khi được dùng
+    uint32_t lastVerifyUs;  // Thời gian so khớp lần gần nhất (µs)
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Khởi tạo kho PIN
+ * @param reporter Hàm báo PIN đã dùng (gọi lại tới khi trả về true)
+ */
+void initPinCache(PinUsedReporter reporter);
+
+/**
+ * Thêm hoặc thay bản ghi của một đơn
+ * @param saltHex Salt dạng hex (PIN_SALT_SIZE byte)
+ * @param hashHex SHA-256(salt || PIN) dạng hex (32 byte)
+ * @param ttlSec Thời hạn tính từ lúc nhận (giây, tối đa PIN_CACHE_MAX_TTL)
+ * @return false nếu dữ liệu sai định dạng hoặc kho đầy
+ */
+bool pinCacheProvision(int boxId, uint32_t orderId, const char* saltHex, const char* hashHex, uint32_t ttlSec);
+
+/**
+ * Xoá bản ghi của một đơn (backend huỷ đơn, hoặc PIN đã dùng qua đường online)
+ * @return true nếu có bản ghi bị xoá
+ */
+bool pinCacheRevoke(uint32_t orderId);
+
+/**
+ * So khớp PIN với mọi bản ghi của box trong thời gian cố định
+ * PIN_CACHE_HIT: bản ghi được đánh dấu đã dùng và xếp hàng báo cáo
+ * @param orderId Đơn khớp (chỉ có giá trị khi HIT/USED)
+ */
+PinCacheResult pinCacheVerify(int boxId, const char* pinCode, uint32_t& orderId);
+
+/**
+ * Dọn bản ghi hết hạn và gửi lại báo cáo còn treo, gọi định kỳ
+ */
+void pinCacheMaintain();
+
+/**
+ * Lấy số liệu kho PIN
+ */
+void pinCacheGetStats(PinCacheStats& stats);
+
+#endif // PIN_CACHE_H
@@ -0,0 +1,77 @@
+/**
+ * PIN Guard Header
+ *
+ * Chặn nhập sai PIN lặp lại ngay trên ESP, không gọi backend:
+ * - Negative cache: PIN backend vừa từ chối (theo box) được nhớ trong
+ *   PIN_NEG_CACHE_TTL, nhập lại được trả lời "không hợp lệ" ngay
+ * - Token bucket theo IP nguồn và theo box: mỗi lần nhập sai tốn một token,
+ *   hết token thì trả 429 tới khi token hồi lại
+ *
+ * Lần nhập đúng không tốn token: mọi khách dùng chung IP của tablet kiosk
+ * nên chỉ nhập sai liên tục mới bị giới hạn.
+ */
+
+#ifndef PIN_GUARD_H
+#define PIN_GUARD_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Quyết định cho một lần nhập PIN
+ */
+enum PinGuardResult {
+    PIN_GUARD_ALLOW,        // Gửi backend xác thực
+    PIN_GUARD_REJECTED,     // PIN vừa bị backend từ chối (negative cache)
+    PIN_GUARD_LIMITED       // Nhập sai quá nhiều, chờ retryAfter
+};
+
+/**
+ * Số liệu PIN guard
+ */
+struct PinGuardStats {
+    uint8_t rejectedPins;   // PIN sai đang được nhớ
+    uint8_t sources;        // IP nguồn đang theo dõi
+    uint32_t negativeHits;  // Trả lời từ negative cache
+    uint32_t limited;       // Bị chặn bởi token bucket
+    uint32_t failures;      // Tổng số lần nhập sai đã ghi nhận
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Xóa negative cache và bucket
+ */
+void initPinGuard();
+
+/**
+ * Chỉ kiểm tra token bucket của IP nguồn và box (trước cả kho PIN cục bộ,
+ * để nguồn đã bị chặn không đoán tiếp được PIN đã cấp sẵn)
+ * @param retryAfterSec Số giây cần chờ khi trả về true
+ * @return true nếu đã hết lượt nhập sai
+ */
+bool pinGuardLimited(IPAddress source, int boxId, uint32_t& retryAfterSec);
+
+/**
+ * Kiểm tra trước khi gọi backend
+ * @param retryAfterSec Số giây cần chờ (chỉ có giá trị khi PIN_GUARD_LIMITED)
+ */
+PinGuardResult pinGuardCheck(IPAddress source, int boxId, const char* pinCode, uint32_t& retryAfterSec);
+
+/**
+ * Backend từ chối PIN: nhớ vào negative cache và trừ token
+ */
+void pinGuardRecordFailure(IPAddress source, int boxId, const char* pinCode);
+
+/**
+ * Lấy số liệu PIN guard
+ */
+void pinGuardGetStats(PinGuardStats& stats);
+
+#endif // PIN_GUARD_H
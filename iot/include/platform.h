@@ -0,0 +1,155 @@
+/**
+ * Platform Header
+ *
+ * Lớp tương thích ESP8266 / ESP32: chọn header WiFi, WebServer, HTTPClient
+ * theo core đang build và gói các API chỉ có trên một core (RTC user
+ * memory, lý do reset, thống kê heap, ghi socket từ PROGMEM, SHA-256) thành cùng
+ * một hàm. Bản build native (host/) dùng nhánh ESP8266.
+ */
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <Arduino.h>
+
+#if defined(ESP32)
+#include <WiFi.h>
+#include <WebServer.h>
+#include <HTTPClient.h>
+#include <esp_system.h>
+#include <esp_heap_caps.h>
+#include <mbedtls/sha256.h>
+
+// WebServer của core ESP32 là bản port của ESP8266WebServer (cùng API)
+typedef WebServer ESP8266WebServer;
+#else
+#include <ESP8266WiFi.h>
+#include <ESP8266WebServer.h>
+#include <ESP8266HTTPClient.h>
+#include <bearssl/bearssl_hash.h>
+#endif
+
+// ============================================
+// RTC user memory (còn sau reset, mất khi mất điện)
+// ============================================
+#define PLATFORM_RTC_BLOCKS 128         // 512 byte, đánh địa chỉ theo block 4 byte như ESP8266
+
+#if defined(ESP32)
+// ESP32 không có rtcUserMemory*: dùng vùng RTC slow memory không bị khởi tạo lại khi reset
+extern uint32_t platformRtcMemory[PLATFORM_RTC_BLOCKS];
+#endif
+
+/**
+ * Đọc RTC user memory từ block offset
+ */
+inline bool platformRtcRead(uint32_t offset, uint32_t* data, size_t size) {
+#if defined(ESP32)
+    if (offset * 4 + size > sizeof(platformRtcMemory)) return false;
+    memcpy(data, &platformRtcMemory[offset], size);
+    return true;
+#else
+    return ESP.rtcUserMemoryRead(offset, data, size);
+#endif
+}
+
+/**
+ * Ghi RTC user memory từ block offset
+ */
+inline bool platformRtcWrite(uint32_t offset, uint32_t* data, size_t size) {
+#if defined(ESP32)
+    if (offset * 4 + size > sizeof(platformRtcMemory)) return false;
+    memcpy(&platformRtcMemory[offset], data, size);
+    return true;
+#else
+    return ESP.rtcUserMemoryWrite(offset, data, size);
+#endif
+}
+
+// ============================================
+// Chip
+// ============================================
+
+/**
+ * Lý do reset lần trước (chuỗi như ESP.getResetReason() của ESP8266)
+ */
+String platformResetReason();
+
+/**
+ * Free heap, khối liên tục lớn nhất, phần trăm phân mảnh
+ */
+inline void platformHeapStats(uint32_t* freeHeap, uint32_t* maxBlock, uint8_t* fragmentation) {
+#if defined(ESP32)
+    *freeHeap = ESP.getFreeHeap();
+    *maxBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    *fragmentation = *freeHeap ? 100 - (uint8_t)((uint64_t)*maxBlock * 100 / *freeHeap) : 0;
+#else
+    ESP.getHeapStats(freeHeap, maxBlock, fragmentation);
+#endif
+}
+
+// ============================================
+// Socket
+// ============================================
+
+/**
+ * Số byte ghi được ngay không chặn. WiFiClient của ESP32 không báo cửa sổ
+ * gửi (luôn 0) nên trả về STREAM_BLOCK_SIZE khi socket còn mở
+ */
+inline size_t platformWritable(WiFiClient& client, size_t blockSize) {
+#if defined(ESP32)
+    return client.connected() ? blockSize : 0;
+#else
+    (void)blockSize;
+    return client.availableForWrite();
+#endif
+}
+
+/**
+ * Ghi dữ liệu PROGMEM (ESP32: flash được map vào bộ nhớ, ghi trực tiếp)
+ */
+inline size_t platformWriteP(WiFiClient& client, PGM_P data, size_t length) {
+#if defined(ESP32)
+    return client.write((const uint8_t*)data, length);
+#else
+    return client.write_P(data, length);
+#endif
+}
+
+// ============================================
+// SHA-256
+// ============================================
+// ESP8266 có BearSSL, ESP32 có mbedTLS (API 2.x của IDF 4.4)
+
+#if defined(ESP32)
+typedef mbedtls_sha256_context PlatformSha256;
+
+inline void platformSha256Init(PlatformSha256* ctx) {
+    mbedtls_sha256_init(ctx);
+    mbedtls_sha256_starts_ret(ctx, 0);
+}
+
+inline void platformSha256Update(PlatformSha256* ctx, const void* data, size_t length) {
+    mbedtls_sha256_update_ret(ctx, (const unsigned char*)data, length);
+}
+
+inline void platformSha256Out(PlatformSha256* ctx, uint8_t* digest) {
+    mbedtls_sha256_finish_ret(ctx, digest);
+    mbedtls_sha256_free(ctx);
+}
+#else
+typedef br_sha256_context PlatformSha256;
+
+inline void platformSha256Init(PlatformSha256* ctx) {
+    br_sha256_init(ctx);
+}
+
+inline void platformSha256Update(PlatformSha256* ctx, const void* data, size_t length) {
+    br_sha256_update(ctx, data, length);
+}
+
+inline void platformSha256Out(PlatformSha256* ctx, uint8_t* digest) {
+    br_sha256_out(ctx, digest);
+}
+#endif
+
+#endif // PLATFORM_H
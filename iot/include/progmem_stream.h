@@ -0,0 +1,61 @@
+/**
+ * PROGMEM Stream Header
+ *
+ * Gửi asset nằm trong flash (PROGMEM) mà không giữ loop() suốt lúc truyền.
+ * Handler chỉ gửi header rồi trả về; progmemStreamLoop() ghi tiếp từng khối
+ * vừa với chỗ trống của cửa sổ gửi TCP (availableForWrite), đọc thẳng từ
+ * flash, không qua String hay buffer heap. Giữa hai khối loop() vẫn chạy
+ * MQTT, nút nhấn, auto-lock... nên tải trang không làm trễ lệnh mở khóa.
+ */
+
+#ifndef PROGMEM_STREAM_H
+#define PROGMEM_STREAM_H
+
+#include <Arduino.h>
+#include "platform.h"
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Số liệu stream
+ */
+struct ProgmemStreamStats {
+    uint8_t active;         // Stream đang gửi
+    uint32_t started;       // Số response đã nhận gửi nền
+    uint32_t completed;     // Gửi đủ byte
+    uint32_t aborted;       // Client ngắt hoặc hết STREAM_TIMEOUT
+    uint32_t fallbacks;     // Hết slot, phải gửi chặn bằng send_P()
+    uint32_t bytes;         // Tổng byte body đã gửi
+    uint16_t maxBlock;      // Khối lớn nhất ghi trong một lượt
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Gửi header (kèm các sendHeader() đã gọi trước đó) rồi stream body nền
+ * Hết slot thì gửi chặn bằng server.send_P() như trước
+ * @param data Con trỏ PROGMEM tới body
+ * @param length Số byte body
+ */
+void streamProgmem(ESP8266WebServer& server, int code, const char* contentType, PGM_P data, size_t length);
+
+/**
+ * Ghi khối tiếp theo cho mỗi stream đang mở, gọi mỗi vòng loop()
+ */
+void progmemStreamLoop();
+
+/**
+ * Có stream đang chờ và socket đã có chỗ trống để ghi (dùng cho schedulerIdle)
+ */
+bool progmemStreamReady();
+
+/**
+ * Lấy số liệu stream
+ */
+void progmemStreamGetStats(ProgmemStreamStats& stats);
+
+#endif // PROGMEM_STREAM_H
@@ -0,0 +1,36 @@
+/**
+ * Relay Driver Header
+ *
+ * Điều khiển N relay cho bảng box. Chọn phần cứng bằng RELAY_DRIVER
+ * trong config.h:
+ * - RELAY_DRIVER_GPIO:    mỗi relay một chân GPIO (RELAY_PINS)
+ * - RELAY_DRIVER_74HC595: chuỗi thanh ghi dịch 74HC595 (3 chân, 8 relay/IC)
+ * - RELAY_DRIVER_PCF8574: IC mở rộng I2C PCF8574 (2 chân, 8 relay/IC)
+ */
+
+#ifndef RELAY_DRIVER_H
+#define RELAY_DRIVER_H
+
+#include <Arduino.h>
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Khởi tạo driver, tắt tất cả relay (khóa đóng)
+ */
+void initRelayDriver();
+
+/**
+ * Bật/tắt relay của một kênh (kênh = chỉ số box trong bảng)
+ * Với 74HC595/PCF8574 toàn bộ trạng thái được ghi ra ngay
+ */
+void relayWrite(uint8_t channel, bool on);
+
+/**
+ * Trạng thái logic của relay (true = đang bật)
+ */
+bool relayState(uint8_t channel);
+
+#endif // RELAY_DRIVER_H
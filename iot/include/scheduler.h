@@ -0,0 +1,94 @@
+/**
+ * Cooperative Scheduler Header
+ *
+ * Bộ lập lịch hợp tác dùng hashed timer wheel cho các công việc định kỳ
+ * (status report, kiểm tra WiFi, reconnect MQTT) và một lần (auto-lock).
+ * Thay cho chuỗi kiểm tra millis() thủ công và delay(10) cố định trong loop().
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Hàm công việc được scheduler gọi khi tới hạn
+ */
+typedef void (*SchedulerTask)(void* arg);
+
+/**
+ * ID của task (0 = không hợp lệ). ID cũ sẽ không huỷ nhầm task mới
+ * dùng lại cùng slot.
+ */
+typedef uint16_t SchedulerTaskId;
+#define SCHEDULER_INVALID_TASK 0
+
+/**
+ * Thống kê độ trễ loop: task chạy muộn bao nhiêu so với deadline
+ */
+struct SchedulerStats {
+    uint8_t activeTasks;
+    uint32_t dispatched;    // Tổng số lần chạy task
+    uint32_t lateCount;     // Số lần chạy muộn hơn SCHED_LATE_THRESHOLD_MS
+    uint32_t maxLagMs;      // Độ trễ lớn nhất
+    uint32_t avgLagMs;      // Độ trễ trung bình
+    uint32_t lastLagMs;     // Độ trễ của task gần nhất
+    uint32_t idleMs;        // Tổng thời gian ngủ trong schedulerIdle()
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Khởi tạo scheduler
+ */
+void initScheduler();
+
+/**
+ * Thêm task định kỳ
+ * @param intervalMs Chu kỳ (ms), lần chạy đầu sau intervalMs
+ * @param task Hàm công việc
+ * @param name Tên task (dùng cho log)
+ * @param arg Tham số truyền cho task
+ * @return ID task hoặc SCHEDULER_INVALID_TASK nếu hết slot
+ */
+SchedulerTaskId schedulerEvery(uint32_t intervalMs, SchedulerTask task, const char* name, void* arg = nullptr);
+
+/**
+ * Thêm task chạy một lần sau delayMs
+ */
+SchedulerTaskId schedulerAfter(uint32_t delayMs, SchedulerTask task, const char* name, void* arg = nullptr);
+
+/**
+ * Huỷ task (an toàn khi gọi với ID đã hết hạn)
+ * @return true nếu task còn hoạt động và đã bị huỷ
+ */
+bool schedulerCancel(SchedulerTaskId id);
+
+/**
+ * Chạy tất cả task đã tới hạn, theo thứ tự deadline
+ */
+void schedulerRun();
+
+/**
+ * Số ms tới deadline gần nhất (0 nếu đã có task tới hạn)
+ */
+uint32_t schedulerTimeToNext();
+
+/**
+ * Ngủ tới deadline gần nhất hoặc tới khi có sự kiện I/O
+ * @param ioReady Hàm kiểm tra có dữ liệu I/O đang chờ (có thể null)
+ */
+void schedulerIdle(bool (*ioReady)());
+
+/**
+ * Lấy thống kê độ trễ loop (wheel của task đang gọi)
+ */
+void schedulerGetStats(SchedulerStats& stats);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,66 @@
+/**
+ * SPSC Queue Header
+ *
+ * Hàng đợi vòng một producer - một consumer, không khóa, kích thước cố
+ * định (lũy thừa của 2), phần tử được chép theo giá trị. Dùng giữa task
+ * mạng và task actuation trên hai lõi ESP32 (xem dual_core.h).
+ *
+ * Khác ring buffer ISR -> loop của input_events (một lõi, chỉ cần chặn
+ * compiler): hai lõi chạy song song nên head/tail là std::atomic với
+ * release khi công bố chỉ số mới và acquire khi đọc chỉ số của phía kia.
+ * head và tail tăng mãi (tràn tự nhiên), size = head - tail.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, uint16_t N>
+class SpscQueue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SpscQueue size must be a power of 2");
+
+public:
+    /**
+     * Producer: thêm phần tử
+     * @return false nếu hàng đợi đầy
+     */
+    bool push(const T& item) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= N) return false;
+        _items[head & (N - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer: lấy phần tử cũ nhất
+     * @return false nếu hàng đợi rỗng
+     */
+    bool pop(T& item) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) return false;
+        item = _items[tail & (N - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Số phần tử đang chờ (gần đúng khi phía kia đang chạy)
+     */
+    uint16_t size() const {
+        return (uint16_t)(_head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire));
+    }
+
+    bool empty() const { return size() == 0; }
+
+    static constexpr uint16_t capacity() { return N; }
+
+private:
+    T _items[N];
+    std::atomic<uint32_t> _head{0};     // Chỉ producer ghi
+    std::atomic<uint32_t> _tail{0};     // Chỉ consumer ghi
+};
+
+#endif // SPSC_QUEUE_H
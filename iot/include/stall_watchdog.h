@@ -0,0 +1,76 @@
+/**
+ * Stall Watchdog Header
+ *
+ * Watchdog phần mềm cho từng stage của loop() và từng task của scheduler:
+ * stallArm() trước khi chạy, stallDisarm() sau khi xong. Stage chạy quá
+ * STALL_BUDGET_MS được ghi vào RTC memory (còn sau reset/WDT): tên stage,
+ * thời gian và ảnh chụp stack (các địa chỉ code trên stack của loop(),
+ * giải mã bằng addr2line / EspExceptionDecoder như một stack dump).
+ *
+ * Ảnh chụp được lấy từ timer SDK (os_timer) khi stage đang treo nhưng
+ * vẫn nhường CPU (HTTPClient, PubSubClient::connect() chờ CONNACK), hoặc
+ * từ custom_crash_callback khi soft WDT / exception reset chip giữa stage.
+ * Các stall lâu nhất được gửi qua MQTT (status "STALL") sau khi hồi phục.
+ */
+
+#ifndef STALL_WATCHDOG_H
+#define STALL_WATCHDOG_H
+
+#include <Arduino.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Số liệu stall
+ */
+struct StallStats {
+    uint32_t stalls;            // Số stall từ lúc khởi động (kể cả stall trước reset)
+    uint32_t resets;            // ...trong đó chip bị reset giữa stage
+    uint32_t worstMs;           // Stall lâu nhất
+    const char* lastStage;      // Stage của stall gần nhất ("" nếu chưa có)
+    uint8_t pending;            // Bản ghi trong RTC chờ gửi
+    uint32_t reports;           // Số báo cáo đã gửi qua MQTT
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Đọc bản ghi còn trong RTC (stall trước lần reset) và khởi động timer kiểm tra
+ * Gọi sớm trong setup()
+ */
+void initStallWatchdog();
+
+/**
+ * Bắt đầu theo dõi một stage
+ * @param stage Tên stage (chuỗi tĩnh, ví dụ "http_server" hoặc tên task)
+ */
+void stallArm(const char* stage);
+
+/**
+ * Stage đã chạy xong
+ */
+void stallDisarm();
+
+/**
+ * Stage đang được theo dõi (nullptr nếu không có), để một bước chặn bên trong
+ * stage tự stallArm() rồi arm lại stage ngoài
+ */
+const char* stallStage();
+
+/**
+ * Gửi các stall đang chờ qua MQTT (status "STALL"), xoá khỏi RTC khi gửi được
+ * Gọi mỗi STALL_REPORT_INTERVAL (scheduler)
+ * @return true nếu đã gửi một báo cáo
+ */
+bool stallReport();
+
+/**
+ * Lấy số liệu stall
+ */
+void stallGetStats(StallStats& stats);
+
+#endif // STALL_WATCHDOG_H
@@ -0,0 +1,64 @@
+/**
+ * Status Outbox Header
+ *
+ * Hàng đợi báo cáo trạng thái box về backend. Người gọi chỉ ghi trạng
+ * thái mới vào outbox rồi trả về ngay; việc gửi HTTP diễn ra nền:
+ * - Trạng thái cũ chưa gửi bị thay bằng trạng thái mới nhất (latest wins)
+ * - Nhiều box đang chờ được gộp vào một request
+ * - Gửi lỗi thì thử lại với backoff tăng dần
+ * - Không có thay đổi thì gửi lại trạng thái mọi box (heartbeat), khoảng
+ *   cách gấp đôi sau mỗi lần tới OUTBOX_HEARTBEAT_MAX_MS
+ */
+
+#ifndef STATUS_OUTBOX_H
+#define STATUS_OUTBOX_H
+
+#include <Arduino.h>
+#include "locker_controller.h"
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Thống kê outbox
+ */
+struct OutboxStats {
+    uint8_t pending;        // Số box có trạng thái chưa gửi
+    uint32_t enqueued;      // Tổng số lần ghi trạng thái
+    uint32_t coalesced;     // Số trạng thái bị thay thế trước khi kịp gửi
+    uint32_t requests;      // Số HTTP request đã gửi
+    uint32_t delivered;     // Số trạng thái backend đã nhận
+    uint32_t failures;      // Số lần gửi thất bại
+    uint32_t backoffMs;     // Backoff hiện tại (0 nếu không có lỗi)
+    uint32_t heartbeats;    // Số lần gửi lại trạng thái khi không có thay đổi
+    uint32_t heartbeatMs;   // Khoảng heartbeat hiện tại
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Khởi tạo outbox
+ */
+void initStatusOutbox();
+
+/**
+ * Ghi trạng thái mới của box vào outbox (không chặn)
+ * @return true nếu đã ghi, false nếu bảng box đầy
+ */
+bool outboxEnqueue(int boxId, BoxStatus status, bool isDoorOpen);
+
+/**
+ * Gửi các trạng thái đang chờ khi tới lượt (không chặn)
+ * Gọi trong mỗi vòng loop()
+ */
+void statusOutboxLoop();
+
+/**
+ * Lấy thống kê outbox
+ */
+void outboxGetStats(OutboxStats& stats);
+
+#endif // STATUS_OUTBOX_H
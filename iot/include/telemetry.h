@@ -0,0 +1,63 @@
+/**
+ * Telemetry Header
+ *
+ * Lấy mẫu định kỳ (số box đang mở, RSSI, heap, số liệu loop) vào vòng đệm
+ * cố định TELEMETRY_RING_SIZE mẫu, rồi gửi cả lô trong một bản tin mỗi
+ * TELEMETRY_FLUSH_INTERVAL hoặc khi vòng đệm đầy. Thay cho POST box-status
+ * định kỳ và bản tin heap riêng; thay đổi trạng thái box vẫn được gửi ngay
+ * qua status outbox.
+ *
+ * Lô được mã hoá delta: mỗi mảng bắt đầu bằng giá trị tuyệt đối, các phần
+ * tử sau là chênh lệch so với mẫu trước (phần lớn là số nhỏ, 1 byte trong
+ * MessagePack). Gửi qua MQTT status topic; MQTT mất kết nối thì POST
+ * /api/iot/telemetry.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Số liệu telemetry
+ */
+struct TelemetryStats {
+    uint8_t samples;        // Mẫu đang chờ gửi
+    uint32_t batches;       // Số lô đã gửi thành công
+    uint32_t mqttBatches;   // ...qua MQTT
+    uint32_t httpBatches;   // ...qua HTTP
+    uint32_t dropped;       // Mẫu bị ghi đè vì không gửi được
+    uint16_t lastBytes;     // Kích thước lô gần nhất
+};
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Khởi tạo vòng đệm
+ */
+void initTelemetry();
+
+/**
+ * Lấy một mẫu, gửi lô nếu vòng đệm đầy hoặc tới hạn
+ * Gọi mỗi TELEMETRY_SAMPLE_INTERVAL (scheduler)
+ */
+void telemetrySample();
+
+/**
+ * Gửi ngay các mẫu đang chờ (không chặn)
+ * @return true nếu lô đã được gửi (MQTT) hoặc request HTTP đã được tạo
+ */
+bool telemetryFlush();
+
+/**
+ * Lấy số liệu telemetry
+ */
+void telemetryGetStats(TelemetryStats& stats);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,40 @@
+/**
+ * Verify Pipeline Header
+ *
+ * Xử lý bất đồng bộ luồng kiosk: nhận PIN → gọi backend xác thực →
+ * mở khóa → trả HTTP response cho kiosk khi có kết quả.
+ * Trong lúc chờ backend, loop() vẫn chạy bình thường.
+ */
+
+#ifndef VERIFY_PIPELINE_H
+#define VERIFY_PIPELINE_H
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Bắt đầu xác thực PIN cho một request kiosk
+ * Kết nối kiosk được giữ lại và trả lời khi backend phản hồi
+ * @param kiosk Kết nối HTTP của kiosk (copy từ server.client())
+ * @param pinCode Mã PIN 6 số
+ * @param boxId Box cần mở (phải thuộc controller này)
+ * @return true nếu đã nhận xử lý, false nếu pipeline đang đầy
+ */
+bool beginVerifyAndUnlock(WiFiClient& kiosk, const String& pinCode, int boxId);
+
+/**
+ * Gửi JSON response trực tiếp lên socket kiosk (ngoài ESP8266WebServer)
+ * rồi đóng kết nối
+ */
+void sendDeferredJson(WiFiClient& kiosk, int code, const String& json);
+
+/**
+ * Số request kiosk đang chờ kết quả
+ */
+uint8_t verifyPipelinePending();
+
+#endif // VERIFY_PIPELINE_H
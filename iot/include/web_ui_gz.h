@@ -0,0 +1,328 @@
+/**
+ * Kiosk Web UI (gzip) - FILE TỰ SINH, KHÔNG SỬA TAY
+ *
+ * Sinh bởi scripts/gzip_web_ui.py từ include/web_ui.h
+ * HTML: 17856 byte, gzip: 4924 byte
+ */
+
+#ifndef WEB_UI_GZ_H
+#define WEB_UI_GZ_H
+
+#include <Arduino.h>
+
+#define LOCKER_UI_HASH "983cd94f5a3651c5"
+
+const size_t LOCKER_UI_GZ_SIZE = 4924;
+
+const uint8_t LOCKER_UI_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xed, 0x5c, 0x6d, 0x6f, 0x23, 0xd7,
+    0x75, 0xfe, 0xae, 0x5f, 0x71, 0x97, 0x0b, 0x9b, 0x64, 0x4d, 0x8e, 0x48, 0x8a, 0xa4, 0xb8, 0xa4,
+    0xc4, 0x7a, 0xbd, 0x56, 0xbc, 0xaa, 0xb5, 0xda, 0xc5, 0x4a, 0x6b, 0xd8, 0x70, 0x8d, 0xe0, 0x72,
+    0xe6, 0x92, 0x1c, 0x6b, 0x38, 0x33, 0x99, 0x19, 0x4a, 0x62, 0x19, 0x01, 0x2d, 0x82, 0x26, 0x1f,
+    0xda, 0x22, 0xde, 0x38, 0x40, 0xd1, 0x37, 0x78, 0x53, 0xb7, 0x30, 0xd0, 0xc2, 0x40, 0xd3, 0x17,
+    0xa4, 0x58, 0xc1, 0xc8, 0x07, 0x2d, 0xfa, 0x3f, 0xe4, 0x3f, 0xd0, 0xfc, 0x84, 0x9c, 0x73, 0x5f,
+    0x66, 0xee, 0x70, 0x48, 0x8a, 0xdc, 0x5d, 0xa7, 0xf9, 0xd0, 0x20, 0x11, 0x39, 0x73, 0xef, 0x3d,
+    0xf7, 0xdc, 0x73, 0x9f, 0xf3, 0xce, 0xcd, 0xc6, 0xce, 0xad, 0x77, 0x1f, 0xde, 0x3b, 0xfe, 0xe8,
+    0xd1, 0x1e, 0x19, 0x46, 0x23, 0xa7, 0xbb, 0xb1, 0x83, 0x1f, 0xc4, 0xa1, 0xee, 0x60, 0x37, 0x77,
+    0x6a, 0xe7, 0xf0, 0x05, 0xa3, 0x16, 0x7c, 0x8c, 0x58, 0x44, 0x89, 0x39, 0xa4, 0x41, 0xc8, 0xa2,
+    0xdd, 0xdc, 0x93, 0xe3, 0xef, 0x95, 0x5b, 0x39, 0xf5, 0xda, 0xa5, 0x23, 0x86, 0xd3, 0xd9, 0x99,
+    0xef, 0x05, 0x51, 0x8e, 0x98, 0x9e, 0x1b, 0x31, 0x17, 0xa6, 0x9d, 0xd9, 0x56, 0x34, 0xdc, 0xb5,
+    0xd8, 0xa9, 0x6d, 0xb2, 0x32, 0x7f, 0x28, 0xd9, 0xae, 0x1d, 0xd9, 0xd4, 0x29, 0x87, 0x26, 0x75,
+    0xd8, 0x6e, 0xb5, 0x34, 0x0e, 0x59, 0xc0, 0x1f, 0x68, 0x0f, 0x9e, 0x5d, 0x0f, 0x89, 0x46, 0x76,
+    0xe4, 0xb0, 0xee, 0x01, 0x1d, 0xbb, 0x56, 0x30, 0x21, 0x07, 0x9e, 0x79, 0xc2, 0x82, 0x9d, 0x4d,
+    0xf1, 0x76, 0x63, 0x27, 0x8c, 0x26, 0xf8, 0xf9, 0x07, 0xd3, 0x11, 0x0d, 0x06, 0xb6, 0xdb, 0xae,
+    0x74, 0x7c, 0x6a, 0x59, 0xb6, 0x3b, 0x80, 0x6f, 0x3d, 0xef, 0xbc, 0x1c, 0xda, 0x7f, 0x82, 0x0f,
+    0x3d, 0x2f, 0xb0, 0x80, 0x34, 0xbc, 0xb9, 0xd8, 0xe8, 0x79, 0xd6, 0x64, 0xda, 0x07, 0xae, 0xca,
+    0x7d, 0x3a, 0xb2, 0x9d, 0x49, 0x3b, 0x7f, 0xc4, 0x06, 0x1e, 0x23, 0x4f, 0xf6, 0xf3, 0xa5, 0x70,
+    0x12, 0x46, 0x6c, 0x54, 0x1e, 0xdb, 0xa5, 0x90, 0xba, 0x61, 0x19, 0xd8, 0xb1, 0xfb, 0x9d, 0x1e,
+    0x35, 0x4f, 0x06, 0x81, 0x07, 0x0c, 0xb4, 0x1d, 0xdb, 0x65, 0x34, 0x28, 0x0f, 0x02, 0x6a, 0xd9,
+    0x70, 0xa8, 0x42, 0x75, 0xab, 0x61, 0xb1, 0x41, 0xe9, 0x76, 0x85, 0x56, 0x9b, 0xb5, 0x56, 0xe9,
+    0x76, 0x95, 0xd6, 0x68, 0x9d, 0xc2, 0xb3, 0x55, 0xed, 0x6f, 0x99, 0xc5, 0x8e, 0xe9, 0x39, 0x5e,
+    0xd0, 0xbe, 0xcd, 0x2a, 0xac, 0xd5, 0xaf, 0x74, 0x46, 0xb6, 0x5b, 0x1e, 0x32, 0x7b, 0x30, 0x8c,
+    0xda, 0xd5, 0x4a, 0xe5, 0x74, 0xd8, 0xf1, 0x4e, 0x59, 0xd0, 0x77, 0xbc, 0xb3, 0xf2, 0x79, 0x7b,
+    0x68, 0x5b, 0x16, 0x73, 0x2f, 0x36, 0x0c, 0xea, 0xfb, 0x70, 0x98, 0x73, 0x21, 0xa1, 0x76, 0xbd,
+    0x56, 0xf1, 0xcf, 0x3b, 0xea, 0x70, 0x84, 0x8e, 0x23, 0x2f, 0x3e, 0x61, 0xb5, 0x89, 0x43, 0xb3,
+    0x34, 0x2d, 0x3b, 0xf4, 0x1d, 0x3a, 0x69, 0xf7, 0x1d, 0x76, 0xde, 0xc1, 0x3f, 0x65, 0xcb, 0x0e,
+    0x98, 0x19, 0xd9, 0x9e, 0xdb, 0x06, 0x76, 0xc6, 0x23, 0xdc, 0x24, 0x34, 0x03, 0xc6, 0xdc, 0xa9,
+    0x9a, 0xeb, 0x7a, 0x2e, 0xe3, 0x73, 0xdb, 0xd5, 0x0e, 0x75, 0xed, 0x11, 0xe5, 0xb3, 0xfb, 0xd4,
+    0x62, 0xfb, 0x2e, 0x31, 0xb6, 0x42, 0xc2, 0x68, 0xc8, 0xe2, 0x65, 0x06, 0x05, 0x6a, 0xa7, 0x6c,
+    0xba, 0xca, 0x4e, 0x6f, 0x9f, 0xb0, 0x49, 0x3f, 0x00, 0x48, 0x84, 0x44, 0x90, 0x9b, 0xf6, 0x03,
+    0x6f, 0x34, 0xf5, 0x7c, 0x6a, 0xda, 0xd1, 0x04, 0x2e, 0x29, 0x0a, 0x40, 0xd0, 0x7d, 0x2f, 0x18,
+    0xb5, 0xf9, 0x37, 0x87, 0x46, 0xec, 0xa3, 0x42, 0x15, 0x0e, 0x5d, 0xbc, 0x88, 0xbc, 0x78, 0x5e,
+    0x75, 0xfe, 0xbc, 0x4a, 0xf1, 0xe2, 0x62, 0x63, 0xc3, 0x18, 0x5a, 0x41, 0x9a, 0x19, 0xea, 0xd8,
+    0x03, 0xb7, 0x6c, 0xc3, 0x55, 0x86, 0x6d, 0x13, 0xee, 0x89, 0x05, 0x9d, 0x01, 0xf5, 0xdb, 0xd5,
+    0x5a, 0x2c, 0x4b, 0x80, 0x42, 0x14, 0x79, 0xa3, 0x36, 0x17, 0xaf, 0x12, 0x68, 0xcb, 0x3f, 0x27,
+    0x95, 0x0b, 0x4e, 0x8f, 0x18, 0x78, 0xeb, 0x53, 0x71, 0x09, 0x5b, 0x28, 0x68, 0x29, 0x64, 0xfe,
+    0x5d, 0xc2, 0x09, 0x51, 0x30, 0x0e, 0xdb, 0x8d, 0xca, 0x1b, 0x3a, 0x46, 0x82, 0x41, 0x8f, 0x16,
+    0x6a, 0x8d, 0x46, 0x49, 0xfd, 0xcf, 0xa8, 0xb4, 0x8a, 0x72, 0x49, 0xbb, 0x0a, 0x5b, 0x84, 0x9e,
+    0x63, 0x5b, 0x24, 0x3b, 0xad, 0x5a, 0x2b, 0x76, 0x6e, 0x3a, 0xc6, 0xa7, 0xe3, 0x30, 0xb2, 0xfb,
+    0x93, 0xb2, 0xd4, 0x2a, 0xf5, 0xda, 0x1c, 0x07, 0x21, 0x00, 0xcd, 0xf7, 0x6c, 0xfe, 0xc8, 0xd1,
+    0x0d, 0xd0, 0x67, 0xed, 0x2a, 0x9c, 0x49, 0xa1, 0x70, 0x9b, 0xb6, 0x7a, 0xb4, 0x25, 0x24, 0x69,
+    0xf3, 0x5b, 0xa2, 0x8e, 0x43, 0x8c, 0x5a, 0xa8, 0x1f, 0xb9, 0x3d, 0x44, 0x50, 0x4e, 0x97, 0x9e,
+    0xa7, 0xda, 0x88, 0x91, 0xdd, 0xef, 0xf7, 0xe5, 0xea, 0x61, 0x6d, 0xaa, 0x6d, 0xbb, 0x0d, 0xdb,
+    0xf2, 0xc7, 0x33, 0x21, 0xb6, 0x66, 0xa5, 0xa2, 0x96, 0x98, 0x2d, 0xab, 0xc9, 0x1a, 0xfc, 0xde,
+    0xbc, 0x11, 0x2b, 0x3b, 0xde, 0xc0, 0x9b, 0x46, 0xec, 0x3c, 0x2a, 0xf3, 0xe3, 0xaa, 0x13, 0x49,
+    0xc8, 0xd7, 0x2b, 0x78, 0x27, 0x04, 0xaf, 0xe9, 0x42, 0x5b, 0x40, 0x0c, 0x1b, 0x24, 0xa0, 0x6d,
+    0xd8, 0xac, 0xc3, 0x86, 0x4a, 0x78, 0x3d, 0x07, 0xac, 0xc4, 0xcc, 0x45, 0xe3, 0xdd, 0xa7, 0x28,
+    0x0c, 0xab, 0xda, 0xf2, 0x5a, 0x73, 0x86, 0xdf, 0x16, 0xf0, 0xbb, 0x82, 0xde, 0xd7, 0x5b, 0x26,
+    0x65, 0x75, 0xd0, 0xf7, 0x4a, 0xaf, 0x6e, 0xb5, 0xf0, 0x73, 0x7b, 0xbb, 0xd7, 0x2c, 0x76, 0x80,
+    0x4c, 0xef, 0xc4, 0x8e, 0xca, 0x09, 0x89, 0xb2, 0xe9, 0xd8, 0x7e, 0x1b, 0xcf, 0x19, 0x0f, 0xf2,
+    0x43, 0xf7, 0x6d, 0xc7, 0x29, 0x0b, 0xc9, 0xf0, 0x8b, 0xf1, 0x69, 0x00, 0x1b, 0x74, 0x1c, 0x16,
+    0x45, 0x68, 0x0b, 0x11, 0xff, 0xa8, 0xea, 0xb3, 0xc7, 0x0f, 0xc7, 0xbd, 0xa9, 0x94, 0x67, 0x83,
+    0x36, 0xfb, 0x2d, 0xaa, 0xdf, 0x79, 0x3d, 0x81, 0x79, 0xe4, 0xf9, 0xed, 0x66, 0xb2, 0x38, 0x8c,
+    0x68, 0x34, 0x0e, 0xe7, 0x88, 0x3b, 0xb6, 0x29, 0xa8, 0x22, 0xb3, 0x97, 0xbf, 0x55, 0x2f, 0x55,
+    0xef, 0x6c, 0x97, 0xee, 0xd4, 0xe1, 0xea, 0x17, 0x21, 0x59, 0x9b, 0x53, 0x2b, 0xce, 0x28, 0x48,
+    0x55, 0xb3, 0x61, 0x68, 0xb4, 0x48, 0x8c, 0x85, 0x3a, 0xd8, 0x84, 0x56, 0x45, 0xe7, 0x7d, 0x2b,
+    0x61, 0x96, 0x72, 0x53, 0x12, 0xae, 0x60, 0x67, 0x32, 0xda, 0x8d, 0xc7, 0xae, 0xd5, 0x91, 0xd4,
+    0x86, 0xd1, 0x8b, 0x5c, 0xa9, 0xc7, 0x60, 0x20, 0xdf, 0x48, 0x4e, 0xda, 0x88, 0x15, 0x59, 0xd8,
+    0xbf, 0x19, 0x9e, 0x6b, 0x0a, 0x11, 0x82, 0xaf, 0xc6, 0x3c, 0x40, 0xa7, 0xb5, 0x2e, 0xab, 0x58,
+    0x2f, 0xab, 0xce, 0xfc, 0x38, 0x02, 0xf2, 0xc0, 0x7d, 0x5b, 0xda, 0xdb, 0xc4, 0x04, 0x72, 0x7f,
+    0x59, 0x30, 0xee, 0x6c, 0x17, 0xe5, 0x0c, 0xd8, 0x07, 0x5d, 0xa6, 0x15, 0x1b, 0x4c, 0xa3, 0xa1,
+    0xb8, 0x73, 0x3d, 0xbc, 0x6a, 0x70, 0x32, 0xcc, 0xd2, 0x8c, 0x28, 0x9e, 0x58, 0xac, 0x2d, 0xfb,
+    0xd3, 0x55, 0x1c, 0xdc, 0x0c, 0xc0, 0x13, 0xf5, 0x17, 0x6e, 0x76, 0x48, 0x2d, 0xef, 0x0c, 0x1c,
+    0x14, 0xc8, 0x9c, 0xa0, 0xac, 0x04, 0x28, 0x2a, 0xa5, 0x6a, 0xab, 0x52, 0xaa, 0x55, 0x9b, 0x25,
+    0x63, 0xab, 0xa8, 0xb6, 0x13, 0x16, 0x06, 0xf9, 0x2a, 0xc4, 0x7c, 0x17, 0xa7, 0x29, 0x2a, 0x88,
+    0x11, 0x54, 0xf9, 0x0c, 0x95, 0xba, 0xa2, 0x12, 0x2e, 0xb7, 0x50, 0x95, 0x84, 0x45, 0x61, 0x6e,
+    0x62, 0xd4, 0x1a, 0x8d, 0xe5, 0x16, 0x58, 0xd1, 0x5f, 0xc0, 0xe5, 0x52, 0xb3, 0x58, 0x44, 0xb8,
+    0xa1, 0x78, 0xcb, 0x38, 0xc7, 0x9f, 0xce, 0x58, 0x20, 0xa1, 0x87, 0xc9, 0x38, 0x44, 0x56, 0x3d,
+    0xe6, 0x4c, 0x97, 0x59, 0xad, 0x66, 0x1a, 0x84, 0x5b, 0x19, 0x63, 0xae, 0x43, 0xb2, 0x51, 0x41,
+    0xe7, 0x65, 0xbb, 0xfe, 0x5c, 0xb8, 0xf3, 0x9b, 0x69, 0xce, 0xd1, 0xee, 0x8c, 0xe0, 0xa4, 0xa8,
+    0x6a, 0xcb, 0x04, 0x55, 0x9c, 0xa7, 0x2e, 0xe9, 0x68, 0x67, 0x46, 0x79, 0xbc, 0x71, 0x84, 0xe0,
+    0x12, 0xba, 0xa6, 0xa9, 0x8a, 0xa4, 0xc3, 0xd7, 0x4a, 0x67, 0x04, 0x47, 0x68, 0xf7, 0x3d, 0x13,
+    0x0c, 0x95, 0x3e, 0xd8, 0x96, 0x20, 0x94, 0x13, 0xda, 0x20, 0x34, 0x93, 0x0d, 0x3d, 0x07, 0x26,
+    0x4c, 0x63, 0x73, 0xd2, 0xa0, 0xdb, 0x15, 0xbc, 0x85, 0x51, 0x38, 0x98, 0xea, 0x36, 0x8d, 0x70,
+    0xa3, 0xb8, 0xd0, 0x2c, 0x71, 0x83, 0xc1, 0x9f, 0x67, 0xa4, 0x9d, 0x8a, 0x90, 0x90, 0xff, 0x38,
+    0xd8, 0x32, 0xea, 0x17, 0x7c, 0x1b, 0x83, 0x05, 0x81, 0x37, 0xc7, 0x61, 0x6e, 0xdd, 0x29, 0x35,
+    0x5b, 0xf8, 0x5f, 0xee, 0xd7, 0x95, 0xbe, 0xb4, 0xb6, 0xab, 0xdb, 0xd5, 0x45, 0xc1, 0x40, 0xb2,
+    0x44, 0x8b, 0x04, 0x38, 0x2c, 0xe4, 0x56, 0xe1, 0xd8, 0x34, 0x59, 0x98, 0xc5, 0xbe, 0x6e, 0xa0,
+    0x93, 0xcd, 0xa4, 0x71, 0x5d, 0xc5, 0x5e, 0xcf, 0x6c, 0xb6, 0x61, 0xf8, 0x20, 0x93, 0xc0, 0x3b,
+    0x4b, 0xdb, 0x5e, 0x34, 0x4b, 0x18, 0x4f, 0x2c, 0xb0, 0x5a, 0xd2, 0xc2, 0x73, 0xc5, 0x45, 0x24,
+    0x22, 0x0d, 0xb8, 0xa9, 0x71, 0x24, 0xf1, 0x58, 0xd7, 0xc2, 0xa8, 0x06, 0x7e, 0xcf, 0xba, 0x21,
+    0xcd, 0x23, 0xd7, 0x66, 0x0c, 0xee, 0x76, 0xda, 0x23, 0xbf, 0x3c, 0x74, 0x6b, 0xcb, 0xb0, 0x8b,
+    0x06, 0x2d, 0x85, 0x54, 0x69, 0xdc, 0xcb, 0xec, 0x14, 0x38, 0x0c, 0x95, 0xdd, 0x8c, 0x8f, 0x66,
+    0xa0, 0xff, 0x06, 0xbb, 0x3b, 0x0f, 0xa8, 0x19, 0x76, 0x35, 0x43, 0x06, 0x21, 0x61, 0x8a, 0x8c,
+    0x04, 0x51, 0x8a, 0x8a, 0x02, 0xcb, 0x62, 0x64, 0x61, 0x60, 0x99, 0xc4, 0xeb, 0x60, 0x3e, 0x4f,
+    0x18, 0x31, 0xea, 0x61, 0x8a, 0x72, 0x8c, 0x99, 0x14, 0x6d, 0x85, 0x8d, 0xc5, 0x40, 0xe2, 0x1c,
+    0x6a, 0xe1, 0x3b, 0xa7, 0x3e, 0xad, 0xbc, 0x51, 0x42, 0xb3, 0x32, 0x9d, 0x13, 0x8e, 0x7f, 0x88,
+    0xe1, 0x78, 0xad, 0xb1, 0x60, 0xac, 0x5c, 0xc7, 0x90, 0x7e, 0x7b, 0xd1, 0x30, 0x1f, 0x45, 0xe0,
+    0xb9, 0xe3, 0x11, 0xe8, 0x6d, 0x8c, 0xbb, 0x41, 0x60, 0x5b, 0x1d, 0xfc, 0x03, 0xd1, 0xd2, 0xc8,
+    0xc7, 0xb9, 0x65, 0xe1, 0xf2, 0xc3, 0x76, 0xc0, 0x7c, 0x46, 0xa3, 0xc2, 0x56, 0xa9, 0xda, 0x0f,
+    0x8a, 0xb1, 0xcb, 0xec, 0x24, 0xb9, 0x53, 0xad, 0x95, 0xc9, 0x9d, 0x2e, 0xd4, 0x06, 0xc4, 0x80,
+    0x93, 0x4d, 0x53, 0x99, 0xd4, 0x5a, 0x68, 0x6c, 0xae, 0x81, 0xc6, 0xea, 0xfa, 0x86, 0x34, 0x1d,
+    0x58, 0xa4, 0xed, 0xea, 0x6c, 0x98, 0x51, 0x6d, 0x84, 0x1d, 0x91, 0x38, 0x33, 0x07, 0xa2, 0x22,
+    0x05, 0x51, 0xed, 0x9c, 0x2a, 0x80, 0x58, 0x82, 0x47, 0x50, 0x8a, 0x6c, 0x78, 0xd1, 0x28, 0xa6,
+    0xe9, 0x18, 0x7d, 0x3d, 0xe4, 0xe6, 0x16, 0x35, 0xe5, 0x8d, 0xf0, 0xfe, 0x24, 0xdc, 0x30, 0xd5,
+    0xbe, 0x29, 0xaa, 0xbf, 0x48, 0xcd, 0xce, 0x84, 0xf4, 0xdb, 0xb5, 0x9b, 0x42, 0x7a, 0xe1, 0x50,
+    0x75, 0x1a, 0xa9, 0x24, 0xa4, 0xa6, 0xe9, 0xb5, 0xc4, 0x7b, 0x9a, 0x40, 0x2b, 0xb3, 0xde, 0x9f,
+    0xce, 0x71, 0xaf, 0xc9, 0x69, 0xd3, 0x0e, 0x00, 0x72, 0x18, 0xc3, 0x04, 0x69, 0x46, 0x10, 0xb4,
+    0xa4, 0x04, 0xa3, 0xb9, 0x69, 0x19, 0x9c, 0xeb, 0x5e, 0x66, 0x2e, 0xd6, 0x50, 0x74, 0xfc, 0x12,
+    0x6d, 0xb7, 0xef, 0x25, 0xb8, 0xac, 0xc4, 0x9e, 0x6b, 0xa9, 0x29, 0x59, 0x80, 0x34, 0x6d, 0x12,
+    0xa6, 0x6c, 0x8b, 0xbd, 0x9f, 0x26, 0xd0, 0x05, 0xe1, 0x86, 0x48, 0x74, 0x3a, 0xab, 0x64, 0xd9,
+    0x2d, 0x11, 0x76, 0x87, 0x60, 0x82, 0x5c, 0x96, 0x24, 0xe6, 0xb6, 0xcb, 0xa5, 0x27, 0x2e, 0x52,
+    0x06, 0x28, 0xad, 0xc4, 0x21, 0xf0, 0xef, 0x2b, 0x98, 0xef, 0xad, 0xf8, 0x1c, 0x20, 0xcc, 0x72,
+    0x2a, 0x0c, 0x9d, 0xcd, 0xc9, 0x35, 0xcb, 0x08, 0xbc, 0x10, 0xa3, 0x19, 0x12, 0x11, 0xde, 0x12,
+    0x10, 0x32, 0x96, 0x9e, 0x58, 0xda, 0xc0, 0xc1, 0xa4, 0x69, 0xe4, 0x69, 0xf6, 0x29, 0xf0, 0x20,
+    0x5d, 0x62, 0x85, 0xad, 0x66, 0x05, 0x62, 0x60, 0x61, 0x9e, 0xfa, 0x9e, 0x07, 0xe7, 0xbc, 0x21,
+    0x81, 0x4a, 0xf2, 0x9b, 0x2d, 0x5a, 0xa7, 0xcd, 0x54, 0x28, 0x54, 0x4d, 0xc7, 0x1c, 0xc2, 0x28,
+    0xed, 0x6c, 0xca, 0x3a, 0xd6, 0xce, 0xa6, 0xac, 0xb0, 0x61, 0x91, 0x0a, 0x3e, 0x2c, 0xfb, 0x94,
+    0x98, 0x0e, 0x0d, 0xc3, 0xdd, 0x1c, 0xf5, 0xfd, 0x5c, 0x77, 0x63, 0x63, 0xe7, 0x56, 0xb9, 0x4c,
+    0x76, 0xe7, 0xfc, 0x87, 0xdc, 0x7f, 0xf8, 0x60, 0x6f, 0xfe, 0x48, 0xb9, 0x2c, 0x49, 0xd9, 0xd6,
+    0x6e, 0x4e, 0xd4, 0x70, 0xca, 0x98, 0x61, 0xe5, 0x14, 0x6d, 0xf1, 0x8e, 0x08, 0x33, 0x01, 0xbb,
+    0x10, 0xa2, 0xef, 0x1c, 0xa7, 0x9d, 0x7c, 0x04, 0xc6, 0x20, 0x2b, 0x75, 0xd5, 0x20, 0x2a, 0x6d,
+    0xae, 0xfb, 0x9b, 0x2f, 0x7e, 0xfe, 0x19, 0x1c, 0x02, 0xde, 0xcb, 0x29, 0xc3, 0x6a, 0xf7, 0xe0,
+    0xee, 0x93, 0xc3, 0x77, 0x1f, 0x7f, 0x44, 0x0e, 0x1e, 0xde, 0x7b, 0x7f, 0xef, 0x31, 0x9c, 0xac,
+    0x2a, 0xc7, 0xfc, 0x78, 0xdb, 0x71, 0x2f, 0xd7, 0xbd, 0x7f, 0x7d, 0xf9, 0x13, 0x12, 0x0d, 0xaf,
+    0x2f, 0x9f, 0xba, 0x03, 0x12, 0x5d, 0x5f, 0x7e, 0x45, 0x06, 0xf6, 0xf5, 0xf3, 0x5f, 0x45, 0xf0,
+    0xee, 0xea, 0x3f, 0xe1, 0xd5, 0xc8, 0x76, 0x87, 0x3b, 0x9b, 0x3e, 0x67, 0x6a, 0x13, 0xb8, 0x9a,
+    0xcb, 0x9d, 0xc8, 0x6b, 0x73, 0xfc, 0x80, 0xa2, 0xc2, 0x78, 0x24, 0xde, 0x00, 0x67, 0x9f, 0xff,
+    0x82, 0xbc, 0x03, 0xaa, 0x7d, 0x5b, 0xb0, 0x8d, 0x33, 0x70, 0x09, 0xbc, 0xda, 0xb7, 0x72, 0xdd,
+    0xb2, 0xe4, 0x9a, 0x7c, 0xfb, 0xa7, 0x3f, 0x27, 0x2f, 0x3e, 0xa3, 0xb0, 0xe1, 0xc9, 0xf5, 0xf3,
+    0x5f, 0x47, 0xc4, 0x05, 0x86, 0x6c, 0xc3, 0x30, 0x16, 0xef, 0x29, 0xd3, 0x53, 0x25, 0x94, 0xde,
+    0x18, 0x74, 0x28, 0x16, 0x0b, 0xe4, 0x10, 0x84, 0x67, 0x3b, 0x39, 0xe2, 0xb9, 0x90, 0xfa, 0x9b,
+    0x27, 0xbb, 0xb9, 0x81, 0x57, 0xc8, 0x83, 0x18, 0x6d, 0x37, 0x5f, 0xe4, 0x12, 0x7b, 0x0a, 0x1b,
+    0xbe, 0xf8, 0x11, 0xec, 0xe8, 0x0e, 0xaf, 0x9f, 0x7f, 0xed, 0x93, 0x37, 0xc9, 0x83, 0xeb, 0xcb,
+    0x2f, 0xc8, 0xc9, 0xf0, 0xea, 0x3f, 0xe8, 0xce, 0xa6, 0xa0, 0xb7, 0xf0, 0xd8, 0x02, 0x88, 0xb9,
+    0xee, 0x23, 0x48, 0xec, 0x02, 0x66, 0x91, 0xde, 0x84, 0xa4, 0x6b, 0xa4, 0x64, 0xdf, 0x3b, 0x96,
+    0x2b, 0xe5, 0xc7, 0x12, 0xec, 0x1c, 0x3c, 0x7c, 0x6f, 0xff, 0x70, 0x75, 0xf0, 0xf0, 0x53, 0xcc,
+    0xa0, 0x27, 0x0b, 0x1b, 0x0b, 0xd8, 0x4b, 0x61, 0x05, 0x8d, 0x58, 0x4a, 0x1e, 0xf7, 0x41, 0x8e,
+    0x05, 0x10, 0xc6, 0xb7, 0x3f, 0x56, 0xe8, 0xd9, 0x19, 0xd6, 0xba, 0x29, 0xa9, 0x00, 0x6e, 0x6a,
+    0xdd, 0x44, 0x02, 0x3e, 0xe1, 0x9a, 0xb2, 0x9b, 0x5b, 0x68, 0xa7, 0xb7, 0xe6, 0xd6, 0xf8, 0x72,
+    0xdd, 0x43, 0x21, 0x64, 0x36, 0xa2, 0xb6, 0x43, 0x5e, 0x3c, 0xbd, 0xbe, 0xfc, 0x91, 0xd8, 0xc1,
+    0x25, 0xa3, 0xab, 0x2f, 0xc9, 0xc3, 0xe3, 0x47, 0xe4, 0xfc, 0xea, 0x17, 0x26, 0x47, 0xe2, 0x2f,
+    0x4d, 0x05, 0xb8, 0x94, 0xc0, 0x55, 0xde, 0xa6, 0x6e, 0x9c, 0xa7, 0x6f, 0xdd, 0x3d, 0x24, 0xb8,
+    0xb3, 0x29, 0x1e, 0xc4, 0x00, 0x0f, 0xbc, 0x48, 0x34, 0xf1, 0x81, 0x4f, 0xbe, 0x5f, 0x2c, 0x2a,
+    0x18, 0x11, 0x20, 0xe5, 0xaf, 0xf7, 0x71, 0x5e, 0x8e, 0x68, 0x89, 0x0c, 0x0c, 0x9c, 0x53, 0x88,
+    0x73, 0xd8, 0xdb, 0x03, 0x9c, 0x00, 0xee, 0x65, 0x94, 0xe3, 0x81, 0x0b, 0x7c, 0x81, 0xb7, 0x51,
+    0x4c, 0x30, 0x8d, 0x8b, 0x85, 0xd8, 0xc3, 0xad, 0xe0, 0xeb, 0x11, 0x73, 0xad, 0x87, 0x91, 0x8e,
+    0xc5, 0x50, 0xbc, 0x29, 0x70, 0x24, 0x7e, 0xfe, 0x15, 0x79, 0xef, 0xfa, 0xf2, 0x6b, 0x5b, 0x49,
+    0x22, 0x05, 0x3e, 0x4d, 0x04, 0x90, 0x82, 0x08, 0x92, 0xfc, 0xfe, 0x1f, 0xc0, 0x53, 0x77, 0x65,
+    0x84, 0xa1, 0x80, 0x57, 0xc6, 0x97, 0x87, 0xbc, 0xbe, 0x22, 0xba, 0xf0, 0x31, 0x8b, 0xad, 0x0f,
+    0x93, 0x3b, 0x16, 0x27, 0x7d, 0x65, 0x74, 0xb5, 0x10, 0x5c, 0x0f, 0x24, 0x84, 0x5e, 0x3c, 0x85,
+    0x2f, 0x03, 0x2e, 0x4b, 0x80, 0xd8, 0xf3, 0x5f, 0xbb, 0x60, 0x2c, 0xa3, 0xc0, 0x03, 0x34, 0xe3,
+    0xe9, 0xe0, 0x58, 0x7b, 0xe2, 0xf6, 0xd0, 0xe0, 0xe3, 0xeb, 0xee, 0x1a, 0x40, 0x93, 0x00, 0x56,
+    0x68, 0x6d, 0x92, 0x10, 0x4c, 0xd4, 0x62, 0xe0, 0xa1, 0x8b, 0xca, 0xe2, 0x0e, 0x58, 0x98, 0x87,
+    0xba, 0x6a, 0x6d, 0xab, 0xde, 0x68, 0xe6, 0x08, 0x04, 0xcf, 0x0e, 0x73, 0x07, 0xd1, 0x70, 0x37,
+    0x07, 0x4f, 0x3e, 0xc5, 0x22, 0xa4, 0xbb, 0x9b, 0xfb, 0x63, 0x6b, 0xda, 0xbc, 0x00, 0x02, 0xb8,
+    0x72, 0xe4, 0x59, 0x40, 0x1d, 0xa2, 0x42, 0x16, 0xd8, 0x66, 0x4e, 0x09, 0x6c, 0x69, 0xf0, 0xcc,
+    0x43, 0xa7, 0x74, 0x41, 0xb3, 0x95, 0xcd, 0xee, 0xd6, 0xc4, 0xf4, 0x07, 0xd8, 0x9b, 0x99, 0xa4,
+    0x51, 0x7d, 0xaa, 0xde, 0xf1, 0x8b, 0xff, 0xfb, 0x3f, 0x27, 0xfc, 0xba, 0x85, 0x9a, 0xdf, 0x08,
+    0x6a, 0x10, 0xcd, 0x7a, 0x90, 0x7e, 0xbc, 0xf7, 0xde, 0xfe, 0xd1, 0xf1, 0xde, 0xe3, 0xd5, 0x71,
+    0x1d, 0xb0, 0x81, 0x1d, 0xa2, 0xd9, 0xfe, 0x8e, 0x4d, 0xe7, 0xc9, 0xd5, 0x37, 0x24, 0xba, 0x7a,
+    0x66, 0x83, 0x2f, 0xf1, 0xae, 0x9f, 0x7f, 0xe9, 0xbe, 0x36, 0x23, 0x7a, 0xac, 0x11, 0x25, 0xa3,
+    0xeb, 0xcb, 0xbf, 0xb3, 0x6f, 0x91, 0x0f, 0xc6, 0x36, 0x71, 0xae, 0xfe, 0x3d, 0xf1, 0x63, 0xd2,
+    0x71, 0x47, 0x10, 0x73, 0x09, 0x3b, 0x3b, 0xf4, 0xae, 0x9e, 0xb9, 0xe0, 0xdb, 0x9f, 0xff, 0x73,
+    0x04, 0x6f, 0x14, 0x87, 0xc6, 0x1a, 0xd8, 0x87, 0x20, 0xe1, 0xaf, 0xd6, 0x85, 0x3a, 0x08, 0xfb,
+    0x80, 0x86, 0xd1, 0x21, 0xc5, 0x40, 0x27, 0x85, 0xf6, 0xc3, 0xc1, 0x78, 0xa2, 0xa4, 0x3e, 0xdf,
+    0xb7, 0xce, 0xe7, 0xe2, 0xf8, 0xea, 0x5f, 0xdc, 0x97, 0xe0, 0xe2, 0x7b, 0x76, 0x30, 0x97, 0x8d,
+    0x0f, 0xe0, 0x7a, 0xef, 0xae, 0xcf, 0xc5, 0xe1, 0xe0, 0xea, 0xd9, 0x84, 0x84, 0x3c, 0x2c, 0x5a,
+    0xc4, 0x8b, 0x05, 0x71, 0xeb, 0x5c, 0x5e, 0xde, 0xb1, 0x83, 0x68, 0x68, 0xd1, 0x49, 0x2e, 0x05,
+    0x81, 0x72, 0x68, 0x0e, 0xd9, 0x88, 0xb5, 0x2d, 0x1a, 0x9c, 0xac, 0xa9, 0x86, 0x8f, 0x63, 0x48,
+    0xc7, 0xe0, 0x54, 0xbe, 0x4a, 0x0c, 0x05, 0x3c, 0x04, 0x97, 0x8e, 0xe6, 0x1f, 0x48, 0x82, 0xd0,
+    0x1b, 0x15, 0x12, 0xd8, 0x5d, 0x4f, 0x21, 0x1f, 0xad, 0x13, 0xc3, 0xf8, 0xdf, 0x61, 0x04, 0xa3,
+    0x99, 0x6a, 0xe0, 0x69, 0x46, 0xfb, 0xb4, 0x0d, 0xe2, 0x8c, 0x4f, 0x1c, 0x18, 0x1f, 0xf7, 0xf1,
+    0x09, 0x44, 0xf5, 0xf4, 0x9f, 0x48, 0x12, 0xb0, 0xe2, 0x00, 0x07, 0x50, 0x57, 0x6d, 0xf2, 0xaa,
+    0x2e, 0x2b, 0x9b, 0x81, 0xe6, 0x66, 0xb8, 0x96, 0x0e, 0x46, 0xaa, 0xf0, 0x08, 0x23, 0x53, 0x8c,
+    0xce, 0xe7, 0x28, 0xad, 0xac, 0x15, 0x8a, 0x33, 0xc0, 0xc3, 0x63, 0xf8, 0x7e, 0x93, 0x7e, 0xc4,
+    0xf5, 0xa9, 0x1c, 0x09, 0x20, 0xe3, 0xf1, 0x5c, 0x67, 0xf2, 0xff, 0x4b, 0xe6, 0xdb, 0x01, 0x51,
+    0x80, 0x51, 0x12, 0xd5, 0x06, 0x20, 0x75, 0xd5, 0xb0, 0xe8, 0x07, 0x2c, 0x0c, 0xdf, 0x67, 0x93,
+    0x42, 0xbe, 0x8a, 0xf9, 0x45, 0x35, 0xa6, 0xb5, 0xda, 0xa2, 0x1a, 0x2e, 0xaa, 0xad, 0xb9, 0x68,
+    0x0b, 0x17, 0x6d, 0xad, 0xb9, 0xa8, 0x8e, 0x8b, 0xea, 0x6b, 0x2e, 0x6a, 0xe0, 0xa2, 0xc6, 0x9a,
+    0x8b, 0x9a, 0xb8, 0xa8, 0xb9, 0xe6, 0xa2, 0x6d, 0x5c, 0xb4, 0xbd, 0xe6, 0xa2, 0x16, 0x2e, 0x6a,
+    0xad, 0xb9, 0xe8, 0x0e, 0x2e, 0xba, 0xb3, 0x78, 0x11, 0xe9, 0xbb, 0xba, 0x55, 0x75, 0x18, 0x0d,
+    0x1e, 0xd9, 0xdc, 0x92, 0x7e, 0xc8, 0x33, 0xc4, 0xb5, 0x36, 0xab, 0xe0, 0x66, 0x95, 0x55, 0x37,
+    0x03, 0x7c, 0xbe, 0x03, 0xa6, 0x0e, 0xa3, 0x35, 0x61, 0xde, 0xfe, 0xf2, 0x5f, 0x13, 0x6c, 0xae,
+    0xec, 0x1b, 0x80, 0xdb, 0x27, 0x2e, 0xd6, 0x7b, 0x34, 0xca, 0x43, 0xea, 0x5a, 0x0e, 0x8b, 0x47,
+    0x80, 0x38, 0x51, 0xed, 0x35, 0x65, 0xc9, 0x66, 0x8a, 0x65, 0x3c, 0x57, 0xfe, 0x7c, 0x51, 0x6e,
+    0x3c, 0xcf, 0x71, 0xf8, 0xeb, 0x26, 0x27, 0x47, 0x4f, 0xee, 0xdd, 0xdb, 0x3b, 0x3a, 0x5a, 0xdd,
+    0x79, 0xc8, 0x9a, 0xe1, 0x4d, 0x0e, 0x44, 0x2b, 0x2d, 0x2e, 0xae, 0x9d, 0x40, 0x9c, 0x9a, 0x2e,
+    0x9d, 0xd4, 0xc4, 0x4e, 0x62, 0xed, 0x31, 0xfe, 0xd0, 0x09, 0x02, 0xaf, 0x21, 0x84, 0x50, 0x43,
+    0x62, 0x62, 0x64, 0x75, 0x8b, 0x3b, 0x14, 0x55, 0x4b, 0xd1, 0xe6, 0xf2, 0x43, 0x1f, 0x63, 0x09,
+    0x85, 0xe7, 0x21, 0x68, 0xb3, 0x0d, 0x02, 0xa1, 0xd3, 0xdf, 0x80, 0x93, 0xb8, 0x7e, 0xfe, 0x0d,
+    0xda, 0xef, 0x5f, 0x0a, 0x11, 0x92, 0x90, 0x8e, 0x49, 0x83, 0x0c, 0xec, 0xab, 0x7f, 0x9c, 0x18,
+    0xcb, 0xaa, 0x2b, 0x71, 0x7d, 0x53, 0x48, 0x36, 0x79, 0xec, 0xde, 0x04, 0x83, 0x70, 0x9e, 0x9f,
+    0x9c, 0x73, 0xc5, 0x22, 0xb0, 0xfc, 0xcd, 0x17, 0x3f, 0x7d, 0x46, 0x3e, 0xb8, 0xbe, 0xfc, 0x33,
+    0x82, 0xe5, 0xb7, 0x01, 0x31, 0x87, 0xdc, 0xd7, 0xa8, 0x8b, 0x8e, 0xaf, 0x50, 0x7d, 0x82, 0xc0,
+    0x6d, 0x3f, 0xea, 0x6e, 0x6c, 0x6e, 0x12, 0xac, 0xf4, 0xb0, 0x0d, 0x08, 0x38, 0xc8, 0xa7, 0x67,
+    0x11, 0xd9, 0x25, 0xf9, 0x7c, 0x87, 0x3f, 0x89, 0x3b, 0xb9, 0x0f, 0x21, 0x88, 0x17, 0x4c, 0xe0,
+    0xfd, 0xc7, 0x79, 0x2c, 0xdb, 0xe4, 0x3f, 0x11, 0xa3, 0x3d, 0xac, 0xff, 0xc0, 0xdb, 0xaa, 0x78,
+    0x04, 0xc8, 0xec, 0x5b, 0xe7, 0xf0, 0x5c, 0x11, 0xcf, 0xa6, 0x75, 0x6c, 0x43, 0x86, 0x03, 0x2f,
+    0xdc, 0xb1, 0xe3, 0x74, 0x36, 0x70, 0xa3, 0x7d, 0xd7, 0x8e, 0x36, 0x68, 0x38, 0x71, 0x4d, 0xd2,
+    0x1f, 0xbb, 0xbc, 0xfa, 0x43, 0xb0, 0x8c, 0x58, 0x28, 0x92, 0x29, 0xc8, 0x21, 0x82, 0x5d, 0xa6,
+    0xfc, 0x56, 0xe0, 0x5a, 0xc3, 0x08, 0x0c, 0x7b, 0x08, 0xcb, 0xe9, 0x19, 0xb5, 0x23, 0xd2, 0x67,
+    0x91, 0x39, 0x2c, 0xe4, 0x37, 0xa9, 0x6f, 0x6f, 0xa2, 0xbf, 0xcf, 0x17, 0x3b, 0xda, 0x4c, 0x2b,
+    0x9e, 0x07, 0x6b, 0x8c, 0x4f, 0x43, 0x0c, 0x97, 0xc4, 0xb8, 0xe2, 0xd2, 0x32, 0xc4, 0xb7, 0x1f,
+    0xfe, 0x10, 0x19, 0xc6, 0x11, 0xcb, 0x33, 0x21, 0x05, 0x73, 0x23, 0x63, 0xc0, 0xa2, 0x3d, 0x87,
+    0xe1, 0xd7, 0x77, 0x26, 0xfb, 0x56, 0x21, 0x1f, 0x17, 0xb7, 0xf2, 0x45, 0x03, 0x7d, 0xce, 0x3d,
+    0xd1, 0xa4, 0x03, 0x22, 0x9c, 0x84, 0xbe, 0x2f, 0xf2, 0xb7, 0x90, 0x8e, 0x5e, 0x46, 0x53, 0xec,
+    0x86, 0x06, 0xaf, 0xe9, 0xde, 0x3f, 0x7e, 0x70, 0x80, 0x82, 0x4e, 0x6a, 0x6b, 0x79, 0xf2, 0x96,
+    0xe4, 0xf5, 0x2d, 0x92, 0xe7, 0xb5, 0x34, 0x7c, 0x53, 0xb0, 0x0c, 0x51, 0x98, 0x43, 0xc5, 0x22,
+    0xf9, 0x27, 0x87, 0xbc, 0x14, 0xf8, 0x6e, 0x9e, 0xfc, 0x21, 0xae, 0x05, 0x9d, 0x16, 0x05, 0x37,
+    0xc4, 0x69, 0x9e, 0xb4, 0xf9, 0xbb, 0x9f, 0x91, 0xa3, 0xeb, 0xe7, 0xff, 0xe5, 0x92, 0x10, 0xe0,
+    0x3e, 0x10, 0xdb, 0x5e, 0x10, 0x93, 0xa2, 0xf4, 0x58, 0x31, 0x25, 0xde, 0x57, 0x65, 0xfe, 0xdb,
+    0xbf, 0x7d, 0xf6, 0xbf, 0xff, 0xfd, 0x53, 0x72, 0x70, 0x7d, 0xf9, 0xd7, 0xb6, 0x5e, 0xf3, 0x83,
+    0xf4, 0xc5, 0xe6, 0x4f, 0xbd, 0xeb, 0xcb, 0xbf, 0xc8, 0xab, 0xa5, 0x1c, 0xb7, 0x86, 0xa8, 0x31,
+    0xdf, 0xe3, 0xad, 0x6a, 0x20, 0x31, 0xdb, 0x8e, 0xdb, 0x2a, 0xce, 0xce, 0x8f, 0xab, 0xf6, 0xf3,
+    0xa6, 0x57, 0x67, 0xa7, 0x9b, 0x8a, 0xb0, 0x6c, 0xfd, 0xf1, 0xe1, 0x8b, 0x8d, 0x0b, 0x8e, 0xbe,
+    0x43, 0x7a, 0x6a, 0x0f, 0x78, 0x2c, 0xbd, 0x11, 0xa3, 0x6f, 0xe0, 0x15, 0xf0, 0xe7, 0x96, 0x42,
+    0x30, 0x42, 0x2c, 0xe6, 0x38, 0xd0, 0x05, 0xf3, 0x83, 0x31, 0x0b, 0x26, 0x47, 0xbc, 0x31, 0xe4,
+    0x05, 0x85, 0x7c, 0xfa, 0x17, 0x7c, 0x42, 0x32, 0x76, 0x9f, 0x14, 0x60, 0x55, 0x11, 0x97, 0x1a,
+    0x5c, 0x89, 0x0f, 0x40, 0x67, 0x8c, 0x80, 0x8d, 0xbc, 0x53, 0x56, 0xc8, 0xeb, 0x53, 0x17, 0xca,
+    0x5b, 0x9a, 0x45, 0xbc, 0x74, 0xce, 0x90, 0x46, 0x87, 0x5a, 0x56, 0x9a, 0x48, 0x4a, 0x2f, 0x0d,
+    0x7f, 0x1c, 0x0e, 0xc5, 0x21, 0x3a, 0x78, 0xd0, 0xf8, 0x68, 0xa2, 0x7c, 0xc3, 0x0f, 0x86, 0x0c,
+    0xa6, 0x17, 0x89, 0x1a, 0x05, 0xd9, 0x01, 0xf5, 0x2d, 0x82, 0xce, 0x44, 0xe3, 0xc0, 0x9d, 0x43,
+    0xd9, 0xf3, 0x85, 0x1a, 0x09, 0xc1, 0x80, 0x2b, 0x3c, 0x05, 0xc9, 0xa4, 0xe6, 0x7c, 0x3c, 0x97,
+    0x6c, 0x99, 0x54, 0x3f, 0xe9, 0xfc, 0xfe, 0x08, 0x14, 0x19, 0x5f, 0x22, 0x50, 0x5d, 0x68, 0xca,
+    0xce, 0x72, 0xb1, 0x25, 0xd6, 0x90, 0xa4, 0xcc, 0x1b, 0x59, 0x62, 0x19, 0x25, 0xf3, 0xc2, 0xf8,
+    0x01, 0x19, 0xc2, 0xa3, 0x8e, 0x7d, 0xcc, 0x0f, 0x4e, 0xa9, 0x13, 0x0f, 0x74, 0x66, 0xed, 0x23,
+    0xa0, 0x94, 0x2c, 0x90, 0xd1, 0x5d, 0xc7, 0x01, 0x31, 0x81, 0x6f, 0x06, 0x7b, 0x04, 0x29, 0xed,
+    0x1e, 0x05, 0x55, 0x1e, 0x91, 0xdd, 0x2e, 0x10, 0x1f, 0x89, 0x53, 0x61, 0x66, 0x83, 0x9c, 0xe2,
+    0x9c, 0x0e, 0xbc, 0x14, 0xca, 0x20, 0xfb, 0x46, 0x38, 0x80, 0x1d, 0x4d, 0x18, 0xb9, 0x48, 0x8b,
+    0x6c, 0xce, 0x2e, 0x10, 0x52, 0x6b, 0xbb, 0xd8, 0xb8, 0x8b, 0x6d, 0x00, 0xe3, 0x63, 0x4e, 0x5f,
+    0x88, 0x3c, 0x89, 0xa3, 0x7e, 0x4f, 0xee, 0x98, 0xcb, 0x7e, 0xa9, 0xc6, 0x08, 0x27, 0xd3, 0x91,
+    0x86, 0xe0, 0xc9, 0x3e, 0x19, 0x32, 0xc7, 0x67, 0x41, 0x98, 0x5c, 0x7c, 0x38, 0xf4, 0xce, 0xc0,
+    0xfb, 0x17, 0x6c, 0xab, 0xc4, 0xd3, 0x0d, 0xf8, 0x0b, 0xa6, 0x5f, 0xb7, 0x0b, 0xcc, 0x59, 0x62,
+    0x2f, 0x6d, 0x8b, 0xef, 0xc3, 0x9c, 0xcc, 0x85, 0x70, 0x3b, 0x8e, 0x14, 0xe5, 0x78, 0xda, 0xa3,
+    0xf0, 0x9f, 0x33, 0x8a, 0x81, 0xcc, 0xa5, 0xf1, 0x46, 0x5f, 0x3e, 0x8d, 0xcf, 0x90, 0x45, 0x07,
+    0x1e, 0xc5, 0x3e, 0x59, 0x01, 0x42, 0x84, 0x7d, 0x60, 0xd6, 0x73, 0x75, 0x26, 0x31, 0x76, 0x58,
+    0xcc, 0x25, 0x5f, 0x12, 0x4b, 0xff, 0x16, 0x3c, 0xea, 0xca, 0x0f, 0x8f, 0x46, 0x1c, 0x49, 0xee,
+    0x02, 0x61, 0x35, 0x91, 0x6f, 0xc1, 0x87, 0xbf, 0xcf, 0xbd, 0x20, 0x7c, 0x89, 0x1d, 0x41, 0x27,
+    0xfd, 0x88, 0x7c, 0xa7, 0x22, 0x34, 0xd9, 0xc4, 0x8c, 0xf3, 0x6e, 0xe9, 0xb1, 0xce, 0xaf, 0x2f,
+    0xbf, 0x26, 0xce, 0xd5, 0x37, 0x86, 0x61, 0xe4, 0x05, 0xf6, 0x99, 0x13, 0x32, 0xb9, 0x8b, 0x4e,
+    0x4d, 0xee, 0x0a, 0x6e, 0x3b, 0xff, 0xf0, 0x7d, 0x3e, 0x55, 0xdc, 0x61, 0xa6, 0xf5, 0x52, 0xe0,
+    0x85, 0x61, 0x2c, 0xec, 0x16, 0xb5, 0xc1, 0x8d, 0xd9, 0x70, 0x23, 0x2e, 0xdb, 0xeb, 0x37, 0xcb,
+    0x57, 0x2e, 0x71, 0x86, 0x49, 0xaf, 0x01, 0x60, 0xc6, 0xb5, 0xc1, 0x88, 0x02, 0x7b, 0x54, 0x48,
+    0x44, 0x29, 0x48, 0x00, 0x97, 0xe2, 0x1b, 0x1c, 0xc1, 0x74, 0xc6, 0x16, 0x0b, 0x0b, 0xf9, 0xb7,
+    0xf3, 0x45, 0xe5, 0x76, 0x15, 0xc6, 0xf2, 0xaa, 0xfa, 0x9f, 0x2f, 0x91, 0x3c, 0xff, 0xdd, 0x0a,
+    0x7e, 0xc9, 0x54, 0x01, 0x05, 0x4d, 0x08, 0xe3, 0xbe, 0xf4, 0x89, 0x73, 0x7d, 0xf9, 0x13, 0xe5,
+    0x86, 0x93, 0x1b, 0x43, 0xb9, 0x69, 0x88, 0xc8, 0x27, 0x8d, 0x0a, 0x20, 0x18, 0x05, 0x63, 0xc6,
+    0x57, 0xac, 0x1a, 0x56, 0xf9, 0x81, 0x77, 0x3e, 0xd9, 0x44, 0x01, 0x61, 0xfb, 0x00, 0x28, 0x88,
+    0x45, 0x84, 0x8c, 0x58, 0x34, 0xf4, 0x2c, 0x08, 0x2f, 0x1e, 0x3d, 0x3c, 0x3a, 0xce, 0x97, 0xe4,
+    0x5b, 0xec, 0xb3, 0x82, 0x0a, 0xb5, 0xe1, 0xd2, 0xf2, 0x12, 0xd0, 0xe5, 0x63, 0xc0, 0x79, 0x1e,
+    0x26, 0x52, 0xdf, 0x87, 0xb8, 0x95, 0xfb, 0xda, 0x4d, 0x8c, 0xc6, 0xf2, 0xe4, 0x42, 0x2d, 0xc3,
+    0xbe, 0x6c, 0x9b, 0xfc, 0xd1, 0xd1, 0xc3, 0x43, 0x40, 0x7c, 0x00, 0x6c, 0xdb, 0xfd, 0x49, 0x61,
+    0x2a, 0x0f, 0x7b, 0x51, 0xe4, 0xb3, 0x2e, 0xd2, 0xc1, 0x1d, 0x8d, 0xe8, 0xc2, 0xf8, 0x0e, 0xa5,
+    0x8f, 0x13, 0xd4, 0x8f, 0x10, 0x8a, 0x31, 0xd7, 0x67, 0xb6, 0x0b, 0x71, 0xb6, 0xf1, 0x7d, 0x75,
+    0xbb, 0xfc, 0xb3, 0x23, 0x07, 0x17, 0x5e, 0xb5, 0xea, 0x30, 0x64, 0x62, 0xbf, 0xd4, 0x72, 0x6c,
+    0x44, 0xa2, 0x8c, 0x24, 0x13, 0x17, 0x12, 0xbd, 0x72, 0x74, 0xe9, 0x3d, 0x73, 0x66, 0x47, 0xc0,
+    0x29, 0x1d, 0x30, 0x0e, 0x6b, 0x11, 0x3f, 0x89, 0x96, 0x07, 0xa0, 0x37, 0xa6, 0x39, 0x2f, 0x70,
+    0x5b, 0x8e, 0xa0, 0x6c, 0x24, 0x16, 0x82, 0xd7, 0x61, 0x81, 0x8c, 0x02, 0x97, 0x81, 0xa5, 0x4f,
+    0xe1, 0x00, 0xc2, 0x40, 0xce, 0x28, 0x8c, 0xd6, 0x11, 0xd0, 0x54, 0x06, 0x0e, 0xbf, 0x4c, 0x61,
+    0x54, 0x93, 0x64, 0x81, 0xba, 0xc0, 0xb0, 0x0a, 0x15, 0x6e, 0x81, 0x02, 0x37, 0x33, 0xc7, 0x13,
+    0x9d, 0x84, 0xe5, 0xea, 0x81, 0x65, 0xb5, 0xaf, 0x54, 0x8d, 0x4d, 0x13, 0xdc, 0x52, 0xf5, 0x88,
+    0x7b, 0x1e, 0x2f, 0xaf, 0x20, 0x42, 0x20, 0xff, 0x57, 0x2a, 0xd2, 0x4e, 0xe3, 0xba, 0xc4, 0x6f,
+    0xe2, 0xd5, 0xd5, 0x86, 0xbc, 0xf9, 0xa6, 0x40, 0x26, 0xfe, 0x49, 0x74, 0x28, 0x9e, 0xc6, 0xff,
+    0xb8, 0xec, 0xec, 0x09, 0x20, 0x0a, 0x51, 0x9b, 0xbc, 0xb4, 0xc3, 0x43, 0xf1, 0x3a, 0x59, 0x45,
+    0x08, 0x46, 0xdb, 0xec, 0x8c, 0x60, 0xd5, 0x95, 0x7c, 0xfb, 0xe3, 0x9f, 0x81, 0xbe, 0x90, 0xc8,
+    0x23, 0x81, 0x56, 0xce, 0x8e, 0xa7, 0xaa, 0xe3, 0xe0, 0xaf, 0xd3, 0x8e, 0xbd, 0x13, 0xc6, 0xfd,
+    0x57, 0x4c, 0x3d, 0x7e, 0xdb, 0x89, 0x17, 0xa0, 0xee, 0xa9, 0x36, 0x90, 0xba, 0xf3, 0x8c, 0x0a,
+    0xaa, 0xe0, 0x2d, 0xa1, 0x44, 0x45, 0x31, 0x20, 0x4d, 0x4b, 0x48, 0xca, 0x15, 0xde, 0x5a, 0x3b,
+    0xa9, 0xaa, 0x23, 0xa7, 0xc4, 0x12, 0xbf, 0x35, 0xfa, 0x10, 0xb1, 0x1d, 0xf2, 0xb4, 0x01, 0x44,
+    0x91, 0xba, 0x8f, 0x84, 0xf4, 0x42, 0xdd, 0x50, 0xa5, 0xe8, 0x8c, 0x85, 0x41, 0x36, 0xd2, 0xc7,
+    0xf4, 0xf1, 0x97, 0x0e, 0xf1, 0x09, 0x97, 0x9a, 0x9a, 0xac, 0xc6, 0x64, 0x0c, 0x0d, 0xf6, 0x3c,
+    0x4f, 0x44, 0x67, 0x29, 0xeb, 0x54, 0x96, 0x9b, 0x9b, 0x39, 0xfa, 0xb8, 0xb6, 0xb1, 0xd1, 0x55,
+    0x4f, 0x33, 0x37, 0x69, 0x5f, 0x2e, 0x3a, 0x82, 0x8f, 0xef, 0x1e, 0xef, 0x3f, 0x3c, 0x5c, 0xe6,
+    0xc6, 0xe7, 0x77, 0x48, 0x34, 0x03, 0xd5, 0x57, 0x2d, 0xa3, 0x65, 0x66, 0x4a, 0x6f, 0x2d, 0xcd,
+    0x31, 0x55, 0x82, 0x92, 0x43, 0x57, 0x22, 0xa4, 0x3a, 0x65, 0x0b, 0xe9, 0xf4, 0x64, 0xe3, 0xe8,
+    0x06, 0x3a, 0xaa, 0xbf, 0xa4, 0xe8, 0xc4, 0x21, 0x46, 0x72, 0x22, 0x0c, 0x33, 0x62, 0xae, 0xf0,
+    0x41, 0x91, 0xce, 0xdc, 0x9b, 0x68, 0x00, 0xdd, 0x68, 0x47, 0x9f, 0x7f, 0x35, 0x91, 0xe6, 0x34,
+    0xe9, 0x3c, 0xae, 0x64, 0x4e, 0x55, 0xef, 0xea, 0xe5, 0xad, 0x69, 0x90, 0x50, 0xf8, 0x1d, 0xda,
+    0xd2, 0x58, 0xcb, 0x62, 0xfb, 0xd2, 0xce, 0x1a, 0xa2, 0x52, 0x3c, 0x2b, 0x16, 0x7d, 0x3b, 0xf9,
+    0x9a, 0x8c, 0xaa, 0xab, 0x68, 0xc7, 0xdf, 0x92, 0x31, 0x75, 0x33, 0xed, 0xf8, 0x9b, 0xd2, 0xe6,
+    0xef, 0xca, 0x64, 0xaf, 0x60, 0xf7, 0xd6, 0x37, 0x4d, 0x31, 0xda, 0xb0, 0x38, 0x85, 0x09, 0x4d,
+    0x2c, 0x06, 0x3d, 0x22, 0xd2, 0xcc, 0xd5, 0x22, 0x33, 0x95, 0x05, 0xe4, 0x82, 0x78, 0x28, 0xe9,
+    0x72, 0xaf, 0x66, 0xa1, 0xe6, 0x20, 0x7d, 0x6d, 0x0b, 0xa5, 0xa1, 0x79, 0xa1, 0x81, 0xc2, 0xbe,
+    0x9e, 0x28, 0xc3, 0xa5, 0xcc, 0x53, 0x6c, 0x98, 0xe2, 0x7e, 0x81, 0x3b, 0x1e, 0xe9, 0xf6, 0x88,
+    0xf7, 0xaa, 0xc2, 0x85, 0x39, 0x32, 0xcf, 0xbe, 0x6f, 0x8b, 0xd6, 0x1f, 0x49, 0x7e, 0x7b, 0x9e,
+    0xa4, 0xca, 0xb2, 0xfe, 0xd0, 0xe5, 0xd1, 0x52, 0xa2, 0x93, 0x82, 0xec, 0xc7, 0x62, 0xf4, 0x93,
+    0x38, 0x53, 0x87, 0xcd, 0xe7, 0x8c, 0xce, 0x24, 0xc8, 0xe2, 0x87, 0xf7, 0x62, 0x0b, 0x31, 0xe5,
+    0xad, 0xb7, 0x96, 0xa6, 0xdb, 0x7a, 0x43, 0x02, 0x20, 0xa2, 0xe5, 0x8a, 0x92, 0xbb, 0x1d, 0xd2,
+    0x9c, 0xe1, 0x77, 0x57, 0x84, 0x77, 0x20, 0x68, 0xac, 0x76, 0x78, 0xe3, 0xa8, 0x00, 0x56, 0x7a,
+    0xb7, 0x4b, 0x32, 0x4d, 0x8c, 0x12, 0xd9, 0xaa, 0x54, 0x66, 0x8a, 0x31, 0xe9, 0x1e, 0xca, 0xeb,
+    0x17, 0xe6, 0xce, 0x2e, 0xa9, 0xe8, 0xc2, 0x14, 0xaf, 0xcb, 0xe5, 0x25, 0x82, 0x15, 0xc5, 0xa0,
+    0x85, 0x72, 0x55, 0xd5, 0x0b, 0x29, 0x5a, 0x1d, 0x8d, 0x52, 0x6b, 0x6f, 0xa8, 0x68, 0x2c, 0x16,
+    0x31, 0xda, 0xd7, 0xb4, 0x78, 0x92, 0x3a, 0xcc, 0x6b, 0x14, 0xcd, 0x2d, 0x41, 0x40, 0x86, 0xe7,
+    0x59, 0xa8, 0xa5, 0x6b, 0x43, 0xd3, 0x54, 0x75, 0xa8, 0x03, 0x4f, 0x6b, 0xca, 0x42, 0x1a, 0xc0,
+    0x74, 0x75, 0x6d, 0x95, 0x52, 0xc6, 0x8c, 0xa4, 0x14, 0xfb, 0xbc, 0xa4, 0x31, 0x53, 0xc8, 0x88,
+    0x25, 0x37, 0x13, 0x43, 0x64, 0x30, 0xf8, 0x9a, 0xc4, 0x28, 0xab, 0xa5, 0x36, 0xb2, 0x7f, 0x37,
+    0x08, 0xe8, 0xc4, 0xc0, 0x7f, 0xb1, 0x5d, 0x10, 0x24, 0x8b, 0xc6, 0x88, 0xfa, 0xa9, 0xc2, 0x5a,
+    0xd1, 0xf8, 0xd4, 0x83, 0x4b, 0xcc, 0xa7, 0xe0, 0x39, 0x93, 0x1e, 0x69, 0x15, 0xda, 0xb4, 0xc9,
+    0x4a, 0x44, 0xb0, 0xa6, 0x07, 0x96, 0x59, 0x0c, 0x88, 0xa0, 0x3c, 0x56, 0x04, 0x7e, 0x97, 0xc9,
+    0x0c, 0x9c, 0xf1, 0x9e, 0x67, 0x81, 0xcf, 0x44, 0x39, 0xbd, 0xce, 0xb4, 0x7f, 0x1e, 0x4c, 0xed,
+    0x59, 0xd3, 0x17, 0x03, 0x30, 0x8e, 0xae, 0x33, 0x16, 0x6a, 0x7a, 0x73, 0x24, 0xaf, 0x37, 0x18,
+    0x33, 0x2e, 0x33, 0xff, 0xe2, 0x33, 0xd9, 0x41, 0x14, 0x0d, 0xc3, 0x5b, 0xf9, 0xce, 0xca, 0x14,
+    0x1f, 0xf0, 0x5a, 0x6f, 0x9a, 0x5e, 0xc6, 0x4f, 0x8a, 0xb6, 0x24, 0xef, 0x53, 0xbe, 0x78, 0xfa,
+    0x3f, 0xff, 0x06, 0x11, 0xbd, 0x29, 0x1b, 0x96, 0xc7, 0xf3, 0xbb, 0x94, 0xf9, 0x74, 0x72, 0x91,
+    0x32, 0x48, 0x32, 0x92, 0xc1, 0xa6, 0x1f, 0x33, 0xb1, 0xa9, 0xd7, 0x98, 0x4d, 0x92, 0x4c, 0x6b,
+    0x99, 0x36, 0xc6, 0x6d, 0x4d, 0x9d, 0x9c, 0x69, 0xcd, 0xca, 0x64, 0xb6, 0x3f, 0xc9, 0xf9, 0xc3,
+    0x78, 0x02, 0x77, 0x85, 0xd8, 0x22, 0xd4, 0x78, 0x4c, 0xd5, 0xd1, 0x17, 0x54, 0xd1, 0xb5, 0xad,
+    0x54, 0x35, 0x1d, 0x2e, 0x32, 0x9e, 0x37, 0x7b, 0x93, 0x78, 0xcd, 0xa6, 0xb0, 0xef, 0xaf, 0x87,
+    0x47, 0xd9, 0x5a, 0x81, 0x01, 0xe1, 0x4b, 0x56, 0x2f, 0xf7, 0xab, 0x46, 0x43, 0x47, 0xe6, 0x75,
+    0x1c, 0xff, 0x25, 0x52, 0xad, 0x70, 0x2f, 0x18, 0x3f, 0x37, 0xe2, 0xc7, 0x99, 0x88, 0x6a, 0x25,
+    0x98, 0x0b, 0x83, 0xab, 0x81, 0x5c, 0x45, 0x4b, 0xfe, 0xcd, 0x65, 0xa9, 0x07, 0xf2, 0x47, 0x4c,
+    0x0b, 0x33, 0xc6, 0x39, 0x3a, 0x93, 0x78, 0xa4, 0x12, 0xa9, 0x25, 0x27, 0x59, 0x1e, 0xb9, 0xf9,
+    0xaf, 0xa1, 0x90, 0xa5, 0x9b, 0x41, 0x2d, 0x74, 0x93, 0x21, 0xbd, 0x07, 0x43, 0x14, 0xe1, 0x8b,
+    0x6d, 0x80, 0x0e, 0xfe, 0x5b, 0x11, 0xd9, 0xfb, 0xde, 0xd9, 0x94, 0xff, 0x4a, 0x64, 0x53, 0xfc,
+    0xdf, 0xb5, 0xfc, 0x16, 0xfe, 0x23, 0xa5, 0xb0, 0xc0, 0x45, 0x00, 0x00,
+};
+
+#endif // WEB_UI_GZ_H
@@ -0,0 +1,55 @@
+/**
+ * WiFi Manager Header
+ *
+ * Kết nối WiFi không chặn loop(). BSSID, kênh và IP của lần kết nối thành
+ * công gần nhất được lưu trong RTC memory (còn sau reset/WDT) và flash
+ * (còn sau mất điện). Khi kết nối lại, thử đường nhanh trước: vào thẳng AP
+ * đã biết trên kênh đã biết, dùng lại IP để bỏ qua DHCP. Nếu không được
+ * trong WIFI_FAST_TIMEOUT thì chuyển sang quét đầy đủ + DHCP.
+ */
+
+#ifndef WIFI_MANAGER_H
+#define WIFI_MANAGER_H
+
+#include <Arduino.h>
+
+// ============================================
+// Types
+// ============================================
+
+/**
+ * Số liệu kết nối WiFi
+ */
+struct WiFiStats {
+    bool connected;
+    bool cacheValid;        // Có BSSID/kênh đã lưu
+    uint32_t connects;      // Số lần kết nối thành công
+    uint32_t fastConnects;  // Trong đó qua đường nhanh
+    uint32_t fastFailures;  // Đường nhanh hết hạn, phải quét đầy đủ
+    uint32_t lastConnectMs; // Thời gian của lần kết nối gần nhất (ms)
+    uint8_t channel;
+};
+
+typedef void (*WiFiConnectedCallback)();
+
+// ============================================
+// Function Declarations
+// ============================================
+
+/**
+ * Đọc cache và bắt đầu kết nối (trả về ngay)
+ * @param onConnected Gọi mỗi lần có kết nối (để kết nối MQTT ngay)
+ */
+void initWiFiManager(WiFiConnectedCallback onConnected);
+
+/**
+ * Máy trạng thái kết nối, gọi định kỳ (WIFI_POLL_INTERVAL)
+ */
+void wifiManagerLoop();
+
+/**
+ * Lấy số liệu kết nối
+ */
+void wifiGetStats(WiFiStats& stats);
+
+#endif // WIFI_MANAGER_H
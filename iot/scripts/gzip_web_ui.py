@@ -0,0 +1,86 @@
+"""
+Nén kiosk Web UI thành mảng PROGMEM gzip (include/web_ui_gz.h)
+
+- Nguồn: chuỗi raw literal LOCKER_UI_HTML trong include/web_ui.h
+- Đầu ra: LOCKER_UI_GZ[] + LOCKER_UI_GZ_SIZE + LOCKER_UI_HASH (16 ký tự hex
+  đầu của SHA-256 nội dung HTML, dùng làm ETag)
+- gzip không ghi mtime/tên file nên cùng nội dung luôn ra cùng byte; file
+  đầu ra chỉ được ghi lại khi nội dung đổi (không làm build lại vô ích)
+
+Chạy tự động trước mỗi lần build (extra_scripts trong platformio.ini),
+hoặc chạy tay: python scripts/gzip_web_ui.py
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 - có sẵn khi chạy trong PlatformIO/SCons
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(PROJECT_DIR, "include", "web_ui.h")
+OUTPUT = os.path.join(PROJECT_DIR, "include", "web_ui_gz.h")
+BYTES_PER_LINE = 16
+
+
+def extract_html(header_text):
+    match = re.search(r'R"rawliteral\((.*?)\)rawliteral"', header_text, re.S)
+    if not match:
+        raise SystemExit("[WEB_UI] Không tìm thấy LOCKER_UI_HTML trong " + SOURCE)
+    return match.group(1).encode("utf-8")
+
+
+def render(html, packed, digest):
+    lines = []
+    for i in range(0, len(packed), BYTES_PER_LINE):
+        chunk = packed[i:i + BYTES_PER_LINE]
+        lines.append("    " + ", ".join("0x%02x" % b for b in chunk) + ",")
+
+    return """/**
+ * Kiosk Web UI (gzip) - FILE TỰ SINH, KHÔNG SỬA TAY
+ *
+ * Sinh bởi scripts/gzip_web_ui.py từ include/web_ui.h
+ * HTML: {html_size} byte, gzip: {gz_size} byte
+ */
+
+#ifndef WEB_UI_GZ_H
+#define WEB_UI_GZ_H
+
+#include <Arduino.h>
+
+#define LOCKER_UI_HASH "{digest}"
+
+const size_t LOCKER_UI_GZ_SIZE = {gz_size};
+
+const uint8_t LOCKER_UI_GZ[] PROGMEM = {{
+{body}
+}};
+
+#endif // WEB_UI_GZ_H
+""".format(html_size=len(html), gz_size=len(packed), digest=digest, body="\n".join(lines))
+
+
+def main():
+    with open(SOURCE, encoding="utf-8") as f:
+        html = extract_html(f.read())
+
+    packed = bytearray(gzip.compress(html, compresslevel=9, mtime=0))
+    packed[9] = 0xFF  # Trường OS = "unknown": cùng byte trên mọi máy build
+    digest = hashlib.sha256(html).hexdigest()[:16]
+    content = render(html, packed, digest)
+
+    current = None
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, encoding="utf-8") as f:
+            current = f.read()
+    if current != content:
+        with open(OUTPUT, "w", encoding="utf-8", newline="\n") as f:
+            f.write(content)
+        print("[WEB_UI] %d -> %d bytes gzip, hash %s" % (len(html), len(packed), digest))
+
+
+main()
@@ -0,0 +1,338 @@
+"""
+Đo độ trễ mở khóa end-to-end từ "trace" trong bản tin trả lời OPEN/LOCK
+
+ESP trả lời UNLOCKED/LOCKED kèm:
+  "trace": {"ts": <epoch ms backend gửi lệnh, nếu lệnh có "ts">,
+            "rx": <epoch ms ESP bắt đầu đọc gói, khi đã đồng bộ NTP>,
+            "cb": <µs từ rx tới callback>, "relay": <µs tới lúc ghi relay>,
+            "pub": <µs tới lúc publish trả lời>}
+
+Script tính p50 / p99 / p999 cho từng giai đoạn:
+  broker   ts -> rx          backend publish tới lúc ESP đọc gói (cần NTP cả hai phía)
+  read     rx -> cb          PubSubClient đọc gói + parse header MQTT
+  relay    cb -> relay       parse lệnh, dedup, log, ghi relay
+  publish  relay -> pub      dựng bản tin trả lời
+  device   rx -> pub         tổng thời gian trên ESP
+  return   pub -> nhận ack   ESP publish tới lúc script nhận (cần NTP)
+  total    ts -> nhận ack    vòng đầy đủ (đồng hồ của người gửi lệnh)
+
+Hai chế độ:
+  - Thụ động (mặc định): nghe locker/status/+ (và /mp) — backend thật gửi lệnh
+    kèm "ts"; chạy trong một khoảng --duration giây
+  - Chủ động (--count N): tự gửi N lệnh OPEN/LOCK xen kẽ tới --device, mỗi
+    --interval giây (relay sẽ đóng/mở thật!)
+
+Chỉ dùng thư viện chuẩn (MQTT 3.1.1 QoS 0 và MessagePack tối giản có sẵn):
+  python scripts/latency_collector.py --host 192.168.1.10 --duration 3600
+  python scripts/latency_collector.py --host 127.0.0.1 --count 1000 --interval 0.2 --csv lat.csv
+"""
+
+import argparse
+import csv
+import json
+import math
+import os
+import select
+import socket
+import struct
+import sys
+import time
+
+STAGES = ["broker", "read", "relay", "publish", "device", "return", "total"]
+
+
+# ============================================
+# MQTT 3.1.1 (QoS 0)
+# ============================================
+
+def encode_length(n):
+    out = bytearray()
+    while True:
+        byte, n = n % 128, n // 128
+        out.append(byte | (0x80 if n else 0))
+        if not n:
+            return bytes(out)
+
+
+def mqtt_string(s):
+    data = s.encode("utf-8")
+    return struct.pack(">H", len(data)) + data
+
+
+class MqttClient:
+    def __init__(self, host, port, client_id, keepalive=60):
+        self.sock = socket.create_connection((host, port), timeout=10)
+        self.buffer = b""
+        self.keepalive = keepalive
+        self.last_send = time.monotonic()
+        body = mqtt_string("MQTT") + bytes([4, 0x02]) + struct.pack(">H", keepalive) + mqtt_string(client_id)
+        self._send(0x10, body)
+        packet_type, payload = self._read_packet(10)
+        if packet_type != 0x20 or payload[1] != 0:
+            raise SystemExit("[COLLECTOR] Broker từ chối kết nối")
+
+    def _send(self, header, body):
+        self.sock.sendall(bytes([header]) + encode_length(len(body)) + body)
+        self.last_send = time.monotonic()
+
+    def subscribe(self, topics):
+        body = struct.pack(">H", 1) + b"".join(mqtt_string(t) + b"\x00" for t in topics)
+        self._send(0x82, body)
+
+    def publish(self, topic, payload):
+        self._send(0x30, mqtt_string(topic) + payload)
+
+    def _read_packet(self, timeout):
+        deadline = time.monotonic() + timeout
+        while True:
+            packet = self._parse()
+            if packet:
+                return packet
+            remaining = deadline - time.monotonic()
+            if remaining <= 0 or not select.select([self.sock], [], [], remaining)[0]:
+                return None, None
+            chunk = self.sock.recv(65536)
+            if not chunk:
+                raise SystemExit("[COLLECTOR] Mất kết nối broker")
+            self.buffer += chunk
+
+    def _parse(self):
+        if len(self.buffer) < 2:
+            return None
+        length, multiplier, i = 0, 1, 1
+        while True:
+            if i >= len(self.buffer):
+                return None
+            byte = self.buffer[i]
+            length += (byte & 0x7F) * multiplier
+            multiplier *= 128
+            i += 1
+            if not byte & 0x80:
+                break
+        if len(self.buffer) < i + length:
+            return None
+        packet = (self.buffer[0] & 0xF0, self.buffer[i:i + length])
+        self.buffer = self.buffer[i + length:]
+        return packet
+
+    def poll(self, timeout):
+        """Trả về (topic, payload, epoch ms lúc nhận) hoặc None"""
+        if time.monotonic() - self.last_send > self.keepalive / 2:
+            self._send(0xC0, b"")
+        packet_type, body = self._read_packet(timeout)
+        if packet_type != 0x30:
+            return None
+        received_ms = time.time() * 1000.0
+        topic_length = struct.unpack(">H", body[:2])[0]
+        topic = body[2:2 + topic_length].decode("utf-8", "replace")
+        return topic, body[2 + topic_length:], received_ms
+
+
+# ============================================
+# MessagePack (đủ cho lệnh và bản tin trạng thái)
+# ============================================
+
+def msgpack_encode(value):
+    if value is None:
+        return b"\xc0"
+    if value is True or value is False:
+        return b"\xc3" if value else b"\xc2"
+    if isinstance(value, int):
+        if 0 <= value < 0x80:
+            return bytes([value])
+        if 0 <= value < 1 << 32:
+            return b"\xce" + struct.pack(">I", value)
+        if value >= 0:
+            return b"\xcf" + struct.pack(">Q", value)
+        return b"\xd3" + struct.pack(">q", value)
+    if isinstance(value, str):
+        data = value.encode("utf-8")
+        if len(data) < 32:
+            return bytes([0xA0 | len(data)]) + data
+        return b"\xd9" + bytes([len(data)]) + data
+    if isinstance(value, dict):
+        return bytes([0x80 | len(value)]) + b"".join(msgpack_encode(k) + msgpack_encode(v) for k, v in value.items())
+    raise TypeError(value)
+
+
+def msgpack_decode(data, i=0):
+    t = data[i]
+    if t < 0x80:
+        return t, i + 1
+    if t >= 0xE0:
+        return t - 0x100, i + 1
+    if 0x80 <= t <= 0x8F or t in (0xDE, 0xDF):
+        if t <= 0x8F:
+            count, i = t & 0x0F, i + 1
+        elif t == 0xDE:
+            count, i = struct.unpack(">H", data[i + 1:i + 3])[0], i + 3
+        else:
+            count, i = struct.unpack(">I", data[i + 1:i + 5])[0], i + 5
+        result = {}
+        for _ in range(count):
+            key, i = msgpack_decode(data, i)
+            result[key], i = msgpack_decode(data, i)
+        return result, i
+    if 0x90 <= t <= 0x9F:
+        result, i = [], i + 1
+        for _ in range(t & 0x0F):
+            item, i = msgpack_decode(data, i)
+            result.append(item)
+        return result, i
+    if 0xA0 <= t <= 0xBF:
+        n = t & 0x1F
+        return data[i + 1:i + 1 + n].decode("utf-8"), i + 1 + n
+    simple = {0xC0: None, 0xC2: False, 0xC3: True}
+    if t in simple:
+        return simple[t], i + 1
+    fixed = {0xCC: ">B", 0xCD: ">H", 0xCE: ">I", 0xCF: ">Q", 0xD0: ">b", 0xD1: ">h", 0xD2: ">i", 0xD3: ">q",
+             0xCA: ">f", 0xCB: ">d"}
+    if t in fixed:
+        size = struct.calcsize(fixed[t])
+        return struct.unpack(fixed[t], data[i + 1:i + 1 + size])[0], i + 1 + size
+    if t in (0xD9, 0xDA):
+        size = 1 if t == 0xD9 else 2
+        n = int.from_bytes(data[i + 1:i + 1 + size], "big")
+        start = i + 1 + size
+        return data[start:start + n].decode("utf-8"), start + n
+    if t == 0xDC:
+        n = struct.unpack(">H", data[i + 1:i + 3])[0]
+        result, i = [], i + 3
+        for _ in range(n):
+            item, i = msgpack_decode(data, i)
+            result.append(item)
+        return result, i
+    raise ValueError("MessagePack type 0x%02x" % t)
+
+
+def decode_status(topic, payload):
+    try:
+        if topic.endswith("/mp") and payload[:1] != b"{":
+            return msgpack_decode(payload)[0]
+        return json.loads(payload)
+    except (ValueError, IndexError, UnicodeDecodeError):
+        return None
+
+
+# ============================================
+# Stage Timings
+# ============================================
+
+def stage_timings(trace, received_ms):
+    """Thời gian từng giai đoạn (ms) của một bản tin trả lời có "trace" """
+    cb, relay, pub = trace.get("cb"), trace.get("relay"), trace.get("pub")
+    if cb is None or relay is None or pub is None:
+        return None
+    ts, rx = trace.get("ts"), trace.get("rx")
+    stages = {
+        "read": cb / 1000.0,
+        "relay": (relay - cb) / 1000.0,
+        "publish": (pub - relay) / 1000.0,
+        "device": pub / 1000.0,
+    }
+    if ts and rx:
+        stages["broker"] = rx - ts
+    if rx:
+        stages["return"] = received_ms - (rx + pub / 1000.0)
+    if ts:
+        stages["total"] = received_ms - ts
+    return {k: round(v, 3) for k, v in stages.items()}
+
+
+def percentile(sorted_values, p):
+    """Nearest-rank: p999 của < 1000 mẫu là giá trị lớn nhất"""
+    if not sorted_values:
+        return float("nan")
+    rank = max(1, math.ceil(p / 100.0 * len(sorted_values)))
+    return sorted_values[rank - 1]
+
+
+def print_report(samples):
+    print("%-8s %7s %10s %10s %10s %10s" % ("stage", "n", "p50 ms", "p99 ms", "p999 ms", "max ms"))
+    for stage in STAGES:
+        values = sorted(s[stage] for s in samples if stage in s)
+        if not values:
+            continue
+        print("%-8s %7d %10.3f %10.3f %10.3f %10.3f" % (
+            stage, len(values), percentile(values, 50), percentile(values, 99), percentile(values, 99.9), values[-1]))
+
+
+# ============================================
+# Main
+# ============================================
+
+def main():
+    parser = argparse.ArgumentParser(description="Thống kê độ trễ mở khóa từ trace trong bản tin trả lời")
+    parser.add_argument("--host", default="127.0.0.1", help="MQTT broker")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--device", default="ESP8266_LOCKER_01", help="DEVICE_ID (chế độ chủ động)")
+    parser.add_argument("--box", type=int, default=1, help="box_id gửi trong lệnh (chế độ chủ động)")
+    parser.add_argument("--count", type=int, default=0, help="Số lệnh tự gửi (0 = chỉ nghe)")
+    parser.add_argument("--interval", type=float, default=1.0, help="Giây giữa hai lệnh")
+    parser.add_argument("--duration", type=float, default=60.0, help="Thời gian nghe ở chế độ thụ động (giây)")
+    parser.add_argument("--msgpack", action="store_true", help="Gửi lệnh dạng MessagePack (topic /mp)")
+    parser.add_argument("--csv", help="Ghi từng mẫu ra file CSV")
+    args = parser.parse_args()
+
+    client = MqttClient(args.host, args.port, "latency-collector-%d" % os.getpid())
+    if args.count:
+        status_topic = "locker/status/" + args.device
+        client.subscribe([status_topic, status_topic + "/mp"])
+    else:
+        client.subscribe(["locker/status/+", "locker/status/+/mp"])
+
+    command_topic = "locker/commands/" + args.device + ("/mp" if args.msgpack else "")
+    samples = []
+    sent = 0
+    next_send = time.monotonic()
+    end = time.monotonic() + (args.duration if not args.count else float("inf"))
+    drain_until = None
+
+    print("[COLLECTOR] %s" % ("Sending %d commands to %s" % (args.count, command_topic) if args.count
+                             else "Listening for %.0f s" % args.duration), file=sys.stderr)
+
+    while time.monotonic() < end:
+        now = time.monotonic()
+        if args.count and sent < args.count and now >= next_send:
+            command = {"box_id": args.box, "action": "OPEN" if sent % 2 == 0 else "LOCK",
+                       "cmd_id": "lat-%d-%d" % (os.getpid(), sent), "ts": int(time.time() * 1000)}
+            if args.msgpack:
+                client.publish(command_topic, msgpack_encode(command))
+            else:
+                client.publish(command_topic, json.dumps(command, separators=(",", ":")).encode())
+            sent += 1
+            next_send += args.interval
+            if sent == args.count:
+                drain_until = time.monotonic() + max(2.0, args.interval)
+        if drain_until and time.monotonic() >= drain_until:
+            break
+
+        wait = max(0.0, min(next_send - time.monotonic(), 0.5)) if args.count and sent < args.count else 0.5
+        message = client.poll(wait)
+        if not message:
+            continue
+        topic, payload, received_ms = message
+        status = decode_status(topic, payload)
+        if not isinstance(status, dict) or not isinstance(status.get("trace"), dict):
+            continue
+        stages = stage_timings(status["trace"], received_ms)
+        if stages is None:
+            continue
+        stages["device_id"] = status.get("device", topic.split("/")[2])
+        stages["cmd_id"] = status.get("cmd_id", "")
+        samples.append(stages)
+        if args.count and len(samples) >= args.count:
+            break
+
+    if args.count:
+        print("[COLLECTOR] %d sent, %d acks with trace" % (sent, len(samples)), file=sys.stderr)
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=["device_id", "cmd_id"] + STAGES)
+            writer.writeheader()
+            writer.writerows(samples)
+    print_report(samples)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,11 @@
+"""
+Link env:fleet_image thành shared object thay vì chương trình
+
+Fleet simulator (host/fleet/) dlopen nhiều bản sao của file này, mỗi bản là
+một locker ảo. Mã nguồn đã build với -fPIC (build_flags); ở đây chỉ thêm
+-shared khi link. Đầu ra vẫn mang tên .pio/build/fleet_image/program.
+"""
+
+Import("env")  # noqa: F821 - có sẵn khi chạy trong PlatformIO/SCons
+
+env.Append(LINKFLAGS=["-shared"])  # noqa: F821
@@ -0,0 +1,332 @@
+/**
+ * Async HTTP Client Implementation
+ *
+ * Mỗi request chiếm một slot cố định (buffer tĩnh, không cấp phát heap
+ * cho phản hồi). loop() chỉ đọc những byte đã có sẵn trên socket nên
+ * backend chậm không còn làm treo MQTT, nút nhấn và auto-lock.
+ * Socket lấy từ backend_pool và được trả lại để dùng tiếp (keep-alive).
+ */
+
+#include "async_http.h"
+#include "backend_pool.h"
+#include "config.h"
+#include "platform.h"
+#include <WiFiClient.h>
+
+// ============================================
+// Request Slots
+// ============================================
+enum AsyncHttpState {
+    ASYNC_IDLE,
+    ASYNC_WAIT_RESPONSE,
+    ASYNC_CALLBACK          // Đang gọi callback, buffer vẫn chứa body
+};
+
+struct AsyncHttpRequest {
+    AsyncHttpState state;
+    WiFiClient* client;
+    bool reused;            // Socket keep-alive dùng lại (có thể đã chết ngầm)
+    AsyncHttpCallback callback;
+    void* ctx;
+    unsigned long deadline;
+    size_t requestLength;   // Request còn giữ trong buffer để gửi lại, 0 nếu không
+    size_t received;
+    char buffer[ASYNC_HTTP_BUFFER_SIZE + 1];
+};
+
+static AsyncHttpRequest _requests[ASYNC_HTTP_SLOTS];
+static uint32_t _retried = 0;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+/**
+ * Tìm header (không phân biệt hoa thường) trong khối header đã nhận
+ * @return Con trỏ tới giá trị header hoặc nullptr
+ */
+static const char* findHeader(const char* headers, const char* end, const char* name) {
+    size_t nameLen = strlen(name);
+    const char* line = headers;
+    while (line < end) {
+        if (strncasecmp(line, name, nameLen) == 0 && line[nameLen] == ':') {
+            const char* value = line + nameLen + 1;
+            while (*value == ' ') value++;
+            return value;
+        }
+        const char* next = strstr(line, "\r\n");
+        if (!next) break;
+        line = next + 2;
+    }
+    return nullptr;
+}
+
+/**
+ * Duyệt các chunk trong buffer
+ * @param compact true: chép dữ liệu các chunk về liền nhau ở đầu buffer
+ * @return Độ dài body sau khi giải mã, -1 nếu chưa thấy chunk cuối (0)
+ */
+static long walkChunks(char* body, size_t available, bool compact) {
+    const char* src = body;
+    const char* end = body + available;
+    char* dst = body;
+
+    while (src < end) {
+        const char* lineEnd = strstr(src, "\r\n");
+        if (!lineEnd) return -1;
+        long chunkLen = strtol(src, nullptr, 16);
+        src = lineEnd + 2;
+        if (chunkLen == 0) {
+            if (compact) *dst = '\0';
+            return dst - body;
+        }
+        if (src + chunkLen + 2 > end) return -1;
+        if (compact) memmove(dst, src, chunkLen);
+        dst += chunkLen;
+        src += chunkLen + 2;
+    }
+    return -1;
+}
+
+/**
+ * Giải mã chunked transfer encoding ngay trong buffer
+ * Chỉ ghi vào buffer khi đã nhận đủ tới chunk cuối: chưa đủ thì buffer giữ
+ * nguyên để lần gọi sau đọc lại từ đầu
+ * @return Độ dài body sau khi giải mã, -1 nếu chưa nhận đủ
+ */
+static long decodeChunked(char* body, size_t available) {
+    if (walkChunks(body, available, false) < 0) return -1;
+    return walkChunks(body, available, true);
+}
+
+/**
+ * Kết thúc request: trả socket về pool rồi gọi callback
+ * Slot chỉ được giải phóng sau callback vì body nằm trong buffer của slot
+ * @param keepAlive true nếu socket còn dùng lại được
+ */
+static void finishRequest(AsyncHttpRequest& req, int httpCode, const char* body, size_t length, bool keepAlive = false) {
+    backendRelease(req.client, keepAlive);
+    req.client = nullptr;
+    req.state = ASYNC_CALLBACK;
+
+    if (req.callback) {
+        req.callback(httpCode, body ? body : "", length, req.ctx);
+    }
+    req.state = ASYNC_IDLE;
+}
+
+/**
+ * Gửi request (đã dựng sẵn trong buffer hoặc head + body riêng)
+ */
+static bool writeRequest(WiFiClient* client, const char* data, size_t length, const String* body) {
+    if (client->write((const uint8_t*)data, length) != length) return false;
+    if (body && client->write((const uint8_t*)body->c_str(), body->length()) != body->length()) return false;
+    return true;
+}
+
+/**
+ * Socket keep-alive bị backend đóng trước khi trả lời: gửi lại một lần
+ * trên kết nối mới (chỉ khi request còn giữ trong buffer)
+ * @return true nếu đã gửi lại
+ */
+static bool retryOnFreshConnection(AsyncHttpRequest& req) {
+    if (!req.reused || req.received > 0 || req.requestLength == 0) return false;
+
+    backendRelease(req.client, false);
+    req.client = backendAcquire(&req.reused);
+    if (!req.client) return false;
+
+    if (!writeRequest(req.client, req.buffer, req.requestLength, nullptr)) {
+        return false;
+    }
+    _retried++;
+    Serial.println("[HTTP] Stale keep-alive socket, request resent");
+    return true;
+}
+
+/**
+ * Kiểm tra phản hồi đã đủ chưa; nếu đủ thì gọi callback
+ * @param closed true nếu backend đã đóng kết nối
+ * @return true nếu request đã kết thúc
+ */
+static bool tryCompleteResponse(AsyncHttpRequest& req, bool closed) {
+    if (closed && retryOnFreshConnection(req)) return false;
+    req.buffer[req.received] = '\0';
+
+    char* headerEnd = strstr(req.buffer, "\r\n\r\n");
+    if (!headerEnd) {
+        if (closed) {
+            finishRequest(req, HTTPC_ERROR_CONNECTION_LOST, nullptr, 0);
+            return true;
+        }
+        return false;
+    }
+
+    // Status line: "HTTP/1.1 200 OK"
+    const char* space = strchr(req.buffer, ' ');
+    int httpCode = space ? atoi(space + 1) : 0;
+    if (httpCode <= 0) {
+        finishRequest(req, HTTPC_ERROR_NO_HTTP_SERVER, nullptr, 0);
+        return true;
+    }
+
+    char* body = headerEnd + 4;
+    size_t bodyReceived = req.received - (body - req.buffer);
+
+    // Giữ socket cho request sau trừ khi backend yêu cầu đóng
+    const char* connection = findHeader(req.buffer, headerEnd, "Connection");
+    bool keepAlive = !closed && !(connection && strncasecmp(connection, "close", 5) == 0);
+
+    const char* encoding = findHeader(req.buffer, headerEnd, "Transfer-Encoding");
+    if (encoding && strncasecmp(encoding, "chunked", 7) == 0) {
+        long decoded = decodeChunked(body, bodyReceived);
+        if (decoded >= 0) {
+            finishRequest(req, httpCode, body, (size_t)decoded, keepAlive);
+            return true;
+        }
+    } else {
+        const char* lengthHeader = findHeader(req.buffer, headerEnd, "Content-Length");
+        if (lengthHeader && bodyReceived >= (size_t)atol(lengthHeader)) {
+            size_t length = (size_t)atol(lengthHeader);
+            body[length] = '\0';
+            finishRequest(req, httpCode, body, length, keepAlive);
+            return true;
+        }
+        // Không có Content-Length: body kết thúc khi backend đóng kết nối
+        if (!lengthHeader && closed) {
+            finishRequest(req, httpCode, body, bodyReceived);
+            return true;
+        }
+    }
+
+    if (closed) {
+        finishRequest(req, HTTPC_ERROR_CONNECTION_LOST, nullptr, 0);
+        return true;
+    }
+    return false;
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initAsyncHttp() {
+    for (uint8_t i = 0; i < ASYNC_HTTP_SLOTS; i++) {
+        _requests[i].state = ASYNC_IDLE;
+        _requests[i].client = nullptr;
+    }
+    Serial.printf("[HTTP] Async client ready (%d slots)\n", ASYNC_HTTP_SLOTS);
+}
+
+bool asyncHttpPost(const char* path, const String& body, AsyncHttpCallback callback, void* ctx) {
+    if (WiFi.status() != WL_CONNECTED) {
+        Serial.println("[HTTP] WiFi not connected, cannot send request");
+        return false;
+    }
+
+    AsyncHttpRequest* req = nullptr;
+    for (uint8_t i = 0; i < ASYNC_HTTP_SLOTS; i++) {
+        if (_requests[i].state == ASYNC_IDLE) {
+            req = &_requests[i];
+            break;
+        }
+    }
+    if (!req) {
+        Serial.println("[HTTP] No free request slot");
+        return false;
+    }
+
+    req->client = backendAcquire(&req->reused);
+    if (!req->client) {
+        return false;
+    }
+
+    // Dựng request trong buffer để còn gửi lại được nếu socket keep-alive đã chết;
+    // body quá lớn thì gửi thẳng từ String (không gửi lại được)
+    int headLen = snprintf(req->buffer, ASYNC_HTTP_BUFFER_SIZE + 1,
+        "POST %s HTTP/1.1\r\n"
+        "Host: %s:%u\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: %u\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n",
+        path, backendHost(), backendPort(), (unsigned)body.length());
+
+    bool sent = false;
+    req->requestLength = 0;
+    if (headLen > 0 && headLen + body.length() <= ASYNC_HTTP_BUFFER_SIZE) {
+        memcpy(req->buffer + headLen, body.c_str(), body.length());
+        req->requestLength = headLen + body.length();
+        sent = writeRequest(req->client, req->buffer, req->requestLength, nullptr);
+    } else if (headLen > 0 && headLen <= ASYNC_HTTP_BUFFER_SIZE) {
+        sent = writeRequest(req->client, req->buffer, headLen, &body);
+    }
+
+    if (!sent) {
+        Serial.printf("[HTTP] Failed to send request %s\n", path);
+        backendRelease(req->client, false);
+        req->client = nullptr;
+        return false;
+    }
+
+    req->state = ASYNC_WAIT_RESPONSE;
+    req->callback = callback;
+    req->ctx = ctx;
+    req->deadline = millis() + HTTP_TIMEOUT;
+    req->received = 0;
+
+    Serial.printf("[HTTP] POST %s sent (async%s)\n", path, req->reused ? ", reused" : "");
+    return true;
+}
+
+void asyncHttpLoop() {
+    for (uint8_t i = 0; i < ASYNC_HTTP_SLOTS; i++) {
+        AsyncHttpRequest& req = _requests[i];
+        if (req.state != ASYNC_WAIT_RESPONSE) continue;
+
+        // Chỉ đọc những gì đã có trong buffer TCP, không chờ
+        int avail = req.client->available();
+        while (avail > 0) {
+            size_t space = ASYNC_HTTP_BUFFER_SIZE - req.received;
+            if (space == 0) {
+                Serial.println("[HTTP] Response too large for buffer");
+                finishRequest(req, HTTPC_ERROR_TOO_LESS_RAM, nullptr, 0);
+                break;
+            }
+            int n = req.client->read((uint8_t*)req.buffer + req.received, min((size_t)avail, space));
+            if (n <= 0) break;
+            req.received += n;
+            avail = req.client->available();
+        }
+        if (req.state != ASYNC_WAIT_RESPONSE) continue;
+
+        if (tryCompleteResponse(req, !req.client->connected())) continue;
+
+        if ((long)(millis() - req.deadline) >= 0) {
+            Serial.println("[HTTP] Request timed out");
+            finishRequest(req, HTTPC_ERROR_READ_TIMEOUT, nullptr, 0);
+        }
+    }
+}
+
+bool asyncHttpReady() {
+    for (uint8_t i = 0; i < ASYNC_HTTP_SLOTS; i++) {
+        AsyncHttpRequest& req = _requests[i];
+        if (req.state == ASYNC_WAIT_RESPONSE && (req.client->available() > 0 || !req.client->connected())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t asyncHttpPending() {
+    uint8_t pending = 0;
+    for (uint8_t i = 0; i < ASYNC_HTTP_SLOTS; i++) {
+        if (_requests[i].state != ASYNC_IDLE) pending++;
+    }
+    return pending;
+}
+
+uint32_t asyncHttpRetried() {
+    return _retried;
+}
@@ -0,0 +1,182 @@
+/**
+ * Backend Connection Pool Implementation
+ *
+ * Số socket cố định (BACKEND_POOL_SIZE). Socket rảnh được kiểm tra trước
+ * khi dùng lại: đã bị backend đóng, có dữ liệu lạ (ví dụ 408 timeout) hoặc
+ * rảnh quá BACKEND_KEEPALIVE_MS thì bị đóng và thay bằng kết nối mới.
+ */
+
+#include "backend_pool.h"
+#include "config.h"
+#include "platform.h"
+#include "stall_watchdog.h"
+
+// ============================================
+// Connection Table
+// ============================================
+struct BackendConnection {
+    WiFiClient client;
+    bool open;
+    bool inUse;
+    unsigned long lastUsed;
+};
+
+static BackendConnection _connections[BACKEND_POOL_SIZE];
+static char _backendHost[64];
+static uint16_t _backendPort = 80;
+
+static uint32_t _acquired = 0;
+static uint32_t _reused = 0;
+static uint32_t _connects = 0;
+static uint32_t _stale = 0;
+static uint32_t _connectFailures = 0;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+/**
+ * Tách host và port từ BACKEND_URL ("http://host:port")
+ */
+static void parseBackendUrl() {
+    const char* url = BACKEND_URL;
+    if (strncmp(url, "http://", 7) == 0) url += 7;
+
+    size_t len = strcspn(url, ":/");
+    if (len >= sizeof(_backendHost)) len = sizeof(_backendHost) - 1;
+    memcpy(_backendHost, url, len);
+    _backendHost[len] = '\0';
+
+    _backendPort = (url[len] == ':') ? (uint16_t)atoi(url + len + 1) : 80;
+}
+
+/**
+ * Socket rảnh còn dùng lại được không
+ */
+static bool isIdleAlive(BackendConnection& conn) {
+    if (!conn.client.connected()) return false;
+    if (conn.client.available() > 0) return false;
+    return millis() - conn.lastUsed < BACKEND_KEEPALIVE_MS;
+}
+
+static void closeConnection(BackendConnection& conn) {
+    conn.client.stop();
+    conn.open = false;
+    conn.inUse = false;
+}
+
+static BackendConnection* findConnection(WiFiClient* client) {
+    for (uint8_t i = 0; i < BACKEND_POOL_SIZE; i++) {
+        if (&_connections[i].client == client) return &_connections[i];
+    }
+    return nullptr;
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initBackendPool() {
+    parseBackendUrl();
+    for (uint8_t i = 0; i < BACKEND_POOL_SIZE; i++) {
+        _connections[i].open = false;
+        _connections[i].inUse = false;
+    }
+    Serial.printf("[POOL] Backend %s:%u (%d connections, keep-alive %d ms)\n",
+                  _backendHost, _backendPort, BACKEND_POOL_SIZE, BACKEND_KEEPALIVE_MS);
+}
+
+WiFiClient* backendAcquire(bool* reused) {
+    if (reused) *reused = false;
+    if (WiFi.status() != WL_CONNECTED) return nullptr;
+
+    // Ưu tiên socket rảnh còn sống
+    BackendConnection* freeConn = nullptr;
+    for (uint8_t i = 0; i < BACKEND_POOL_SIZE; i++) {
+        BackendConnection& conn = _connections[i];
+        if (conn.inUse) continue;
+        if (conn.open) {
+            if (isIdleAlive(conn)) {
+                conn.inUse = true;
+                _acquired++;
+                _reused++;
+                if (reused) *reused = true;
+                return &conn.client;
+            }
+            closeConnection(conn);
+            _stale++;
+        }
+        if (!freeConn) freeConn = &conn;
+    }
+
+    if (!freeConn) {
+        Serial.println("[POOL] No free backend connection");
+        return nullptr;
+    }
+
+    // connect() chặn loop(): tra DNS (nếu BACKEND_URL là tên miền) rồi chờ bắt
+    // tay TCP tối đa BACKEND_CONNECT_TIMEOUT. Chỉ xảy ra khi không có socket
+    // keep-alive để dùng lại; tính thành stage riêng để stall ghi đúng chỗ
+    const char* outerStage = stallStage();
+    stallArm("backend-connect");
+    freeConn->client.setTimeout(BACKEND_CONNECT_TIMEOUT);
+    bool connected = freeConn->client.connect(_backendHost, _backendPort);
+    stallDisarm();
+    if (outerStage) stallArm(outerStage);  // Phần còn lại của stage ngoài tính lại từ đây
+    if (!connected) {
+        Serial.printf("[POOL] Connect to %s:%u failed\n", _backendHost, _backendPort);
+        freeConn->client.stop();
+        _connectFailures++;
+        return nullptr;
+    }
+    freeConn->client.setNoDelay(true);
+    freeConn->open = true;
+    freeConn->inUse = true;
+    _acquired++;
+    _connects++;
+    return &freeConn->client;
+}
+
+void backendRelease(WiFiClient* client, bool keepAlive) {
+    BackendConnection* conn = findConnection(client);
+    if (!conn) return;
+
+    if (keepAlive && conn->client.connected()) {
+        conn->inUse = false;
+        conn->lastUsed = millis();
+    } else {
+        closeConnection(*conn);
+    }
+}
+
+void backendPoolMaintain() {
+    for (uint8_t i = 0; i < BACKEND_POOL_SIZE; i++) {
+        BackendConnection& conn = _connections[i];
+        if (conn.open && !conn.inUse && !isIdleAlive(conn)) {
+            closeConnection(conn);
+            _stale++;
+        }
+    }
+}
+
+const char* backendHost() {
+    return _backendHost;
+}
+
+uint16_t backendPort() {
+    return _backendPort;
+}
+
+void backendPoolGetStats(BackendPoolStats& stats) {
+    stats.open = 0;
+    stats.inUse = 0;
+    for (uint8_t i = 0; i < BACKEND_POOL_SIZE; i++) {
+        if (_connections[i].open) stats.open++;
+        if (_connections[i].inUse) stats.inUse++;
+    }
+    stats.acquired = _acquired;
+    stats.reused = _reused;
+    stats.connects = _connects;
+    stats.stale = _stale;
+    stats.connectFailures = _connectFailures;
+}
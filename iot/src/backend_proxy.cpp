@@ -0,0 +1,247 @@
+/**
+ * Backend Proxy Implementation
+ *
+ * Header phản hồi được đọc từng dòng vào buffer dòng cố định; body được
+ * chép qua một buffer tĩnh PROXY_BUFFER_SIZE từ socket backend sang socket
+ * kiosk. Body chunked của backend được giải mã rồi gửi lại cho kiosk bằng
+ * sendContent() (web server tự đóng gói chunked khi chưa biết độ dài).
+ */
+
+#include "backend_proxy.h"
+#include "backend_pool.h"
+#include "config.h"
+#include <WiFiClient.h>
+
+// ============================================
+// Buffers & Stats
+// ============================================
+static char _buffer[PROXY_BUFFER_SIZE];
+static char _line[PROXY_LINE_SIZE];
+
+static uint32_t _requests = 0;
+static uint32_t _errors = 0;
+static uint32_t _bytes = 0;
+static uint32_t _maxBody = 0;
+
+/**
+ * Thông tin header phản hồi cần cho việc stream
+ */
+struct ProxyResponse {
+    int code;
+    long contentLength;     // -1 nếu không có Content-Length
+    bool chunked;
+    bool close;             // Backend yêu cầu đóng kết nối
+    char contentType[64];
+};
+
+// ============================================
+// Helper Functions
+// ============================================
+
+/**
+ * Chờ có dữ liệu trên socket backend
+ * @return false nếu socket đóng hoặc hết thời gian
+ */
+static bool waitData(WiFiClient* client, unsigned long deadline) {
+    while (client->available() <= 0) {
+        if (!client->connected()) return false;
+        if ((long)(millis() - deadline) >= 0) return false;
+        delay(1);
+    }
+    return true;
+}
+
+/**
+ * Đọc một dòng (bỏ "\r\n"); phần vượt quá PROXY_LINE_SIZE bị cắt bỏ
+ * @return Độ dài dòng hoặc -1 nếu socket đóng / hết thời gian
+ */
+static int readLine(WiFiClient* client, unsigned long deadline) {
+    size_t len = 0;
+    while (true) {
+        if (!waitData(client, deadline)) return -1;
+        int c = client->read();
+        if (c < 0) continue;
+        if (c == '\n') break;
+        if (c != '\r' && len < PROXY_LINE_SIZE - 1) _line[len++] = (char)c;
+    }
+    _line[len] = '\0';
+    return (int)len;
+}
+
+/**
+ * Chép đúng length byte từ backend sang kiosk qua buffer tĩnh
+ */
+static bool pipeBytes(WiFiClient* client, ESP8266WebServer& server, size_t length,
+                      unsigned long& deadline, size_t& total) {
+    while (length > 0) {
+        if (!waitData(client, deadline)) return false;
+        int n = client->read((uint8_t*)_buffer, min(length, (size_t)PROXY_BUFFER_SIZE));
+        if (n <= 0) continue;
+        server.sendContent(_buffer, n);
+        length -= n;
+        total += n;
+        deadline = millis() + HTTP_TIMEOUT;
+    }
+    return true;
+}
+
+/**
+ * Giải mã body chunked của backend, gửi từng phần cho kiosk
+ */
+static bool pipeChunked(WiFiClient* client, ESP8266WebServer& server,
+                        unsigned long& deadline, size_t& total) {
+    while (true) {
+        if (readLine(client, deadline) < 0) return false;
+        size_t chunkLen = strtoul(_line, nullptr, 16);
+        if (chunkLen == 0) {
+            // Bỏ qua trailer tới dòng trống
+            int len;
+            while ((len = readLine(client, deadline)) > 0) {}
+            return len == 0;
+        }
+        if (!pipeBytes(client, server, chunkLen, deadline, total)) return false;
+        if (readLine(client, deadline) < 0) return false;
+    }
+}
+
+/**
+ * Body không có độ dài: chép tới khi backend đóng kết nối
+ */
+static void pipeUntilClose(WiFiClient* client, ESP8266WebServer& server,
+                           unsigned long& deadline, size_t& total) {
+    while (waitData(client, deadline)) {
+        int n = client->read((uint8_t*)_buffer, PROXY_BUFFER_SIZE);
+        if (n <= 0) continue;
+        server.sendContent(_buffer, n);
+        total += n;
+        deadline = millis() + HTTP_TIMEOUT;
+    }
+}
+
+/**
+ * Gửi request tới backend (header viết thẳng ra socket, không dựng String)
+ */
+static bool sendRequest(WiFiClient* client, const char* method, const char* path,
+                        const String& body, const String& auth) {
+    client->printf("%s %s HTTP/1.1\r\nHost: %s:%u\r\n", method, path, backendHost(), backendPort());
+    client->print("Content-Type: application/json\r\nConnection: keep-alive\r\n");
+    if (auth.length() > 0) {
+        client->print("Authorization: ");
+        client->print(auth);
+        client->print("\r\n");
+    }
+    client->printf("Content-Length: %u\r\n\r\n", (unsigned)body.length());
+    if (body.length() > 0 &&
+        client->write((const uint8_t*)body.c_str(), body.length()) != body.length()) {
+        return false;
+    }
+    return client->connected();
+}
+
+/**
+ * Đọc status line và header phản hồi
+ * @return 1 nếu thành công, 0 nếu socket bị đóng trước khi có phản hồi, -1 nếu lỗi/timeout
+ */
+static int readResponseHead(WiFiClient* client, ProxyResponse& res, unsigned long deadline) {
+    int len = readLine(client, deadline);
+    if (len < 0) return client->connected() ? -1 : 0;
+
+    // Status line: "HTTP/1.1 200 OK"
+    const char* space = strchr(_line, ' ');
+    res.code = space ? atoi(space + 1) : 0;
+    if (res.code <= 0) return -1;
+
+    res.contentLength = -1;
+    res.chunked = false;
+    res.close = false;
+    strcpy(res.contentType, "application/json");
+
+    while ((len = readLine(client, deadline)) > 0) {
+        char* colon = strchr(_line, ':');
+        if (!colon) continue;
+        *colon = '\0';
+        const char* value = colon + 1;
+        while (*value == ' ') value++;
+
+        if (strcasecmp(_line, "Content-Length") == 0) {
+            res.contentLength = atol(value);
+        } else if (strcasecmp(_line, "Transfer-Encoding") == 0) {
+            res.chunked = strncasecmp(value, "chunked", 7) == 0;
+        } else if (strcasecmp(_line, "Connection") == 0) {
+            res.close = strncasecmp(value, "close", 5) == 0;
+        } else if (strcasecmp(_line, "Content-Type") == 0) {
+            strncpy(res.contentType, value, sizeof(res.contentType) - 1);
+            res.contentType[sizeof(res.contentType) - 1] = '\0';
+        }
+    }
+    return len == 0 ? 1 : -1;
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+bool proxyStream(ESP8266WebServer& server, const char* method, const char* path,
+                 const String& body, const String& auth) {
+    _requests++;
+
+    ProxyResponse res;
+    bool reused = false;
+    WiFiClient* client = nullptr;
+    int head = 0;
+
+    // Socket keep-alive bị backend đóng ngầm: thử lại một lần trên kết nối mới
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+        client = backendAcquire(&reused);
+        if (!client) break;
+
+        unsigned long deadline = millis() + HTTP_TIMEOUT;
+        head = sendRequest(client, method, path, body, auth) ? readResponseHead(client, res, deadline) : 0;
+        if (head == 1) break;
+
+        backendRelease(client, false);
+        client = nullptr;
+        if (head < 0 || !reused) break;
+        Serial.println("[PROXY] Stale keep-alive socket, retrying");
+    }
+
+    if (!client) {
+        _errors++;
+        return false;
+    }
+
+    // Độ dài biết trước thì giữ nguyên, còn lại để web server gửi chunked
+    server.setContentLength(res.chunked || res.contentLength < 0
+                            ? CONTENT_LENGTH_UNKNOWN : (size_t)res.contentLength);
+    server.send(res.code, res.contentType, "");
+
+    unsigned long deadline = millis() + HTTP_TIMEOUT;
+    size_t total = 0;
+    bool complete;
+    if (res.chunked) {
+        complete = pipeChunked(client, server, deadline, total);
+    } else if (res.contentLength >= 0) {
+        complete = pipeBytes(client, server, (size_t)res.contentLength, deadline, total);
+    } else {
+        pipeUntilClose(client, server, deadline, total);
+        complete = false;
+    }
+
+    backendRelease(client, complete && !res.close);
+
+    if (!complete && (res.chunked || res.contentLength >= 0)) {
+        _errors++;
+        Serial.printf("[PROXY] Backend response truncated after %u bytes\n", (unsigned)total);
+    }
+    _bytes += total;
+    if (total > _maxBody) _maxBody = total;
+    Serial.printf("[PROXY] Response: %d (%u bytes streamed)\n", res.code, (unsigned)total);
+    return true;
+}
+
+void proxyGetStats(ProxyStats& stats) {
+    stats.requests = _requests;
+    stats.errors = _errors;
+    stats.bytes = _bytes;
+    stats.maxBody = _maxBody;
+}
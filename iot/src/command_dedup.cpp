@@ -0,0 +1,123 @@
+/**
+ * Command Dedup Implementation
+ *
+ * Khóa của lệnh là FNV-1a 64 bit của cmd_id (hoặc seq) nên mỗi phần tử chỉ
+ * tốn vài byte dù cmd_id là UUID. Vòng đệm ghi đè phần tử cũ nhất; bảng băm
+ * là các chuỗi liên kết qua chỉ số trong vòng đệm (không cấp phát động),
+ * phần tử bị ghi đè được gỡ khỏi chuỗi của nó trước.
+ */
+
+#include "command_dedup.h"
+#include "config.h"
+
+// ============================================
+// Ring + Hash Index
+// ============================================
+#define DEDUP_NONE 0xFF
+#define DEDUP_SEQ_TAG 0x8000000000000000ULL  // Phân biệt khóa seq với khóa cmd_id
+
+struct DedupEntry {
+    uint64_t key;           // 0 = trống
+    uint32_t executedAt;    // millis()
+    uint8_t next;           // Phần tử kế trong cùng bucket
+};
+
+static DedupEntry _ring[CMD_DEDUP_SIZE];
+static uint8_t _buckets[CMD_DEDUP_BUCKETS];
+static uint8_t _head = 0;  // Phần tử sẽ bị ghi đè tiếp theo (cũ nhất)
+
+static uint32_t _executed = 0;
+static uint32_t _duplicates = 0;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static uint64_t commandKey(const char* cmdId, uint32_t seq) {
+    if (cmdId && *cmdId) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (const char* p = cmdId; *p; p++) {
+            hash = (hash ^ (uint8_t)*p) * 1099511628211ULL;
+        }
+        return (hash & ~DEDUP_SEQ_TAG) | 1;
+    }
+    return seq ? (DEDUP_SEQ_TAG | seq) : 0;
+}
+
+static uint8_t bucketOf(uint64_t key) {
+    return (uint8_t)((key ^ (key >> 32)) & (CMD_DEDUP_BUCKETS - 1));
+}
+
+static void unlink(uint8_t index) {
+    uint8_t* link = &_buckets[bucketOf(_ring[index].key)];
+    while (*link != DEDUP_NONE) {
+        if (*link == index) {
+            *link = _ring[index].next;
+            return;
+        }
+        link = &_ring[*link].next;
+    }
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initCommandDedup() {
+    memset(_ring, 0, sizeof(_ring));
+    memset(_buckets, DEDUP_NONE, sizeof(_buckets));
+    _head = 0;
+}
+
+bool commandSeen(const char* cmdId, uint32_t seq) {
+    uint64_t key = commandKey(cmdId, seq);
+    if (key == 0) return false;  // Lệnh kiểu cũ không có ID: luôn thực hiện
+
+    uint32_t now = millis();
+    for (uint8_t i = _buckets[bucketOf(key)]; i != DEDUP_NONE; i = _ring[i].next) {
+        if (_ring[i].key != key) continue;
+        if (now - _ring[i].executedAt < CMD_DEDUP_WINDOW) {
+            _duplicates++;
+            return true;
+        }
+        // Đã quá cửa sổ dedup: coi như lệnh mới
+        _ring[i].executedAt = now;
+        _executed++;
+        return false;
+    }
+
+    // Ghi đè phần tử cũ nhất
+    if (_ring[_head].key != 0) unlink(_head);
+    uint8_t bucket = bucketOf(key);
+    _ring[_head].key = key;
+    _ring[_head].executedAt = now;
+    _ring[_head].next = _buckets[bucket];
+    _buckets[bucket] = _head;
+    _head = (_head + 1) % CMD_DEDUP_SIZE;
+    _executed++;
+    return false;
+}
+
+void commandForget(const char* cmdId, uint32_t seq) {
+    uint64_t key = commandKey(cmdId, seq);
+    if (key == 0) return;
+
+    for (uint8_t i = _buckets[bucketOf(key)]; i != DEDUP_NONE; i = _ring[i].next) {
+        if (_ring[i].key != key) continue;
+        // Để trống phần tử: vòng đệm ghi đè nó như phần tử chưa dùng
+        unlink(i);
+        _ring[i].key = 0;
+        _executed--;
+        return;
+    }
+}
+
+void commandDedupGetStats(CommandDedupStats& stats) {
+    uint32_t now = millis();
+    stats.tracked = 0;
+    for (uint8_t i = 0; i < CMD_DEDUP_SIZE; i++) {
+        if (_ring[i].key != 0 && now - _ring[i].executedAt < CMD_DEDUP_WINDOW) stats.tracked++;
+    }
+    stats.executed = _executed;
+    stats.duplicates = _duplicates;
+}
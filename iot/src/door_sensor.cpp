@@ -0,0 +1,195 @@
+/**
+ * Door Sensor Implementation
+ *
+ * input_events lo phần ngắt và chống dội cạnh (leading-edge, hợp với nút
+ * nhấn). Công tắc cửa còn bị rung khi đóng sập hay va chạm, nên mỗi box có
+ * thêm máy trạng thái: mức mới chỉ được nhận (CLOSED <-> OPEN) khi giữ
+ * nguyên DOOR_SETTLE_MS; quay về mức cũ trước đó thì tính là nhiễu (glitch).
+ * Mỗi chuyển trạng thái được nhận ghi journal và đưa trạng thái box vào
+ * outbox. Mọi cửa dùng chung một task one-shot của scheduler.
+ */
+
+#include "door_sensor.h"
+#include "config.h"
+#include "input_events.h"
+#include "locker_controller.h"
+#include "event_journal.h"
+#include "scheduler.h"
+#include "dual_core.h"
+
+// ============================================
+// Door Table
+// ============================================
+enum DoorState : uint8_t {
+    DOOR_UNKNOWN,           // Box không có cảm biến
+    DOOR_CLOSED,
+    DOOR_OPEN
+};
+
+struct DoorEntry {
+    int8_t input;           // ID input_events, -1 nếu không có cảm biến
+    CoreShared<DoorState> state;  // Trạng thái đã được nhận (lõi mạng đọc cho /status, outbox)
+    bool settling;          // Mức hiện tại khác state, đang chờ đủ DOOR_SETTLE_MS
+    unsigned long since;    // millis() lúc mức bắt đầu khác state
+};
+
+static constexpr uint8_t DOOR_PIN_MAP[] = DOOR_SENSOR_PINS;
+
+// Mảng khai báo thiếu phần tử sẽ được điền 0 (GPIO0), không phải DOOR_NO_SENSOR
+static_assert(sizeof(DOOR_PIN_MAP) == BOX_COUNT, "DOOR_SENSOR_PINS must list one entry per box");
+
+static constexpr bool doorPinUsed(uint8_t pin, int index = 0) {
+    return index < BOX_COUNT && (DOOR_PIN_MAP[index] == pin || doorPinUsed(pin, index + 1));
+}
+
+// Chân của nút nhấn, LED và driver relay đã được dùng, không gắn được ngắt cửa
+static_assert(!doorPinUsed(BUTTON_PIN) && !doorPinUsed(LED_STATUS), "Door sensor pin collides with the button or LED");
+
+#if RELAY_DRIVER == RELAY_DRIVER_GPIO
+static constexpr uint8_t DOOR_RELAY_PINS[] = RELAY_PINS;
+
+static constexpr bool relayPinUsedByDoor(int index = 0) {
+    return index < (int)sizeof(DOOR_RELAY_PINS) &&
+           (doorPinUsed(DOOR_RELAY_PINS[index]) || relayPinUsedByDoor(index + 1));
+}
+
+static_assert(!relayPinUsedByDoor(), "Door sensor pin collides with a relay pin");
+#elif RELAY_DRIVER == RELAY_DRIVER_74HC595
+static_assert(!doorPinUsed(SHIFT_DATA_PIN) && !doorPinUsed(SHIFT_CLOCK_PIN) && !doorPinUsed(SHIFT_LATCH_PIN),
+              "Door sensor pin collides with a 74HC595 pin");
+#elif RELAY_DRIVER == RELAY_DRIVER_PCF8574
+static_assert(!doorPinUsed(I2C_SDA_PIN) && !doorPinUsed(I2C_SCL_PIN),
+              "Door sensor pin collides with a PCF8574 I2C pin");
+#endif
+static DoorEntry _doors[BOX_COUNT];
+
+static CoreShared<uint32_t> _transitions{0};
+static CoreShared<uint32_t> _forced{0};
+static CoreShared<uint32_t> _glitches{0};
+static SchedulerTaskId _settleTask = SCHEDULER_INVALID_TASK;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static inline DoorState stateForLevel(uint8_t level) {
+    return level == DOOR_OPEN_LEVEL ? DOOR_OPEN : DOOR_CLOSED;
+}
+
+/**
+ * Mức mới đã giữ đủ lâu: nhận chuyển trạng thái, ghi journal và báo backend
+ */
+static void commitDoor(uint8_t index) {
+    DoorEntry& door = _doors[index];
+    door.state = door.state == DOOR_OPEN ? DOOR_CLOSED : DOOR_OPEN;
+    door.settling = false;
+    _transitions++;
+
+    int boxId = boxIdAt(index);
+    bool open = door.state == DOOR_OPEN;
+    bool unlocked = isUnlocked(boxId);
+    journalAppend(open ? JOURNAL_DOOR_OPEN : JOURNAL_DOOR_CLOSE, boxId);
+
+    if (open && !unlocked) {
+        _forced++;
+        Serial.printf("[DOOR] Box %d opened while locked!\n", boxId);
+    } else {
+        Serial.printf("[DOOR] Box %d %s\n", boxId, open ? "opened" : "closed");
+    }
+
+    // Đổi trạng thái thật: báo ngay (outbox gộp các cạnh sát nhau)
+    reportBoxStatus(boxId, unlocked ? STATUS_AVAILABLE : STATUS_LOCKED, open);
+}
+
+/**
+ * Task one-shot: nhận các cửa đã giữ mức mới đủ lâu, hẹn lại cho cửa
+ * còn đang chờ sớm nhất
+ */
+static void settleTask(void* arg) {
+    _settleTask = SCHEDULER_INVALID_TASK;
+    unsigned long now = millis();
+    uint32_t nextMs = 0;
+    bool pending = false;
+
+    for (uint8_t i = 0; i < BOX_COUNT; i++) {
+        DoorEntry& door = _doors[i];
+        if (!door.settling) continue;
+        uint32_t elapsed = now - door.since;
+        if (elapsed >= DOOR_SETTLE_MS) {
+            commitDoor(i);
+            continue;
+        }
+        uint32_t remaining = DOOR_SETTLE_MS - elapsed;
+        if (!pending || remaining < nextMs) nextMs = remaining;
+        pending = true;
+    }
+
+    if (pending) _settleTask = schedulerAfter(nextMs, settleTask, "door-settle");
+}
+
+/**
+ * Handler input_events: mức công tắc cửa của một box đổi
+ */
+static void handleDoor(int8_t input, uint8_t level, uint32_t timestampUs) {
+    uint8_t index = 0;
+    while (index < BOX_COUNT && _doors[index].input != input) index++;
+    if (index == BOX_COUNT) return;
+
+    DoorEntry& door = _doors[index];
+    if (stateForLevel(level) == door.state) {
+        // Quay về mức cũ trước khi kịp ổn định: rung/nhiễu, bỏ qua
+        if (door.settling) {
+            door.settling = false;
+            _glitches++;
+        }
+        return;
+    }
+    if (door.settling) return;
+
+    door.settling = true;
+    door.since = millis();
+    if (_settleTask == SCHEDULER_INVALID_TASK) {
+        _settleTask = schedulerAfter(DOOR_SETTLE_MS, settleTask, "door-settle");
+    }
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initDoorSensors() {
+    uint8_t sensors = 0;
+    for (uint8_t i = 0; i < BOX_COUNT; i++) {
+        DoorEntry& door = _doors[i];
+        door.input = -1;
+        door.state = DOOR_UNKNOWN;
+        door.settling = false;
+        if (DOOR_PIN_MAP[i] == DOOR_NO_SENSOR) continue;
+
+        door.input = inputRegister(DOOR_PIN_MAP[i], INPUT_PULLUP, DOOR_DEBOUNCE_TIME, handleDoor, "door");
+        if (door.input < 0) continue;
+        door.state = stateForLevel(inputLevel(door.input));
+        sensors++;
+    }
+    Serial.printf("[DOOR] %u sensor(s) ready\n", sensors);
+}
+
+bool doorHasSensor(int boxId) {
+    return isValidBox(boxId) && _doors[boxId - BOX_ID].state != DOOR_UNKNOWN;
+}
+
+bool doorIsOpen(int boxId) {
+    return isValidBox(boxId) && _doors[boxId - BOX_ID].state == DOOR_OPEN;
+}
+
+void doorGetStats(DoorStats& stats) {
+    stats.sensors = 0;
+    stats.open = 0;
+    for (uint8_t i = 0; i < BOX_COUNT; i++) {
+        if (_doors[i].state != DOOR_UNKNOWN) stats.sensors++;
+        if (_doors[i].state == DOOR_OPEN) stats.open++;
+    }
+    stats.transitions = _transitions;
+    stats.forced = _forced;
+    stats.glitches = _glitches;
+}
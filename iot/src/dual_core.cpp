@@ -0,0 +1,285 @@
+/**
+ * Dual Core Implementation
+ *
+ * Hai task ghim lõi và hai hàng đợi SPSC giữa chúng (xem dual_core.h).
+ * Lệnh chỉ do task mạng push và task actuation pop; sự kiện ngược lại, nên
+ * mỗi hàng đợi đúng một producer và một consumer.
+ *
+ * Sự kiện không bao giờ bị bỏ khi lõi mạng chậm:
+ * - EVENT_DONE: mỗi lệnh có callback chiếm một suất trong ACTUATOR_QUEUE_SIZE
+ *   suất cho tới khi lõi mạng xử lý kết quả, và journal/trạng thái không
+ *   được lấn vào ACTUATOR_QUEUE_SIZE chỗ cuối của hàng đợi sự kiện, nên
+ *   kết quả lệnh luôn push được (PendingReply của MQTT luôn được giải phóng)
+ * - Journal/trạng thái không vừa thì chờ trong backlog của lõi actuation,
+ *   theo thứ tự, và được đẩy lại mỗi vòng actuatorRun()
+ */
+
+#include "dual_core.h"
+
+#if LOCKER_DUAL_CORE
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "spsc_queue.h"
+
+// ============================================
+// Queue Entries
+// ============================================
+struct ActuatorCommand {
+    ActuatorAction action;
+    int boxId;
+    uint32_t queuedUs;      // micros() khi push, để đo thời gian chờ
+    ActuatorDone done;
+    void* ctx;
+};
+
+enum ActuatorEventKind : uint8_t {
+    EVENT_DONE,             // Lệnh đã thực hiện (gọi done trên lõi mạng)
+    EVENT_JOURNAL,          // Bản ghi journal
+    EVENT_STATUS            // Trạng thái box cần báo
+};
+
+struct ActuatorEvent {
+    ActuatorEventKind kind;
+    uint8_t code;           // ActuatorAction / JournalEvent / BoxStatus
+    bool flag;              // ok / isDoorOpen
+    int boxId;
+    uint32_t time;          // relayUs (DONE) / uptimeMs (JOURNAL)
+    ActuatorDone done;
+    void* ctx;
+};
+
+// ============================================
+// Dual Core State
+// ============================================
+struct CoreTask {
+    CoreFunction setup;
+    CoreFunction loop;
+};
+
+static CoreTask _actuation = {nullptr, nullptr};
+static CoreTask _network = {nullptr, nullptr};
+static TaskHandle_t _actuationTask = nullptr;
+static std::atomic<bool> _actuationReady{false};
+
+static SpscQueue<ActuatorCommand, ACTUATOR_QUEUE_SIZE> _commands;
+static SpscQueue<ActuatorEvent, ACTUATOR_EVENT_QUEUE_SIZE> _events;
+
+static_assert(ACTUATOR_EVENT_QUEUE_SIZE > ACTUATOR_QUEUE_SIZE,
+              "Event queue must have room beyond the slots reserved for command results");
+
+// Chỉ lõi mạng đọc/ghi: lệnh có callback chưa được xử lý kết quả
+static uint16_t _inflight = 0;
+
+// Chỉ lõi actuation đọc/ghi: journal/trạng thái chờ chỗ trong hàng đợi sự kiện
+static ActuatorEvent _backlog[ACTUATOR_BACKLOG_SIZE];
+static uint16_t _backlogHead = 0;       // Phần tử cũ nhất
+static uint16_t _backlogCount = 0;
+
+// Mỗi số đếm chỉ một task ghi; /status đọc từ lõi mạng
+static std::atomic<uint32_t> _executed{0};
+static std::atomic<uint32_t> _deferred{0};
+static std::atomic<uint32_t> _dropped{0};
+static std::atomic<uint16_t> _backlogDepth{0};
+static std::atomic<uint32_t> _lastQueueUs{0};
+static std::atomic<uint32_t> _maxQueueUs{0};
+static std::atomic<uint32_t> _actuationLoops{0};
+static uint32_t _handled = 0;
+static uint32_t _rejected = 0;
+static uint32_t _flashStalls = 0;
+static uint32_t _maxFlashUs = 0;
+
+// ============================================
+// Tasks
+// ============================================
+
+static void actuationTaskMain(void* arg) {
+    (void)arg;
+    // Gán handle ngay trong task: xTaskCreatePinnedToCore có thể chưa trả về
+    // khi task đã chạy trên lõi kia
+    _actuationTask = xTaskGetCurrentTaskHandle();
+    _actuation.setup();
+    _actuationReady.store(true, std::memory_order_release);
+
+    for (;;) {
+        _actuation.loop();
+        _actuationLoops.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+static void networkTaskMain(void* arg) {
+    (void)arg;
+    // Chờ relay và input sẵn sàng trước khi nhận lệnh từ mạng
+    while (!_actuationReady.load(std::memory_order_acquire)) {
+        vTaskDelay(1);
+    }
+    _network.setup();
+
+    for (;;) {
+        _network.loop();
+    }
+}
+
+// ============================================
+// Helper Functions
+// ============================================
+
+/**
+ * Journal/trạng thái chỉ được dùng phần hàng đợi không dành cho EVENT_DONE
+ */
+static bool pushRecord(const ActuatorEvent& event) {
+    if (_events.size() >= ACTUATOR_EVENT_QUEUE_SIZE - ACTUATOR_QUEUE_SIZE) return false;
+    return _events.push(event);
+}
+
+/**
+ * Đẩy backlog sang lõi mạng theo thứ tự, dừng khi hàng đợi hết chỗ
+ */
+static void flushBacklog() {
+    if (_backlogCount == 0) return;
+    while (_backlogCount > 0 && pushRecord(_backlog[_backlogHead])) {
+        _backlogHead = (_backlogHead + 1) % ACTUATOR_BACKLOG_SIZE;
+        _backlogCount--;
+    }
+    _backlogDepth.store(_backlogCount, std::memory_order_relaxed);
+}
+
+/**
+ * Journal/trạng thái: đi sau backlog để giữ thứ tự; lõi mạng treo quá lâu
+ * thì chờ trong backlog, không chặn lõi actuation
+ */
+static bool postRecord(const ActuatorEvent& event) {
+    flushBacklog();
+    if (_backlogCount == 0 && pushRecord(event)) return true;
+
+    if (_backlogCount == ACTUATOR_BACKLOG_SIZE) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        Serial.printf("[CORE] Event backlog full, box %d event lost\n", event.boxId);
+        return false;
+    }
+    _backlog[(_backlogHead + _backlogCount) % ACTUATOR_BACKLOG_SIZE] = event;
+    _backlogCount++;
+    _backlogDepth.store(_backlogCount, std::memory_order_relaxed);
+    _deferred.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void dualCoreStart(CoreFunction actuationSetup, CoreFunction actuationLoop,
+                   CoreFunction networkSetup, CoreFunction networkLoop) {
+    _actuation = {actuationSetup, actuationLoop};
+    _network = {networkSetup, networkLoop};
+
+    xTaskCreatePinnedToCore(actuationTaskMain, "actuation", ACTUATION_TASK_STACK, nullptr,
+                            ACTUATION_TASK_PRIORITY, nullptr, ACTUATION_CORE);
+    xTaskCreatePinnedToCore(networkTaskMain, "network", NETWORK_TASK_STACK, nullptr,
+                            NETWORK_TASK_PRIORITY, nullptr, NETWORK_CORE);
+
+    Serial.printf("[CORE] Actuation task on core %d, network task on core %d\n", ACTUATION_CORE, NETWORK_CORE);
+}
+
+bool onActuationCore() {
+    return _actuationTask != nullptr && xTaskGetCurrentTaskHandle() == _actuationTask;
+}
+
+bool actuatorSubmit(ActuatorAction action, int boxId, ActuatorDone done, void* ctx) {
+    ActuatorCommand command = {action, boxId, (uint32_t)micros(), done, ctx};
+    // Hết suất kết quả thì từ chối luôn: EVENT_DONE của lệnh đã nhận không được mất
+    if ((done != nullptr && _inflight >= ACTUATOR_QUEUE_SIZE) || !_commands.push(command)) {
+        _rejected++;
+        Serial.printf("[CORE] Command queue full, box %d rejected\n", boxId);
+        return false;
+    }
+    if (done != nullptr) _inflight++;
+    if (_actuationTask != nullptr) xTaskNotifyGive(_actuationTask);
+    return true;
+}
+
+void actuatorRun() {
+    flushBacklog();
+
+    ActuatorCommand command;
+    while (_commands.pop(command)) {
+        uint32_t waitedUs = micros() - command.queuedUs;
+        _lastQueueUs.store(waitedUs, std::memory_order_relaxed);
+        if (waitedUs > _maxQueueUs.load(std::memory_order_relaxed)) {
+            _maxQueueUs.store(waitedUs, std::memory_order_relaxed);
+        }
+
+        bool ok = command.action == ACTUATOR_UNLOCK ? unlockBox(command.boxId) : lockBox(command.boxId);
+        _executed.fetch_add(1, std::memory_order_relaxed);
+
+        if (command.done != nullptr) {
+            ActuatorEvent event = {EVENT_DONE, (uint8_t)command.action, ok, command.boxId,
+                                   lastRelayWriteUs(), command.done, command.ctx};
+            // Luôn có chỗ: tối đa ACTUATOR_QUEUE_SIZE lệnh có callback đang chờ
+            // kết quả, và journal/trạng thái không dùng chừng ấy chỗ cuối
+            _events.push(event);
+        }
+    }
+}
+
+void actuatorIdle(uint32_t maxMs) {
+    if (!_commands.empty()) return;
+    // Ít nhất một tick: tick 0 biến vòng actuation thành busy loop, bỏ đói idle task của lõi
+    TickType_t ticks = pdMS_TO_TICKS(maxMs);
+    ulTaskNotifyTake(pdTRUE, ticks > 0 ? ticks : 1);
+}
+
+bool actuatorPostJournal(JournalEvent event, int boxId, uint32_t uptimeMs) {
+    ActuatorEvent entry = {EVENT_JOURNAL, (uint8_t)event, false, boxId, uptimeMs, nullptr, nullptr};
+    return postRecord(entry);
+}
+
+bool actuatorPostStatus(int boxId, BoxStatus status, bool isDoorOpen) {
+    ActuatorEvent entry = {EVENT_STATUS, (uint8_t)status, isDoorOpen, boxId, 0, nullptr, nullptr};
+    return postRecord(entry);
+}
+
+void actuatorEventsPoll() {
+    ActuatorEvent event;
+    while (_events.pop(event)) {
+        _handled++;
+        switch (event.kind) {
+            case EVENT_DONE:
+                _inflight--;
+                event.done(event.boxId, (ActuatorAction)event.code, event.flag, event.time, event.ctx);
+                break;
+            case EVENT_JOURNAL:
+                journalAppend((JournalEvent)event.code, event.boxId, event.time);
+                break;
+            case EVENT_STATUS:
+                queueBoxStatus(event.boxId, (BoxStatus)event.code, event.flag);
+                break;
+        }
+    }
+}
+
+bool actuatorEventsPending() {
+    return !_events.empty();
+}
+
+void dualCoreFlashDone(uint32_t startUs) {
+    uint32_t elapsedUs = micros() - startUs;
+    _flashStalls++;
+    if (elapsedUs > _maxFlashUs) _maxFlashUs = elapsedUs;
+}
+
+void dualCoreGetStats(DualCoreStats& stats) {
+    stats.commands = _executed.load(std::memory_order_relaxed);
+    stats.events = _handled;
+    stats.rejected = _rejected;
+    stats.deferred = _deferred.load(std::memory_order_relaxed);
+    stats.backlog = _backlogDepth.load(std::memory_order_relaxed);
+    stats.dropped = _dropped.load(std::memory_order_relaxed);
+    stats.lastQueueUs = _lastQueueUs.load(std::memory_order_relaxed);
+    stats.maxQueueUs = _maxQueueUs.load(std::memory_order_relaxed);
+    stats.actuationLoops = _actuationLoops.load(std::memory_order_relaxed);
+    stats.flashStalls = _flashStalls;
+    stats.maxFlashUs = _maxFlashUs;
+}
+
+#endif // LOCKER_DUAL_CORE
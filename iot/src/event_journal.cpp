@@ -0,0 +1,364 @@
+/**
+ * Event Journal Implementation
+ *
+ * Vùng journal gồm JOURNAL_SECTORS sector liên tiếp, chia thành các ô 16
+ * byte. Bản ghi có số thứ tự seq tăng dần và luôn nằm ở ô seq % số ô, nên
+ * đọc lại theo seq không cần tìm kiếm; khởi động chỉ cần quét một lần để
+ * tìm seq lớn nhất.
+ *
+ * Sector kế tiếp sau sector đang ghi luôn được xoá trước (journalMaintain),
+ * nhờ vậy journalAppend() chỉ là một lần ghi 16 byte. Khi backend nhận một
+ * lô, journal ghi thêm bản ghi ACK chứa seq cuối đã nhận: vị trí gửi lại
+ * nằm ngay trong journal, không cần vùng flash riêng.
+ */
+
+#include "event_journal.h"
+#include "async_http.h"
+#include "config.h"
+#include "heap_monitor.h"
+#include "platform.h"
+#include "dual_core.h"
+#include <ArduinoJson.h>
+#include <time.h>
+
+// deviceId, seq, at, ms, box, event
+#define JOURNAL_JSON_SIZE (JSON_OBJECT_SIZE(6) + 4 * JSON_ARRAY_SIZE(JOURNAL_BATCH_SIZE))
+
+// ============================================
+// Flash Layout
+// ============================================
+#define JOURNAL_ACK 0xA5        // Bản ghi nội bộ: backend đã nhận tới seq = at
+
+struct JournalRecord {
+    uint32_t seq;           // Số thứ tự (bắt đầu từ 1), ô = seq % JOURNAL_SLOTS
+    uint32_t at;            // Epoch (giây), 0 nếu chưa đồng bộ NTP; ACK: seq cuối đã gửi
+    uint32_t uptimeMs;      // millis() lúc ghi
+    uint8_t boxIndex;       // boxId - BOX_ID
+    uint8_t event;          // JournalEvent hoặc JOURNAL_ACK
+    uint16_t crc;           // CRC-16/CCITT của 14 byte phía trên
+};
+
+#define JOURNAL_PER_SECTOR (SPI_FLASH_SEC_SIZE / sizeof(JournalRecord))
+#define JOURNAL_SLOTS (JOURNAL_SECTORS * JOURNAL_PER_SECTOR)
+
+static_assert(sizeof(JournalRecord) == 16, "Journal record must be 16 bytes");
+static_assert(JOURNAL_SECTORS >= 2, "Journal needs a pre-erased spare sector");
+static_assert(JOURNAL_FLASH_ADDR % SPI_FLASH_SEC_SIZE == 0, "Journal must start on a sector boundary");
+
+// ============================================
+// State Variables
+// ============================================
+static uint32_t _head = 1;          // seq của bản ghi kế tiếp
+static bool _aheadReady = false;    // Sector sau sector đang ghi đã được xoá
+static uint32_t _replayFrom = 1;    // seq nhỏ nhất chưa được backend xác nhận
+static uint16_t _pending = 0;
+
+static bool _inFlight = false;
+static uint32_t _sentThrough = 0;   // seq cuối của lô đang gửi
+static uint8_t _sentCount = 0;
+static unsigned long _nextAttempt = 0;
+
+static uint32_t _appended = 0;
+static uint32_t _replayed = 0;
+static uint32_t _batches = 0;
+static uint32_t _failures = 0;
+static uint32_t _dropped = 0;
+static uint32_t _erases = 0;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static uint16_t crc16(const void* data, size_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)bytes[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static inline uint32_t slotAddress(uint32_t seq) {
+    return JOURNAL_FLASH_ADDR + (seq % JOURNAL_SLOTS) * sizeof(JournalRecord);
+}
+
+static inline uint8_t sectorIndex(uint32_t seq) {
+    return (seq % JOURNAL_SLOTS) / JOURNAL_PER_SECTOR;
+}
+
+static inline uint32_t sectorStart(uint32_t seq) {
+    return seq - seq % JOURNAL_PER_SECTOR;
+}
+
+static bool isBlank(const JournalRecord& record) {
+    const uint32_t* words = (const uint32_t*)&record;
+    for (uint8_t i = 0; i < sizeof(record) / 4; i++) {
+        if (words[i] != 0xFFFFFFFF) return false;
+    }
+    return true;
+}
+
+static bool isValid(const JournalRecord& record, uint32_t seq) {
+    return record.seq == seq && record.crc == crc16(&record, offsetof(JournalRecord, crc));
+}
+
+static bool readRecord(uint32_t seq, JournalRecord& record) {
+    return ESP.flashRead(slotAddress(seq), (uint32_t*)&record, sizeof(record)) && isValid(record, seq);
+}
+
+/**
+ * Xoá sector sẽ chứa các bản ghi từ seq base; sự kiện chưa gửi còn trong
+ * sector (vòng trước) bị tính là mất
+ */
+static void eraseSector(uint32_t base) {
+    if (base >= JOURNAL_SLOTS) {
+        uint32_t oldStart = base - JOURNAL_SLOTS;
+        uint32_t oldEnd = oldStart + JOURNAL_PER_SECTOR;
+        if (_replayFrom < oldEnd) {
+            uint16_t lost = 0;
+            JournalRecord record;
+            for (uint32_t seq = max(_replayFrom, oldStart); seq < oldEnd; seq++) {
+                if (readRecord(seq, record) && record.event != JOURNAL_ACK) lost++;
+            }
+            _dropped += lost;
+            _pending -= min(lost, _pending);
+            _replayFrom = oldEnd;
+            if (lost) Serial.printf("[JOURNAL] Overwrote %u unsent event(s)\n", lost);
+        }
+    }
+#if LOCKER_DUAL_CORE
+    uint32_t flashStart = micros();
+#endif
+    ESP.flashEraseSector(JOURNAL_FLASH_ADDR / SPI_FLASH_SEC_SIZE + sectorIndex(base));
+#if LOCKER_DUAL_CORE
+    dualCoreFlashDone(flashStart);
+#endif
+    _erases++;
+}
+
+/**
+ * Ghi bản ghi vào ô của _head (đã xoá sẵn) rồi tiến _head
+ */
+static bool writeRecord(uint8_t event, uint8_t boxIndex, uint32_t at, uint32_t uptimeMs) {
+    JournalRecord record;
+    record.seq = _head;
+    record.at = at;
+    record.uptimeMs = uptimeMs;
+    record.boxIndex = boxIndex;
+    record.event = event;
+    record.crc = crc16(&record, offsetof(JournalRecord, crc));
+#if LOCKER_DUAL_CORE
+    uint32_t flashStart = micros();
+#endif
+    bool written = ESP.flashWrite(slotAddress(_head), (uint32_t*)&record, sizeof(record));
+#if LOCKER_DUAL_CORE
+    dualCoreFlashDone(flashStart);
+#endif
+    if (!written) return false;
+
+    _head++;
+    if (_head % JOURNAL_PER_SECTOR == 0) {
+        // Sang sector mới: bình thường đã được xoá trước, chỉ xoá tại chỗ
+        // khi journalMaintain() chưa kịp chạy giữa JOURNAL_PER_SECTOR lần ghi
+        if (!_aheadReady) eraseSector(_head);
+        _aheadReady = false;
+    }
+    return true;
+}
+
+/**
+ * Từ _head tới hết sector đều là ô trống (không có bản ghi ghi dở)
+ */
+static bool restOfSectorBlank() {
+    JournalRecord record;
+    uint32_t end = sectorStart(_head) + JOURNAL_PER_SECTOR;
+    for (uint32_t seq = _head; seq < end; seq++) {
+        ESP.flashRead(slotAddress(seq), (uint32_t*)&record, sizeof(record));
+        if (!isBlank(record)) return false;
+    }
+    return true;
+}
+
+/**
+ * Một ký tự cho mỗi sự kiện trong lô
+ */
+static char eventCode(uint8_t event) {
+    switch (event) {
+        case JOURNAL_UNLOCK: return 'U';
+        case JOURNAL_LOCK: return 'L';
+        case JOURNAL_BUTTON: return 'B';
+        case JOURNAL_DOOR_OPEN: return 'O';
+        case JOURNAL_DOOR_CLOSE: return 'C';
+        default: return '?';
+    }
+}
+
+static void onReplayResponse(int httpCode, const char* body, size_t length, void* ctx) {
+    _inFlight = false;
+    if (httpCode != HTTP_CODE_OK) {
+        Serial.printf("[JOURNAL] Replay failed: %d\n", httpCode);
+        _failures++;
+        _nextAttempt = millis() + JOURNAL_RETRY_MS;
+        return;
+    }
+
+    Serial.printf("[JOURNAL] Replayed %u event(s) through seq %lu\n", _sentCount, (unsigned long)_sentThrough);
+    writeRecord(JOURNAL_ACK, 0, _sentThrough, millis());
+    if (_sentThrough + 1 > _replayFrom) _replayFrom = _sentThrough + 1;
+    _pending -= min((uint16_t)_sentCount, _pending);
+    _replayed += _sentCount;
+    _batches++;
+    _nextAttempt = millis();
+}
+
+/**
+ * Gửi lô sự kiện kế tiếp, mọi mảng mã hoá delta như telemetry:
+ * {"deviceId":"...","seq":[41,1,2],"at":[1792278285,3,0],"ms":[...],"box":[1,0,0],"event":"ULB"}
+ */
+static void sendBatch() {
+    HeapScope heapScope("journal:replay");
+
+    static StaticJsonDocument<JOURNAL_JSON_SIZE> doc;
+    static char events[JOURNAL_BATCH_SIZE + 1];
+    doc.clear();
+    doc["deviceId"] = DEVICE_ID;
+    JsonArray seqs = doc.createNestedArray("seq");
+    JsonArray ats = doc.createNestedArray("at");
+    JsonArray ms = doc.createNestedArray("ms");
+    JsonArray boxes = doc.createNestedArray("box");
+
+    JournalRecord record;
+    JournalRecord prev = {};
+    uint8_t n = 0;
+    uint32_t seq = _replayFrom;
+    // Giới hạn số ô đọc mỗi lượt (bản ghi ACK, ô hỏng xen giữa)
+    for (uint16_t scanned = 0; seq < _head && n < JOURNAL_BATCH_SIZE && scanned < 2 * JOURNAL_BATCH_SIZE; seq++, scanned++) {
+        if (!readRecord(seq, record) || record.event == JOURNAL_ACK) continue;
+        seqs.add((int32_t)(record.seq - prev.seq));
+        ats.add((int32_t)(record.at - prev.at));
+        ms.add((int32_t)(record.uptimeMs - prev.uptimeMs));
+        boxes.add((int)record.boxIndex - (int)prev.boxIndex + (n == 0 ? BOX_ID : 0));
+        events[n++] = eventCode(record.event);
+        prev = record;
+    }
+    events[n] = '\0';
+
+    // Chỉ có bản ghi ACK / hỏng: bỏ qua, không cần gọi backend
+    if (n == 0) {
+        _replayFrom = seq;
+        return;
+    }
+    doc["event"] = (const char*)events;
+
+    String jsonBody;
+    serializeJson(doc, jsonBody);
+    if (!asyncHttpPost("/api/iot/events", jsonBody, onReplayResponse, nullptr)) {
+        _failures++;
+        _nextAttempt = millis() + JOURNAL_RETRY_MS;
+        return;
+    }
+    Serial.printf("[JOURNAL] Sending %u event(s) (%u bytes)\n", n, (unsigned)jsonBody.length());
+    _inFlight = true;
+    _sentThrough = seq - 1;
+    _sentCount = n;
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initEventJournal() {
+    static JournalRecord chunk[16];
+    bool blank[JOURNAL_SECTORS];
+    uint32_t maxSeq = 0;
+    uint32_t acked = 0;
+
+    // Quét mọi ô: seq lớn nhất và ACK mới nhất
+    for (uint32_t slot = 0; slot < JOURNAL_SLOTS; slot += 16) {
+        uint8_t sector = slot / JOURNAL_PER_SECTOR;
+        if (slot % JOURNAL_PER_SECTOR == 0) blank[sector] = true;
+        ESP.flashRead(JOURNAL_FLASH_ADDR + slot * sizeof(JournalRecord), (uint32_t*)chunk, sizeof(chunk));
+        for (uint8_t i = 0; i < 16; i++) {
+            const JournalRecord& record = chunk[i];
+            if (isBlank(record)) continue;
+            blank[sector] = false;
+            if (record.seq % JOURNAL_SLOTS != slot + i || !isValid(record, record.seq)) continue;
+            if (record.seq > maxSeq) maxSeq = record.seq;
+            if (record.event == JOURNAL_ACK && record.at > acked) acked = record.at;
+        }
+    }
+
+    _head = maxSeq + 1;
+    _replayFrom = acked + 1;
+    // Ô kế tiếp có dữ liệu (mất điện khi đang ghi, hoặc vùng flash chưa từng
+    // dùng cho journal): bắt đầu ở sector mới
+    if (!restOfSectorBlank()) {
+        if (_head % JOURNAL_PER_SECTOR) _head = sectorStart(_head) + JOURNAL_PER_SECTOR;
+        eraseSector(_head);
+        blank[sectorIndex(_head)] = true;
+    }
+    _aheadReady = blank[sectorIndex(sectorStart(_head) + JOURNAL_PER_SECTOR)];
+
+    // Sự kiện chưa gửi còn trong flash
+    _pending = 0;
+    uint32_t oldest = _head > JOURNAL_SLOTS ? _head - JOURNAL_SLOTS : 1;
+    if (_replayFrom < oldest) _replayFrom = oldest;
+    JournalRecord record;
+    uint32_t first = _head;
+    for (uint32_t seq = _replayFrom; seq < _head; seq++) {
+        if (!readRecord(seq, record) || record.event == JOURNAL_ACK) continue;
+        if (_pending++ == 0) first = seq;
+    }
+    _replayFrom = first;
+
+    _inFlight = false;
+    _nextAttempt = millis();
+    Serial.printf("[JOURNAL] %u slots, next seq %lu, %u event(s) to replay\n",
+                  (unsigned)JOURNAL_SLOTS, (unsigned long)_head, _pending);
+}
+
+bool journalAppend(JournalEvent event, int boxId, uint32_t uptimeMs) {
+#if LOCKER_DUAL_CORE
+    // Flash và replay thuộc lõi mạng: sự kiện của lõi actuation đi qua hàng đợi
+    if (onActuationCore()) return actuatorPostJournal(event, boxId, uptimeMs);
+#endif
+    time_t now = time(nullptr);
+    // Lùi về thời điểm xảy ra (sự kiện có thể đã nằm trong hàng đợi một lúc)
+    now -= (millis() - uptimeMs) / 1000;
+    uint32_t at = now > NTP_VALID_AFTER ? (uint32_t)now : 0;
+    if (!writeRecord(event, (uint8_t)(boxId - BOX_ID), at, uptimeMs)) {
+        Serial.println("[JOURNAL] Flash write failed");
+        return false;
+    }
+    _appended++;
+    _pending++;
+    return true;
+}
+
+void journalMaintain() {
+    if (!_aheadReady) {
+        eraseSector(sectorStart(_head) + JOURNAL_PER_SECTOR);
+        _aheadReady = true;
+    }
+
+    if (_inFlight || _replayFrom >= _head) return;
+    if ((long)(millis() - _nextAttempt) < 0) return;
+    if (WiFi.status() != WL_CONNECTED) return;
+    if (asyncHttpPending() >= ASYNC_HTTP_SLOTS) return;
+
+    sendBatch();
+}
+
+void journalGetStats(JournalStats& stats) {
+    stats.headSeq = _head;
+    stats.pending = _pending;
+    stats.appended = _appended;
+    stats.replayed = _replayed;
+    stats.batches = _batches;
+    stats.failures = _failures;
+    stats.dropped = _dropped;
+    stats.erases = _erases;
+}
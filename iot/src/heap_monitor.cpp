@@ -0,0 +1,173 @@
+/**
+ * Heap Monitor Implementation
+ *
+ * Scope lồng nhau được giữ trong một stack nhỏ; cấp phát luôn tính cho
+ * scope trong cùng. Bảng site cố định HEAP_MAX_SITES, tra theo con trỏ
+ * chuỗi hằng nên không tốn heap để theo dõi heap.
+ */
+
+#include "heap_monitor.h"
+#include "config.h"
+#include "platform.h"
+#include "dual_core.h"
+
+// ============================================
+// Site Table & Scope Stack
+// ============================================
+struct ScopeFrame {
+    HeapSiteStats* entry;
+    uint32_t freeAtEnter;
+};
+
+static HeapSiteStats _sites[HEAP_MAX_SITES];
+static uint8_t _siteCount = 0;
+
+static ScopeFrame _stack[HEAP_SCOPE_DEPTH];
+static uint8_t _depth = 0;
+
+// Site đang nhận cấp phát (đọc trong wrapper malloc)
+static HeapSiteStats* volatile _current = nullptr;
+static volatile uint32_t _totalAllocs = 0;
+static uint32_t _lowWater = 0;
+
+// ============================================
+// malloc Wrappers (HEAP_TRACK_ALLOCATIONS)
+// ============================================
+#ifdef HEAP_TRACK_ALLOCATIONS
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+// Có thể được gọi từ ngắt nên phải nằm trong IRAM và chỉ tăng bộ đếm
+static inline void IRAM_ATTR countAlloc(size_t size) {
+    _totalAllocs++;
+    HeapSiteStats* site = _current;
+    if (site) {
+        site->allocs++;
+        site->allocBytes += size;
+    }
+}
+
+void* IRAM_ATTR __wrap_malloc(size_t size) {
+    countAlloc(size);
+    return __real_malloc(size);
+}
+
+void* IRAM_ATTR __wrap_calloc(size_t count, size_t size) {
+    countAlloc(count * size);
+    return __real_calloc(count, size);
+}
+
+void* IRAM_ATTR __wrap_realloc(void* ptr, size_t size) {
+    countAlloc(size);
+    return __real_realloc(ptr, size);
+}
+}
+#endif
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static HeapSiteStats* findSite(const char* site) {
+    for (uint8_t i = 0; i < _siteCount; i++) {
+        if (_sites[i].site == site || strcmp(_sites[i].site, site) == 0) return &_sites[i];
+    }
+    if (_siteCount >= HEAP_MAX_SITES) return nullptr;
+
+    HeapSiteStats& entry = _sites[_siteCount++];
+    memset(&entry, 0, sizeof(entry));
+    entry.site = site;
+    entry.minFreeHeap = UINT32_MAX;
+    return &entry;
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initHeapMonitor() {
+    _siteCount = 0;
+    _depth = 0;
+    _current = nullptr;
+    _lowWater = ESP.getFreeHeap();
+#ifdef HEAP_TRACK_ALLOCATIONS
+    Serial.printf("[HEAP] Monitor ready, free %u bytes (allocation tracking on)\n", (unsigned)_lowWater);
+#else
+    Serial.printf("[HEAP] Monitor ready, free %u bytes\n", (unsigned)_lowWater);
+#endif
+}
+
+void heapScopeEnter(const char* site) {
+#if LOCKER_DUAL_CORE
+    // Chồng scope thuộc lõi mạng; lõi actuation chỉ được tính vào tổng
+    if (onActuationCore()) return;
+#endif
+    if (_depth >= HEAP_SCOPE_DEPTH) {
+        _depth++;   // Vẫn đếm để heapScopeExit() cân bằng
+        return;
+    }
+    ScopeFrame& frame = _stack[_depth++];
+    frame.entry = findSite(site);
+    frame.freeAtEnter = ESP.getFreeHeap();
+    if (frame.entry) frame.entry->calls++;
+    _current = frame.entry;
+}
+
+void heapScopeExit() {
+#if LOCKER_DUAL_CORE
+    if (onActuationCore()) return;
+#endif
+    if (_depth == 0) return;
+    _depth--;
+    if (_depth >= HEAP_SCOPE_DEPTH) return;
+
+    uint32_t freeHeap = ESP.getFreeHeap();
+    ScopeFrame& frame = _stack[_depth];
+    if (frame.entry) {
+        frame.entry->retained += (int32_t)(frame.freeAtEnter - freeHeap);
+        if (freeHeap < frame.entry->minFreeHeap) frame.entry->minFreeHeap = freeHeap;
+    }
+    if (freeHeap < _lowWater) _lowWater = freeHeap;
+
+    _current = _depth > 0 ? _stack[_depth - 1].entry : nullptr;
+}
+
+void heapSample() {
+    uint32_t freeHeap = ESP.getFreeHeap();
+    if (freeHeap < _lowWater) _lowWater = freeHeap;
+}
+
+void heapGetStats(HeapStats& stats) {
+    uint32_t freeHeap;
+    uint32_t maxBlock;
+    uint8_t frag;
+    platformHeapStats(&freeHeap, &maxBlock, &frag);
+    if (freeHeap < _lowWater) _lowWater = freeHeap;
+
+    stats.freeHeap = freeHeap;
+    stats.maxFreeBlock = maxBlock;
+    stats.fragmentation = frag;
+    stats.lowWater = _lowWater;
+    stats.totalAllocs = _totalAllocs;
+}
+
+uint8_t heapTopSites(HeapSiteStats* sites, uint8_t maxSites) {
+    // Chọn lần lượt site có allocBytes lớn nhất (bảng nhỏ, không cần sort)
+    bool taken[HEAP_MAX_SITES] = {};
+    uint8_t count = 0;
+    while (count < maxSites && count < _siteCount) {
+        int8_t best = -1;
+        for (uint8_t i = 0; i < _siteCount; i++) {
+            if (taken[i]) continue;
+            if (best < 0 || _sites[i].allocBytes > _sites[best].allocBytes ||
+                (_sites[i].allocBytes == _sites[best].allocBytes && _sites[i].retained > _sites[best].retained)) {
+                best = i;
+            }
+        }
+        taken[best] = true;
+        sites[count++] = _sites[best];
+    }
+    return count;
+}
@@ -0,0 +1,181 @@
+/**
+ * Input Events Implementation
+ *
+ * ISR chỉ ghi một bản ghi cố định vào ring buffer (một producer là ISR,
+ * một consumer là loop) nên không cần khóa. Debounce kiểu leading-edge:
+ * cạnh đầu tiên được nhận ngay, các cạnh trong debounceMs sau đó bị bỏ.
+ * Nếu cạnh nhả bị bỏ trong cửa sổ dội, inputEventsPoll() đọc lại mức
+ * thực tế khi cửa sổ kết thúc để không bị kẹt trạng thái.
+ */
+
+#include "input_events.h"
+#include "config.h"
+#include "dual_core.h"
+
+// ============================================
+// Input Table & ISR Ring Buffer
+// ============================================
+struct InputEntry {
+    uint8_t pin;
+    uint8_t stableLevel;
+    uint32_t debounceUs;
+    uint32_t lastChangeUs;  // Thời điểm đổi mức ổn định gần nhất
+    uint32_t lastEdgeUs;    // Thời điểm cạnh thô gần nhất (kể cả cạnh dội)
+    InputHandler handler;
+    const char* name;
+};
+
+struct RawEdge {
+    uint8_t input;
+    uint8_t level;
+    uint32_t timestampUs;
+};
+
+static InputEntry _inputs[MAX_INPUTS];
+static uint8_t _inputCount = 0;
+
+static RawEdge _queue[INPUT_QUEUE_SIZE];
+static volatile uint16_t _head = 0;     // Chỉ ISR ghi
+static volatile uint16_t _tail = 0;     // Chỉ loop() ghi
+static volatile uint32_t _edges = 0;
+static volatile uint32_t _dropped = 0;
+
+// Chặn compiler đảo thứ tự đọc/ghi bản ghi với cập nhật chỉ số head/tail
+#define COMPILER_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+// /status đọc từ lõi mạng trên bản build hai lõi
+static CoreShared<uint32_t> _accepted{0};
+static CoreShared<uint32_t> _bounced{0};
+static CoreShared<uint32_t> _maxLatencyUs{0};
+
+// ============================================
+// ISR
+// ============================================
+
+static void IRAM_ATTR inputIsr(void* arg) {
+    uint8_t input = (uint8_t)(uintptr_t)arg;
+    uint32_t now = micros();
+
+    _edges++;
+    uint16_t head = _head;
+    uint16_t next = (head + 1) & (INPUT_QUEUE_SIZE - 1);
+    if (next == _tail) {
+        _dropped++;
+        return;
+    }
+
+    _queue[head].input = input;
+    _queue[head].level = (uint8_t)digitalRead(_inputs[input].pin);
+    _queue[head].timestampUs = now;
+    COMPILER_BARRIER();
+    _head = next;
+}
+
+// ============================================
+// Helper Functions
+// ============================================
+
+/**
+ * Ghi nhận mức ổn định mới và gọi handler
+ * @param fromIsr true nếu từ cạnh trong hàng đợi (tính độ trễ), false nếu đồng bộ lại
+ */
+static void acceptLevel(int8_t input, uint8_t level, uint32_t timestampUs, bool fromIsr) {
+    InputEntry& entry = _inputs[input];
+    entry.stableLevel = level;
+    entry.lastChangeUs = timestampUs;
+    _accepted++;
+
+    if (fromIsr) {
+        uint32_t latency = micros() - timestampUs;
+        if (latency > _maxLatencyUs) _maxLatencyUs = latency;
+    }
+
+    if (entry.handler) {
+        entry.handler(input, level, timestampUs);
+    }
+}
+
+static void processEdge(const RawEdge& edge) {
+    if (edge.input >= _inputCount) return;
+    InputEntry& entry = _inputs[edge.input];
+    entry.lastEdgeUs = edge.timestampUs;
+
+    if (edge.level == entry.stableLevel ||
+        edge.timestampUs - entry.lastChangeUs < entry.debounceUs) {
+        _bounced++;
+        return;
+    }
+    acceptLevel(edge.input, edge.level, edge.timestampUs, true);
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initInputEvents() {
+    _inputCount = 0;
+    _head = 0;
+    _tail = 0;
+    Serial.printf("[INPUT] Event queue ready (%d entries)\n", INPUT_QUEUE_SIZE);
+}
+
+int8_t inputRegister(uint8_t pin, uint8_t mode, uint32_t debounceMs, InputHandler handler, const char* name) {
+    if (_inputCount >= MAX_INPUTS) {
+        Serial.printf("[INPUT] No free slot for %s\n", name);
+        return -1;
+    }
+
+    int8_t input = _inputCount;
+    InputEntry& entry = _inputs[input];
+    pinMode(pin, mode);
+    entry.pin = pin;
+    entry.stableLevel = (uint8_t)digitalRead(pin);
+    entry.debounceUs = debounceMs * 1000UL;
+    entry.lastChangeUs = micros() - entry.debounceUs;
+    entry.lastEdgeUs = entry.lastChangeUs;
+    entry.handler = handler;
+    entry.name = name;
+    _inputCount++;
+
+    attachInterruptArg(digitalPinToInterrupt(pin), inputIsr, (void*)(uintptr_t)input, CHANGE);
+    Serial.printf("[INPUT] %s on GPIO%d (debounce %lu ms)\n", name, pin, (unsigned long)debounceMs);
+    return input;
+}
+
+uint8_t inputLevel(int8_t input) {
+    return (input >= 0 && input < _inputCount) ? _inputs[input].stableLevel : LOW;
+}
+
+void inputEventsPoll() {
+    while (_tail != _head) {
+        COMPILER_BARRIER();
+        RawEdge edge = _queue[_tail];
+        COMPILER_BARRIER();
+        _tail = (_tail + 1) & (INPUT_QUEUE_SIZE - 1);
+        processEdge(edge);
+    }
+
+    // Hết cửa sổ dội: đồng bộ lại với mức thực tế (cạnh bị bỏ hoặc bị mất).
+    // Lấy thời điểm cạnh thô cuối cùng làm mốc để không kéo dài cửa sổ dội.
+    uint32_t now = micros();
+    for (int8_t i = 0; i < _inputCount; i++) {
+        InputEntry& entry = _inputs[i];
+        if (now - entry.lastChangeUs < entry.debounceUs) continue;
+        uint8_t level = (uint8_t)digitalRead(entry.pin);
+        if (level != entry.stableLevel) {
+            acceptLevel(i, level, entry.lastEdgeUs, false);
+        }
+    }
+}
+
+bool inputEventsPending() {
+    return _tail != _head;
+}
+
+void inputGetStats(InputStats& stats) {
+    stats.edges = _edges;
+    stats.accepted = _accepted;
+    stats.bounced = _bounced;
+    stats.dropped = _dropped;
+    stats.maxLatencyUs = _maxLatencyUs;
+}
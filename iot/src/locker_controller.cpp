@@ -1,35 +1,181 @@
 /**
  * Locker Controller Implementation
- * 
+ *
  * Điều khiển khóa solenoid qua relay và giao tiếp với backend
+ *
+ * Mỗi box có một entry trong bảng _boxes (chỉ số = boxId - BOX_ID). Hạn
+ * tự khóa của các box đang mở nằm trong một min-heap chung; scheduler chỉ
+ * giữ một task một lần cho deadline sớm nhất thay vì một task mỗi box.
+ *
+ * Bảng và heap chỉ do lõi actuation đọc/ghi. isUnlocked()/autoLockRemaining()
+ * đọc _autoLockAt: mỗi box một từ gộp cả trạng thái mở và hạn tự khóa, nên
+ * lõi mạng (dual_core.h) không bao giờ thấy cặp giá trị lệch nhau.
  */
 
 #include "locker_controller.h"
 #include "config.h"
-#include <ESP8266WiFi.h>
-#include <ESP8266HTTPClient.h>
-#include <WiFiClient.h>
-#include <ArduinoJson.h>
+#include "scheduler.h"
+#include "status_outbox.h"
+#include "loop_metrics.h"
+#include "relay_driver.h"
+#include "event_journal.h"
+#include "door_sensor.h"
+#include "dual_core.h"
 
 // ============================================
-// State Variables
+// Box Table
 // ============================================
-static bool _isUnlocked = false;
-static unsigned long _unlockStartTime = 0;
+struct BoxEntry {
+    bool unlocked;
+    uint32_t lockDeadline;  // millis() khi tự khóa (hợp lệ khi heapPos >= 0)
+    int8_t heapPos;         // Vị trí trong deadline heap, -1 nếu không có
+};
+
+static BoxEntry _boxes[BOX_COUNT];
+static CoreShared<uint8_t> _unlockedCount{0};
+static CoreShared<uint32_t> _lastRelayWriteUs{0};
+
+// Công bố sau mỗi lần mở/khóa: 0 = đang khóa, khác 0 = đang mở và tự khóa
+// lúc millis() bằng giá trị này (bit 0 luôn bật, lệch tối đa 1 ms)
+static CoreShared<uint32_t> _autoLockAt[BOX_COUNT];
+
+// Min-heap chỉ số box theo lockDeadline
+static uint8_t _heap[BOX_COUNT];
+static uint8_t _heapSize = 0;
+static_assert(BOX_COUNT <= 127, "Deadline heap positions are int8_t");
+
+static SchedulerTaskId _autoLockTask = SCHEDULER_INVALID_TASK;
+static uint32_t _armedDeadline = 0;
 
 // ============================================
-// Helper Functions
+// Deadline Heap
 // ============================================
 
 /**
- * Điều khiển relay theo logic (active LOW/HIGH)
+ * So sánh deadline an toàn khi millis() tràn
  */
-void setRelay(bool on) {
-    if (RELAY_ACTIVE_LOW) {
-        digitalWrite(RELAY_PIN, on ? LOW : HIGH);
+static bool deadlineBefore(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static void heapSwap(uint8_t i, uint8_t j) {
+    uint8_t a = _heap[i];
+    uint8_t b = _heap[j];
+    _heap[i] = b;
+    _heap[j] = a;
+    _boxes[b].heapPos = i;
+    _boxes[a].heapPos = j;
+}
+
+static void heapSiftUp(uint8_t pos) {
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!deadlineBefore(_boxes[_heap[pos]].lockDeadline, _boxes[_heap[parent]].lockDeadline)) break;
+        heapSwap(pos, parent);
+        pos = parent;
+    }
+}
+
+static void heapSiftDown(uint8_t pos) {
+    while (true) {
+        uint8_t smallest = pos;
+        uint8_t left = pos * 2 + 1;
+        uint8_t right = left + 1;
+        if (left < _heapSize && deadlineBefore(_boxes[_heap[left]].lockDeadline, _boxes[_heap[smallest]].lockDeadline)) {
+            smallest = left;
+        }
+        if (right < _heapSize && deadlineBefore(_boxes[_heap[right]].lockDeadline, _boxes[_heap[smallest]].lockDeadline)) {
+            smallest = right;
+        }
+        if (smallest == pos) break;
+        heapSwap(pos, smallest);
+        pos = smallest;
+    }
+}
+
+/**
+ * Thêm hoặc cập nhật deadline của box (mở lại khi đang mở sẽ gia hạn)
+ */
+static void heapSet(uint8_t index, uint32_t deadline) {
+    BoxEntry& box = _boxes[index];
+    box.lockDeadline = deadline;
+    if (box.heapPos < 0) {
+        box.heapPos = _heapSize;
+        _heap[_heapSize++] = index;
+        heapSiftUp(box.heapPos);
     } else {
-        digitalWrite(RELAY_PIN, on ? HIGH : LOW);
+        // Gia hạn chỉ làm deadline muộn hơn
+        heapSiftDown(box.heapPos);
+    }
+}
+
+static void heapRemove(uint8_t index) {
+    int8_t pos = _boxes[index].heapPos;
+    if (pos < 0) return;
+    _boxes[index].heapPos = -1;
+    _heapSize--;
+    if (pos == _heapSize) return;
+
+    _heap[pos] = _heap[_heapSize];
+    _boxes[_heap[pos]].heapPos = pos;
+    heapSiftUp(pos);
+    heapSiftDown(_boxes[_heap[pos]].heapPos);
+}
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static void autoLockTask(void* arg);
+
+/**
+ * Hẹn task scheduler cho deadline sớm nhất (chỉ đặt lại khi đỉnh heap đổi)
+ */
+static void armAutoLock() {
+    if (_heapSize == 0) {
+        schedulerCancel(_autoLockTask);
+        _autoLockTask = SCHEDULER_INVALID_TASK;
+        return;
     }
+
+    uint32_t deadline = _boxes[_heap[0]].lockDeadline;
+    if (_autoLockTask != SCHEDULER_INVALID_TASK && deadline == _armedDeadline) return;
+
+    schedulerCancel(_autoLockTask);
+    int32_t delayMs = (int32_t)(deadline - millis());
+    _autoLockTask = schedulerAfter(delayMs > 0 ? delayMs : 0, autoLockTask, "auto-lock");
+    _armedDeadline = deadline;
+}
+
+/**
+ * Task một lần của scheduler: khóa mọi box đã tới hạn rồi hẹn deadline kế tiếp
+ */
+static void autoLockTask(void* arg) {
+    uint32_t start = micros();
+    _autoLockTask = SCHEDULER_INVALID_TASK;
+
+    uint32_t now = millis();
+    while (_heapSize > 0 && !deadlineBefore(now, _boxes[_heap[0]].lockDeadline)) {
+        int boxId = BOX_ID + _heap[0];
+        lockBox(boxId);
+        Serial.printf("[LOCKER] Box %d auto-locked after timeout\n", boxId);
+    }
+    armAutoLock();
+    metricsRecord(STAGE_AUTO_LOCK, micros() - start);
+}
+
+static void publishBox(uint8_t index) {
+    const BoxEntry& box = _boxes[index];
+    _autoLockAt[index] = box.unlocked && box.heapPos >= 0 ? box.lockDeadline | 1 : 0;
+}
+
+/**
+ * LED trạng thái sáng khi còn ít nhất một box đang mở
+ */
+static void updateStatusLed() {
+    // LED built-in của ESP8266 active LOW, của ESP32 DevKit active HIGH
+    bool on = _unlockedCount > 0;
+    digitalWrite(LED_STATUS, on == LED_ACTIVE_LOW ? LOW : HIGH);
 }
 
 // ============================================
@@ -37,54 +183,116 @@ void setRelay(bool on) {
 // ============================================
 
 void initLockerController() {
-    // Cấu hình GPIO
-    pinMode(RELAY_PIN, OUTPUT);
     pinMode(LED_STATUS, OUTPUT);
-    
-    // Đảm bảo relay ở trạng thái OFF ban đầu (khóa đóng)
-    setRelay(false);
-    // ESP8266 built-in LED is active LOW
-    digitalWrite(LED_STATUS, HIGH);
-    
-    _isUnlocked = false;
+
+    // Đảm bảo mọi relay ở trạng thái OFF ban đầu (khóa đóng)
+    initRelayDriver();
+
+    for (uint8_t i = 0; i < BOX_COUNT; i++) {
+        _boxes[i].unlocked = false;
+        _boxes[i].lockDeadline = 0;
+        _boxes[i].heapPos = -1;
+        _autoLockAt[i] = 0;
+    }
+    _heapSize = 0;
+    _unlockedCount = 0;
+    updateStatusLed();
+
     Serial.println("[LOCKER] Controller initialized");
-    Serial.printf("[LOCKER] Relay pin: GPIO%d\n", RELAY_PIN);
+    Serial.printf("[LOCKER] Boxes %d..%d\n", BOX_ID, BOX_ID + BOX_COUNT - 1);
 }
 
-void unlockBox() {
-    Serial.println("[LOCKER] Unlocking box...");
-    
+uint8_t boxCount() {
+    return BOX_COUNT;
+}
+
+int boxIdAt(uint8_t index) {
+    return BOX_ID + index;
+}
+
+bool isValidBox(int boxId) {
+    return boxId >= BOX_ID && boxId < BOX_ID + BOX_COUNT;
+}
+
+bool unlockBox(int boxId) {
+    if (!isValidBox(boxId)) return false;
+#if LOCKER_DUAL_CORE
+    // Relay thuộc lõi actuation: lời gọi từ lõi mạng (HTTP, verify) đi qua hàng đợi
+    if (!onActuationCore()) return actuatorSubmit(ACTUATOR_UNLOCK, boxId);
+#endif
+    uint8_t index = boxId - BOX_ID;
+    BoxEntry& box = _boxes[index];
+
+    Serial.printf("[LOCKER] Unlocking box %d...\n", boxId);
+
     // Kích hoạt relay để mở solenoid
-    setRelay(true);
-    // ESP8266 built-in LED is active LOW
-    digitalWrite(LED_STATUS, LOW);
-    
-    _isUnlocked = true;
-    _unlockStartTime = millis();
-    
-    Serial.printf("[LOCKER] Box unlocked! Will auto-lock after %d ms\n", UNLOCK_DURATION);
-}
-
-void lockBox() {
-    Serial.println("[LOCKER] Locking box...");
-    
+    relayWrite(index, true);
+    _lastRelayWriteUs = micros();
+    // Ghi nhật ký sau khi relay đã bật (một lần ghi flash, không gọi mạng)
+    journalAppend(JOURNAL_UNLOCK, boxId);
+    if (!box.unlocked) {
+        box.unlocked = true;
+        _unlockedCount++;
+    }
+    updateStatusLed();
+
+    // Hẹn giờ tự khóa (mở lại khi đang mở sẽ gia hạn thời gian)
+    heapSet(index, millis() + UNLOCK_DURATION);
+    armAutoLock();
+    publishBox(index);
+
+    Serial.printf("[LOCKER] Box %d unlocked! Will auto-lock after %d ms\n", boxId, UNLOCK_DURATION);
+    return true;
+}
+
+bool lockBox(int boxId) {
+    if (!isValidBox(boxId)) return false;
+#if LOCKER_DUAL_CORE
+    if (!onActuationCore()) return actuatorSubmit(ACTUATOR_LOCK, boxId);
+#endif
+    uint8_t index = boxId - BOX_ID;
+    BoxEntry& box = _boxes[index];
+
+    Serial.printf("[LOCKER] Locking box %d...\n", boxId);
+
     // Tắt relay để đóng solenoid
-    setRelay(false);
-    // ESP8266 built-in LED is active LOW
-    digitalWrite(LED_STATUS, HIGH);
-    
-    _isUnlocked = false;
-    
-    Serial.println("[LOCKER] Box locked!");
-}
-
-bool isUnlocked() {
-    // Tự động khóa sau UNLOCK_DURATION
-    if (_isUnlocked && (millis() - _unlockStartTime >= UNLOCK_DURATION)) {
-        lockBox();
-        Serial.println("[LOCKER] Auto-locked after timeout");
+    relayWrite(index, false);
+    _lastRelayWriteUs = micros();
+    journalAppend(JOURNAL_LOCK, boxId);
+    if (box.unlocked) {
+        box.unlocked = false;
+        _unlockedCount--;
     }
-    return _isUnlocked;
+    updateStatusLed();
+
+    heapRemove(index);
+    armAutoLock();
+    publishBox(index);
+
+    Serial.printf("[LOCKER] Box %d locked!\n", boxId);
+    return true;
+}
+
+bool isUnlocked(int boxId) {
+    // Auto-lock do scheduler đảm nhiệm (xem autoLockTask)
+    if (!isValidBox(boxId)) return false;
+    return _autoLockAt[boxId - BOX_ID] != 0;
+}
+
+uint32_t autoLockRemaining(int boxId) {
+    if (!isValidBox(boxId)) return 0;
+    uint32_t deadline = _autoLockAt[boxId - BOX_ID];
+    if (deadline == 0) return 0;
+    int32_t remaining = (int32_t)(deadline - millis());
+    return remaining > 0 ? remaining : 0;
+}
+
+uint8_t unlockedCount() {
+    return _unlockedCount;
+}
+
+uint32_t lastRelayWriteUs() {
+    return _lastRelayWriteUs;
 }
 
 const char* getStatusString(BoxStatus status) {
@@ -97,49 +305,25 @@ const char* getStatusString(BoxStatus status) {
     }
 }
 
-bool reportBoxStatus(BoxStatus status, bool isDoorOpen) {
-    // Kiểm tra kết nối WiFi
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("[LOCKER] WiFi not connected, cannot report status");
-        return false;
-    }
-    
-    WiFiClient client;
-    HTTPClient http;
-    String url = String(BACKEND_URL) + "/api/iot/box-status";
-    
-    Serial.printf("[LOCKER] Reporting status to: %s\n", url.c_str());
-    
-    http.begin(client, url);
-    http.addHeader("Content-Type", "application/json");
-    http.setTimeout(HTTP_TIMEOUT);
-    
-    // Tạo JSON body
-    StaticJsonDocument<512> doc;
-    doc["boxId"] = BOX_ID;
-    doc["status"] = getStatusString(status);
-    doc["deviceId"] = DEVICE_ID;
-    doc["isDoorOpen"] = isDoorOpen;
-    
-    String jsonBody;
-    serializeJson(doc, jsonBody);
-    
-    Serial.printf("[LOCKER] Request body: %s\n", jsonBody.c_str());
-    
-    int httpCode = http.POST(jsonBody);
-    bool success = false;
-    
-    if (httpCode > 0) {
-        Serial.printf("[LOCKER] HTTP Response: %d\n", httpCode);
-        if (httpCode == HTTP_CODE_OK) {
-            String response = http.getString();
-            Serial.printf("[LOCKER] Response: %s\n", response.c_str());
-            success = true;
-        }
-    } else {
-        Serial.printf("[LOCKER] HTTP Error: %s\n", http.errorToString(httpCode).c_str());
-    }
-    
-    http.end();
-    return success;
+bool reportBoxStatus(int boxId, BoxStatus status, bool isDoorOpen) {
+    // Box có cảm biến cửa: dùng trạng thái thật thay cho giá trị đoán theo relay
+    if (doorHasSensor(boxId)) isDoorOpen = doorIsOpen(boxId);
+
+#if LOCKER_DUAL_CORE
+    // Outbox thuộc lõi mạng: báo cáo từ lõi actuation (nút nhấn, cửa) đi qua
+    // hàng đợi, kèm trạng thái cửa lúc xảy ra
+    if (onActuationCore()) return actuatorPostStatus(boxId, status, isDoorOpen);
+#endif
+    return queueBoxStatus(boxId, status, isDoorOpen);
+}
+
+bool queueBoxStatus(int boxId, BoxStatus status, bool isDoorOpen) {
+    uint32_t start = micros();
+
+    // Chỉ ghi vào outbox, việc gửi HTTP do statusOutboxLoop() đảm nhiệm
+    Serial.printf("[LOCKER] Queue box %d status %s (door %s)\n", boxId, getStatusString(status), isDoorOpen ? "open" : "closed");
+    bool queued = outboxEnqueue(boxId, status, isDoorOpen);
+
+    metricsRecord(STAGE_STATUS_REPORT, micros() - start);
+    return queued;
 }
@@ -0,0 +1,174 @@
+/**
+ * Loop Metrics Implementation
+ *
+ * Bucket i chứa các lần chạy <= 2^(METRICS_FIRST_BUCKET_LOG2 + i) µs,
+ * bucket cuối là +Inf. Chỉ số bucket tính bằng một lệnh đếm bit
+ * (__builtin_clz) nên ghi nhận rất rẻ, có thể gọi mỗi vòng loop().
+ */
+
+#include "loop_metrics.h"
+#include "config.h"
+
+// ============================================
+// Histogram Storage
+// ============================================
+struct StageHistogram {
+    uint32_t buckets[METRICS_BUCKETS];
+    uint32_t count;
+    uint32_t maxUs;
+    uint64_t sumUs;
+};
+
+static StageHistogram _stages[STAGE_COUNT];
+
+static const char* const STAGE_NAMES[STAGE_COUNT] = {
+    "loop",
+    "http_server",
+    "async_http",
+    "mqtt",
+    "button",
+    "auto_lock",
+    "wifi_check",
+    "status_report",
+    "outbox",
+    "stream"
+};
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static uint8_t bucketIndex(uint32_t us) {
+    if (us <= (1UL << METRICS_FIRST_BUCKET_LOG2)) return 0;
+    uint8_t bits = 32 - __builtin_clz(us - 1);
+    uint8_t index = bits - METRICS_FIRST_BUCKET_LOG2;
+    return index < METRICS_BUCKETS ? index : METRICS_BUCKETS - 1;
+}
+
+/**
+ * Cận trên của bucket (µs), bucket cuối trả về 0 (+Inf)
+ */
+static uint32_t bucketBoundUs(uint8_t index) {
+    if (index >= METRICS_BUCKETS - 1) return 0;
+    return 1UL << (METRICS_FIRST_BUCKET_LOG2 + index);
+}
+
+/**
+ * Giá trị µs dạng giây cho Prometheus, ví dụ 1500 -> "0.001500"
+ */
+static int formatSeconds(char* out, size_t size, uint64_t us) {
+    return snprintf(out, size, "%lu.%06lu", (unsigned long)(us / 1000000), (unsigned long)(us % 1000000));
+}
+
+/**
+ * snprintf nối tiếp vào buffer; trả về false nếu hết chỗ
+ */
+static bool append(char* buffer, size_t size, size_t& len, const char* fmt, ...) {
+    if (len >= size) return false;
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buffer + len, size - len, fmt, args);
+    va_end(args);
+    if (n < 0 || (size_t)n >= size - len) {
+        len = size;
+        return false;
+    }
+    len += n;
+    return true;
+}
+
+static size_t formatHistogram(LoopStage stage, char* buffer, size_t size) {
+    const StageHistogram& h = _stages[stage];
+    const char* name = STAGE_NAMES[stage];
+    char seconds[24];
+    size_t len = 0;
+
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < METRICS_BUCKETS; i++) {
+        cumulative += h.buckets[i];
+        uint32_t bound = bucketBoundUs(i);
+        if (bound) {
+            formatSeconds(seconds, sizeof(seconds), bound);
+        } else {
+            strcpy(seconds, "+Inf");
+        }
+        append(buffer, size, len, "locker_loop_stage_seconds_bucket{stage=\"%s\",le=\"%s\"} %lu\n",
+               name, seconds, (unsigned long)cumulative);
+    }
+    formatSeconds(seconds, sizeof(seconds), h.sumUs);
+    append(buffer, size, len, "locker_loop_stage_seconds_sum{stage=\"%s\"} %s\n", name, seconds);
+    append(buffer, size, len, "locker_loop_stage_seconds_count{stage=\"%s\"} %lu\n", name, (unsigned long)h.count);
+    return len < size ? len : 0;
+}
+
+/**
+ * Một gauge cho tất cả stage (max hoặc p99)
+ */
+static size_t formatGauge(bool p99, char* buffer, size_t size) {
+    const char* metric = p99 ? "locker_loop_stage_p99_seconds" : "locker_loop_stage_max_seconds";
+    char seconds[24];
+    size_t len = 0;
+
+    append(buffer, size, len, "# HELP %s %s\n# TYPE %s gauge\n", metric,
+           p99 ? "Upper bound of the histogram bucket holding p99" : "Longest single run of the stage",
+           metric);
+    for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+        StageSummary summary;
+        metricsGetSummary((LoopStage)i, summary);
+        formatSeconds(seconds, sizeof(seconds), p99 ? summary.p99Us : summary.maxUs);
+        append(buffer, size, len, "%s{stage=\"%s\"} %s\n", metric, STAGE_NAMES[i], seconds);
+    }
+    return len < size ? len : 0;
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void metricsRecord(LoopStage stage, uint32_t durationUs) {
+    StageHistogram& h = _stages[stage];
+    h.buckets[bucketIndex(durationUs)]++;
+    h.count++;
+    h.sumUs += durationUs;
+    if (durationUs > h.maxUs) h.maxUs = durationUs;
+}
+
+void metricsGetSummary(LoopStage stage, StageSummary& summary) {
+    const StageHistogram& h = _stages[stage];
+    summary.count = h.count;
+    summary.maxUs = h.maxUs;
+    summary.sumUs = h.sumUs;
+    summary.p99Us = 0;
+    if (h.count == 0) return;
+
+    // Bucket đầu tiên mà tổng tích lũy đạt 99% số lần chạy
+    uint32_t target = h.count - h.count / 100;
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < METRICS_BUCKETS; i++) {
+        cumulative += h.buckets[i];
+        if (cumulative >= target) {
+            uint32_t bound = bucketBoundUs(i);
+            // Không vượt quá max thực tế (bucket +Inf hoặc bucket thưa)
+            summary.p99Us = (bound == 0 || bound > h.maxUs) ? h.maxUs : bound;
+            return;
+        }
+    }
+}
+
+size_t metricsFormatPart(uint8_t part, char* buffer, size_t size) {
+    if (part == 0) {
+        size_t len = 0;
+        append(buffer, size, len,
+               "# HELP locker_loop_stage_seconds Time spent in each loop() stage\n"
+               "# TYPE locker_loop_stage_seconds histogram\n");
+        return len < size ? len : 0;
+    }
+    if (part <= STAGE_COUNT) return formatHistogram((LoopStage)(part - 1), buffer, size);
+    if (part == STAGE_COUNT + 1) return formatGauge(false, buffer, size);
+    if (part == STAGE_COUNT + 2) return formatGauge(true, buffer, size);
+    return 0;
+}
+
+const char* metricsStageName(LoopStage stage) {
+    return stage < STAGE_COUNT ? STAGE_NAMES[stage] : "unknown";
+}
@@ -19,84 +19,103 @@
  */
 
 #include <Arduino.h>
-#include <ESP8266WiFi.h>
-#include <ESP8266WebServer.h>
-#include <ESP8266HTTPClient.h>
+#include "platform.h"
 #include <PubSubClient.h>
 #include <WiFiClient.h>
 #include <ArduinoJson.h>
 #include "config.h"
 #include "locker_controller.h"
+#include "async_http.h"
+#include "backend_pool.h"
+#include "backend_proxy.h"
+#include "verify_pipeline.h"
+#include "scheduler.h"
+#include "input_events.h"
+#include "door_sensor.h"
+#include "status_outbox.h"
+#include "event_journal.h"
+#include "loop_metrics.h"
+#include "heap_monitor.h"
+#include "stall_watchdog.h"
+#include "progmem_stream.h"
+#include "pin_cache.h"
+#include "pin_guard.h"
+#include "command_dedup.h"
+#include "mqtt_commands.h"
+#include "telemetry.h"
+#include "wifi_manager.h"
+#include "dual_core.h"
+#if LOCKER_DUAL_CORE
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
 #include "web_ui.h"
+#include "web_ui_gz.h"
 
 // ============================================
 // Global Variables
 // ============================================
-ESP8266WebServer server(SERVER_PORT);
+
+/**
+ * ESP8266WebServer có thêm hàm kiểm tra kết nối mới đang chờ,
+ * dùng để đánh thức loop() khỏi schedulerIdle()
+ */
+class LockerWebServer : public ESP8266WebServer {
+public:
+    using ESP8266WebServer::ESP8266WebServer;
+    bool hasPendingClient() { return _server.hasClient(); }
+};
+
+LockerWebServer server(SERVER_PORT);
 WiFiClient mqttWifiClient;
 PubSubClient mqttClient(mqttWifiClient);
-unsigned long lastStatusReport = 0;
-unsigned long lastWiFiCheck = 0;
-unsigned long lastMqttReconnect = 0;
-
-// Button handling variables
-unsigned long lastButtonPress = 0;
-bool lastButtonState = HIGH;  // Pull-up: HIGH khi không nhấn
 
 // ============================================
-// WiFi Functions
+// HTTP Server Handlers
 // ============================================
 
-void connectWiFi() {
-    Serial.println("\n[WIFI] Connecting to WiFi...");
-    Serial.printf("[WIFI] SSID: %s\n", WIFI_SSID);
+/**
+ * Handle root endpoint - Phục vụ trang web kiosk
+ * Gửi bản gzip dựng sẵn (web_ui_gz.h) kèm ETag; tablet đã có bản hiện tại
+ * (If-None-Match khớp) chỉ nhận 304 không có body. Body được stream nền
+ * từ flash (progmem_stream) nên handler trả về ngay
+ */
+void handleRoot() {
+    HeapScope heapScope("http:/");
     
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    bool gzip = server.header("Accept-Encoding").indexOf("gzip") >= 0;
+    String etag = gzip ? "\"" LOCKER_UI_HASH "-gz\"" : "\"" LOCKER_UI_HASH "\"";
     
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 30) {
-        delay(500);
-        Serial.print(".");
-        attempts++;
+    server.sendHeader("ETag", etag);
+    server.sendHeader("Cache-Control", WEB_UI_CACHE_CONTROL);
+    server.sendHeader("Vary", "Accept-Encoding");
+    
+    // Cùng hash = cùng nội dung HTML, với bất kỳ encoding nào tablet đang giữ
+    if (server.header("If-None-Match").indexOf(LOCKER_UI_HASH) >= 0) {
+        server.send(304);
+        return;
     }
     
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println("\n[WIFI] Connected!");
-        Serial.printf("[WIFI] IP Address: %s\n", WiFi.localIP().toString().c_str());
-        Serial.printf("[WIFI] Signal strength: %d dBm\n", WiFi.RSSI());
+    if (gzip) {
+        server.sendHeader("Content-Encoding", "gzip");
+        streamProgmem(server, 200, "text/html", (PGM_P)LOCKER_UI_GZ, LOCKER_UI_GZ_SIZE);
     } else {
-        Serial.println("\n[WIFI] Connection failed!");
-    }
-}
-
-void checkWiFiConnection() {
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("[WIFI] Connection lost, reconnecting...");
-        connectWiFi();
+        streamProgmem(server, 200, "text/html", LOCKER_UI_HTML, sizeof(LOCKER_UI_HTML) - 1);
     }
 }
 
-// ============================================
-// HTTP Server Handlers
-// ============================================
-
-/**
- * Handle root endpoint - Phục vụ trang web kiosk
- */
-void handleRoot() {
-    server.send(200, "text/html", FPSTR(LOCKER_UI_HTML));
-}
-
 /**
  * Handle API info endpoint - Thông tin thiết bị (JSON)
  */
 void handleApiInfo() {
+    HeapScope heapScope("http:/api/info");
+    
     StaticJsonDocument<256> doc;
     doc["device"] = DEVICE_ID;
     doc["boxId"] = BOX_ID;
+    doc["boxCount"] = boxCount();
     doc["lockerId"] = LOCKER_ID;
-    doc["status"] = isUnlocked() ? "UNLOCKED" : "LOCKED";
+    doc["status"] = isUnlocked(BOX_ID) ? "UNLOCKED" : "LOCKED";
     doc["uptime"] = millis() / 1000;
     doc["rssi"] = WiFi.RSSI();
     
@@ -110,9 +129,14 @@ void handleApiInfo() {
  * Handle verify-and-unlock endpoint
  * Nhận PIN từ web UI → gọi backend xác thực → nếu hợp lệ, mở relay
  * POST /verify-and-unlock
- * Body: {"pinCode": "123456"}
+ * Body: {"pinCode": "123456", "boxId": 1} (boxId mặc định BOX_ID)
+ *
+ * Handler trả về ngay sau khi gửi request tới backend; response cho kiosk
+ * được gửi từ verify pipeline khi backend phản hồi (xem verify_pipeline.cpp)
  */
 void handleVerifyAndUnlock() {
+    HeapScope heapScope("http:/verify-and-unlock");
+    
     Serial.println("[KIOSK] Received verify-and-unlock request");
     
     if (!server.hasArg("plain")) {
@@ -132,92 +156,25 @@ void handleVerifyAndUnlock() {
     }
     
     String pinCode = reqDoc["pinCode"] | "";
+    int boxId = reqDoc["boxId"] | BOX_ID;
     
     if (pinCode.length() != 6) {
         server.send(400, "application/json", "{\"success\":false,\"message\":\"PIN phải có 6 số\"}");
         return;
     }
     
-    // Gọi backend để xác thực PIN
-    Serial.println("[KIOSK] Calling backend to verify PIN...");
-    
-    WiFiClient client;
-    HTTPClient http;
-    String url = String(BACKEND_URL) + "/api/iot/verify-pin";
-    
-    http.begin(client, url);
-    http.addHeader("Content-Type", "application/json");
-    http.setTimeout(HTTP_TIMEOUT);
-    
-    // Tạo request body cho backend
-    StaticJsonDocument<128> verifyReq;
-    verifyReq["boxId"] = BOX_ID;
-    verifyReq["pinCode"] = pinCode;
-    
-    String verifyBody;
-    serializeJson(verifyReq, verifyBody);
-    Serial.printf("[KIOSK] Backend request: %s\n", verifyBody.c_str());
-    
-    int httpCode = http.POST(verifyBody);
-    
-    if (httpCode <= 0) {
-        Serial.printf("[KIOSK] Backend connection failed: %s\n", http.errorToString(httpCode).c_str());
-        http.end();
-        server.send(500, "application/json", "{\"success\":false,\"message\":\"Không thể kết nối server. Thử lại sau.\"}");
-        return;
-    }
-    
-    String backendResponse = http.getString();
-    Serial.printf("[KIOSK] Backend response (%d): %s\n", httpCode, backendResponse.c_str());
-    http.end();
-    
-    // Parse backend response
-    StaticJsonDocument<512> resDoc;
-    error = deserializeJson(resDoc, backendResponse);
-    
-    if (error) {
-        Serial.println("[KIOSK] Failed to parse backend response");
-        server.send(500, "application/json", "{\"success\":false,\"message\":\"Lỗi xử lý phản hồi từ server\"}");
+    if (!isValidBox(boxId)) {
+        server.send(400, "application/json", "{\"success\":false,\"message\":\"Box không thuộc thiết bị này\"}");
         return;
     }
     
-    // Kiểm tra kết quả xác thực
-    // Backend trả về: {"success": true, "data": {"valid": true, ...}, "code": "PIN_VALID"}
-    bool isValid = resDoc["data"]["valid"] | false;
+    // Xác thực PIN: kho cục bộ trước, không có thì gọi backend (không chặn loop)
+    Serial.println("[KIOSK] Verifying PIN...");
     
-    if (!isValid) {
-        String msg = resDoc["data"]["message"] | "Mã PIN không hợp lệ";
-        Serial.printf("[KIOSK] PIN invalid: %s\n", msg.c_str());
-        
-        StaticJsonDocument<256> errResp;
-        errResp["success"] = false;
-        errResp["message"] = msg;
-        String errJson;
-        serializeJson(errResp, errJson);
-        server.send(200, "application/json", errJson);
-        return;
+    WiFiClient kiosk = server.client();
+    if (!beginVerifyAndUnlock(kiosk, pinCode, boxId)) {
+        server.send(503, "application/json", "{\"success\":false,\"message\":\"Hệ thống đang bận, thử lại sau.\"}");
     }
-    
-    // PIN hợp lệ - Mở khóa!
-    Serial.println("[KIOSK] PIN valid! Unlocking box...");
-    unlockBox();
-    
-    // Gửi response thành công
-    long orderId = resDoc["data"]["orderId"] | 0;
-    int boxNumber = resDoc["data"]["boxNumber"] | BOX_ID;
-    
-    StaticJsonDocument<256> successResp;
-    successResp["success"] = true;
-    successResp["message"] = "Đã mở khóa thành công! Hộp sẽ tự khóa sau 5 giây.";
-    successResp["orderId"] = orderId;
-    successResp["boxNumber"] = boxNumber;
-    
-    String successJson;
-    serializeJson(successResp, successJson);
-    server.send(200, "application/json", successJson);
-    
-    // Báo cáo trạng thái
-    reportBoxStatus(STATUS_AVAILABLE, true);
 }
 
 /**
@@ -226,6 +183,8 @@ void handleVerifyAndUnlock() {
  * Body: {"boxId": 1, "action": "UNLOCK"}
  */
 void handleUnlock() {
+    HeapScope heapScope("http:/unlock");
+    
     Serial.println("[SERVER] Received unlock request");
     
     if (server.hasArg("plain")) {
@@ -245,20 +204,24 @@ void handleUnlock() {
         String action = doc["action"] | "";
         
         // Kiểm tra box ID
-        if (requestedBoxId != BOX_ID) {
-            Serial.printf("[SERVER] Box ID mismatch: expected %d, got %d\n", BOX_ID, requestedBoxId);
+        if (!isValidBox(requestedBoxId)) {
+            Serial.printf("[SERVER] Box ID mismatch: expected %d..%d, got %d\n", BOX_ID, BOX_ID + boxCount() - 1, requestedBoxId);
             server.send(400, "application/json", "{\"success\":false,\"error\":\"Box ID mismatch\"}");
             return;
         }
         
         // Thực hiện action
         if (action == "UNLOCK") {
-            unlockBox();
+            // Bản build hai lõi: false = hàng đợi lệnh đầy (task actuation treo)
+            if (!unlockBox(requestedBoxId)) {
+                server.send(503, "application/json", "{\"success\":false,\"error\":\"Actuator busy\"}");
+                return;
+            }
             
             // Gửi response thành công
             StaticJsonDocument<256> resDoc;
             resDoc["success"] = true;
-            resDoc["boxId"] = BOX_ID;
+            resDoc["boxId"] = requestedBoxId;
             resDoc["status"] = "UNLOCKED";
             resDoc["message"] = "Box unlocked successfully";
             
@@ -267,13 +230,16 @@ void handleUnlock() {
             server.send(200, "application/json", response);
             
             // Báo cáo trạng thái về backend
-            reportBoxStatus(STATUS_AVAILABLE, true);
+            reportBoxStatus(requestedBoxId, STATUS_AVAILABLE, true);
         } else if (action == "LOCK") {
-            lockBox();
+            if (!lockBox(requestedBoxId)) {
+                server.send(503, "application/json", "{\"success\":false,\"error\":\"Actuator busy\"}");
+                return;
+            }
             
             StaticJsonDocument<256> resDoc;
             resDoc["success"] = true;
-            resDoc["boxId"] = BOX_ID;
+            resDoc["boxId"] = requestedBoxId;
             resDoc["status"] = "LOCKED";
             resDoc["message"] = "Box locked successfully";
             
@@ -281,7 +247,7 @@ void handleUnlock() {
             serializeJson(resDoc, response);
             server.send(200, "application/json", response);
             
-            reportBoxStatus(STATUS_LOCKED, false);
+            reportBoxStatus(requestedBoxId, STATUS_LOCKED, false);
         } else {
             server.send(400, "application/json", "{\"success\":false,\"error\":\"Invalid action\"}");
         }
@@ -295,21 +261,232 @@ void handleUnlock() {
  * GET /status
  */
 void handleStatus() {
-    StaticJsonDocument<256> doc;
+    HeapScope heapScope("http:/status");
+    
+    // Document tĩnh: /status đã quá lớn để đặt trên stack 4 KB của loop()
+    // Tính theo slot (~96 trường hiện tại) để đủ cả trên bản build native 64-bit
+    static StaticJsonDocument<JSON_OBJECT_SIZE(147) + 256 + BOX_COUNT * JSON_OBJECT_SIZE(5)> doc;
+    doc.clear();
     doc["boxId"] = BOX_ID;
     doc["deviceId"] = DEVICE_ID;
-    doc["isUnlocked"] = isUnlocked();
-    doc["status"] = isUnlocked() ? "UNLOCKED" : "LOCKED";
+    doc["isUnlocked"] = isUnlocked(BOX_ID);
+    doc["status"] = isUnlocked(BOX_ID) ? "UNLOCKED" : "LOCKED";
     doc["uptime"] = millis() / 1000;
     doc["wifiRssi"] = WiFi.RSSI();
     doc["freeHeap"] = ESP.getFreeHeap();
     
+    // Trạng thái từng box trong bảng
+    JsonArray boxes = doc.createNestedArray("boxes");
+    for (uint8_t i = 0; i < boxCount(); i++) {
+        int boxId = boxIdAt(i);
+        JsonObject box = boxes.createNestedObject();
+        box["boxId"] = boxId;
+        box["isUnlocked"] = isUnlocked(boxId);
+        box["status"] = isUnlocked(boxId) ? "UNLOCKED" : "LOCKED";
+        box["autoLockMs"] = autoLockRemaining(boxId);
+        if (doorHasSensor(boxId)) box["doorOpen"] = doorIsOpen(boxId);
+    }
+    
+    SchedulerStats sched;
+    schedulerGetStats(sched);
+    JsonObject loopLag = doc.createNestedObject("loopLag");
+    loopLag["tasks"] = sched.activeTasks;
+    loopLag["dispatched"] = sched.dispatched;
+    loopLag["late"] = sched.lateCount;
+    loopLag["maxMs"] = sched.maxLagMs;
+    loopLag["avgMs"] = sched.avgLagMs;
+    loopLag["idleMs"] = sched.idleMs;
+    
+    WiFiStats wifi;
+    wifiGetStats(wifi);
+    JsonObject wifiObj = doc.createNestedObject("wifi");
+    wifiObj["connects"] = wifi.connects;
+    wifiObj["fastConnects"] = wifi.fastConnects;
+    wifiObj["fastFailures"] = wifi.fastFailures;
+    wifiObj["lastConnectMs"] = wifi.lastConnectMs;
+    wifiObj["channel"] = wifi.channel;
+    
+    InputStats input;
+    inputGetStats(input);
+    JsonObject inputs = doc.createNestedObject("inputs");
+    inputs["edges"] = input.edges;
+    inputs["dropped"] = input.dropped;
+    inputs["maxLatencyUs"] = input.maxLatencyUs;
+    
+    OutboxStats outbox;
+    outboxGetStats(outbox);
+    JsonObject outboxObj = doc.createNestedObject("outbox");
+    outboxObj["pending"] = outbox.pending;
+    outboxObj["coalesced"] = outbox.coalesced;
+    outboxObj["requests"] = outbox.requests;
+    outboxObj["failures"] = outbox.failures;
+    outboxObj["backoffMs"] = outbox.backoffMs;
+    outboxObj["heartbeats"] = outbox.heartbeats;
+    outboxObj["heartbeatMs"] = outbox.heartbeatMs;
+    
+    DoorStats door;
+    doorGetStats(door);
+    JsonObject doors = doc.createNestedObject("doors");
+    doors["sensors"] = door.sensors;
+    doors["open"] = door.open;
+    doors["transitions"] = door.transitions;
+    doors["forced"] = door.forced;
+    doors["glitches"] = door.glitches;
+    
+    BackendPoolStats pool;
+    backendPoolGetStats(pool);
+    JsonObject backend = doc.createNestedObject("backendPool");
+    backend["open"] = pool.open;
+    backend["reused"] = pool.reused;
+    backend["connects"] = pool.connects;
+    backend["stale"] = pool.stale;
+    backend["hitRate"] = pool.acquired ? pool.reused * 100 / pool.acquired : 0;
+    backend["retried"] = asyncHttpRetried();
+    
+    ProgmemStreamStats stream;
+    progmemStreamGetStats(stream);
+    JsonObject streamObj = doc.createNestedObject("stream");
+    streamObj["active"] = stream.active;
+    streamObj["completed"] = stream.completed;
+    streamObj["aborted"] = stream.aborted;
+    streamObj["fallbacks"] = stream.fallbacks;
+    streamObj["bytes"] = stream.bytes;
+    streamObj["maxBlock"] = stream.maxBlock;
+    
+    TelemetryStats telemetry;
+    telemetryGetStats(telemetry);
+    JsonObject telemetryObj = doc.createNestedObject("telemetry");
+    telemetryObj["samples"] = telemetry.samples;
+    telemetryObj["batches"] = telemetry.batches;
+    telemetryObj["mqtt"] = telemetry.mqttBatches;
+    telemetryObj["http"] = telemetry.httpBatches;
+    telemetryObj["dropped"] = telemetry.dropped;
+    telemetryObj["lastBytes"] = telemetry.lastBytes;
+    
+    PinCacheStats pins;
+    pinCacheGetStats(pins);
+    JsonObject pinObj = doc.createNestedObject("pinCache");
+    pinObj["entries"] = pins.entries;
+    pinObj["unreported"] = pins.unreported;
+    pinObj["hits"] = pins.hits;
+    pinObj["misses"] = pins.misses;
+    pinObj["expired"] = pins.expired;
+    pinObj["lastVerifyUs"] = pins.lastVerifyUs;
+    
+    CommandDedupStats dedup;
+    commandDedupGetStats(dedup);
+    JsonObject dedupObj = doc.createNestedObject("commands");
+    dedupObj["tracked"] = dedup.tracked;
+    dedupObj["executed"] = dedup.executed;
+    dedupObj["duplicates"] = dedup.duplicates;
+    MqttCommandStats wire;
+    mqttCommandsGetStats(wire);
+    dedupObj["wire"] = wireFormatName(wire.format);
+    dedupObj["json"] = wire.jsonCommands;
+    dedupObj["msgpack"] = wire.msgpackCommands;
+    dedupObj["parseErrors"] = wire.parseErrors;
+    
+    PinGuardStats guard;
+    pinGuardGetStats(guard);
+    JsonObject guardObj = doc.createNestedObject("pinGuard");
+    guardObj["rejectedPins"] = guard.rejectedPins;
+    guardObj["sources"] = guard.sources;
+    guardObj["negativeHits"] = guard.negativeHits;
+    guardObj["limited"] = guard.limited;
+    guardObj["failures"] = guard.failures;
+    
+    ProxyStats proxy;
+    proxyGetStats(proxy);
+    JsonObject proxyObj = doc.createNestedObject("proxy");
+    proxyObj["requests"] = proxy.requests;
+    proxyObj["errors"] = proxy.errors;
+    proxyObj["bytes"] = proxy.bytes;
+    proxyObj["maxBody"] = proxy.maxBody;
+    
+    HeapStats heap;
+    heapGetStats(heap);
+    JsonObject heapObj = doc.createNestedObject("heap");
+    heapObj["free"] = heap.freeHeap;
+    heapObj["maxBlock"] = heap.maxFreeBlock;
+    heapObj["fragPct"] = heap.fragmentation;
+    heapObj["lowWater"] = heap.lowWater;
+    heapObj["allocs"] = heap.totalAllocs;
+    
+    HeapSiteStats sites[HEAP_TOP_SITES];
+    uint8_t siteCount = heapTopSites(sites, HEAP_TOP_SITES);
+    JsonArray top = heapObj.createNestedArray("topSites");
+    for (uint8_t i = 0; i < siteCount; i++) {
+        JsonObject site = top.createNestedObject();
+        site["site"] = sites[i].site;
+        site["calls"] = sites[i].calls;
+        site["allocs"] = sites[i].allocs;
+        site["bytes"] = sites[i].allocBytes;
+        site["retained"] = sites[i].retained;
+    }
+    
+    JournalStats journal;
+    journalGetStats(journal);
+    JsonObject journalObj = doc.createNestedObject("journal");
+    journalObj["seq"] = journal.headSeq;
+    journalObj["pending"] = journal.pending;
+    journalObj["appended"] = journal.appended;
+    journalObj["replayed"] = journal.replayed;
+    journalObj["batches"] = journal.batches;
+    journalObj["failures"] = journal.failures;
+    journalObj["dropped"] = journal.dropped;
+    journalObj["erases"] = journal.erases;
+    
+    StallStats stall;
+    stallGetStats(stall);
+    JsonObject stallObj = doc.createNestedObject("stalls");
+    stallObj["count"] = stall.stalls;
+    stallObj["resets"] = stall.resets;
+    stallObj["worstMs"] = stall.worstMs;
+    stallObj["lastStage"] = stall.lastStage;
+    stallObj["pending"] = stall.pending;
+    stallObj["reports"] = stall.reports;
+    
+#if LOCKER_DUAL_CORE
+    DualCoreStats cores;
+    dualCoreGetStats(cores);
+    JsonObject coresObj = doc.createNestedObject("cores");
+    coresObj["commands"] = cores.commands;
+    coresObj["events"] = cores.events;
+    coresObj["rejected"] = cores.rejected;
+    coresObj["deferred"] = cores.deferred;
+    coresObj["backlog"] = cores.backlog;
+    coresObj["dropped"] = cores.dropped;
+    coresObj["queueUs"] = cores.lastQueueUs;
+    coresObj["maxQueueUs"] = cores.maxQueueUs;
+    coresObj["loops"] = cores.actuationLoops;
+    coresObj["flashStalls"] = cores.flashStalls;
+    coresObj["maxFlashUs"] = cores.maxFlashUs;
+#endif
+    
     String response;
     serializeJson(doc, response);
     
     server.send(200, "application/json", response);
 }
 
+/**
+ * Handle metrics endpoint - Histogram thời gian từng stage của loop()
+ * GET /metrics (Prometheus text format, gửi từng phần qua buffer tĩnh)
+ */
+void handleMetrics() {
+    HeapScope heapScope("http:/metrics");
+    
+    static char part[METRICS_PART_SIZE];
+    
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "text/plain; version=0.0.4", "");
+    
+    size_t len;
+    for (uint8_t i = 0; (len = metricsFormatPart(i, part, sizeof(part))) > 0; i++) {
+        server.sendContent(part, len);
+    }
+}
+
 /**
  * Handle 404 - Not found
  */
@@ -321,63 +498,32 @@ void handleNotFound() {
 // MQTT Functions
 // ============================================
 
+/**
+ * Publish bản tin trạng thái (dùng cho mqtt_commands và pin_cache)
+ */
+bool publishStatus(const char* topic, const uint8_t* payload, size_t length) {
+    if (!mqttClient.connected()) return false;
+    // Header: 1 byte loại gói + tối đa 4 byte độ dài + 2 byte độ dài topic
+    if (5 + 2 + strlen(topic) + length <= mqttClient.getBufferSize()) {
+        return mqttClient.publish(topic, payload, length);
+    }
+    // Bản tin dài hơn buffer PubSubClient (lô telemetry): ghi thẳng ra socket
+    return mqttClient.beginPublish(topic, length, false)
+        && mqttClient.write(payload, length) == length
+        && mqttClient.endPublish();
+}
+
 /**
  * MQTT message callback - xử lý lệnh từ backend
  * Topic: locker/commands/{DEVICE_ID}
  * Payload: {"box_id": 1, "action": "OPEN"} hoặc {"box_id": 1, "action": "LOCK"}
+ * Tùy chọn "cmd_id" (chuỗi duy nhất) và/hoặc "seq": lệnh trùng trong
+ * CMD_DEDUP_WINDOW chỉ được xác nhận lại (ACK, duplicate = true)
+ * Topic locker/commands/{DEVICE_ID}/mp: cùng lệnh dạng MessagePack
+ * Xem mqtt_commands.cpp (parse tại chỗ, không cấp phát)
  */
 void mqttCallback(char* topic, byte* payload, unsigned int length) {
-    // Parse payload
-    char msg[length + 1];
-    memcpy(msg, payload, length);
-    msg[length] = '\0';
-    
-    Serial.printf("[MQTT] Message on [%s]: %s\n", topic, msg);
-    
-    StaticJsonDocument<256> doc;
-    DeserializationError err = deserializeJson(doc, msg);
-    if (err) {
-        Serial.printf("[MQTT] JSON parse error: %s\n", err.c_str());
-        return;
-    }
-    
-    int cmdBoxId = doc["box_id"] | -1;
-    const char* action = doc["action"] | "";
-    
-    // Kiểm tra box_id có đúng box này không
-    if (cmdBoxId != BOX_ID) {
-        Serial.printf("[MQTT] Ignored: box_id %d != my BOX_ID %d\n", cmdBoxId, BOX_ID);
-        return;
-    }
-    
-    if (strcmp(action, "OPEN") == 0) {
-        Serial.println("[MQTT] >>> OPEN command received! Unlocking...");
-        unlockBox();
-        
-        // Publish status update
-        StaticJsonDocument<128> status;
-        status["box_id"] = BOX_ID;
-        status["status"] = "UNLOCKED";
-        status["device"] = DEVICE_ID;
-        char statusMsg[128];
-        serializeJson(status, statusMsg);
-        mqttClient.publish(MQTT_TOPIC_STATUS, statusMsg);
-        
-    } else if (strcmp(action, "LOCK") == 0) {
-        Serial.println("[MQTT] >>> LOCK command received! Locking...");
-        lockBox();
-        
-        StaticJsonDocument<128> status;
-        status["box_id"] = BOX_ID;
-        status["status"] = "LOCKED";
-        status["device"] = DEVICE_ID;
-        char statusMsg[128];
-        serializeJson(status, statusMsg);
-        mqttClient.publish(MQTT_TOPIC_STATUS, statusMsg);
-        
-    } else {
-        Serial.printf("[MQTT] Unknown action: %s\n", action);
-    }
+    handleMqttCommand(topic, payload, length);
 }
 
 /**
@@ -386,6 +532,7 @@ void mqttCallback(char* topic, byte* payload, unsigned int length) {
 void connectMQTT() {
     mqttClient.setServer(MQTT_BROKER, MQTT_PORT);
     mqttClient.setCallback(mqttCallback);
+    if (mqttClient.getBufferSize() != MQTT_BUFFER_SIZE) mqttClient.setBufferSize(MQTT_BUFFER_SIZE);
     
     String clientId = String(DEVICE_ID) + "_" + String(random(0xffff), HEX);
     Serial.printf("[MQTT] Connecting to %s:%d as %s...\n", MQTT_BROKER, MQTT_PORT, clientId.c_str());
@@ -401,16 +548,19 @@ void connectMQTT() {
         Serial.println("[MQTT] Connected!");
         mqttClient.subscribe(MQTT_TOPIC_CMD);
         Serial.printf("[MQTT] Subscribed to: %s\n", MQTT_TOPIC_CMD);
+#if MQTT_MSGPACK_ENABLED
+        mqttClient.subscribe(MQTT_TOPIC_CMD_MSGPACK);
+        Serial.printf("[MQTT] Subscribed to: %s\n", MQTT_TOPIC_CMD_MSGPACK);
+#endif
         
         // Publish online status
-        StaticJsonDocument<128> status;
+        StaticJsonDocument<JSON_OBJECT_SIZE(5) + 16> status;  // + bản sao chuỗi IP
         status["box_id"] = BOX_ID;
+        status["box_count"] = boxCount();
         status["status"] = "ONLINE";
         status["device"] = DEVICE_ID;
         status["ip"] = WiFi.localIP().toString();
-        char statusMsg[128];
-        serializeJson(status, statusMsg);
-        mqttClient.publish(MQTT_TOPIC_STATUS, statusMsg);
+        publishStatusDoc(status);
     } else {
         Serial.printf("[MQTT] Failed, rc=%d. Retry in %ds\n", mqttClient.state(), MQTT_RECONNECT_INTERVAL / 1000);
     }
@@ -427,39 +577,20 @@ void connectMQTT() {
  * forwards to backend, returns response.
  */
 void proxyToBackend(const char* method, const String& backendPath, const String& bodyOverride = "") {
+    HeapScope heapScope("http:/api/proxy");
+    
     String body = bodyOverride.length() > 0 ? bodyOverride 
                  : (server.hasArg("plain") ? server.arg("plain") : "");
     String auth = server.header("Authorization");
     
-    WiFiClient wifiClient;
-    HTTPClient http;
-    String url = String(BACKEND_URL) + backendPath;
-    
-    Serial.printf("[PROXY] %s %s\n", method, url.c_str());
+    Serial.printf("[PROXY] %s %s%s\n", method, BACKEND_URL, backendPath.c_str());
     
-    http.begin(wifiClient, url);
-    http.addHeader("Content-Type", "application/json");
-    if (auth.length() > 0) {
-        http.addHeader("Authorization", auth);
-    }
-    http.setTimeout(HTTP_TIMEOUT);
-    
-    int httpCode;
-    String methodStr = String(method);
-    if (methodStr == "GET") httpCode = http.GET();
-    else if (methodStr == "PUT") httpCode = http.PUT(body);
-    else httpCode = http.POST(body);
-    
-    if (httpCode > 0) {
-        String response = http.getString();
-        server.send(httpCode, "application/json", response);
-        Serial.printf("[PROXY] Response: %d\n", httpCode);
-    } else {
-        Serial.printf("[PROXY] Error: %s\n", http.errorToString(httpCode).c_str());
+    // Phản hồi được stream thẳng từ socket backend sang kiosk theo từng đoạn nhỏ
+    if (!proxyStream(server, method, backendPath.c_str(), body, auth)) {
+        Serial.println("[PROXY] Error: cannot reach backend");
         server.send(502, "application/json", 
             "{\"success\":false,\"message\":\"Không thể kết nối server\"}");
     }
-    http.end();
 }
 
 // Auth proxy handlers
@@ -468,8 +599,9 @@ void handleProxyVerifyOtp() { proxyToBackend("POST", "/api/auth/email/verify-otp
 void handleProxyRegister() { proxyToBackend("POST", "/api/auth/email/complete-registration"); }
 
 void setupServer() {
-    // Collect Authorization header from requests
-    server.collectHeaders("Authorization");
+    // Collect Authorization (proxy) và các header cache/nén của trang kiosk
+    static const char* headerKeys[] = { "Authorization", "If-None-Match", "Accept-Encoding" };
+    server.collectHeaders(headerKeys, sizeof(headerKeys) / sizeof(headerKeys[0]));
     
     // Core endpoints
     server.on("/", HTTP_GET, handleRoot);
@@ -477,6 +609,7 @@ void setupServer() {
     server.on("/verify-and-unlock", HTTP_POST, handleVerifyAndUnlock);
     server.on("/unlock", HTTP_POST, handleUnlock);
     server.on("/status", HTTP_GET, handleStatus);
+    server.on("/metrics", HTTP_GET, handleMetrics);
     
     // Auth proxy endpoints (for kiosk login/register)
     server.on("/api/proxy/send-otp", HTTP_POST, handleProxySendOtp);
@@ -493,6 +626,7 @@ void setupServer() {
     Serial.println("  POST /verify-and-unlock       - PIN verify & unlock");
     Serial.println("  POST /unlock                  - Direct unlock/lock");
     Serial.println("  GET  /status                  - Current status");
+    Serial.println("  GET  /metrics                 - Loop stage histograms (Prometheus)");
     Serial.println("  POST /api/proxy/send-otp      - Auth: Send OTP");
     Serial.println("  POST /api/proxy/verify-otp    - Auth: Verify OTP");
     Serial.println("  POST /api/proxy/register      - Auth: Register");
@@ -503,112 +637,304 @@ void setupServer() {
 // ============================================
 
 /**
- * Kiểm tra nút nhấn và toggle trạng thái khóa
- * Sử dụng debounce để tránh bấm nhiều lần
+ * Xử lý sự kiện nút nhấn và toggle trạng thái khóa
+ * Được gọi từ inputEventsPoll() sau khi ISR ghi nhận cạnh và đã debounce
+ * @param level LOW khi nhấn (pull-up), HIGH khi nhả
+ * @param timestampUs Thời điểm cạnh xảy ra trong ISR
  */
-void handleButton() {
-    bool currentButtonState = digitalRead(BUTTON_PIN);
+void handleButton(int8_t input, uint8_t level, uint32_t timestampUs) {
+    // Chỉ xử lý cạnh xuống (HIGH -> LOW)
+    if (level != LOW) {
+        return;
+    }
     
-    // Phát hiện cạnh xuống (HIGH -> LOW) với debounce
-    if (currentButtonState == LOW && lastButtonState == HIGH) {
-        unsigned long currentTime = millis();
-        
-        if (currentTime - lastButtonPress >= BUTTON_DEBOUNCE_TIME) {
-            lastButtonPress = currentTime;
-            
-            // Toggle trạng thái khóa
-            if (isUnlocked()) {
-                Serial.println("[BUTTON] Button pressed - Locking box");
-                lockBox();
-                reportBoxStatus(STATUS_LOCKED, false);
-            } else {
-                Serial.println("[BUTTON] Button pressed - Unlocking box");
-                unlockBox();
-                reportBoxStatus(STATUS_AVAILABLE, true);
-            }
-        }
+    uint32_t start = micros();
+    HeapScope heapScope("button");
+    
+    // Toggle trạng thái khóa (nút bảo trì điều khiển box đầu tiên)
+    if (isUnlocked(BOX_ID)) {
+        Serial.println("[BUTTON] Button pressed - Locking box");
+        lockBox(BOX_ID);
+        Serial.printf("[BUTTON] Press-to-relay: %lu us\n", (unsigned long)(micros() - timestampUs));
+        journalAppend(JOURNAL_BUTTON, BOX_ID);
+        reportBoxStatus(BOX_ID, STATUS_LOCKED, false);
+    } else {
+        Serial.println("[BUTTON] Button pressed - Unlocking box");
+        unlockBox(BOX_ID);
+        Serial.printf("[BUTTON] Press-to-relay: %lu us\n", (unsigned long)(micros() - timestampUs));
+        journalAppend(JOURNAL_BUTTON, BOX_ID);
+        reportBoxStatus(BOX_ID, STATUS_AVAILABLE, true);
     }
     
-    lastButtonState = currentButtonState;
+    metricsRecord(STAGE_BUTTON, micros() - start);
 }
 
 // ============================================
-// Main Functions
+// Scheduled Tasks
 // ============================================
 
-void setup() {
-    // Khởi tạo Serial
-    Serial.begin(115200);
-    delay(1000);
-    
-    Serial.println("\n");
-    Serial.println("========================================");
-    Serial.println("   ESP8266 Laundry Locker Controller");
-    Serial.println("========================================");
-    Serial.printf("Device ID: %s\n", DEVICE_ID);
-    Serial.printf("Box ID: %d\n", BOX_ID);
-    Serial.println("----------------------------------------");
-    
-    // Khởi tạo locker controller
+/**
+ * Thử kết nối lại MQTT nếu mất kết nối (mỗi MQTT_RECONNECT_INTERVAL)
+ */
+void mqttReconnectTask(void* arg) {
+    if (WiFi.status() != WL_CONNECTED) return;
+    if (!mqttClient.connected()) {
+        Serial.println("[MQTT] Reconnecting...");
+        connectMQTT();
+    }
+}
+
+/**
+ * Máy trạng thái kết nối WiFi (mỗi WIFI_POLL_INTERVAL, không chặn)
+ */
+void wifiCheckTask(void* arg) {
+    uint32_t start = micros();
+    wifiManagerLoop();
+    metricsRecord(STAGE_WIFI_CHECK, micros() - start);
+}
+
+/**
+ * Có WiFi: kết nối MQTT ngay thay vì chờ mqttReconnectTask
+ */
+void onWiFiConnected() {
+    if (!mqttClient.connected()) {
+        connectMQTT();
+    }
+}
+
+/**
+ * Lấy mẫu telemetry, gửi lô khi đầy hoặc tới hạn (mỗi TELEMETRY_SAMPLE_INTERVAL)
+ * Thay đổi trạng thái box vẫn được gửi ngay qua outbox
+ */
+void telemetryTask(void* arg) {
+    telemetrySample();
+}
+
+/**
+ * Lấy mẫu heap để cập nhật low-water (mỗi HEAP_SAMPLE_INTERVAL)
+ */
+void heapSampleTask(void* arg) {
+    heapSample();
+}
+
+/**
+ * Dọn PIN hết hạn, gửi lại báo cáo PIN đã dùng khi MQTT có lại
+ */
+void pinCacheTask(void* arg) {
+    pinCacheMaintain();
+}
+
+/**
+ * Đóng các socket backend rảnh đã chết hoặc hết hạn keep-alive
+ */
+void backendPoolTask(void* arg) {
+    backendPoolMaintain();
+}
+
+/**
+ * Xoá trước sector journal kế tiếp, gửi lại nhật ký sự kiện khi có WiFi
+ */
+void journalTask(void* arg) {
+    journalMaintain();
+}
+
+/**
+ * Gửi các stall ghi trong RTC (kể cả trước lần reset) khi MQTT có lại
+ */
+void stallReportTask(void* arg) {
+    stallReport();
+}
+
+/**
+ * Có sự kiện I/O cần xử lý ngay không (dùng để thoát khỏi schedulerIdle)
+ */
+bool ioReady() {
+    return server.hasPendingClient()
+        || mqttWifiClient.available() > 0
+        || asyncHttpReady()
+        || progmemStreamReady()
+#if LOCKER_DUAL_CORE
+        || actuatorEventsPending();
+#else
+        || inputEventsPending();
+#endif
+}
+
+// ============================================
+// Setup & Loop Stages
+// ============================================
+
+/**
+ * Relay, nút nhấn và cảm biến cửa
+ * Bản build hai lõi: chạy trong task actuation để ngắt input gắn vào lõi đó
+ */
+void setupActuation() {
     initLockerController();
     
-    // Khởi tạo nút nhấn với pull-up
-    pinMode(BUTTON_PIN, INPUT_PULLUP);
-    Serial.printf("[BUTTON] Button pin: GPIO%d\n", BUTTON_PIN);
-    
-    // Kết nối WiFi
-    connectWiFi();
+    // Khởi tạo nút nhấn với pull-up, bắt cạnh bằng ngắt
+    initInputEvents();
+    inputRegister(BUTTON_PIN, INPUT_PULLUP, BUTTON_DEBOUNCE_TIME, handleButton, "button");
     
-    // Khởi động HTTP server
-    if (WiFi.status() == WL_CONNECTED) {
-        setupServer();
-        
-        // Kết nối MQTT
-        connectMQTT();
-        
-        // Báo cáo trạng thái ban đầu
-        reportBoxStatus(STATUS_AVAILABLE, false);
+    // Công tắc cửa: báo trạng thái box khi cửa thật sự mở/đóng
+    initDoorSensors();
+}
+
+/**
+ * WiFi, backend, MQTT, HTTP server và các công việc định kỳ của chúng
+ */
+void setupNetwork() {
+    // Kết nối WiFi nền (BSSID/kênh đã lưu trước, quét đầy đủ nếu không được)
+    initWiFiManager(onWiFiConnected);
+    // SNTP chạy nền khi có WiFi; mốc trace chỉ có epoch ms sau khi đồng bộ
+    configTime(0, 0, NTP_SERVER);
+    initBackendPool();
+    initAsyncHttp();
+    initStatusOutbox();
+    initEventJournal();
+    initMqttCommands(publishStatus);
+    initPinCache(publishPinUsed);
+    initPinGuard();
+    initCommandDedup();
+    initTelemetry();
+    
+    // Khởi động HTTP server (lắng nghe trên mọi interface, sẵn sàng khi có WiFi)
+    setupServer();
+    
+    // Báo cáo trạng thái ban đầu (outbox giữ lại tới khi có WiFi)
+    for (uint8_t i = 0; i < boxCount(); i++) {
+        reportBoxStatus(boxIdAt(i), STATUS_AVAILABLE, false);
     }
     
+    // Các công việc định kỳ chạy trên scheduler
+    schedulerEvery(MQTT_RECONNECT_INTERVAL, mqttReconnectTask, "mqtt-reconnect");
+    schedulerEvery(WIFI_POLL_INTERVAL, wifiCheckTask, "wifi-check");
+    schedulerEvery(TELEMETRY_SAMPLE_INTERVAL, telemetryTask, "telemetry");
+    schedulerEvery(BACKEND_POOL_CHECK_INTERVAL, backendPoolTask, "backend-pool");
+    schedulerEvery(HEAP_SAMPLE_INTERVAL, heapSampleTask, "heap-sample");
+    schedulerEvery(PIN_CACHE_MAINTAIN_INTERVAL, pinCacheTask, "pin-cache");
+    schedulerEvery(STALL_REPORT_INTERVAL, stallReportTask, "stall-report");
+    schedulerEvery(JOURNAL_MAINTAIN_INTERVAL, journalTask, "journal");
+    
     Serial.println("========================================");
     Serial.println("   Setup completed!");
     Serial.println("========================================\n");
 }
 
-void loop() {
-    unsigned long currentMillis = millis();
+/**
+ * Một vòng của phần mạng; bản build một lõi xử lý cả nút nhấn ở đây
+ */
+void loopNetwork() {
+    uint32_t loopStart = micros();
+    uint32_t stageStart = loopStart;
     
     // Xử lý HTTP requests
+    stallArm("http_server");
     server.handleClient();
-    
-    // Xử lý MQTT
+    stallDisarm();
+    metricsRecord(STAGE_HTTP_SERVER, micros() - stageStart);
+    
+    // Đọc phản hồi backend cho các request bất đồng bộ
+    stageStart = micros();
+    stallArm("async_http");
+    asyncHttpLoop();
+    stallDisarm();
+    metricsRecord(STAGE_ASYNC_HTTP, micros() - stageStart);
+    
+    // Gửi tiếp các response PROGMEM (trang kiosk) theo từng khối
+    stageStart = micros();
+    stallArm("stream");
+    progmemStreamLoop();
+    stallDisarm();
+    metricsRecord(STAGE_STREAM, micros() - stageStart);
+    
+    // Gửi nền các trạng thái box đang chờ trong outbox
+    stageStart = micros();
+    stallArm("outbox");
+    statusOutboxLoop();
+    stallDisarm();
+    metricsRecord(STAGE_OUTBOX, micros() - stageStart);
+    
+    // Xử lý MQTT (reconnect do mqttReconnectTask đảm nhiệm)
     if (mqttClient.connected()) {
+        stageStart = micros();
+        markMqttReceive();
+        stallArm("mqtt");
         mqttClient.loop();
-    } else if (currentMillis - lastMqttReconnect >= MQTT_RECONNECT_INTERVAL) {
-        lastMqttReconnect = currentMillis;
-        Serial.println("[MQTT] Reconnecting...");
-        connectMQTT();
+        stallDisarm();
+        metricsRecord(STAGE_MQTT, micros() - stageStart);
     }
     
-    // Xử lý nút nhấn
-    handleButton();
-    
-    // Kiểm tra auto-lock
-    isUnlocked();
-    
-    // Kiểm tra kết nối WiFi định kỳ
-    if (currentMillis - lastWiFiCheck >= WIFI_RECONNECT_INTERVAL) {
-        lastWiFiCheck = currentMillis;
-        checkWiFiConnection();
-    }
+#if LOCKER_DUAL_CORE
+    // Kết quả lệnh, journal và trạng thái box từ task actuation
+    stallArm("core-events");
+    actuatorEventsPoll();
+    stallDisarm();
+#else
+    // Xử lý sự kiện nút nhấn từ hàng đợi ngắt
+    stallArm("input");
+    inputEventsPoll();
+    stallDisarm();
+#endif
+    
+    // Chạy các task tới hạn: auto-lock, kiểm tra WiFi, status report, reconnect MQTT
+    schedulerRun();
+    metricsRecord(STAGE_LOOP, micros() - loopStart);
+    
+    // Ngủ tới deadline kế tiếp hoặc khi có I/O, thay cho delay(10) cố định
+    schedulerIdle(ioReady);
+}
+
+#if LOCKER_DUAL_CORE
+/**
+ * Một vòng của task actuation: lệnh từ lõi mạng, nút nhấn, cửa, auto-lock
+ * Không có stage mạng nào nên độ trễ chỉ phụ thuộc ACTUATION_POLL_MS
+ */
+void loopActuation() {
+    actuatorRun();
+    inputEventsPoll();
+    schedulerRun();
+    
+    if (inputEventsPending()) return;
+    uint32_t wait = schedulerTimeToNext();
+    actuatorIdle(wait < ACTUATION_POLL_MS ? wait : ACTUATION_POLL_MS);
+}
+#endif
+
+// ============================================
+// Main Functions
+// ============================================
+
+void setup() {
+    // Khởi tạo Serial
+    Serial.begin(115200);
+    delay(1000);
     
-    // Gửi status report định kỳ
-    if (currentMillis - lastStatusReport >= STATUS_REPORT_INTERVAL) {
-        lastStatusReport = currentMillis;
-        BoxStatus status = isUnlocked() ? STATUS_OCCUPIED : STATUS_AVAILABLE;
-        reportBoxStatus(status, isUnlocked());
-    }
+    Serial.println("\n");
+    Serial.println("========================================");
+    Serial.println("   ESP8266 Laundry Locker Controller");
+    Serial.println("========================================");
+    Serial.printf("Device ID: %s\n", DEVICE_ID);
+    Serial.printf("Box ID: %d (%d box)\n", BOX_ID, BOX_COUNT);
+    Serial.println("----------------------------------------");
     
-    // Nhỏ delay để không chiếm hết CPU
-    delay(10);
+    initHeapMonitor();
+    initStallWatchdog();
+    initScheduler();
+    
+#if LOCKER_DUAL_CORE
+    // Relay/input và mạng chạy trên hai task ghim hai lõi (dual_core.h)
+    dualCoreStart(setupActuation, loopActuation, setupNetwork, loopNetwork);
+#else
+    setupActuation();
+    setupNetwork();
+#endif
+}
+
+void loop() {
+#if LOCKER_DUAL_CORE
+    // Mọi công việc chạy trong task actuation và task mạng
+    vTaskDelete(nullptr);
+#else
+    loopNetwork();
+#endif
 }
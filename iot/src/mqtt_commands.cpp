@@ -0,0 +1,393 @@
+/**
+ * MQTT Commands Implementation
+ *
+ * deserializeJson/deserializeMsgPack(doc, payload, length) với payload không
+ * const chạy ở chế độ zero-copy: chuỗi trong doc trỏ thẳng vào buffer của
+ * PubSubClient, doc chỉ giữ các slot nên StaticJsonDocument tĩnh vài trăm
+ * byte là đủ. Hai định dạng cho ra cùng một doc, phần xử lý lệnh dùng chung.
+ *
+ * publish() của PubSubClient ghi đè chính buffer đó, vì vậy bản tin trả lời
+ * (có thể trỏ tới cmd_id trong payload) phải được serialize vào _reply trước
+ * khi gọi _publish(); sau đó không đọc doc nữa.
+ *
+ * Bản build hai lõi: OPEN/LOCK chỉ được trả lời khi lõi actuation báo relay
+ * đã ghi (replyActuated), nên cmd_id được chép ra khỏi payload trước.
+ *
+ * Log dùng Serial.print từng phần cho chuỗi lấy từ payload: Print::printf
+ * của core cấp phát heap khi dòng dài hơn 64 byte.
+ */
+
+#include "mqtt_commands.h"
+#include "config.h"
+#include "locker_controller.h"
+#include "pin_cache.h"
+#include "command_dedup.h"
+#include "heap_monitor.h"
+#include "dual_core.h"
+#include <ArduinoJson.h>
+#include <sys/time.h>
+
+// ============================================
+// Buffers
+// ============================================
+// box_id, action, cmd_id, seq, order_id, salt, hash, ttl + dự phòng
+#define COMMAND_DOC_SIZE JSON_OBJECT_SIZE(10)
+// box_id, status, device, cmd_id, seq, duplicate / order_id, trace{ts, rx, cb, relay, pub}
+#define REPLY_DOC_SIZE (JSON_OBJECT_SIZE(7) + JSON_OBJECT_SIZE(5))
+// Bản tin dài nhất: trả lời lệnh có cmd_id tối đa và trace (~280 byte JSON)
+#define REPLY_SIZE 320
+
+static StaticJsonDocument<COMMAND_DOC_SIZE> _doc;
+static StaticJsonDocument<REPLY_DOC_SIZE> _replyDoc;
+static uint8_t _reply[REPLY_SIZE];
+static StatusPublisher _publish = nullptr;
+static WireFormat _format = WIRE_JSON;
+
+static uint32_t _rxUs = 0;  // micros() lúc mqttClient.loop() bắt đầu đọc gói
+
+static uint32_t _jsonCommands = 0;
+static uint32_t _msgpackCommands = 0;
+static uint32_t _parseErrors = 0;
+
+// ============================================
+// Latency Trace
+// ============================================
+
+/**
+ * Mốc thời gian của một lệnh OPEN/LOCK; các mốc µs tính từ rx
+ */
+struct CommandTrace {
+    uint64_t sentMs;        // "ts" backend gửi kèm lệnh (epoch ms), 0 = không có
+    uint64_t rxMs;          // Epoch ms lúc rx, 0 = chưa đồng bộ NTP
+    uint32_t callbackUs;    // Vào callback: PubSubClient đã đọc xong gói
+    uint32_t relayUs;       // Relay đã được ghi
+    uint32_t rxUs;          // micros() lúc rx (gốc của các mốc, dùng cho "pub")
+};
+
+/**
+ * Đổi mốc micros() sang epoch ms theo giờ NTP (0 nếu chưa đồng bộ)
+ */
+static uint64_t epochMsAt(uint32_t us) {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    if (tv.tv_sec < NTP_VALID_AFTER) return 0;
+    uint64_t nowMs = (uint64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+    return nowMs - (micros() - us) / 1000;
+}
+
+/**
+ * Ghi các mốc của lệnh vừa thực hiện (đọc "ts" trước khi doc bị ghi đè)
+ * @return nullptr nếu tắt TRACE_COMMANDS
+ */
+static const CommandTrace* traceCommand(CommandTrace& trace, uint32_t callbackUs) {
+#if TRACE_COMMANDS
+    trace.sentMs = _doc["ts"] | (uint64_t)0;
+    trace.rxMs = epochMsAt(_rxUs);
+    trace.callbackUs = callbackUs - _rxUs;
+    trace.relayUs = lastRelayWriteUs() - _rxUs;
+    trace.rxUs = _rxUs;
+    return &trace;
+#else
+    return nullptr;
+#endif
+}
+
+// ============================================
+// Reply Encoding
+// ============================================
+
+/**
+ * Serialize bản tin vào buffer theo _format rồi publish lên status topic
+ * tương ứng. Chuỗi trong bản tin được giữ dạng con trỏ (không chép)
+ */
+static size_t publishEncoded(JsonVariantConst status, uint8_t* buffer, size_t size) {
+    const char* topic = MQTT_TOPIC_STATUS;
+    size_t length;
+#if MQTT_MSGPACK_ENABLED
+    if (_format == WIRE_MSGPACK) {
+        topic = MQTT_TOPIC_STATUS_MSGPACK;
+        if (measureMsgPack(status) > size) length = 0;
+        else length = serializeMsgPack(status, buffer, size);
+    } else
+#endif
+    {
+        if (measureJson(status) >= size) length = 0;
+        else length = serializeJson(status, (char*)buffer, size);
+    }
+    if (length == 0) {
+        Serial.println("[MQTT] Status message too large, dropped");
+        return 0;
+    }
+    return _publish(topic, buffer, length) ? length : 0;
+}
+
+/**
+ * Dựng bản tin trạng thái trả lời lệnh vào _replyDoc
+ * {"box_id":1,"status":"UNLOCKED","device":"...","cmd_id":"...","seq":7,"duplicate":true,
+ *  "trace":{"ts":...,"rx":...,"cb":180,"relay":2450,"pub":2610}}
+ * Mốc "pub" được lấy ngay trước khi serialize và publish
+ */
+static JsonVariantConst formatStatus(int boxId, const char* status, const char* cmdId, uint32_t seq, bool duplicate,
+                                     const CommandTrace* trace = nullptr) {
+    _replyDoc.clear();
+    _replyDoc["box_id"] = boxId;
+    _replyDoc["status"] = status;
+    _replyDoc["device"] = DEVICE_ID;
+    if (*cmdId) _replyDoc["cmd_id"] = cmdId;
+    if (seq) _replyDoc["seq"] = seq;
+    if (duplicate) _replyDoc["duplicate"] = true;
+    if (trace) {
+        JsonObject t = _replyDoc.createNestedObject("trace");
+        if (trace->sentMs) t["ts"] = trace->sentMs;
+        if (trace->rxMs) t["rx"] = trace->rxMs;
+        t["cb"] = trace->callbackUs;
+        t["relay"] = trace->relayUs;
+        t["pub"] = micros() - trace->rxUs;
+    }
+    return _replyDoc.as<JsonVariantConst>();
+}
+
+#if LOCKER_DUAL_CORE
+// ============================================
+// Deferred Replies
+// ============================================
+
+/**
+ * Lệnh OPEN/LOCK đang chờ lõi actuation ghi relay
+ */
+struct PendingReply {
+    bool used;
+    const char* status;
+    char cmdId[CMD_ID_MAX_LEN + 1];     // Chép: payload bị ghi đè bởi gói kế tiếp
+    uint32_t seq;
+    bool traced;
+    CommandTrace trace;
+};
+
+static PendingReply _pending[ACTUATOR_QUEUE_SIZE];
+
+/**
+ * Callback trên lõi mạng: relay đã ghi, trả lời với mốc relay thật
+ */
+static void replyActuated(int boxId, ActuatorAction action, bool ok, uint32_t relayUs, void* ctx) {
+    (void)action;
+    (void)ok;
+    PendingReply& reply = *(PendingReply*)ctx;
+    reply.trace.relayUs = relayUs - reply.trace.rxUs;
+    publishStatusDoc(formatStatus(boxId, reply.status, reply.cmdId, reply.seq, false,
+                                  reply.traced ? &reply.trace : nullptr));
+    reply.used = false;
+}
+
+/**
+ * Gửi lệnh sang lõi actuation; hết chỗ (lõi actuation treo) thì trả lời BUSY
+ * và quên cmd_id để backend retry được thực hiện, không chỉ được ACK
+ */
+static void submitCommand(ActuatorAction action, int boxId, const char* status, const char* cmdId, uint32_t seq,
+                          uint32_t callbackUs) {
+    for (PendingReply& reply : _pending) {
+        if (reply.used) continue;
+
+        reply.status = status;
+        strncpy(reply.cmdId, cmdId, CMD_ID_MAX_LEN);
+        reply.cmdId[CMD_ID_MAX_LEN] = '\0';
+        reply.seq = seq;
+        reply.traced = traceCommand(reply.trace, callbackUs) != nullptr;
+        reply.trace.rxUs = _rxUs;
+        if (actuatorSubmit(action, boxId, replyActuated, &reply)) {
+            reply.used = true;
+            return;
+        }
+        break;
+    }
+    Serial.printf("[MQTT] Actuator busy, box %d not actuated\n", boxId);
+    commandForget(cmdId, seq);
+    publishStatusDoc(formatStatus(boxId, "BUSY", cmdId, seq, false));
+}
+#endif
+
+// ============================================
+// Helper Functions
+// ============================================
+
+/**
+ * Lệnh trên topic /mp là MessagePack. Byte đầu '{' (0x7B) là số nguyên dương
+ * trong MessagePack, không thể là lệnh hợp lệ (map) nên được hiểu là công cụ
+ * cũ gửi JSON lên topic /mp: xử lý và trả lời dạng JSON
+ */
+static WireFormat commandFormat(const char* topic, const uint8_t* payload, unsigned int length) {
+#if MQTT_MSGPACK_ENABLED
+    size_t topicLen = strlen(topic);
+    size_t suffixLen = sizeof(MQTT_MSGPACK_SUFFIX) - 1;
+    bool binaryTopic = topicLen > suffixLen && strcmp(topic + topicLen - suffixLen, MQTT_MSGPACK_SUFFIX) == 0;
+    if (binaryTopic && !(length > 0 && payload[0] == '{')) return WIRE_MSGPACK;
+#endif
+    return WIRE_JSON;
+}
+
+/**
+ * cmd_id được trả lại nguyên vẹn trong bản tin trả lời nên chỉ nhận ký tự
+ * an toàn trong JSON và topic log: chữ, số và - _ . :
+ */
+static bool isValidCommandId(const char* cmdId) {
+    size_t len = 0;
+    for (const char* p = cmdId; *p; p++, len++) {
+        char c = *p;
+        bool ok = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+            || c == '-' || c == '_' || c == '.' || c == ':';
+        if (!ok || len >= CMD_ID_MAX_LEN) return false;
+    }
+    return true;
+}
+
+static void logPayload(const char* topic, const uint8_t* payload, unsigned int length, WireFormat format) {
+    Serial.print("[MQTT] Message on [");
+    Serial.print(topic);
+    Serial.print("]: ");
+    if (format == WIRE_MSGPACK) {
+        // Nhị phân: chỉ in kích thước, nội dung in dạng JSON sau khi parse
+        Serial.print(length);
+        Serial.println(" bytes msgpack");
+        return;
+    }
+    Serial.write(payload, length);
+    Serial.println();
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initMqttCommands(StatusPublisher publisher) {
+    _publish = publisher;
+}
+
+void markMqttReceive() {
+    _rxUs = micros();
+}
+
+void handleMqttCommand(const char* topic, uint8_t* payload, unsigned int length) {
+    uint32_t callbackUs = micros();
+    HeapScope heapScope("mqtt:command");
+
+    WireFormat format = commandFormat(topic, payload, length);
+
+    // In trước khi parse: parse zero-copy sửa payload tại chỗ
+    logPayload(topic, payload, length, format);
+
+    DeserializationError err = format == WIRE_MSGPACK
+        ? deserializeMsgPack(_doc, payload, length)
+        : deserializeJson(_doc, payload, length);
+    if (err) {
+        _parseErrors++;
+        Serial.printf("[MQTT] %s parse error: %s\n", format == WIRE_MSGPACK ? "MsgPack" : "JSON", err.c_str());
+        return;
+    }
+
+    if (format == WIRE_MSGPACK) {
+        _msgpackCommands++;
+        Serial.print("[MQTT] Decoded: ");
+        serializeJson(_doc, Serial);
+        Serial.println();
+    } else {
+        _jsonCommands++;
+    }
+
+    // Backend trả lời và nhận trạng thái theo định dạng của lệnh gần nhất
+    if (format != _format) {
+        Serial.printf("[MQTT] Wire format: %s\n", wireFormatName(format));
+        _format = format;
+    }
+
+    int cmdBoxId = _doc["box_id"] | -1;
+    const char* action = _doc["action"] | "";
+    const char* cmdId = _doc["cmd_id"] | "";
+    uint32_t seq = _doc["seq"] | 0UL;
+
+    // Kiểm tra box_id có thuộc bảng box của thiết bị này không
+    if (!isValidBox(cmdBoxId)) {
+        Serial.printf("[MQTT] Ignored: box_id %d not in %d..%d\n", cmdBoxId, BOX_ID, BOX_ID + boxCount() - 1);
+        return;
+    }
+
+    if (!isValidCommandId(cmdId)) {
+        Serial.println("[MQTT] Ignored: invalid cmd_id");
+        return;
+    }
+
+    // Broker gửi lại / backend retry: xác nhận, không mở relay lần nữa
+    if (commandSeen(cmdId, seq)) {
+        Serial.print("[MQTT] Duplicate command, ack only: ");
+        Serial.println(*cmdId ? cmdId : "(seq)");
+        publishStatusDoc(formatStatus(cmdBoxId, "ACK", cmdId, seq, true));
+        return;
+    }
+
+    if (strcmp(action, "OPEN") == 0) {
+        Serial.printf("[MQTT] >>> OPEN command received! Unlocking box %d...\n", cmdBoxId);
+#if LOCKER_DUAL_CORE
+        submitCommand(ACTUATOR_UNLOCK, cmdBoxId, "UNLOCKED", cmdId, seq, callbackUs);
+#else
+        unlockBox(cmdBoxId);
+
+        // Publish status update
+        CommandTrace trace;
+        publishStatusDoc(formatStatus(cmdBoxId, "UNLOCKED", cmdId, seq, false, traceCommand(trace, callbackUs)));
+#endif
+
+    } else if (strcmp(action, "LOCK") == 0) {
+        Serial.printf("[MQTT] >>> LOCK command received! Locking box %d...\n", cmdBoxId);
+#if LOCKER_DUAL_CORE
+        submitCommand(ACTUATOR_LOCK, cmdBoxId, "LOCKED", cmdId, seq, callbackUs);
+#else
+        lockBox(cmdBoxId);
+
+        CommandTrace trace;
+        publishStatusDoc(formatStatus(cmdBoxId, "LOCKED", cmdId, seq, false, traceCommand(trace, callbackUs)));
+#endif
+
+    } else if (strcmp(action, "PIN_PROVISION") == 0) {
+        // PIN backend gửi trước để kiosk xác thực cục bộ
+        uint32_t orderId = _doc["order_id"] | 0UL;
+        uint32_t ttl = _doc["ttl"] | 0UL;
+        pinCacheProvision(cmdBoxId, orderId, _doc["salt"] | "", _doc["hash"] | "", ttl);
+        if (*cmdId || seq) publishStatusDoc(formatStatus(cmdBoxId, "ACK", cmdId, seq, false));
+
+    } else if (strcmp(action, "PIN_REVOKE") == 0) {
+        uint32_t orderId = _doc["order_id"] | 0UL;
+        pinCacheRevoke(orderId);
+        if (*cmdId || seq) publishStatusDoc(formatStatus(cmdBoxId, "ACK", cmdId, seq, false));
+
+    } else {
+        Serial.print("[MQTT] Unknown action: ");
+        Serial.println(action);
+    }
+}
+
+bool publishStatusDoc(JsonVariantConst status) {
+    return publishEncoded(status, _reply, sizeof(_reply)) > 0;
+}
+
+size_t publishStatusBatch(JsonVariantConst status, uint8_t* buffer, size_t size) {
+    return publishEncoded(status, buffer, size);
+}
+
+bool publishPinUsed(int boxId, uint32_t orderId) {
+    _replyDoc.clear();
+    _replyDoc["box_id"] = boxId;
+    _replyDoc["status"] = "PIN_USED";
+    _replyDoc["order_id"] = orderId;
+    _replyDoc["device"] = DEVICE_ID;
+    return publishStatusDoc(_replyDoc.as<JsonVariantConst>());
+}
+
+void mqttCommandsGetStats(MqttCommandStats& stats) {
+    stats.format = _format;
+    stats.jsonCommands = _jsonCommands;
+    stats.msgpackCommands = _msgpackCommands;
+    stats.parseErrors = _parseErrors;
+}
+
+const char* wireFormatName(WireFormat format) {
+    return format == WIRE_MSGPACK ? "msgpack" : "json";
+}
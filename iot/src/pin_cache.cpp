@@ -0,0 +1,210 @@
+/**
+ * PIN Cache Implementation
+ *
+ * Bảng cố định PIN_CACHE_SIZE bản ghi. Khi so khớp, PIN được băm với salt
+ * của MỌI bản ghi (kể cả ô trống) và so sánh đủ 32 byte bằng XOR tích luỹ,
+ * nên thời gian không phụ thuộc PIN đúng/sai hay khớp ở bản ghi nào.
+ * Bản ghi đã dùng được giữ lại tới khi báo được cho backend để PIN không
+ * thể dùng lần nữa trong lúc mất kết nối.
+ */
+
+#include "pin_cache.h"
+#include "config.h"
+#include "platform.h"
+
+// ============================================
+// Cache Entries
+// ============================================
+#define PIN_HASH_SIZE 32  // SHA-256
+
+enum PinEntryState {
+    PIN_ENTRY_FREE,
+    PIN_ENTRY_ACTIVE,       // Chờ dùng
+    PIN_ENTRY_USED          // Đã mở khóa, chờ báo backend
+};
+
+struct PinEntry {
+    uint8_t state;
+    int boxId;
+    uint32_t orderId;
+    uint32_t expiresAt;     // millis()
+    uint8_t salt[PIN_SALT_SIZE];
+    uint8_t hash[PIN_HASH_SIZE];
+};
+
+static PinEntry _entries[PIN_CACHE_SIZE];
+static PinUsedReporter _reporter = nullptr;
+
+static uint32_t _provisioned = 0;
+static uint32_t _hits = 0;
+static uint32_t _misses = 0;
+static uint32_t _expired = 0;
+static uint32_t _lastVerifyUs = 0;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static bool parseHex(const char* hex, uint8_t* out, size_t length) {
+    if (!hex || strlen(hex) != length * 2) return false;
+    for (size_t i = 0; i < length * 2; i++) {
+        char c = hex[i];
+        uint8_t nibble;
+        if (c >= '0' && c <= '9') nibble = c - '0';
+        else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
+        else return false;
+        out[i / 2] = (i % 2) ? (out[i / 2] | nibble) : (nibble << 4);
+    }
+    return true;
+}
+
+static void pinHash(const uint8_t* salt, const char* pinCode, uint8_t* digest) {
+    PlatformSha256 ctx;
+    platformSha256Init(&ctx);
+    platformSha256Update(&ctx, salt, PIN_SALT_SIZE);
+    platformSha256Update(&ctx, pinCode, strlen(pinCode));
+    platformSha256Out(&ctx, digest);
+}
+
+static bool isExpired(const PinEntry& entry, uint32_t now) {
+    return (int32_t)(now - entry.expiresAt) >= 0;
+}
+
+static void freeEntry(PinEntry& entry) {
+    memset(&entry, 0, sizeof(entry));
+}
+
+/**
+ * Báo PIN đã dùng; thành công thì giải phóng bản ghi
+ */
+static void reportUsed(PinEntry& entry) {
+    if (!_reporter || !_reporter(entry.boxId, entry.orderId)) return;
+    Serial.printf("[PIN] Reported order %lu used\n", (unsigned long)entry.orderId);
+    freeEntry(entry);
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initPinCache(PinUsedReporter reporter) {
+    _reporter = reporter;
+    for (uint8_t i = 0; i < PIN_CACHE_SIZE; i++) {
+        freeEntry(_entries[i]);
+    }
+}
+
+bool pinCacheProvision(int boxId, uint32_t orderId, const char* saltHex, const char* hashHex, uint32_t ttlSec) {
+    PinEntry entry;
+    if (!parseHex(saltHex, entry.salt, PIN_SALT_SIZE) || !parseHex(hashHex, entry.hash, PIN_HASH_SIZE)) {
+        Serial.printf("[PIN] Bad salt/hash for order %lu\n", (unsigned long)orderId);
+        return false;
+    }
+    if (ttlSec == 0 || ttlSec > PIN_CACHE_MAX_TTL) ttlSec = PIN_CACHE_MAX_TTL;
+
+    // Cùng đơn thì thay bản ghi cũ, nếu không lấy ô trống
+    PinEntry* slot = nullptr;
+    for (uint8_t i = 0; i < PIN_CACHE_SIZE; i++) {
+        if (_entries[i].state != PIN_ENTRY_FREE && _entries[i].orderId == orderId) {
+            slot = &_entries[i];
+            break;
+        }
+        if (!slot && _entries[i].state == PIN_ENTRY_FREE) slot = &_entries[i];
+    }
+    if (!slot) {
+        Serial.printf("[PIN] Cache full, order %lu stays online-only\n", (unsigned long)orderId);
+        return false;
+    }
+    if (slot->state == PIN_ENTRY_USED) {
+        // Đã mở khóa bằng PIN này, bỏ qua bản gửi lại
+        return true;
+    }
+
+    entry.state = PIN_ENTRY_ACTIVE;
+    entry.boxId = boxId;
+    entry.orderId = orderId;
+    entry.expiresAt = millis() + ttlSec * 1000UL;
+    *slot = entry;
+    _provisioned++;
+
+    Serial.printf("[PIN] Provisioned order %lu for box %d (%lus)\n", (unsigned long)orderId, boxId, (unsigned long)ttlSec);
+    return true;
+}
+
+bool pinCacheRevoke(uint32_t orderId) {
+    for (uint8_t i = 0; i < PIN_CACHE_SIZE; i++) {
+        if (_entries[i].state == PIN_ENTRY_ACTIVE && _entries[i].orderId == orderId) {
+            freeEntry(_entries[i]);
+            Serial.printf("[PIN] Revoked order %lu\n", (unsigned long)orderId);
+            return true;
+        }
+    }
+    return false;
+}
+
+PinCacheResult pinCacheVerify(int boxId, const char* pinCode, uint32_t& orderId) {
+    uint32_t start = micros();
+    uint32_t now = millis();
+    int8_t match = -1;
+
+    for (uint8_t i = 0; i < PIN_CACHE_SIZE; i++) {
+        PinEntry& entry = _entries[i];
+        uint8_t digest[PIN_HASH_SIZE];
+        pinHash(entry.salt, pinCode, digest);
+
+        uint8_t diff = 0;
+        for (uint8_t b = 0; b < PIN_HASH_SIZE; b++) {
+            diff |= digest[b] ^ entry.hash[b];
+        }
+
+        bool candidate = entry.state == PIN_ENTRY_USED
+            || (entry.state == PIN_ENTRY_ACTIVE && !isExpired(entry, now));
+        if ((diff == 0) & candidate & (entry.boxId == boxId)) match = i;
+    }
+    _lastVerifyUs = micros() - start;
+
+    if (match < 0) {
+        _misses++;
+        return PIN_CACHE_MISS;
+    }
+
+    PinEntry& entry = _entries[match];
+    orderId = entry.orderId;
+    if (entry.state == PIN_ENTRY_USED) return PIN_CACHE_USED;
+
+    entry.state = PIN_ENTRY_USED;
+    _hits++;
+    Serial.printf("[PIN] Local match: order %lu box %d in %lu us\n",
+                  (unsigned long)orderId, boxId, (unsigned long)_lastVerifyUs);
+    reportUsed(entry);
+    return PIN_CACHE_HIT;
+}
+
+void pinCacheMaintain() {
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < PIN_CACHE_SIZE; i++) {
+        PinEntry& entry = _entries[i];
+        if (entry.state == PIN_ENTRY_USED) {
+            reportUsed(entry);
+        } else if (entry.state == PIN_ENTRY_ACTIVE && isExpired(entry, now)) {
+            Serial.printf("[PIN] Order %lu expired\n", (unsigned long)entry.orderId);
+            freeEntry(entry);
+            _expired++;
+        }
+    }
+}
+
+void pinCacheGetStats(PinCacheStats& stats) {
+    stats.entries = 0;
+    stats.unreported = 0;
+    for (uint8_t i = 0; i < PIN_CACHE_SIZE; i++) {
+        if (_entries[i].state == PIN_ENTRY_ACTIVE) stats.entries++;
+        if (_entries[i].state == PIN_ENTRY_USED) stats.unreported++;
+    }
+    stats.provisioned = _provisioned;
+    stats.hits = _hits;
+    stats.misses = _misses;
+    stats.expired = _expired;
+    stats.lastVerifyUs = _lastVerifyUs;
+}
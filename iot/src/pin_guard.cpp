@@ -0,0 +1,207 @@
+/**
+ * PIN Guard Implementation
+ *
+ * Negative cache chỉ giữ khóa băm 32 bit của (box, PIN), không giữ PIN.
+ * Bucket theo IP nằm trong bảng nhỏ; IP mới thay bucket đầy token nhất
+ * (IP ít nhập sai nhất) nên kẻ dò PIN không xoá được bucket của chính mình
+ * bằng cách chiếm chỗ.
+ */
+
+#include "pin_guard.h"
+#include "config.h"
+
+// ============================================
+// State
+// ============================================
+struct RejectedPin {
+    uint32_t key;           // 0 = ô trống
+    uint32_t expiresAt;     // millis()
+};
+
+struct TokenBucket {
+    uint32_t ip;            // Chỉ dùng cho bucket theo IP, 0 = ô trống
+    uint8_t tokens;
+    uint32_t lastRefill;
+};
+
+static RejectedPin _rejected[PIN_NEG_CACHE_SIZE];
+static TokenBucket _sources[PIN_RATE_MAX_SOURCES];
+static TokenBucket _boxes[BOX_COUNT];
+
+static uint32_t _negativeHits = 0;
+static uint32_t _limited = 0;
+static uint32_t _failures = 0;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+/**
+ * FNV-1a của (boxId, PIN)
+ */
+static uint32_t pinKey(int boxId, const char* pinCode) {
+    uint32_t hash = 2166136261UL;
+    const uint8_t* id = (const uint8_t*)&boxId;
+    for (size_t i = 0; i < sizeof(boxId); i++) {
+        hash = (hash ^ id[i]) * 16777619UL;
+    }
+    for (const char* p = pinCode; *p; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619UL;
+    }
+    return hash ? hash : 1;
+}
+
+static bool isExpired(uint32_t expiresAt, uint32_t now) {
+    return (int32_t)(now - expiresAt) >= 0;
+}
+
+static void refill(TokenBucket& bucket, uint8_t burst, uint32_t refillMs, uint32_t now) {
+    uint32_t earned = (now - bucket.lastRefill) / refillMs;
+    if (earned == 0) return;
+    if (bucket.tokens + earned >= burst) {
+        bucket.tokens = burst;
+        bucket.lastRefill = now;
+    } else {
+        bucket.tokens += earned;
+        bucket.lastRefill += earned * refillMs;
+    }
+}
+
+/**
+ * Giây còn lại tới khi bucket rỗng có lại một token
+ */
+static uint32_t retryAfter(const TokenBucket& bucket, uint32_t refillMs, uint32_t now) {
+    uint32_t waitMs = refillMs - (now - bucket.lastRefill);
+    return (waitMs + 999) / 1000;
+}
+
+/**
+ * Bucket của IP nguồn; create = true thì cấp mới nếu chưa có
+ */
+static TokenBucket* sourceBucket(uint32_t ip, bool create, uint32_t now) {
+    TokenBucket* victim = nullptr;
+    for (uint8_t i = 0; i < PIN_RATE_MAX_SOURCES; i++) {
+        TokenBucket& bucket = _sources[i];
+        if (bucket.ip == ip) {
+            refill(bucket, PIN_RATE_SOURCE_BURST, PIN_RATE_SOURCE_REFILL_MS, now);
+            return &bucket;
+        }
+        if (bucket.ip == 0) {
+            if (!victim || victim->ip != 0) victim = &bucket;
+            continue;
+        }
+        refill(bucket, PIN_RATE_SOURCE_BURST, PIN_RATE_SOURCE_REFILL_MS, now);
+        if (!victim || (victim->ip != 0 && bucket.tokens > victim->tokens)) victim = &bucket;
+    }
+    if (!create) return nullptr;
+
+    victim->ip = ip;
+    victim->tokens = PIN_RATE_SOURCE_BURST;
+    victim->lastRefill = now;
+    return victim;
+}
+
+static TokenBucket& boxBucket(int boxId, uint32_t now) {
+    TokenBucket& bucket = _boxes[boxId - BOX_ID];
+    refill(bucket, PIN_RATE_BOX_BURST, PIN_RATE_BOX_REFILL_MS, now);
+    return bucket;
+}
+
+/**
+ * Trừ một token ở bucket IP và bucket box
+ */
+static void chargeFailure(IPAddress source, int boxId, uint32_t now) {
+    _failures++;
+    TokenBucket* src = sourceBucket(source.v4(), true, now);
+    if (src->tokens > 0) src->tokens--;
+    TokenBucket& box = boxBucket(boxId, now);
+    if (box.tokens > 0) box.tokens--;
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initPinGuard() {
+    memset(_rejected, 0, sizeof(_rejected));
+    memset(_sources, 0, sizeof(_sources));
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < BOX_COUNT; i++) {
+        _boxes[i].ip = 0;
+        _boxes[i].tokens = PIN_RATE_BOX_BURST;
+        _boxes[i].lastRefill = now;
+    }
+}
+
+bool pinGuardLimited(IPAddress source, int boxId, uint32_t& retryAfterSec) {
+    uint32_t now = millis();
+
+    // Token bucket: IP nguồn hoặc box đã hết lượt nhập sai
+    retryAfterSec = 0;
+    TokenBucket* src = sourceBucket(source.v4(), false, now);
+    if (src && src->tokens == 0) {
+        retryAfterSec = retryAfter(*src, PIN_RATE_SOURCE_REFILL_MS, now);
+    }
+    TokenBucket& box = boxBucket(boxId, now);
+    if (box.tokens == 0) {
+        uint32_t boxWait = retryAfter(box, PIN_RATE_BOX_REFILL_MS, now);
+        if (boxWait > retryAfterSec) retryAfterSec = boxWait;
+    }
+    if (retryAfterSec > 0) {
+        _limited++;
+        Serial.printf("[GUARD] %s box %d limited, retry in %lus\n",
+                      source.toString().c_str(), boxId, (unsigned long)retryAfterSec);
+        return true;
+    }
+    return false;
+}
+
+PinGuardResult pinGuardCheck(IPAddress source, int boxId, const char* pinCode, uint32_t& retryAfterSec) {
+    if (pinGuardLimited(source, boxId, retryAfterSec)) return PIN_GUARD_LIMITED;
+
+    // Negative cache: PIN vừa bị từ chối cho box này
+    uint32_t now = millis();
+    uint32_t key = pinKey(boxId, pinCode);
+    for (uint8_t i = 0; i < PIN_NEG_CACHE_SIZE; i++) {
+        if (_rejected[i].key == key && !isExpired(_rejected[i].expiresAt, now)) {
+            _negativeHits++;
+            chargeFailure(source, boxId, now);
+            return PIN_GUARD_REJECTED;
+        }
+    }
+    return PIN_GUARD_ALLOW;
+}
+
+void pinGuardRecordFailure(IPAddress source, int boxId, const char* pinCode) {
+    uint32_t now = millis();
+    chargeFailure(source, boxId, now);
+
+    // Ghi vào ô trống/hết hạn, nếu không thì thay ô sắp hết hạn nhất
+    uint32_t key = pinKey(boxId, pinCode);
+    RejectedPin* slot = &_rejected[0];
+    for (uint8_t i = 0; i < PIN_NEG_CACHE_SIZE; i++) {
+        RejectedPin& entry = _rejected[i];
+        if (entry.key == key || entry.key == 0 || isExpired(entry.expiresAt, now)) {
+            slot = &entry;
+            break;
+        }
+        if ((int32_t)(entry.expiresAt - slot->expiresAt) < 0) slot = &entry;
+    }
+    slot->key = key;
+    slot->expiresAt = now + PIN_NEG_CACHE_TTL;
+}
+
+void pinGuardGetStats(PinGuardStats& stats) {
+    uint32_t now = millis();
+    stats.rejectedPins = 0;
+    for (uint8_t i = 0; i < PIN_NEG_CACHE_SIZE; i++) {
+        if (_rejected[i].key != 0 && !isExpired(_rejected[i].expiresAt, now)) stats.rejectedPins++;
+    }
+    stats.sources = 0;
+    for (uint8_t i = 0; i < PIN_RATE_MAX_SOURCES; i++) {
+        if (_sources[i].ip != 0) stats.sources++;
+    }
+    stats.negativeHits = _negativeHits;
+    stats.limited = _limited;
+    stats.failures = _failures;
+}
@@ -0,0 +1,31 @@
+/**
+ * Platform Implementation
+ *
+ * Phần không inline của lớp tương thích ESP8266 / ESP32 (xem platform.h)
+ */
+
+#include "platform.h"
+
+#if defined(ESP32)
+RTC_NOINIT_ATTR uint32_t platformRtcMemory[PLATFORM_RTC_BLOCKS];
+
+String platformResetReason() {
+    // Cùng tên với ESP.getResetReason() của ESP8266 để báo cáo stall không đổi
+    switch (esp_reset_reason()) {
+        case ESP_RST_POWERON: return "Power On";
+        case ESP_RST_EXT: return "External System";
+        case ESP_RST_SW: return "Software/System restart";
+        case ESP_RST_PANIC: return "Exception";
+        case ESP_RST_INT_WDT: return "Hardware Watchdog";
+        case ESP_RST_TASK_WDT: return "Software Watchdog";
+        case ESP_RST_WDT: return "Hardware Watchdog";
+        case ESP_RST_DEEPSLEEP: return "Deep-Sleep Wake";
+        case ESP_RST_BROWNOUT: return "Brownout";
+        default: return "Unknown";
+    }
+}
+#else
+String platformResetReason() {
+    return ESP.getResetReason();
+}
+#endif
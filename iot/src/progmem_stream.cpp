@@ -0,0 +1,149 @@
+/**
+ * PROGMEM Stream Implementation
+ *
+ * Mỗi slot giữ một bản sao WiFiClient của request (giống verify pipeline)
+ * nên socket vẫn mở sau khi handler trả về. Khối ghi được làm tròn xuống
+ * bội số 4 byte (trừ khối cuối) để mọi lần đọc flash đều căn 4 byte.
+ * Gửi xong chỉ bỏ tham chiếu tới socket: lwIP tự đóng (FIN) sau khi đẩy
+ * hết dữ liệu còn trong hàng đợi, không chờ như WiFiClient::stop().
+ */
+
+#include "progmem_stream.h"
+#include "config.h"
+
+// ============================================
+// Stream Slots
+// ============================================
+struct StreamSlot {
+    bool active;
+    WiFiClient client;
+    PGM_P data;
+    size_t length;
+    size_t sent;
+    uint32_t lastProgress;
+};
+
+static StreamSlot _slots[STREAM_MAX_CLIENTS];
+
+static uint32_t _started = 0;
+static uint32_t _completed = 0;
+static uint32_t _aborted = 0;
+static uint32_t _fallbacks = 0;
+static uint32_t _bytes = 0;
+static uint16_t _maxBlock = 0;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static void closeSlot(StreamSlot& slot, bool completed) {
+    if (completed) {
+        _completed++;
+    } else {
+        _aborted++;
+        Serial.printf("[STREAM] Aborted after %u/%u bytes\n", (unsigned)slot.sent, (unsigned)slot.length);
+    }
+    slot.client = WiFiClient();
+    slot.active = false;
+}
+
+/**
+ * Ghi một khối nếu cửa sổ gửi còn chỗ
+ */
+static void pumpSlot(StreamSlot& slot) {
+    if (!slot.client.connected()) {
+        closeSlot(slot, false);
+        return;
+    }
+
+    size_t remaining = slot.length - slot.sent;
+    size_t block = platformWritable(slot.client, STREAM_BLOCK_SIZE);
+    if (block > STREAM_BLOCK_SIZE) block = STREAM_BLOCK_SIZE;
+    if (block >= remaining) {
+        block = remaining;
+    } else {
+        block &= ~(size_t)3;
+    }
+
+    if (block == 0) {
+        if (millis() - slot.lastProgress >= STREAM_TIMEOUT) closeSlot(slot, false);
+        return;
+    }
+
+    size_t written = platformWriteP(slot.client, slot.data + slot.sent, block);
+    if (written > 0) {
+        slot.sent += written;
+        slot.lastProgress = millis();
+        _bytes += written;
+        if (written > _maxBlock) _maxBlock = written;
+    }
+
+    if (slot.sent >= slot.length) {
+        closeSlot(slot, true);
+    } else if (millis() - slot.lastProgress >= STREAM_TIMEOUT) {
+        closeSlot(slot, false);
+    }
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void streamProgmem(ESP8266WebServer& server, int code, const char* contentType, PGM_P data, size_t length) {
+    StreamSlot* slot = nullptr;
+    for (uint8_t i = 0; i < STREAM_MAX_CLIENTS; i++) {
+        if (!_slots[i].active) {
+            slot = &_slots[i];
+            break;
+        }
+    }
+
+    if (!slot) {
+        _fallbacks++;
+        server.send_P(code, contentType, data, length);
+        return;
+    }
+
+    // Chỉ gửi header; body do progmemStreamLoop() gửi tiếp
+    server.setContentLength(length);
+    server.send(code, contentType, "");
+
+    slot->client = server.client();
+    slot->data = data;
+    slot->length = length;
+    slot->sent = 0;
+    slot->lastProgress = millis();
+    slot->active = true;
+    _started++;
+
+    // Khối đầu tiên đi ngay cùng header
+    pumpSlot(*slot);
+}
+
+void progmemStreamLoop() {
+    for (uint8_t i = 0; i < STREAM_MAX_CLIENTS; i++) {
+        if (_slots[i].active) pumpSlot(_slots[i]);
+    }
+}
+
+bool progmemStreamReady() {
+    for (uint8_t i = 0; i < STREAM_MAX_CLIENTS; i++) {
+        if (_slots[i].active && (platformWritable(_slots[i].client, STREAM_BLOCK_SIZE) > 0 || !_slots[i].client.connected())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void progmemStreamGetStats(ProgmemStreamStats& stats) {
+    stats.active = 0;
+    for (uint8_t i = 0; i < STREAM_MAX_CLIENTS; i++) {
+        if (_slots[i].active) stats.active++;
+    }
+    stats.started = _started;
+    stats.completed = _completed;
+    stats.aborted = _aborted;
+    stats.fallbacks = _fallbacks;
+    stats.bytes = _bytes;
+    stats.maxBlock = _maxBlock;
+}
@@ -0,0 +1,107 @@
+/**
+ * Relay Driver Implementation
+ *
+ * Trạng thái relay được giữ trong một bitmap (1 bit/kênh). Với thanh ghi
+ * dịch và PCF8574, mỗi lần đổi một kênh sẽ ghi lại toàn bộ bitmap; với
+ * BOX_COUNT nhỏ việc này chỉ mất vài chục µs.
+ */
+
+#include "relay_driver.h"
+#include "config.h"
+
+#if RELAY_DRIVER == RELAY_DRIVER_PCF8574
+#include <Wire.h>
+#endif
+
+// ============================================
+// State
+// ============================================
+#define RELAY_BYTES ((BOX_COUNT + 7) / 8)
+
+static uint8_t _state[RELAY_BYTES];
+
+#if RELAY_DRIVER == RELAY_DRIVER_GPIO
+static constexpr uint8_t RELAY_PIN_MAP[] = RELAY_PINS;
+static_assert(sizeof(RELAY_PIN_MAP) == BOX_COUNT, "RELAY_PINS must list one entry per box");
+#endif
+
+// ============================================
+// Helper Functions
+// ============================================
+
+/**
+ * Mức điện của relay theo logic active LOW/HIGH
+ */
+static bool relayLevel(bool on) {
+    return RELAY_ACTIVE_LOW ? !on : on;
+}
+
+/**
+ * Ghi trạng thái ra phần cứng
+ * @param channel Kênh vừa đổi (chỉ dùng cho GPIO)
+ */
+static void flushRelays(uint8_t channel) {
+#if RELAY_DRIVER == RELAY_DRIVER_GPIO
+    digitalWrite(RELAY_PIN_MAP[channel], relayLevel(relayState(channel)) ? HIGH : LOW);
+#elif RELAY_DRIVER == RELAY_DRIVER_74HC595
+    // IC cuối chuỗi nhận byte đầu tiên: dịch từ byte cao xuống
+    digitalWrite(SHIFT_LATCH_PIN, LOW);
+    for (int8_t i = RELAY_BYTES - 1; i >= 0; i--) {
+        uint8_t out = RELAY_ACTIVE_LOW ? ~_state[i] : _state[i];
+        shiftOut(SHIFT_DATA_PIN, SHIFT_CLOCK_PIN, MSBFIRST, out);
+    }
+    digitalWrite(SHIFT_LATCH_PIN, HIGH);
+#elif RELAY_DRIVER == RELAY_DRIVER_PCF8574
+    // Mỗi PCF8574 điều khiển 8 kênh, địa chỉ liên tiếp từ PCF8574_ADDRESS
+    uint8_t chip = channel / 8;
+    uint8_t out = RELAY_ACTIVE_LOW ? ~_state[chip] : _state[chip];
+    Wire.beginTransmission(PCF8574_ADDRESS + chip);
+    Wire.write(out);
+    Wire.endTransmission();
+#endif
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initRelayDriver() {
+    memset(_state, 0, sizeof(_state));
+
+#if RELAY_DRIVER == RELAY_DRIVER_GPIO
+    for (uint8_t i = 0; i < BOX_COUNT; i++) {
+        pinMode(RELAY_PIN_MAP[i], OUTPUT);
+        flushRelays(i);
+    }
+    Serial.printf("[RELAY] GPIO driver, %d relay(s)\n", BOX_COUNT);
+#elif RELAY_DRIVER == RELAY_DRIVER_74HC595
+    pinMode(SHIFT_DATA_PIN, OUTPUT);
+    pinMode(SHIFT_CLOCK_PIN, OUTPUT);
+    pinMode(SHIFT_LATCH_PIN, OUTPUT);
+    flushRelays(0);
+    Serial.printf("[RELAY] 74HC595 driver, %d relay(s) on %d IC(s)\n", BOX_COUNT, RELAY_BYTES);
+#elif RELAY_DRIVER == RELAY_DRIVER_PCF8574
+    Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN);
+    for (uint8_t chip = 0; chip < RELAY_BYTES; chip++) {
+        flushRelays(chip * 8);
+    }
+    Serial.printf("[RELAY] PCF8574 driver, %d relay(s) from 0x%02X\n", BOX_COUNT, PCF8574_ADDRESS);
+#else
+#error "RELAY_DRIVER không hợp lệ (xem config.h)"
+#endif
+}
+
+void relayWrite(uint8_t channel, bool on) {
+    if (channel >= BOX_COUNT) return;
+    if (on) {
+        _state[channel / 8] |= (1 << (channel % 8));
+    } else {
+        _state[channel / 8] &= ~(1 << (channel % 8));
+    }
+    flushRelays(channel);
+}
+
+bool relayState(uint8_t channel) {
+    if (channel >= BOX_COUNT) return false;
+    return _state[channel / 8] & (1 << (channel % 8));
+}
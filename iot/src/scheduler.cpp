@@ -0,0 +1,282 @@
+/**
+ * Cooperative Scheduler Implementation
+ *
+ * Hashed timer wheel: SCHED_WHEEL_SLOTS ô, mỗi ô ứng với SCHED_TICK_MS.
+ * Task được băm vào ô theo tick của deadline; mỗi lần schedulerRun() chỉ
+ * duyệt các ô của những tick đã trôi qua thay vì toàn bộ danh sách task.
+ * Task tới hạn được sắp theo deadline trước khi gọi.
+ *
+ * Bản build hai lõi (dual_core.h) có một wheel cho mỗi task; mọi hàm thao
+ * tác trên wheel của task đang gọi nên hai lõi không dùng chung wheel nào
+ * (dữ liệu chung giữa hai lõi: xem dual_core.h).
+ */
+
+#include "scheduler.h"
+#include "config.h"
+#include "stall_watchdog.h"
+#include "dual_core.h"
+
+// ============================================
+// Task Pool & Wheel
+// ============================================
+#define NO_TASK -1
+
+struct SchedulerEntry {
+    SchedulerTask task;
+    void* arg;
+    const char* name;
+    uint32_t deadline;
+    uint32_t interval;      // 0 = chạy một lần
+    uint8_t generation;
+    bool active;
+    int8_t next;            // Task kế tiếp trong cùng ô của wheel
+};
+
+struct SchedulerContext {
+    SchedulerEntry tasks[SCHED_MAX_TASKS];
+    int8_t wheel[SCHED_WHEEL_SLOTS];
+    uint32_t lastTick;      // Tick cuối cùng đã duyệt xong
+
+    uint32_t dispatched;
+    uint32_t lateCount;
+    uint32_t maxLag;
+    uint32_t lastLag;
+    uint64_t totalLag;
+    uint32_t idleMs;
+};
+
+#if LOCKER_DUAL_CORE
+#define SCHED_CONTEXTS 2    // [0] task mạng (và setup()), [1] task actuation
+#else
+#define SCHED_CONTEXTS 1
+#endif
+
+static SchedulerContext _contexts[SCHED_CONTEXTS];
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static inline bool isDue(uint32_t deadline, uint32_t now) {
+    return (int32_t)(deadline - now) <= 0;
+}
+
+/**
+ * Wheel của task đang gọi
+ */
+static inline SchedulerContext& currentContext() {
+#if LOCKER_DUAL_CORE
+    return _contexts[onActuationCore() ? 1 : 0];
+#else
+    return _contexts[0];
+#endif
+}
+
+static inline SchedulerTaskId makeId(SchedulerContext& s, int8_t index) {
+    return (SchedulerTaskId)(((uint16_t)s.tasks[index].generation << 8) | (uint16_t)(index + 1));
+}
+
+/**
+ * Đưa task vào ô tương ứng với deadline
+ */
+static void wheelInsert(SchedulerContext& s, int8_t index) {
+    uint32_t tick = s.tasks[index].deadline / SCHED_TICK_MS;
+    // Deadline đã qua: đặt vào ô kế tiếp để lần duyệt tới nhặt được
+    if ((int32_t)(tick - s.lastTick) <= 0) {
+        tick = s.lastTick + 1;
+    }
+    uint8_t slot = tick & (SCHED_WHEEL_SLOTS - 1);
+    s.tasks[index].next = s.wheel[slot];
+    s.wheel[slot] = index;
+}
+
+/**
+ * Gỡ task khỏi ô đang chứa nó
+ */
+static void wheelRemove(SchedulerContext& s, int8_t index) {
+    for (uint8_t slot = 0; slot < SCHED_WHEEL_SLOTS; slot++) {
+        int8_t* link = &s.wheel[slot];
+        while (*link != NO_TASK) {
+            if (*link == index) {
+                *link = s.tasks[index].next;
+                s.tasks[index].next = NO_TASK;
+                return;
+            }
+            link = &s.tasks[*link].next;
+        }
+    }
+}
+
+static SchedulerTaskId addTask(uint32_t delayMs, uint32_t intervalMs, SchedulerTask task, const char* name, void* arg) {
+    SchedulerContext& s = currentContext();
+    for (int8_t i = 0; i < SCHED_MAX_TASKS; i++) {
+        SchedulerEntry& entry = s.tasks[i];
+        if (entry.active) continue;
+
+        entry.task = task;
+        entry.arg = arg;
+        entry.name = name;
+        entry.deadline = millis() + delayMs;
+        entry.interval = intervalMs;
+        entry.generation++;
+        entry.active = true;
+        wheelInsert(s, i);
+        return makeId(s, i);
+    }
+    Serial.printf("[SCHED] No free slot for task %s\n", name);
+    return SCHEDULER_INVALID_TASK;
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initScheduler() {
+    for (uint8_t c = 0; c < SCHED_CONTEXTS; c++) {
+        SchedulerContext& s = _contexts[c];
+        for (uint8_t slot = 0; slot < SCHED_WHEEL_SLOTS; slot++) {
+            s.wheel[slot] = NO_TASK;
+        }
+        for (uint8_t i = 0; i < SCHED_MAX_TASKS; i++) {
+            s.tasks[i].active = false;
+            s.tasks[i].next = NO_TASK;
+        }
+        s.lastTick = millis() / SCHED_TICK_MS;
+    }
+    Serial.printf("[SCHED] Timer wheel: %d slots x %d ms, %d tasks max, %d wheel(s)\n",
+                  SCHED_WHEEL_SLOTS, SCHED_TICK_MS, SCHED_MAX_TASKS, SCHED_CONTEXTS);
+}
+
+SchedulerTaskId schedulerEvery(uint32_t intervalMs, SchedulerTask task, const char* name, void* arg) {
+    return addTask(intervalMs, intervalMs, task, name, arg);
+}
+
+SchedulerTaskId schedulerAfter(uint32_t delayMs, SchedulerTask task, const char* name, void* arg) {
+    return addTask(delayMs, 0, task, name, arg);
+}
+
+bool schedulerCancel(SchedulerTaskId id) {
+    if (id == SCHEDULER_INVALID_TASK) return false;
+    int8_t index = (int8_t)((id & 0xff) - 1);
+    if (index < 0 || index >= SCHED_MAX_TASKS) return false;
+
+    SchedulerContext& s = currentContext();
+    SchedulerEntry& entry = s.tasks[index];
+    if (!entry.active || entry.generation != (uint8_t)(id >> 8)) return false;
+
+    wheelRemove(s, index);
+    entry.active = false;
+    return true;
+}
+
+void schedulerRun() {
+    SchedulerContext& s = currentContext();
+    uint32_t now = millis();
+    uint32_t nowTick = now / SCHED_TICK_MS;
+    uint32_t ticks = nowTick - s.lastTick;
+    if (ticks == 0) return;
+    // Trễ hơn một vòng wheel: mỗi ô chỉ cần duyệt một lần
+    if (ticks > SCHED_WHEEL_SLOTS) ticks = SCHED_WHEEL_SLOTS;
+
+    // Gom các task tới hạn từ các ô của những tick đã trôi qua
+    int8_t due[SCHED_MAX_TASKS];
+    uint8_t dueCount = 0;
+    for (uint32_t t = nowTick - ticks + 1; (int32_t)(t - nowTick) <= 0; t++) {
+        int8_t* link = &s.wheel[t & (SCHED_WHEEL_SLOTS - 1)];
+        while (*link != NO_TASK) {
+            int8_t index = *link;
+            if (isDue(s.tasks[index].deadline, now)) {
+                *link = s.tasks[index].next;
+                s.tasks[index].next = NO_TASK;
+                due[dueCount++] = index;
+            } else {
+                link = &s.tasks[index].next;
+            }
+        }
+    }
+    // Tick hiện tại chưa kết thúc: để lại cho lần duyệt sau
+    s.lastTick = nowTick - 1;
+
+    // Sắp xếp theo deadline (insertion sort, số task nhỏ)
+    for (uint8_t i = 1; i < dueCount; i++) {
+        int8_t index = due[i];
+        uint8_t j = i;
+        while (j > 0 && (int32_t)(s.tasks[due[j - 1]].deadline - s.tasks[index].deadline) > 0) {
+            due[j] = due[j - 1];
+            j--;
+        }
+        due[j] = index;
+    }
+
+    for (uint8_t i = 0; i < dueCount; i++) {
+        int8_t index = due[i];
+        SchedulerEntry& entry = s.tasks[index];
+        if (!entry.active) continue;  // Bị huỷ bởi task chạy trước
+
+        uint32_t start = millis();
+        uint32_t lag = start - entry.deadline;
+        s.dispatched++;
+        s.totalLag += lag;
+        s.lastLag = lag;
+        if (lag > s.maxLag) s.maxLag = lag;
+        if (lag > SCHED_LATE_THRESHOLD_MS) {
+            s.lateCount++;
+            Serial.printf("[SCHED] Task %s ran %u ms late\n", entry.name, lag);
+        }
+
+        if (entry.interval > 0) {
+            // Bỏ qua các chu kỳ đã lỡ thay vì chạy dồn
+            entry.deadline += entry.interval;
+            if (isDue(entry.deadline, start)) {
+                entry.deadline = start + entry.interval;
+            }
+            wheelInsert(s, index);
+        } else {
+            entry.active = false;
+        }
+
+        stallArm(entry.name);
+        entry.task(entry.arg);
+        stallDisarm();
+    }
+}
+
+uint32_t schedulerTimeToNext() {
+    SchedulerContext& s = currentContext();
+    uint32_t now = millis();
+    uint32_t best = UINT32_MAX;
+    for (uint8_t i = 0; i < SCHED_MAX_TASKS; i++) {
+        if (!s.tasks[i].active) continue;
+        if (isDue(s.tasks[i].deadline, now)) return 0;
+        uint32_t remain = s.tasks[i].deadline - now;
+        if (remain < best) best = remain;
+    }
+    return best;
+}
+
+void schedulerIdle(bool (*ioReady)()) {
+    uint32_t wait = schedulerTimeToNext();
+    if (wait > SCHED_MAX_IDLE_MS) wait = SCHED_MAX_IDLE_MS;
+
+    uint32_t start = millis();
+    while (millis() - start < wait) {
+        if (ioReady && ioReady()) break;
+        // delay() nhường CPU cho WiFi stack
+        delay(1);
+    }
+    currentContext().idleMs += millis() - start;
+}
+
+void schedulerGetStats(SchedulerStats& stats) {
+    const SchedulerContext& s = currentContext();
+    stats.activeTasks = 0;
+    for (uint8_t i = 0; i < SCHED_MAX_TASKS; i++) {
+        if (s.tasks[i].active) stats.activeTasks++;
+    }
+    stats.dispatched = s.dispatched;
+    stats.lateCount = s.lateCount;
+    stats.maxLagMs = s.maxLag;
+    stats.avgLagMs = s.dispatched ? (uint32_t)(s.totalLag / s.dispatched) : 0;
+    stats.lastLagMs = s.lastLag;
+    stats.idleMs = s.idleMs;
+}
@@ -0,0 +1,387 @@
+/**
+ * Stall Watchdog Implementation
+ *
+ * Bản ghi nằm trong RTC memory từ block STALL_RTC_OFFSET: một bản ghi
+ * "current" cho stall đang diễn ra (còn cờ ACTIVE sau khởi động = chip bị
+ * reset giữa stage) và STALL_RECORDS stall lâu nhất đã kết thúc, sắp
+ * giảm dần theo thời gian. Toàn bộ vùng có CRC như cache WiFi.
+ *
+ * Timer kiểm tra chạy trong ngữ cảnh SDK, chỉ khi loop() nhường CPU: lúc
+ * đó stack của loop() (cont) đang dừng tại sp_yield nên có thể quét tìm
+ * các địa chỉ trả về trong vùng code (IRAM / flash) mà không cần unwind.
+ *
+ * ESP32: timer là esp_timer (task riêng), không có cont để chụp stack và
+ * không có custom_crash_callback; panic/WDT vẫn để lại bản ghi ACTIVE nếu
+ * timer đã kịp ghi. Task timer chen được vào giữa stallArm/stallDisarm nên
+ * stage đang chạy và _rtc được đọc/ghi trong critical section (_rtcMux);
+ * time() và Serial nằm ngoài vì có thể chặn. Khi LOCKER_DUAL_CORE chỉ theo
+ * dõi lõi mạng: lõi actuation không gọi mạng nên không có stage nào treo lâu.
+ */
+
+#include "stall_watchdog.h"
+#include "config.h"
+#include "mqtt_commands.h"
+#include "platform.h"
+#include "dual_core.h"
+#include <ArduinoJson.h>
+#include <time.h>
+#if defined(ESP32)
+#include <esp_timer.h>
+#else
+extern "C" {
+#include <user_interface.h>
+#include <cont.h>
+}
+#endif
+
+// ============================================
+// RTC Record
+// ============================================
+#define STALL_MAGIC 0x53544C31  // "STL1"
+#define STALL_NAME_SIZE 16
+
+enum StallFlags : uint8_t {
+    STALL_ACTIVE = 0x01,    // Stage còn đang chạy lúc ghi
+    STALL_RESET = 0x02,     // Chip bị reset giữa stage
+    STALL_FORCED = 0x04     // ...do STALL_RESET_MS (WDT phần cứng)
+};
+
+struct StallRecord {
+    char stage[STALL_NAME_SIZE];
+    uint32_t durationMs;
+    uint32_t at;            // Epoch (giây) lúc stage bắt đầu, 0 nếu chưa đồng bộ NTP
+    uint8_t flags;
+    uint8_t depth;          // Số địa chỉ trong stack[]
+    uint16_t reserved;
+    uint32_t stack[STALL_STACK_DEPTH];
+};
+
+struct StallRtc {
+    uint32_t magic;
+    uint32_t stalls;        // Tổng số stall (giữ qua reset, mất khi mất điện)
+    uint32_t resets;
+    uint8_t count;          // Số bản ghi trong worst[]
+    uint8_t reserved[3];
+    StallRecord current;
+    StallRecord worst[STALL_RECORDS];
+    uint32_t crc;           // CRC32 của các trường phía trên
+};
+
+static_assert(sizeof(StallRtc) % 4 == 0, "RTC memory is accessed in 4-byte blocks");
+static_assert(STALL_RTC_OFFSET * 4 + sizeof(StallRtc) <= 512, "Stall records do not fit in RTC user memory");
+
+// ============================================
+// State Variables
+// ============================================
+static StallRtc _rtc;
+static const char* volatile _stage = nullptr;  // Stage đang chạy (nullptr = không theo dõi)
+static volatile uint32_t _stageStart = 0;
+static volatile bool _captured = false;         // Stage hiện tại đã được ghi vào current
+#if defined(ESP32)
+static esp_timer_handle_t _checkTimer = nullptr;
+#else
+static os_timer_t _checkTimer;
+#endif
+#if defined(ESP32)
+static portMUX_TYPE _rtcMux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+static char _resetReason[32] = "";
+static char _lastStage[STALL_NAME_SIZE] = "";
+static uint32_t _reports = 0;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+/**
+ * ESP8266: timer chỉ chạy khi loop() nhường CPU, không chen giữa các hàm
+ * dưới đây nên không cần khoá
+ */
+static inline void stallLock() {
+#if defined(ESP32)
+    portENTER_CRITICAL(&_rtcMux);
+#endif
+}
+
+static inline void stallUnlock() {
+#if defined(ESP32)
+    portEXIT_CRITICAL(&_rtcMux);
+#endif
+}
+
+static uint32_t stallCrc32(const void* data, size_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static void rtcSave() {
+    _rtc.crc = stallCrc32(&_rtc, offsetof(StallRtc, crc));
+    platformRtcWrite(STALL_RTC_OFFSET, (uint32_t*)&_rtc, sizeof(_rtc));
+}
+
+static void rtcLoad() {
+    platformRtcRead(STALL_RTC_OFFSET, (uint32_t*)&_rtc, sizeof(_rtc));
+    if (_rtc.magic == STALL_MAGIC && _rtc.count <= STALL_RECORDS &&
+        _rtc.crc == stallCrc32(&_rtc, offsetof(StallRtc, crc))) {
+        return;
+    }
+    // Mất điện hoặc firmware cũ: RTC chứa dữ liệu rác
+    memset(&_rtc, 0, sizeof(_rtc));
+    _rtc.magic = STALL_MAGIC;
+}
+
+/**
+ * Địa chỉ nằm trong IRAM hoặc vùng flash được map (irom0)
+ */
+static inline bool isCodeAddress(uint32_t value) {
+    return (value >= 0x40100000 && value < 0x40108000)
+        || (value >= 0x40200000 && value < 0x40300000);
+}
+
+static void captureStack(StallRecord& record, const uint32_t* from, const uint32_t* to) {
+    record.depth = 0;
+    for (const uint32_t* p = from; p < to && record.depth < STALL_STACK_DEPTH; p++) {
+        if (isCodeAddress(*p)) record.stack[record.depth++] = *p;
+    }
+}
+
+/**
+ * Chụp stack của loop() đang nhường CPU (gọi từ ngữ cảnh SDK)
+ */
+static void captureContStack(StallRecord& record) {
+#if !defined(ESP32)
+    cont_t* cont = g_pcont;
+    if (!cont || !cont->sp_yield) return;
+    const uint32_t* sp = (const uint32_t*)cont->sp_yield;
+    const uint32_t* low = (const uint32_t*)cont->stack;
+    const uint32_t* high = (const uint32_t*)&cont->stack_guard2;
+    if (sp < low || sp >= high) return;     // loop() không ở trạng thái yield
+    captureStack(record, sp, high);
+#endif
+}
+
+/**
+ * @param now time() lấy trước khi khoá (0 nếu không có)
+ */
+static void beginRecord(const char* stage, uint32_t elapsedMs, time_t now) {
+    StallRecord& record = _rtc.current;
+    memset(&record, 0, sizeof(record));
+    strncpy(record.stage, stage, STALL_NAME_SIZE - 1);
+    record.durationMs = elapsedMs;
+    if (now > NTP_VALID_AFTER) record.at = (uint32_t)now - elapsedMs / 1000;
+    record.flags = STALL_ACTIVE;
+    _captured = true;
+}
+
+/**
+ * Chuyển current vào danh sách stall lâu nhất (giảm dần theo thời gian)
+ */
+static void mergeCurrent() {
+    StallRecord record = _rtc.current;
+    record.flags &= ~STALL_ACTIVE;
+    memset(&_rtc.current, 0, sizeof(_rtc.current));
+    _rtc.stalls++;
+    memcpy(_lastStage, record.stage, STALL_NAME_SIZE);
+
+    uint8_t pos = _rtc.count;
+    while (pos > 0 && _rtc.worst[pos - 1].durationMs < record.durationMs) pos--;
+    if (pos >= STALL_RECORDS) return;       // Ngắn hơn mọi bản ghi đang giữ
+    uint8_t last = _rtc.count < STALL_RECORDS ? _rtc.count : STALL_RECORDS - 1;
+    for (uint8_t i = last; i > pos; i--) _rtc.worst[i] = _rtc.worst[i - 1];
+    _rtc.worst[pos] = record;
+    if (_rtc.count < STALL_RECORDS) _rtc.count++;
+}
+
+#if STALL_RESET_MS > 0
+/**
+ * Dừng feed watchdog: tắt soft WDT và ngắt, WDT phần cứng reset chip sau vài giây
+ */
+static void hardwareWatchdogReset() {
+#if defined(ESP32)
+    // Không tắt được WDT của core: reset thẳng, bản ghi đã có cờ FORCED
+    esp_restart();
+#else
+    ESP.wdtDisable();
+    noInterrupts();
+    volatile bool spin = true;
+    while (spin) {}
+#endif
+}
+#endif
+
+/**
+ * Timer SDK mỗi STALL_CHECK_INTERVAL: stage quá hạn thì ghi tên, thời gian,
+ * ảnh chụp stack vào RTC; cập nhật thời gian ở các lần sau
+ */
+static void checkStall(void* arg) {
+    if (!_stage || millis() - _stageStart < STALL_BUDGET_MS) return;
+    time_t now = time(nullptr);
+
+    // Kiểm tra lại trong khoá: stage có thể vừa xong
+    stallLock();
+    const char* stage = _stage;
+    uint32_t elapsed = millis() - _stageStart;
+    bool overdue = stage && elapsed >= STALL_BUDGET_MS;
+    if (overdue) {
+        if (!_captured) {
+            beginRecord(stage, elapsed, now);
+            captureContStack(_rtc.current);
+        } else {
+            _rtc.current.durationMs = elapsed;
+        }
+#if STALL_RESET_MS > 0
+        if (elapsed >= STALL_RESET_MS) _rtc.current.flags |= STALL_FORCED;
+#endif
+        rtcSave();
+    }
+    stallUnlock();
+
+#if STALL_RESET_MS > 0
+    if (overdue && elapsed >= STALL_RESET_MS) hardwareWatchdogReset();
+#endif
+}
+
+/**
+ * Gọi bởi core khi exception hoặc soft WDT reset chip: stage đang chạy
+ * được ghi kèm stack tại lúc crash (cả khi stage không hề nhường CPU)
+ */
+#if !defined(ESP32)
+extern "C" void custom_crash_callback(struct rst_info* info, uint32_t stack, uint32_t stackEnd) {
+    const char* stage = _stage;
+    if (!stage) return;
+    if (!_captured) beginRecord(stage, millis() - _stageStart, time(nullptr));
+    else _rtc.current.durationMs = millis() - _stageStart;
+    captureStack(_rtc.current, (const uint32_t*)(uintptr_t)stack, (const uint32_t*)(uintptr_t)stackEnd);
+    rtcSave();
+}
+#endif
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initStallWatchdog() {
+    _stage = nullptr;
+    strncpy(_resetReason, platformResetReason().c_str(), sizeof(_resetReason) - 1);
+    rtcLoad();
+
+    // Reset khi stage còn đang chạy (WDT, exception, STALL_RESET_MS)
+    if (_rtc.current.flags & STALL_ACTIVE) {
+        _rtc.current.flags |= STALL_RESET;
+        _rtc.resets++;
+        Serial.printf("[STALL] Reset during %s after %lu ms (%s)\n",
+                      _rtc.current.stage, (unsigned long)_rtc.current.durationMs, _resetReason);
+        mergeCurrent();
+    }
+    rtcSave();
+
+#if defined(ESP32)
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = checkStall;
+    timerArgs.name = "stall-check";
+    esp_timer_create(&timerArgs, &_checkTimer);
+    esp_timer_start_periodic(_checkTimer, (uint64_t)STALL_CHECK_INTERVAL * 1000);
+#else
+    os_timer_setfn(&_checkTimer, checkStall, nullptr);
+    os_timer_arm(&_checkTimer, STALL_CHECK_INTERVAL, true);
+#endif
+    Serial.printf("[STALL] Budget %d ms, %u stall(s) pending report\n", STALL_BUDGET_MS, _rtc.count);
+}
+
+void stallArm(const char* stage) {
+#if LOCKER_DUAL_CORE
+    if (onActuationCore()) return;
+#endif
+    stallLock();
+    _stageStart = millis();
+    _captured = false;
+    _stage = stage;
+    stallUnlock();
+}
+
+void stallDisarm() {
+#if LOCKER_DUAL_CORE
+    if (onActuationCore()) return;
+#endif
+    if (!_stage) return;
+    // time() chỉ cần khi stage quá hạn (đọc không khoá, kiểm tra lại bên dưới)
+    time_t now = _captured || millis() - _stageStart >= STALL_BUDGET_MS ? time(nullptr) : 0;
+
+    stallLock();
+    const char* stage = _stage;
+    _stage = nullptr;
+    uint32_t elapsed = millis() - _stageStart;
+    bool stalled = stage && (_captured || elapsed >= STALL_BUDGET_MS);
+    uint8_t depth = 0;
+    if (stalled) {
+        // Quá hạn mà không nhường CPU lần nào: không có ảnh chụp stack
+        if (!_captured) beginRecord(stage, elapsed, now);
+        _rtc.current.durationMs = elapsed;
+        depth = _rtc.current.depth;
+        mergeCurrent();
+        rtcSave();
+    }
+    stallUnlock();
+
+    if (stalled) Serial.printf("[STALL] %s took %lu ms (%u frames)\n", stage, (unsigned long)elapsed, depth);
+}
+
+const char* stallStage() {
+    return _stage;
+}
+
+bool stallReport() {
+    if (_rtc.count == 0) return false;
+
+    // Mỗi stall một bản tin (vừa buffer trả lời lệnh), lâu nhất trước
+    static StaticJsonDocument<JSON_OBJECT_SIZE(9) + JSON_ARRAY_SIZE(STALL_STACK_DEPTH)> doc;
+    static char frames[STALL_STACK_DEPTH][11];
+    uint8_t sent = 0;
+    while (sent < _rtc.count) {
+        const StallRecord& record = _rtc.worst[sent];
+        doc.clear();
+        doc["box_id"] = BOX_ID;
+        doc["status"] = "STALL";
+        doc["device"] = DEVICE_ID;
+        doc["stage"] = (const char*)record.stage;
+        doc["ms"] = record.durationMs;
+        if (record.at) doc["at"] = record.at;
+        if (record.flags & STALL_RESET) {
+            doc["reset"] = (const char*)_resetReason;
+            if (record.flags & STALL_FORCED) doc["forced"] = true;
+        }
+        JsonArray stack = doc.createNestedArray("stack");
+        for (uint8_t i = 0; i < record.depth; i++) {
+            snprintf(frames[i], sizeof(frames[i]), "0x%08lx", (unsigned long)record.stack[i]);
+            stack.add((const char*)frames[i]);
+        }
+        if (!publishStatusDoc(doc.as<JsonVariantConst>())) break;
+        sent++;
+    }
+    if (sent == 0) return false;
+
+    stallLock();
+    for (uint8_t i = sent; i < _rtc.count; i++) _rtc.worst[i - sent] = _rtc.worst[i];
+    _rtc.count -= sent;
+    rtcSave();
+    stallUnlock();
+    _reports += sent;
+    Serial.printf("[STALL] Reported %u stall(s) over MQTT\n", sent);
+    return true;
+}
+
+void stallGetStats(StallStats& stats) {
+    stats.stalls = _rtc.stalls;
+    stats.resets = _rtc.resets;
+    stats.worstMs = _rtc.count ? _rtc.worst[0].durationMs : 0;
+    stats.lastStage = _lastStage;
+    stats.pending = _rtc.count;
+    stats.reports = _reports;
+}
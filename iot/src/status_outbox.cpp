@@ -0,0 +1,251 @@
+/**
+ * Status Outbox Implementation
+ *
+ * Mỗi box có một entry cố định: chỉ giữ trạng thái mới nhất chưa gửi.
+ * Mỗi lần chỉ có một request outbox đang bay; entry ghi nhận seq lúc gửi
+ * để nếu có trạng thái mới hơn trong lúc chờ phản hồi thì vẫn còn dirty
+ * và được gửi ở lượt sau.
+ */
+
+#include "status_outbox.h"
+#include "async_http.h"
+#include "config.h"
+#include "heap_monitor.h"
+#include "platform.h"
+#include <ArduinoJson.h>
+
+// JSON document cho một lần gửi: batch {"deviceId","reports":[...]} đủ cho mọi box
+#define OUTBOX_JSON_SIZE (JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(OUTBOX_MAX_BOXES) + OUTBOX_MAX_BOXES * JSON_OBJECT_SIZE(4))
+
+// ============================================
+// Outbox Table
+// ============================================
+struct OutboxEntry {
+    bool used;
+    bool dirty;             // Có trạng thái chưa được backend xác nhận
+    int boxId;
+    BoxStatus status;
+    bool isDoorOpen;
+    uint16_t seq;           // Tăng mỗi lần ghi trạng thái mới
+    uint16_t sentSeq;       // seq của lần gửi đang chờ phản hồi
+    bool inFlight;
+};
+
+static OutboxEntry _entries[OUTBOX_MAX_BOXES];
+static bool _requestInFlight = false;
+static unsigned long _nextAttempt = 0;
+static uint32_t _backoffMs = 0;
+static uint32_t _heartbeatMs = OUTBOX_HEARTBEAT_MIN_MS;   // Khoảng heartbeat hiện tại
+static unsigned long _nextHeartbeat = 0;
+
+static uint32_t _enqueued = 0;
+static uint32_t _coalesced = 0;
+static uint32_t _requests = 0;
+static uint32_t _delivered = 0;
+static uint32_t _failures = 0;
+static uint32_t _heartbeats = 0;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static OutboxEntry* findEntry(int boxId, bool create) {
+    OutboxEntry* freeEntry = nullptr;
+    for (uint8_t i = 0; i < OUTBOX_MAX_BOXES; i++) {
+        if (_entries[i].used && _entries[i].boxId == boxId) return &_entries[i];
+        if (!_entries[i].used && !freeEntry) freeEntry = &_entries[i];
+    }
+    if (!create || !freeEntry) return nullptr;
+
+    memset(freeEntry, 0, sizeof(OutboxEntry));
+    freeEntry->used = true;
+    freeEntry->boxId = boxId;
+    return freeEntry;
+}
+
+/**
+ * Gửi lỗi: giữ nguyên các entry dirty, tăng backoff (có jitter)
+ */
+static void scheduleRetry() {
+    _failures++;
+    _backoffMs = _backoffMs == 0 ? OUTBOX_RETRY_MIN_MS : min((uint32_t)(_backoffMs * 2), (uint32_t)OUTBOX_RETRY_MAX_MS);
+    _nextAttempt = millis() + _backoffMs + random(_backoffMs / 4 + 1);
+    Serial.printf("[OUTBOX] Retry in %lu ms\n", (unsigned long)_backoffMs);
+}
+
+static void onOutboxResponse(int httpCode, const char* body, size_t length, void* ctx) {
+    _requestInFlight = false;
+    bool success = httpCode == HTTP_CODE_OK;
+
+    if (success) {
+        Serial.printf("[OUTBOX] Delivered (HTTP %d)\n", httpCode);
+    } else {
+        Serial.printf("[OUTBOX] Report failed: %d\n", httpCode);
+    }
+
+    for (uint8_t i = 0; i < OUTBOX_MAX_BOXES; i++) {
+        OutboxEntry& entry = _entries[i];
+        if (!entry.inFlight) continue;
+        entry.inFlight = false;
+        // Chỉ xóa dirty nếu không có trạng thái mới hơn ghi vào trong lúc chờ
+        if (success && entry.seq == entry.sentSeq) {
+            entry.dirty = false;
+        }
+        if (success) _delivered++;
+    }
+
+    if (success) {
+        _backoffMs = 0;
+        _nextAttempt = millis();
+    } else {
+        scheduleRetry();
+    }
+}
+
+static void addReport(JsonObject obj, const OutboxEntry& entry) {
+    obj["boxId"] = entry.boxId;
+    obj["status"] = getStatusString(entry.status);
+    obj["deviceId"] = DEVICE_ID;
+    obj["isDoorOpen"] = entry.isDoorOpen;
+}
+
+/**
+ * Gửi tất cả entry dirty trong một request
+ * Một box: dùng /api/iot/box-status như cũ; nhiều box: gộp vào /batch
+ */
+static void flushOutbox() {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < OUTBOX_MAX_BOXES; i++) {
+        if (_entries[i].dirty) count++;
+    }
+    if (count == 0) return;
+
+    HeapScope heapScope("outbox:send");
+
+    // Document tĩnh: kích thước tăng theo số box, không đặt trên stack loop()
+    static StaticJsonDocument<OUTBOX_JSON_SIZE> doc;
+    doc.clear();
+    const char* path;
+    if (count == 1) {
+        path = "/api/iot/box-status";
+        for (uint8_t i = 0; i < OUTBOX_MAX_BOXES; i++) {
+            if (_entries[i].dirty) addReport(doc.to<JsonObject>(), _entries[i]);
+        }
+    } else {
+        path = "/api/iot/box-status/batch";
+        doc["deviceId"] = DEVICE_ID;
+        JsonArray reports = doc.createNestedArray("reports");
+        for (uint8_t i = 0; i < OUTBOX_MAX_BOXES; i++) {
+            if (_entries[i].dirty) addReport(reports.createNestedObject(), _entries[i]);
+        }
+    }
+
+    String jsonBody;
+    serializeJson(doc, jsonBody);
+    Serial.printf("[OUTBOX] Sending %u report(s): %s\n", count, jsonBody.c_str());
+
+    if (!asyncHttpPost(path, jsonBody, onOutboxResponse, nullptr)) {
+        scheduleRetry();
+        return;
+    }
+
+    _requests++;
+    _requestInFlight = true;
+    for (uint8_t i = 0; i < OUTBOX_MAX_BOXES; i++) {
+        OutboxEntry& entry = _entries[i];
+        if (!entry.dirty) continue;
+        entry.inFlight = true;
+        entry.sentSeq = entry.seq;
+    }
+}
+
+/**
+ * Không có thay đổi nào trong _heartbeatMs: gửi lại trạng thái mọi box rồi
+ * giãn khoảng kế tiếp gấp đôi (backend vẫn biết thiết bị còn sống)
+ */
+static void heartbeat() {
+    uint8_t marked = 0;
+    for (uint8_t i = 0; i < OUTBOX_MAX_BOXES; i++) {
+        if (!_entries[i].used || _entries[i].dirty) continue;
+        _entries[i].dirty = true;
+        marked++;
+    }
+    // Chưa có box nào (mới khởi động) hoặc mọi box đều đang chờ gửi: chỉ hẹn lại
+    if (marked == 0) {
+        _nextHeartbeat = millis() + _heartbeatMs;
+        return;
+    }
+    _heartbeats++;
+    _heartbeatMs = min((uint32_t)(_heartbeatMs * 2), (uint32_t)OUTBOX_HEARTBEAT_MAX_MS);
+    _nextHeartbeat = millis() + _heartbeatMs;
+    Serial.printf("[OUTBOX] Heartbeat for %u box(es), next in %lu s\n", marked, (unsigned long)(_heartbeatMs / 1000));
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initStatusOutbox() {
+    memset(_entries, 0, sizeof(_entries));
+    _requestInFlight = false;
+    _nextAttempt = millis();
+    _backoffMs = 0;
+    _heartbeatMs = OUTBOX_HEARTBEAT_MIN_MS;
+    _nextHeartbeat = millis() + _heartbeatMs;
+    Serial.printf("[OUTBOX] Ready (%d boxes)\n", OUTBOX_MAX_BOXES);
+}
+
+bool outboxEnqueue(int boxId, BoxStatus status, bool isDoorOpen) {
+    OutboxEntry* entry = findEntry(boxId, true);
+    if (!entry) {
+        Serial.printf("[OUTBOX] No slot for box %d\n", boxId);
+        return false;
+    }
+
+    // Trạng thái cũ chưa kịp gửi bị thay bằng trạng thái mới nhất
+    if (entry->dirty && !entry->inFlight) _coalesced++;
+
+    // Chờ một chút để gộp các thay đổi liên tiếp (không lùi lịch khi đang backoff)
+    if (_backoffMs == 0 && !entry->dirty) {
+        _nextAttempt = millis() + OUTBOX_COALESCE_MS;
+    }
+
+    entry->status = status;
+    entry->isDoorOpen = isDoorOpen;
+    entry->dirty = true;
+    entry->seq++;
+    _enqueued++;
+
+    // Có thay đổi thật: heartbeat về lại khoảng ngắn nhất
+    _heartbeatMs = OUTBOX_HEARTBEAT_MIN_MS;
+    _nextHeartbeat = millis() + _heartbeatMs;
+    return true;
+}
+
+void statusOutboxLoop() {
+    if (_requestInFlight) return;
+    if (WiFi.status() != WL_CONNECTED) return;
+    if ((long)(millis() - _nextHeartbeat) >= 0) heartbeat();
+    if ((long)(millis() - _nextAttempt) < 0) return;
+
+    // Slot HTTP đang bận (ví dụ verify-pin): chờ lượt sau, không tính là lỗi
+    if (asyncHttpPending() >= ASYNC_HTTP_SLOTS) return;
+
+    flushOutbox();
+}
+
+void outboxGetStats(OutboxStats& stats) {
+    uint8_t pending = 0;
+    for (uint8_t i = 0; i < OUTBOX_MAX_BOXES; i++) {
+        if (_entries[i].dirty) pending++;
+    }
+    stats.pending = pending;
+    stats.enqueued = _enqueued;
+    stats.coalesced = _coalesced;
+    stats.requests = _requests;
+    stats.delivered = _delivered;
+    stats.failures = _failures;
+    stats.backoffMs = _backoffMs;
+    stats.heartbeats = _heartbeats;
+    stats.heartbeatMs = _heartbeatMs;
+}
@@ -0,0 +1,233 @@
+/**
+ * Telemetry Implementation
+ *
+ * Mẫu được giữ dạng nhị phân 24 byte trong vòng đệm; chỉ khi gửi mới dựng
+ * document (tĩnh) và serialize theo định dạng MQTT đang dùng. Mẫu chỉ bị
+ * xoá khỏi vòng đệm sau khi gửi xong: MQTT publish thành công, hoặc backend
+ * trả HTTP 200. Vòng đệm đầy mà chưa gửi được thì mẫu cũ nhất bị ghi đè.
+ */
+
+#include "telemetry.h"
+#include "config.h"
+#include "locker_controller.h"
+#include "loop_metrics.h"
+#include "heap_monitor.h"
+#include "mqtt_commands.h"
+#include "async_http.h"
+#include "platform.h"
+#include <ArduinoJson.h>
+
+// box_id, box_count, status, device, 8 mảng mẫu, unlocked, lowWater, dropped
+#define TELEMETRY_DOC_SIZE (JSON_OBJECT_SIZE(15) + 8 * JSON_ARRAY_SIZE(TELEMETRY_RING_SIZE) + JSON_ARRAY_SIZE(BOX_COUNT))
+
+// ============================================
+// Sample Ring
+// ============================================
+struct TelemetrySample {
+    uint32_t uptimeSec;
+    uint32_t loops;         // Số vòng loop() trong khoảng mẫu
+    uint32_t freeHeap;
+    uint32_t maxBlock;
+    uint16_t loopAvgUs;     // Thời gian trung bình một vòng loop() (bão hoà 65535)
+    int8_t rssi;            // dBm, 0 = không có WiFi
+    uint8_t unlocked;       // Số box đang mở
+    uint8_t fragPct;        // Phân mảnh heap (0-100 %)
+};
+
+static TelemetrySample _ring[TELEMETRY_RING_SIZE];
+static uint8_t _head = 0;       // Mẫu cũ nhất
+static uint8_t _count = 0;
+static uint8_t _inFlight = 0;   // Số mẫu đầu vòng đệm đang chờ phản hồi HTTP
+static unsigned long _lastFlush = 0;
+
+static uint32_t _lastLoops = 0;
+static uint64_t _lastLoopUs = 0;
+
+static StaticJsonDocument<TELEMETRY_DOC_SIZE> _doc;
+static uint8_t _buffer[TELEMETRY_BUFFER_SIZE];
+
+static uint32_t _batches = 0;
+static uint32_t _mqttBatches = 0;
+static uint32_t _httpBatches = 0;
+static uint32_t _dropped = 0;
+static uint16_t _lastBytes = 0;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static uint16_t saturate16(uint32_t value) {
+    return value > 0xFFFF ? 0xFFFF : (uint16_t)value;
+}
+
+static const TelemetrySample& sampleAt(uint8_t index) {
+    return _ring[(_head + index) % TELEMETRY_RING_SIZE];
+}
+
+/**
+ * Bỏ n mẫu đầu vòng đệm (đã gửi xong hoặc bị ghi đè)
+ */
+static void consume(uint8_t n) {
+    if (n > _count) n = _count;
+    _head = (_head + n) % TELEMETRY_RING_SIZE;
+    _count -= n;
+}
+
+/**
+ * Dựng lô từ n mẫu đầu vòng đệm, mỗi mảng mã hoá delta:
+ * {"t":[86400,30,30],"heap":[38120,-16,8],...}
+ */
+static void buildBatch(uint8_t n) {
+    _doc.clear();
+    _doc["box_id"] = BOX_ID;
+    _doc["box_count"] = boxCount();
+    _doc["status"] = "TELEMETRY";
+    _doc["device"] = DEVICE_ID;
+
+    JsonArray t = _doc.createNestedArray("t");
+    JsonArray open = _doc.createNestedArray("open");
+    JsonArray rssi = _doc.createNestedArray("rssi");
+    JsonArray heap = _doc.createNestedArray("heap");
+    JsonArray maxBlock = _doc.createNestedArray("maxBlock");
+    JsonArray frag = _doc.createNestedArray("fragPct");
+    JsonArray loops = _doc.createNestedArray("loops");
+    JsonArray loopUs = _doc.createNestedArray("loopUs");
+
+    TelemetrySample prev = {};
+    for (uint8_t i = 0; i < n; i++) {
+        const TelemetrySample& s = sampleAt(i);
+        t.add((int32_t)(s.uptimeSec - prev.uptimeSec));
+        open.add((int)s.unlocked - (int)prev.unlocked);
+        rssi.add((int)s.rssi - (int)prev.rssi);
+        heap.add((int32_t)s.freeHeap - (int32_t)prev.freeHeap);
+        maxBlock.add((int32_t)s.maxBlock - (int32_t)prev.maxBlock);
+        frag.add((int)s.fragPct - (int)prev.fragPct);
+        loops.add((int32_t)(s.loops - prev.loops));
+        loopUs.add((int32_t)s.loopAvgUs - (int32_t)prev.loopAvgUs);
+        prev = s;
+    }
+
+    // Trạng thái hiện tại: backend đối chiếu với các report đổi trạng thái
+    JsonArray unlocked = _doc.createNestedArray("unlocked");
+    for (uint8_t i = 0; i < boxCount(); i++) {
+        if (isUnlocked(boxIdAt(i))) unlocked.add(boxIdAt(i));
+    }
+
+    HeapStats stats;
+    heapGetStats(stats);
+    _doc["lowWater"] = stats.lowWater;
+    if (_dropped) _doc["dropped"] = _dropped;
+}
+
+static void onTelemetryResponse(int httpCode, const char* body, size_t length, void* ctx) {
+    if (httpCode == HTTP_CODE_OK) {
+        Serial.printf("[TELEMETRY] Delivered %u samples over HTTP\n", _inFlight);
+        consume(_inFlight);
+        _batches++;
+        _httpBatches++;
+        _lastFlush = millis();
+    } else {
+        Serial.printf("[TELEMETRY] HTTP batch failed: %d\n", httpCode);
+    }
+    _inFlight = 0;
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initTelemetry() {
+    memset(_ring, 0, sizeof(_ring));
+    _head = 0;
+    _count = 0;
+    _inFlight = 0;
+    _lastFlush = millis();
+
+    StageSummary loop;
+    metricsGetSummary(STAGE_LOOP, loop);
+    _lastLoops = loop.count;
+    _lastLoopUs = loop.sumUs;
+}
+
+void telemetrySample() {
+    // Đầy: ghi đè mẫu cũ nhất (kể cả mẫu đang chờ phản hồi HTTP)
+    if (_count == TELEMETRY_RING_SIZE) {
+        if (_inFlight) _inFlight--;
+        consume(1);
+        _dropped++;
+    }
+
+    TelemetrySample& s = _ring[(_head + _count) % TELEMETRY_RING_SIZE];
+    s.uptimeSec = millis() / 1000;
+
+    StageSummary loop;
+    metricsGetSummary(STAGE_LOOP, loop);
+    s.loops = loop.count - _lastLoops;
+    s.loopAvgUs = s.loops ? saturate16((uint32_t)((loop.sumUs - _lastLoopUs) / s.loops)) : 0;
+    _lastLoops = loop.count;
+    _lastLoopUs = loop.sumUs;
+
+    HeapStats heap;
+    heapGetStats(heap);
+    s.freeHeap = heap.freeHeap;
+    s.maxBlock = heap.maxFreeBlock;
+    s.fragPct = heap.fragmentation;
+
+    s.rssi = WiFi.status() == WL_CONNECTED ? (int8_t)WiFi.RSSI() : 0;
+
+    uint8_t unlocked = 0;
+    for (uint8_t i = 0; i < boxCount(); i++) {
+        if (isUnlocked(boxIdAt(i))) unlocked++;
+    }
+    s.unlocked = unlocked;
+    _count++;
+
+    if (_count == TELEMETRY_RING_SIZE || millis() - _lastFlush >= TELEMETRY_FLUSH_INTERVAL) {
+        telemetryFlush();
+    }
+}
+
+bool telemetryFlush() {
+    if (_count == 0 || _inFlight) return false;
+
+    HeapScope heapScope("telemetry:flush");
+
+    // Lô quá lớn cho buffer (số liệu biến động mạnh): gửi nửa đầu, phần còn lại lượt sau
+    uint8_t n = _count;
+    buildBatch(n);
+    while (n > 1 && measureJson(_doc) >= sizeof(_buffer)) {
+        n /= 2;
+        buildBatch(n);
+    }
+
+    size_t bytes = publishStatusBatch(_doc, _buffer, sizeof(_buffer));
+    if (bytes > 0) {
+        Serial.printf("[TELEMETRY] Sent %u samples over MQTT (%u bytes)\n", n, (unsigned)bytes);
+        consume(n);
+        _batches++;
+        _mqttBatches++;
+        _lastBytes = bytes;
+        _lastFlush = millis();
+        return true;
+    }
+
+    // MQTT mất kết nối: gửi JSON qua HTTP, mẫu được giữ tới khi backend trả 200
+    if (WiFi.status() != WL_CONNECTED || asyncHttpPending() >= ASYNC_HTTP_SLOTS) return false;
+    size_t length = serializeJson(_doc, (char*)_buffer, sizeof(_buffer));
+    if (!asyncHttpPost("/api/iot/telemetry", String((const char*)_buffer), onTelemetryResponse, nullptr)) {
+        return false;
+    }
+    Serial.printf("[TELEMETRY] Sending %u samples over HTTP (%u bytes)\n", n, (unsigned)length);
+    _inFlight = n;
+    _lastBytes = length;
+    return true;
+}
+
+void telemetryGetStats(TelemetryStats& stats) {
+    stats.samples = _count;
+    stats.batches = _batches;
+    stats.mqttBatches = _mqttBatches;
+    stats.httpBatches = _httpBatches;
+    stats.dropped = _dropped;
+    stats.lastBytes = _lastBytes;
+}
@@ -0,0 +1,233 @@
+/**
+ * Verify Pipeline Implementation
+ *
+ * Kiosk gửi PIN → khớp kho PIN cục bộ thì mở khóa và trả lời ngay →
+ * PIN vừa sai hoặc nhập sai quá nhiều (pin_guard) thì từ chối ngay →
+ * nếu không, handler đăng ký request vào một slot và trả về ngay →
+ * async HTTP gọi /api/iot/verify-pin → callback mở khóa và trả lời kiosk.
+ */
+
+#include "verify_pipeline.h"
+#include "async_http.h"
+#include "config.h"
+#include "locker_controller.h"
+#include "heap_monitor.h"
+#include "pin_cache.h"
+#include "pin_guard.h"
+#include "platform.h"
+#include <ArduinoJson.h>
+
+// ============================================
+// Pending Kiosk Requests
+// ============================================
+struct PendingVerify {
+    bool active;
+    WiFiClient kiosk;
+    int boxId;
+    char pinCode[8];        // Để ghi negative cache nếu backend từ chối
+    IPAddress source;
+    unsigned long startTime;
+};
+
+static PendingVerify _pending[VERIFY_MAX_PENDING];
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static const char* reasonPhrase(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default: return "";
+    }
+}
+
+/**
+ * Mở khóa, trả kết quả thành công cho kiosk và báo trạng thái box
+ */
+static void unlockAndRespond(WiFiClient& kiosk, int boxId, long orderId, int boxNumber) {
+    // Bản build hai lõi: false = hàng đợi lệnh đầy (task actuation treo)
+    if (!unlockBox(boxId)) {
+        Serial.printf("[KIOSK] Actuator busy, box %d not unlocked\n", boxId);
+        sendDeferredJson(kiosk, 503, "{\"success\":false,\"message\":\"Hệ thống đang bận, thử lại sau.\"}");
+        return;
+    }
+
+    StaticJsonDocument<256> successResp;
+    successResp["success"] = true;
+    successResp["message"] = "Đã mở khóa thành công! Hộp sẽ tự khóa sau 5 giây.";
+    successResp["orderId"] = orderId;
+    successResp["boxNumber"] = boxNumber;
+
+    String successJson;
+    serializeJson(successResp, successJson);
+    sendDeferredJson(kiosk, 200, successJson);
+
+    // Báo cáo trạng thái
+    reportBoxStatus(boxId, STATUS_AVAILABLE, true);
+}
+
+/**
+ * Xử lý phản hồi từ backend verify-pin
+ */
+static void onVerifyResponse(int httpCode, const char* body, size_t length, void* ctx) {
+    HeapScope heapScope("verify:response");
+    PendingVerify* pending = (PendingVerify*)ctx;
+    unsigned long elapsed = millis() - pending->startTime;
+
+    if (httpCode <= 0) {
+        Serial.printf("[KIOSK] Backend connection failed: %s\n", HTTPClient::errorToString(httpCode).c_str());
+        sendDeferredJson(pending->kiosk, 500, "{\"success\":false,\"message\":\"Không thể kết nối server. Thử lại sau.\"}");
+        pending->active = false;
+        return;
+    }
+
+    Serial.printf("[KIOSK] Backend response (%d) after %lu ms: %s\n", httpCode, elapsed, body);
+
+    // Parse backend response
+    StaticJsonDocument<512> resDoc;
+    DeserializationError error = deserializeJson(resDoc, body, length);
+
+    if (error) {
+        Serial.println("[KIOSK] Failed to parse backend response");
+        sendDeferredJson(pending->kiosk, 500, "{\"success\":false,\"message\":\"Lỗi xử lý phản hồi từ server\"}");
+        pending->active = false;
+        return;
+    }
+
+    // Kiểm tra kết quả xác thực
+    // Backend trả về: {"success": true, "data": {"valid": true, ...}, "code": "PIN_VALID"}
+    bool isValid = resDoc["data"]["valid"] | false;
+
+    if (!isValid) {
+        const char* msg = resDoc["data"]["message"] | "Mã PIN không hợp lệ";
+        Serial.printf("[KIOSK] PIN invalid: %s\n", msg);
+        pinGuardRecordFailure(pending->source, pending->boxId, pending->pinCode);
+
+        StaticJsonDocument<256> errResp;
+        errResp["success"] = false;
+        errResp["message"] = msg;
+        String errJson;
+        serializeJson(errResp, errJson);
+        sendDeferredJson(pending->kiosk, 200, errJson);
+        pending->active = false;
+        return;
+    }
+
+    // PIN hợp lệ - Mở khóa!
+    Serial.printf("[KIOSK] PIN valid! Unlocking box %d...\n", pending->boxId);
+    long orderId = resDoc["data"]["orderId"] | 0;
+    int boxNumber = resDoc["data"]["boxNumber"] | pending->boxId;
+
+    // PIN đã dùng qua backend, bản sao cục bộ (nếu có) không còn giá trị
+    if (orderId > 0) pinCacheRevoke(orderId);
+
+    unlockAndRespond(pending->kiosk, pending->boxId, orderId, boxNumber);
+    pending->active = false;
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void sendDeferredJson(WiFiClient& kiosk, int code, const String& json) {
+    char head[160];
+    int headLen = snprintf(head, sizeof(head),
+        "HTTP/1.1 %d %s\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: %u\r\n"
+        "Connection: close\r\n"
+        "\r\n",
+        code, reasonPhrase(code), (unsigned)json.length());
+
+    if (kiosk.connected()) {
+        kiosk.write((const uint8_t*)head, headLen);
+        kiosk.write((const uint8_t*)json.c_str(), json.length());
+    } else {
+        Serial.println("[KIOSK] Kiosk disconnected before response");
+    }
+    kiosk.stop();
+}
+
+bool beginVerifyAndUnlock(WiFiClient& kiosk, const String& pinCode, int boxId) {
+    // Nguồn/box đã hết lượt nhập sai: chặn trước cả kho PIN cục bộ, nếu không
+    // vẫn đoán tiếp được PIN đã cấp sẵn
+    uint32_t retryAfterSec = 0;
+    if (pinGuardLimited(kiosk.remoteIP(), boxId, retryAfterSec)) {
+        char limitedJson[128];
+        snprintf(limitedJson, sizeof(limitedJson),
+                 "{\"success\":false,\"message\":\"Nhập sai quá nhiều lần. Thử lại sau %lu giây.\",\"retryAfter\":%lu}",
+                 (unsigned long)retryAfterSec, (unsigned long)retryAfterSec);
+        sendDeferredJson(kiosk, 429, limitedJson);
+        return true;
+    }
+
+    // PIN backend đã gửi trước: xác thực ngay trên ESP, không cần backend
+    uint32_t orderId = 0;
+    PinCacheResult local = pinCacheVerify(boxId, pinCode.c_str(), orderId);
+    if (local == PIN_CACHE_HIT) {
+        Serial.printf("[KIOSK] PIN valid (local cache)! Unlocking box %d...\n", boxId);
+        unlockAndRespond(kiosk, boxId, orderId, boxId);
+        return true;
+    }
+    if (local == PIN_CACHE_USED) {
+        Serial.printf("[KIOSK] PIN of order %lu already used\n", (unsigned long)orderId);
+        sendDeferredJson(kiosk, 200, "{\"success\":false,\"message\":\"Mã PIN đã được sử dụng\"}");
+        return true;
+    }
+
+    // Nhập sai lặp lại: trả lời ngay, không gọi backend (lượt đã được kiểm ở trên)
+    PinGuardResult guard = pinGuardCheck(kiosk.remoteIP(), boxId, pinCode.c_str(), retryAfterSec);
+    if (guard == PIN_GUARD_REJECTED) {
+        Serial.println("[KIOSK] PIN rejected recently, answering locally");
+        sendDeferredJson(kiosk, 200, "{\"success\":false,\"message\":\"Mã PIN không hợp lệ\"}");
+        return true;
+    }
+
+    PendingVerify* pending = nullptr;
+    for (uint8_t i = 0; i < VERIFY_MAX_PENDING; i++) {
+        if (!_pending[i].active) {
+            pending = &_pending[i];
+            break;
+        }
+    }
+    if (!pending) {
+        Serial.println("[KIOSK] Verify pipeline full");
+        return false;
+    }
+
+    // Tạo request body cho backend
+    StaticJsonDocument<128> verifyReq;
+    verifyReq["boxId"] = boxId;
+    verifyReq["pinCode"] = pinCode;
+
+    String verifyBody;
+    serializeJson(verifyReq, verifyBody);
+    Serial.printf("[KIOSK] Backend request: %s\n", verifyBody.c_str());
+
+    // Giữ kết nối kiosk để trả lời khi backend phản hồi
+    pending->kiosk = kiosk;
+    pending->boxId = boxId;
+    strlcpy(pending->pinCode, pinCode.c_str(), sizeof(pending->pinCode));
+    pending->source = kiosk.remoteIP();
+    pending->startTime = millis();
+    pending->active = true;
+
+    if (!asyncHttpPost("/api/iot/verify-pin", verifyBody, onVerifyResponse, pending)) {
+        sendDeferredJson(pending->kiosk, 500, "{\"success\":false,\"message\":\"Không thể kết nối server. Thử lại sau.\"}");
+        pending->active = false;
+    }
+    return true;
+}
+
+uint8_t verifyPipelinePending() {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < VERIFY_MAX_PENDING; i++) {
+        if (_pending[i].active) count++;
+    }
+    return count;
+}
@@ -0,0 +1,268 @@
+/**
+ * WiFi Manager Implementation
+ *
+ * Máy trạng thái: FAST (BSSID + kênh đã lưu) → FULL (quét đầy đủ) →
+ * RETRY (chờ WIFI_RECONNECT_INTERVAL) → FAST... Mỗi bước chỉ gọi
+ * WiFi.begin() rồi trả về; wifiManagerLoop() kiểm tra kết quả.
+ *
+ * Cache được ghi vào RTC mỗi lần kết nối, vào flash (EEPROM) chỉ khi
+ * BSSID/kênh/IP thay đổi để tránh mòn flash.
+ */
+
+#include "wifi_manager.h"
+#include "config.h"
+#include "platform.h"
+#include "dual_core.h"
+#include <EEPROM.h>
+
+// ============================================
+// Cache Record
+// ============================================
+#define WIFI_CACHE_MAGIC 0x57464331  // "WFC1"
+
+struct WiFiCache {
+    uint32_t magic;
+    uint32_t ssidCrc;       // Đổi WIFI_SSID thì cache cũ không còn hợp lệ
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t reserved;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    uint32_t crc;           // CRC32 của các trường phía trên
+};
+
+enum WiFiState {
+    WIFI_STATE_FAST,
+    WIFI_STATE_FULL,
+    WIFI_STATE_RETRY,
+    WIFI_STATE_CONNECTED
+};
+
+// ============================================
+// State Variables
+// ============================================
+static WiFiCache _cache;
+static bool _cacheValid = false;
+static WiFiState _state = WIFI_STATE_RETRY;
+static uint32_t _stateStart = 0;
+static uint32_t _connectStart = 0;  // Lần thử đầu tiên của đợt kết nối hiện tại
+static WiFiConnectedCallback _onConnected = nullptr;
+
+static uint32_t _connects = 0;
+static uint32_t _fastConnects = 0;
+static uint32_t _fastFailures = 0;
+static uint32_t _lastConnectMs = 0;
+
+// ============================================
+// Helper Functions
+// ============================================
+
+static uint32_t cacheCrc32(const void* data, size_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t cacheCrc(const WiFiCache& cache) {
+    return cacheCrc32(&cache, offsetof(WiFiCache, crc));
+}
+
+static bool cacheUsable(const WiFiCache& cache) {
+    return cache.magic == WIFI_CACHE_MAGIC
+        && cache.ssidCrc == cacheCrc32(WIFI_SSID, strlen(WIFI_SSID))
+        && cache.channel >= 1 && cache.channel <= 14
+        && cache.crc == cacheCrc(cache);
+}
+
+/**
+ * Đọc cache: RTC trước (nhanh, sau reset), flash nếu RTC trống (sau mất điện)
+ */
+static void loadCache() {
+    platformRtcRead(WIFI_RTC_OFFSET, (uint32_t*)&_cache, sizeof(_cache));
+    if (cacheUsable(_cache)) {
+        _cacheValid = true;
+        Serial.println("[WIFI] Cache loaded from RTC");
+        return;
+    }
+
+    EEPROM.get(WIFI_EEPROM_ADDR, _cache);
+    if (cacheUsable(_cache)) {
+        _cacheValid = true;
+        platformRtcWrite(WIFI_RTC_OFFSET, (uint32_t*)&_cache, sizeof(_cache));
+        Serial.println("[WIFI] Cache loaded from flash");
+        return;
+    }
+
+    _cacheValid = false;
+    Serial.println("[WIFI] No cached AP, full scan");
+}
+
+/**
+ * Lưu AP và IP hiện tại
+ */
+static void saveCache() {
+    WiFiCache cache;
+    memset(&cache, 0, sizeof(cache));
+    cache.magic = WIFI_CACHE_MAGIC;
+    cache.ssidCrc = cacheCrc32(WIFI_SSID, strlen(WIFI_SSID));
+    memcpy(cache.bssid, WiFi.BSSID(), sizeof(cache.bssid));
+    cache.channel = WiFi.channel();
+    cache.ip = (uint32_t)WiFi.localIP();
+    cache.gateway = (uint32_t)WiFi.gatewayIP();
+    cache.subnet = (uint32_t)WiFi.subnetMask();
+    cache.dns = (uint32_t)WiFi.dnsIP();
+    cache.crc = cacheCrc(cache);
+
+    bool changed = !_cacheValid || memcmp(&cache, &_cache, sizeof(cache)) != 0;
+    _cache = cache;
+    _cacheValid = true;
+    platformRtcWrite(WIFI_RTC_OFFSET, (uint32_t*)&_cache, sizeof(_cache));
+
+    if (changed) {
+        // Chỉ ghi flash khi AP/kênh/IP đổi (EEPROM.commit xoá cả sector 4 KB)
+        EEPROM.put(WIFI_EEPROM_ADDR, _cache);
+#if LOCKER_DUAL_CORE
+        uint32_t flashStart = micros();
+#endif
+        EEPROM.commit();
+#if LOCKER_DUAL_CORE
+        dualCoreFlashDone(flashStart);
+#endif
+        Serial.printf("[WIFI] Cache updated: %s ch%d\n", WiFi.BSSIDstr().c_str(), _cache.channel);
+    }
+}
+
+/**
+ * Cấu hình IP trước WiFi.begin(): IP tĩnh, IP DHCP lần trước, hoặc DHCP
+ */
+static void configureIp(bool reuseLease) {
+    IPAddress ip;
+    if (ip.fromString(WIFI_STATIC_IP)) {
+        IPAddress gateway, subnet, dns;
+        gateway.fromString(WIFI_STATIC_GATEWAY);
+        subnet.fromString(WIFI_STATIC_SUBNET);
+        dns.fromString(WIFI_STATIC_DNS);
+        WiFi.config(ip, gateway, subnet, dns);
+    } else if (reuseLease && WIFI_REUSE_LEASE && _cache.ip != 0) {
+        WiFi.config(IPAddress(_cache.ip), IPAddress(_cache.gateway), IPAddress(_cache.subnet), IPAddress(_cache.dns));
+    } else {
+        // IP 0.0.0.0 = bật lại DHCP client
+        WiFi.config(IPAddress(), IPAddress(), IPAddress());
+    }
+}
+
+static void startFull() {
+    Serial.printf("[WIFI] Scanning for %s...\n", WIFI_SSID);
+    configureIp(false);
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    _state = WIFI_STATE_FULL;
+    _stateStart = millis();
+}
+
+static void startFast() {
+    if (!_cacheValid) {
+        startFull();
+        return;
+    }
+    Serial.printf("[WIFI] Fast connect to %02X:%02X:%02X:%02X:%02X:%02X ch%d\n",
+                  _cache.bssid[0], _cache.bssid[1], _cache.bssid[2],
+                  _cache.bssid[3], _cache.bssid[4], _cache.bssid[5], _cache.channel);
+    configureIp(true);
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD, _cache.channel, _cache.bssid, true);
+    _state = WIFI_STATE_FAST;
+    _stateStart = millis();
+}
+
+static void onConnected(bool fast) {
+    _lastConnectMs = millis() - _connectStart;
+    _connects++;
+    if (fast) _fastConnects++;
+    _state = WIFI_STATE_CONNECTED;
+
+    Serial.printf("[WIFI] Connected in %lu ms (%s)\n", (unsigned long)_lastConnectMs, fast ? "fast" : "scan");
+    Serial.printf("[WIFI] IP Address: %s\n", WiFi.localIP().toString().c_str());
+    Serial.printf("[WIFI] Signal strength: %d dBm\n", WiFi.RSSI());
+
+    saveCache();
+    if (_onConnected) _onConnected();
+}
+
+// ============================================
+// Public Functions
+// ============================================
+
+void initWiFiManager(WiFiConnectedCallback onConnected) {
+    _onConnected = onConnected;
+
+    // Tự quản lý kết nối lại; SDK không ghi cấu hình WiFi vào flash mỗi lần begin()
+    WiFi.persistent(false);
+    WiFi.setAutoReconnect(false);
+    WiFi.mode(WIFI_STA);
+
+    EEPROM.begin(EEPROM_SIZE);
+    loadCache();
+
+    Serial.printf("\n[WIFI] Connecting to %s...\n", WIFI_SSID);
+    _connectStart = millis();
+    startFast();
+}
+
+void wifiManagerLoop() {
+    bool linkUp = WiFi.status() == WL_CONNECTED;
+    uint32_t elapsed = millis() - _stateStart;
+
+    switch (_state) {
+        case WIFI_STATE_CONNECTED:
+            if (!linkUp) {
+                Serial.println("[WIFI] Connection lost, reconnecting...");
+                _connectStart = millis();
+                startFast();
+            }
+            break;
+
+        case WIFI_STATE_FAST:
+            if (linkUp) {
+                onConnected(true);
+            } else if (elapsed >= WIFI_FAST_TIMEOUT) {
+                _fastFailures++;
+                Serial.println("[WIFI] Fast connect timed out");
+                startFull();
+            }
+            break;
+
+        case WIFI_STATE_FULL:
+            if (linkUp) {
+                onConnected(false);
+            } else if (elapsed >= WIFI_CONNECT_TIMEOUT) {
+                Serial.printf("[WIFI] Connection failed! Retry in %ds\n", WIFI_RECONNECT_INTERVAL / 1000);
+                WiFi.disconnect();
+                _state = WIFI_STATE_RETRY;
+                _stateStart = millis();
+            }
+            break;
+
+        case WIFI_STATE_RETRY:
+            if (elapsed >= WIFI_RECONNECT_INTERVAL) {
+                startFast();
+            }
+            break;
+    }
+}
+
+void wifiGetStats(WiFiStats& stats) {
+    stats.connected = _state == WIFI_STATE_CONNECTED;
+    stats.cacheValid = _cacheValid;
+    stats.connects = _connects;
+    stats.fastConnects = _fastConnects;
+    stats.fastFailures = _fastFailures;
+    stats.lastConnectMs = _lastConnectMs;
+    stats.channel = _cacheValid ? _cache.channel : 0;
+}